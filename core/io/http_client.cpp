@@ -49,6 +49,15 @@ HTTPClient *HTTPClient::create() {
 	return nullptr;
 }
 
+Error HTTPClient::read_response_body(uint8_t *p_buffer, int p_size, int &r_read) {
+	r_read = 0;
+	return ERR_UNAVAILABLE;
+}
+
+Error HTTPClient::pipeline_request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size) {
+	return ERR_UNAVAILABLE;
+}
+
 void HTTPClient::set_http_proxy(const String &p_host, int p_port) {
 	WARN_PRINT("HTTP proxy feature is not available");
 }
@@ -184,6 +184,10 @@ public:
 	virtual int64_t get_response_body_length() const = 0;
 
 	virtual PackedByteArray read_response_body_chunk() = 0; // Can't get body as partial text because of most encodings UTF8, gzip, etc.
+	// Reads the body straight into p_buffer. Returns ERR_UNAVAILABLE if not supported, use read_response_body_chunk then.
+	virtual Error read_response_body(uint8_t *p_buffer, int p_size, int &r_read);
+	// Sends a request while the previous responses are still being received (HTTP/1.1 pipelining).
+	virtual Error pipeline_request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size);
 
 	virtual void set_blocking_mode(bool p_enable) = 0; // Useful mostly if running in a thread
 	virtual bool is_blocking_mode_enabled() const = 0;
@@ -0,0 +1,560 @@
+/*************************************************************************/
+/*  http_client_pool.cpp                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "http_client_pool.h"
+
+#include "core/os/os.h"
+
+bool HTTPClientPool::_is_idempotent(HTTPClient::Method p_method) {
+	switch (p_method) {
+		case HTTPClient::METHOD_GET:
+		case HTTPClient::METHOD_HEAD:
+		case HTTPClient::METHOD_PUT:
+		case HTTPClient::METHOD_DELETE:
+		case HTTPClient::METHOD_OPTIONS:
+		case HTTPClient::METHOD_TRACE:
+			return true;
+		default:
+			return false;
+	}
+}
+
+void HTTPClientPool::_thread_func(void *p_userdata) {
+	HTTPClientPool *pool = (HTTPClientPool *)p_userdata;
+	while (!pool->thread_exit.is_set()) {
+		pool->mutex.lock();
+		pool->_service();
+		pool->mutex.unlock();
+		OS::get_singleton()->delay_usec(THREAD_IDLE_USEC);
+	}
+}
+
+Error HTTPClientPool::_parse_url(const String &p_url, String &r_key, String &r_host, int &r_port, bool &r_ssl, String &r_path) const {
+	String scheme;
+	r_port = 0;
+	Error err = p_url.parse_url(scheme, r_host, r_port, r_path);
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Error parsing URL: " + p_url + ".");
+	if (scheme == "https://") {
+		r_ssl = true;
+	} else if (scheme == "http://") {
+		r_ssl = false;
+	} else {
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Invalid URL scheme: " + scheme + ".");
+	}
+	if (r_port == 0) {
+		r_port = r_ssl ? 443 : 80;
+	}
+	if (r_path.is_empty()) {
+		r_path = "/";
+	}
+	r_key = scheme + r_host + ":" + itos(r_port);
+	return OK;
+}
+
+void HTTPClientPool::_service() {
+	const uint64_t now = OS::get_singleton()->get_ticks_msec();
+	const String *k = nullptr;
+	while ((k = hosts.next(k))) {
+		Host *host = hosts[*k];
+
+		// Hand queued requests to idle connections first, then to new ones, then pipeline them.
+		while (!host->queue.is_empty()) {
+			Request *req = host->queue.front()->get();
+			Connection *target = nullptr;
+			for (uint32_t i = 0; i < host->connections.size() && !target; i++) {
+				Connection *conn = host->connections[i];
+				if (!conn->closing && conn->requests.is_empty()) {
+					target = conn;
+				}
+			}
+			if (!target && (int)host->connections.size() < max_connections_per_host) {
+				Ref<HTTPClient> client = Ref<HTTPClient>(HTTPClient::create());
+				Error err = client.is_valid() ? client->connect_to_host(host->host, host->port, host->ssl) : ERR_UNAVAILABLE;
+				if (err != OK) {
+					host->queue.pop_front();
+					_complete_request(req, err);
+					continue;
+				}
+				target = memnew(Connection);
+				target->client = client;
+				target->idle_since = now;
+				host->connections.push_back(target);
+			}
+			if (!target && max_pipelined_requests > 1 && _is_idempotent(req->method)) {
+				for (uint32_t i = 0; i < host->connections.size(); i++) {
+					Connection *conn = host->connections[i];
+					if (conn->closing || !conn->pipelining || (int)conn->requests.size() >= max_pipelined_requests) {
+						continue;
+					}
+					// Non idempotent requests are never pipelined, nor followed by other requests.
+					if (!_is_idempotent(conn->requests[conn->requests.size() - 1]->method)) {
+						continue;
+					}
+					if (!target || conn->requests.size() < target->requests.size()) {
+						target = conn;
+					}
+				}
+			}
+			if (!target) {
+				break; // Wait for a connection to free up.
+			}
+			host->queue.pop_front();
+			target->requests.push_back(req);
+		}
+
+		for (uint32_t i = 0; i < host->connections.size();) {
+			Connection *conn = host->connections[i];
+			if (!_service_connection(host, conn)) {
+				continue; // Closed and removed.
+			}
+			if (conn->requests.is_empty() && (conn->closing || (now > conn->idle_since && now - conn->idle_since > uint64_t(keep_alive_timeout * 1000)))) {
+				_close_connection(host, conn, OK);
+				continue;
+			}
+			i++;
+		}
+	}
+}
+
+bool HTTPClientPool::_service_connection(Host *p_host, Connection *p_conn) {
+	HTTPClient *client = p_conn->client.ptr();
+	// Each poll parses at most one response header, so loop to catch up with pipelined responses.
+	for (uint32_t i = 0; i <= p_conn->requests.size(); i++) {
+		client->poll();
+		const HTTPClient::Status status = client->get_status();
+		switch (status) {
+			case HTTPClient::STATUS_RESOLVING:
+			case HTTPClient::STATUS_CONNECTING:
+				return true;
+			case HTTPClient::STATUS_CONNECTED:
+			case HTTPClient::STATUS_REQUESTING:
+			case HTTPClient::STATUS_BODY:
+				break;
+			case HTTPClient::STATUS_CANT_RESOLVE:
+				_close_connection(p_host, p_conn, ERR_CANT_RESOLVE);
+				return false;
+			case HTTPClient::STATUS_CANT_CONNECT:
+			case HTTPClient::STATUS_SSL_HANDSHAKE_ERROR:
+				_close_connection(p_host, p_conn, ERR_CANT_CONNECT);
+				return false;
+			default:
+				_close_connection(p_host, p_conn, ERR_CONNECTION_ERROR);
+				return false;
+		}
+		_send_requests(p_host, p_conn);
+		if (!_read_response(p_conn)) {
+			break;
+		}
+	}
+	return true;
+}
+
+void HTTPClientPool::_send_requests(Host *p_host, Connection *p_conn) {
+	HTTPClient *client = p_conn->client.ptr();
+	while (p_conn->sent < p_conn->requests.size()) {
+		Request *req = p_conn->requests[p_conn->sent];
+		const uint8_t *data = req->data.size() ? req->data.ptr() : nullptr;
+		Error err;
+		if (p_conn->sent == 0) {
+			if (client->get_status() != HTTPClient::STATUS_CONNECTED) {
+				return;
+			}
+			err = client->request(req->method, req->url, req->headers, data, req->data.size());
+		} else {
+			err = client->pipeline_request(req->method, req->url, req->headers, data, req->data.size());
+		}
+		if (err == OK) {
+			p_conn->sent++;
+			continue;
+		}
+		if (p_conn->sent == 0) {
+			p_conn->requests.remove_at(0);
+			_complete_request(req, err);
+			continue;
+		}
+		// Pipelining is not available, requeue the requests not sent yet.
+		p_conn->pipelining = false;
+		while (p_conn->requests.size() > p_conn->sent) {
+			p_host->queue.push_front(p_conn->requests[p_conn->requests.size() - 1]);
+			p_conn->requests.remove_at(p_conn->requests.size() - 1);
+		}
+	}
+}
+
+bool HTTPClientPool::_read_response(Connection *p_conn) {
+	if (p_conn->requests.is_empty() || !p_conn->sent) {
+		return false;
+	}
+	HTTPClient *client = p_conn->client.ptr();
+	Request *req = p_conn->requests[0];
+	if (client->has_response()) {
+		req->has_response = true;
+		req->response_code = client->get_response_code();
+		List<String> headers;
+		client->get_response_headers(&headers);
+		req->response_headers.clear();
+		for (const String &E : headers) {
+			req->response_headers.push_back(E);
+			if (E.to_lower().begins_with("connection: close")) {
+				p_conn->closing = true;
+			}
+		}
+	}
+	if (!req->has_response) {
+		return false;
+	}
+
+	Error err = OK;
+	if (client->get_status() == HTTPClient::STATUS_BODY) {
+		err = _read_body(p_conn, req);
+	}
+	const HTTPClient::Status status = client->get_status();
+	// The response also ends when the server closes a connection without body length.
+	const bool done = status == HTTPClient::STATUS_CONNECTED || status == HTTPClient::STATUS_REQUESTING || err == ERR_FILE_EOF;
+	if (!done && err != ERR_OUT_OF_MEMORY) {
+		return false;
+	}
+
+	p_conn->requests.remove_at(0);
+	p_conn->sent--;
+	p_conn->idle_since = OS::get_singleton()->get_ticks_msec();
+	if (err == ERR_OUT_OF_MEMORY) {
+		// The rest of the body can't be skipped, drop the connection.
+		p_conn->closing = true;
+		client->close();
+		_complete_request(req, ERR_OUT_OF_MEMORY);
+	} else {
+		_complete_request(req, OK);
+	}
+	return true;
+}
+
+Error HTTPClientPool::_read_body(Connection *p_conn, Request *p_request) {
+	HTTPClient *client = p_conn->client.ptr();
+	const int64_t length = client->get_response_body_length();
+	if (body_size_limit >= 0 && length > body_size_limit) {
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	while (client->get_status() == HTTPClient::STATUS_BODY) {
+		// The body grows ahead and the client reads straight into it.
+		int64_t room = p_request->body.size() - p_request->body_size;
+		if (room <= 0 && (length < 0 || length > p_request->body_size)) {
+			const int64_t capacity = length >= 0 ? length : MAX(int64_t(p_request->body.size()) * 2, int64_t(MIN_BODY_CAPACITY));
+			p_request->body.resize(capacity);
+			room = capacity - p_request->body_size;
+		}
+		uint8_t end = 0; // Lets the client finish a body with nothing left to read.
+		uint8_t *dst = room > 0 ? p_request->body.ptrw() + p_request->body_size : &end;
+
+		int read = 0;
+		Error err = client->read_response_body(dst, MAX(int(MIN(room, int64_t(1 << 24))), 1), read);
+		if (err == ERR_UNAVAILABLE) {
+			// Not supported by this client, copy its chunks instead.
+			const PackedByteArray chunk = client->read_response_body_chunk();
+			read = chunk.size();
+			if (read > room) {
+				p_request->body.resize(p_request->body_size + read);
+			}
+			if (read) {
+				memcpy(p_request->body.ptrw() + p_request->body_size, chunk.ptr(), read);
+			}
+			err = OK;
+		}
+		p_request->body_size += read;
+		if (body_size_limit >= 0 && p_request->body_size > body_size_limit) {
+			return ERR_OUT_OF_MEMORY;
+		}
+		if (err != OK) {
+			return err;
+		}
+		if (read == 0) {
+			break;
+		}
+	}
+	return OK;
+}
+
+void HTTPClientPool::_complete_request(Request *p_request, Error p_result) {
+	p_request->result = p_result;
+	p_request->body.resize(p_request->body_size);
+	completed.push_back(p_request);
+}
+
+void HTTPClientPool::_close_connection(Host *p_host, Connection *p_conn, Error p_error) {
+	// Requests that got no response yet are retried once on a new connection, if they are safe to repeat.
+	for (int i = p_conn->requests.size() - 1; i >= 0; i--) {
+		Request *req = p_conn->requests[i];
+		if (p_error == ERR_CONNECTION_ERROR && !req->has_response && req->retries < 1 && _is_idempotent(req->method)) {
+			req->retries++;
+			p_host->queue.push_front(req);
+		} else {
+			_complete_request(req, p_error);
+		}
+	}
+	p_conn->client->close();
+	p_host->connections.erase(p_conn);
+	memdelete(p_conn);
+}
+
+int HTTPClientPool::_request(const String &p_url, const Vector<String> &p_headers, HTTPClient::Method p_method, const uint8_t *p_data, int p_size) {
+	ERR_FAIL_INDEX_V(p_method, HTTPClient::METHOD_MAX, -1);
+	String key;
+	String host;
+	String path;
+	int port = 0;
+	bool ssl = false;
+	Error err = _parse_url(p_url, key, host, port, ssl, path);
+	if (err != OK) {
+		return -1;
+	}
+
+	MutexLock lock(mutex);
+	Request *req = memnew(Request);
+	req->id = ++last_request_id;
+	req->method = p_method;
+	req->url = path;
+	req->headers = p_headers;
+	if (p_size > 0) {
+		req->data.resize(p_size);
+		memcpy(req->data.ptrw(), p_data, p_size);
+	}
+
+	Host **existing = hosts.getptr(key);
+	Host *target = existing ? *existing : nullptr;
+	if (!target) {
+		target = memnew(Host);
+		target->host = host;
+		target->port = port;
+		target->ssl = ssl;
+		hosts[key] = target;
+	}
+	target->queue.push_back(req);
+	requests[req->id] = req;
+	return req->id;
+}
+
+int HTTPClientPool::request(const String &p_url, const Vector<String> &p_custom_headers, HTTPClient::Method p_method, const String &p_request_data) {
+	const CharString data = p_request_data.utf8();
+	return _request(p_url, p_custom_headers, p_method, (const uint8_t *)data.get_data(), data.length());
+}
+
+int HTTPClientPool::request_raw(const String &p_url, const Vector<String> &p_custom_headers, HTTPClient::Method p_method, const Vector<uint8_t> &p_request_data_raw) {
+	return _request(p_url, p_custom_headers, p_method, p_request_data_raw.ptr(), p_request_data_raw.size());
+}
+
+void HTTPClientPool::cancel_request(int p_request_id) {
+	MutexLock lock(mutex);
+	Request **found = requests.getptr(p_request_id);
+	ERR_FAIL_COND_MSG(!found, vformat("Unknown request ID %d.", p_request_id));
+	Request *req = *found;
+	requests.erase(p_request_id);
+
+	if (completed.erase(req)) {
+		memdelete(req);
+		return;
+	}
+	const String *k = nullptr;
+	while ((k = hosts.next(k))) {
+		if (hosts[*k]->queue.erase(req)) {
+			memdelete(req);
+			return;
+		}
+	}
+	// Already sent, its response is dropped when received.
+	req->cancelled = true;
+}
+
+void HTTPClientPool::poll() {
+	List<Request *> done;
+	{
+		MutexLock lock(mutex);
+		if (!use_threads) {
+			_service();
+		}
+		for (Request *req : completed) {
+			if (!req->cancelled) {
+				requests.erase(req->id);
+			}
+			done.push_back(req);
+		}
+		completed.clear();
+	}
+
+	for (Request *req : done) {
+		if (!req->cancelled) {
+			emit_signal(SNAME("request_completed"), req->id, req->result, req->response_code, req->response_headers, req->body);
+		}
+		memdelete(req);
+	}
+}
+
+void HTTPClientPool::close() {
+	MutexLock lock(mutex);
+	const String *k = nullptr;
+	while ((k = hosts.next(k))) {
+		Host *host = hosts[*k];
+		for (uint32_t i = 0; i < host->connections.size(); i++) {
+			Connection *conn = host->connections[i];
+			for (uint32_t j = 0; j < conn->requests.size(); j++) {
+				memdelete(conn->requests[j]);
+			}
+			conn->client->close();
+			memdelete(conn);
+		}
+		for (Request *req : host->queue) {
+			memdelete(req);
+		}
+		memdelete(host);
+	}
+	hosts.clear();
+	for (Request *req : completed) {
+		memdelete(req);
+	}
+	completed.clear();
+	requests.clear();
+}
+
+int HTTPClientPool::get_connection_count() const {
+	MutexLock lock(mutex);
+	int count = 0;
+	const String *k = nullptr;
+	while ((k = hosts.next(k))) {
+		count += hosts[*k]->connections.size();
+	}
+	return count;
+}
+
+int HTTPClientPool::get_pending_request_count() const {
+	MutexLock lock(mutex);
+	return requests.size();
+}
+
+void HTTPClientPool::set_max_connections_per_host(int p_max) {
+	ERR_FAIL_COND(p_max < 1);
+	MutexLock lock(mutex);
+	max_connections_per_host = p_max;
+}
+
+int HTTPClientPool::get_max_connections_per_host() const {
+	return max_connections_per_host;
+}
+
+void HTTPClientPool::set_max_pipelined_requests(int p_max) {
+	ERR_FAIL_COND(p_max < 1);
+	MutexLock lock(mutex);
+	max_pipelined_requests = p_max;
+}
+
+int HTTPClientPool::get_max_pipelined_requests() const {
+	return max_pipelined_requests;
+}
+
+void HTTPClientPool::set_keep_alive_timeout(double p_timeout) {
+	ERR_FAIL_COND(p_timeout < 0);
+	MutexLock lock(mutex);
+	keep_alive_timeout = p_timeout;
+}
+
+double HTTPClientPool::get_keep_alive_timeout() const {
+	return keep_alive_timeout;
+}
+
+void HTTPClientPool::set_body_size_limit(int p_limit) {
+	MutexLock lock(mutex);
+	body_size_limit = p_limit;
+}
+
+int HTTPClientPool::get_body_size_limit() const {
+	return body_size_limit;
+}
+
+void HTTPClientPool::_start_thread() {
+	thread_exit.clear();
+	thread.start(_thread_func, this);
+}
+
+void HTTPClientPool::_stop_thread() {
+	if (thread.is_started()) {
+		thread_exit.set();
+		thread.wait_to_finish();
+	}
+}
+
+void HTTPClientPool::set_use_threads(bool p_use) {
+	if (use_threads == p_use) {
+		return;
+	}
+	if (p_use) {
+		use_threads = true;
+		_start_thread();
+	} else {
+		_stop_thread();
+		use_threads = false;
+	}
+}
+
+bool HTTPClientPool::is_using_threads() const {
+	return use_threads;
+}
+
+void HTTPClientPool::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("request", "url", "custom_headers", "method", "request_data"), &HTTPClientPool::request, DEFVAL(PackedStringArray()), DEFVAL(HTTPClient::METHOD_GET), DEFVAL(String()));
+	ClassDB::bind_method(D_METHOD("request_raw", "url", "custom_headers", "method", "request_data_raw"), &HTTPClientPool::request_raw, DEFVAL(PackedStringArray()), DEFVAL(HTTPClient::METHOD_GET), DEFVAL(PackedByteArray()));
+	ClassDB::bind_method(D_METHOD("cancel_request", "request_id"), &HTTPClientPool::cancel_request);
+	ClassDB::bind_method(D_METHOD("poll"), &HTTPClientPool::poll);
+	ClassDB::bind_method(D_METHOD("close"), &HTTPClientPool::close);
+	ClassDB::bind_method(D_METHOD("get_connection_count"), &HTTPClientPool::get_connection_count);
+	ClassDB::bind_method(D_METHOD("get_pending_request_count"), &HTTPClientPool::get_pending_request_count);
+
+	ClassDB::bind_method(D_METHOD("set_max_connections_per_host", "max"), &HTTPClientPool::set_max_connections_per_host);
+	ClassDB::bind_method(D_METHOD("get_max_connections_per_host"), &HTTPClientPool::get_max_connections_per_host);
+	ClassDB::bind_method(D_METHOD("set_max_pipelined_requests", "max"), &HTTPClientPool::set_max_pipelined_requests);
+	ClassDB::bind_method(D_METHOD("get_max_pipelined_requests"), &HTTPClientPool::get_max_pipelined_requests);
+	ClassDB::bind_method(D_METHOD("set_keep_alive_timeout", "timeout"), &HTTPClientPool::set_keep_alive_timeout);
+	ClassDB::bind_method(D_METHOD("get_keep_alive_timeout"), &HTTPClientPool::get_keep_alive_timeout);
+	ClassDB::bind_method(D_METHOD("set_body_size_limit", "bytes"), &HTTPClientPool::set_body_size_limit);
+	ClassDB::bind_method(D_METHOD("get_body_size_limit"), &HTTPClientPool::get_body_size_limit);
+	ClassDB::bind_method(D_METHOD("set_use_threads", "enable"), &HTTPClientPool::set_use_threads);
+	ClassDB::bind_method(D_METHOD("is_using_threads"), &HTTPClientPool::is_using_threads);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_connections_per_host", PROPERTY_HINT_RANGE, "1,64,1,or_greater"), "set_max_connections_per_host", "get_max_connections_per_host");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_pipelined_requests", PROPERTY_HINT_RANGE, "1,32,1,or_greater"), "set_max_pipelined_requests", "get_max_pipelined_requests");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "keep_alive_timeout", PROPERTY_HINT_RANGE, "0,3600,0.1,or_greater"), "set_keep_alive_timeout", "get_keep_alive_timeout");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "body_size_limit", PROPERTY_HINT_RANGE, "-1,2000000000"), "set_body_size_limit", "get_body_size_limit");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "is_using_threads");
+
+	ADD_SIGNAL(MethodInfo("request_completed", PropertyInfo(Variant::INT, "request_id"), PropertyInfo(Variant::INT, "result"), PropertyInfo(Variant::INT, "response_code"), PropertyInfo(Variant::PACKED_STRING_ARRAY, "headers"), PropertyInfo(Variant::PACKED_BYTE_ARRAY, "body")));
+}
+
+HTTPClientPool::~HTTPClientPool() {
+	_stop_thread();
+	close();
+}
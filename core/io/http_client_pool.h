@@ -0,0 +1,144 @@
+/*************************************************************************/
+/*  http_client_pool.h                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef HTTP_CLIENT_POOL_H
+#define HTTP_CLIENT_POOL_H
+
+#include "core/io/http_client.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class HTTPClientPool : public RefCounted {
+	GDCLASS(HTTPClientPool, RefCounted);
+
+private:
+	struct Request {
+		int id = 0;
+		HTTPClient::Method method = HTTPClient::METHOD_GET;
+		String url;
+		Vector<String> headers;
+		Vector<uint8_t> data;
+		int retries = 0;
+		bool cancelled = false;
+
+		Error result = OK;
+		bool has_response = false;
+		int response_code = 0;
+		PackedStringArray response_headers;
+		PackedByteArray body;
+		int64_t body_size = 0; // Bytes written into body, which grows ahead.
+	};
+
+	struct Connection {
+		Ref<HTTPClient> client;
+		LocalVector<Request *> requests; // Sent or about to be, in response order.
+		uint32_t sent = 0;
+		bool closing = false; // The server won't take more requests on this connection.
+		bool pipelining = true;
+		uint64_t idle_since = 0;
+	};
+
+	struct Host {
+		String host;
+		int port = 0;
+		bool ssl = false;
+		List<Request *> queue;
+		LocalVector<Connection *> connections;
+	};
+
+	enum {
+		MIN_BODY_CAPACITY = 16384,
+		THREAD_IDLE_USEC = 1000,
+	};
+
+	int max_connections_per_host = 4;
+	int max_pipelined_requests = 1;
+	double keep_alive_timeout = 30.0;
+	int body_size_limit = -1;
+
+	HashMap<String, Host *> hosts;
+	HashMap<int, Request *> requests;
+	List<Request *> completed;
+	int last_request_id = 0;
+
+	Mutex mutex;
+	Thread thread;
+	SafeFlag thread_exit;
+	bool use_threads = false;
+
+	static bool _is_idempotent(HTTPClient::Method p_method);
+	static void _thread_func(void *p_userdata);
+
+	Error _parse_url(const String &p_url, String &r_key, String &r_host, int &r_port, bool &r_ssl, String &r_path) const;
+	void _service();
+	bool _service_connection(Host *p_host, Connection *p_conn);
+	void _send_requests(Host *p_host, Connection *p_conn);
+	bool _read_response(Connection *p_conn);
+	Error _read_body(Connection *p_conn, Request *p_request);
+	void _complete_request(Request *p_request, Error p_result);
+	void _close_connection(Host *p_host, Connection *p_conn, Error p_error);
+
+	int _request(const String &p_url, const Vector<String> &p_headers, HTTPClient::Method p_method, const uint8_t *p_data, int p_size);
+	void _start_thread();
+	void _stop_thread();
+
+protected:
+	static void _bind_methods();
+
+public:
+	int request(const String &p_url, const Vector<String> &p_custom_headers = Vector<String>(), HTTPClient::Method p_method = HTTPClient::METHOD_GET, const String &p_request_data = "");
+	int request_raw(const String &p_url, const Vector<String> &p_custom_headers = Vector<String>(), HTTPClient::Method p_method = HTTPClient::METHOD_GET, const Vector<uint8_t> &p_request_data_raw = Vector<uint8_t>());
+	void cancel_request(int p_request_id);
+	void poll();
+	void close();
+
+	int get_connection_count() const;
+	int get_pending_request_count() const;
+
+	void set_max_connections_per_host(int p_max);
+	int get_max_connections_per_host() const;
+	void set_max_pipelined_requests(int p_max);
+	int get_max_pipelined_requests() const;
+	void set_keep_alive_timeout(double p_timeout);
+	double get_keep_alive_timeout() const;
+	void set_body_size_limit(int p_limit);
+	int get_body_size_limit() const;
+	void set_use_threads(bool p_use);
+	bool is_using_threads() const;
+
+	HTTPClientPool() {}
+	~HTTPClientPool();
+};
+
+#endif // HTTP_CLIENT_POOL_H
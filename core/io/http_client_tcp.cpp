@@ -140,11 +140,9 @@ static bool _check_request_url(HTTPClientTCP::Method p_method, const String &p_u
 	}
 }
 
-Error HTTPClientTCP::request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size) {
+Error HTTPClientTCP::_queue_request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size) {
 	ERR_FAIL_INDEX_V(p_method, METHOD_MAX, ERR_INVALID_PARAMETER);
 	ERR_FAIL_COND_V(!_check_request_url(p_method, p_url), ERR_INVALID_PARAMETER);
-	ERR_FAIL_COND_V(status != STATUS_CONNECTED, ERR_INVALID_PARAMETER);
-	ERR_FAIL_COND_V(connection.is_null(), ERR_INVALID_DATA);
 
 	Error err = verify_headers(p_headers);
 	if (err) {
@@ -197,12 +195,27 @@ Error HTTPClientTCP::request(Method p_method, const String &p_url, const Vector<
 	request += "\r\n";
 	CharString cs = request.utf8();
 
-	request_buffer->clear();
+	// Append after the requests not sent yet.
+	const int pos = request_buffer->get_position();
+	request_buffer->seek(request_buffer->get_size());
 	request_buffer->put_data((const uint8_t *)cs.get_data(), cs.length());
 	if (p_body_size > 0) {
 		request_buffer->put_data(p_body, p_body_size);
 	}
-	request_buffer->seek(0);
+	request_buffer->seek(pos);
+
+	return OK;
+}
+
+Error HTTPClientTCP::request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size) {
+	ERR_FAIL_COND_V(status != STATUS_CONNECTED, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(connection.is_null(), ERR_INVALID_DATA);
+
+	request_buffer->clear();
+	Error err = _queue_request(p_method, p_url, p_headers, p_body, p_body_size);
+	if (err) {
+		return err;
+	}
 
 	status = STATUS_REQUESTING;
 	head_request = p_method == METHOD_HEAD;
@@ -210,6 +223,61 @@ Error HTTPClientTCP::request(Method p_method, const String &p_url, const Vector<
 	return OK;
 }
 
+Error HTTPClientTCP::pipeline_request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size) {
+	if (status == STATUS_CONNECTED) {
+		return request(p_method, p_url, p_headers, p_body, p_body_size);
+	}
+	ERR_FAIL_COND_V(status != STATUS_REQUESTING && status != STATUS_BODY, ERR_INVALID_PARAMETER);
+
+	Error err = _queue_request(p_method, p_url, p_headers, p_body, p_body_size);
+	if (err) {
+		return err;
+	}
+	pipelined_head_requests.push_back(p_method == METHOD_HEAD);
+
+	return OK;
+}
+
+Error HTTPClientTCP::_send_request_data() {
+	int avail = request_buffer->get_available_bytes();
+	if (!avail) {
+		return OK;
+	}
+	int pos = request_buffer->get_position();
+	const Vector<uint8_t> data = request_buffer->get_data_array();
+	int wrote = 0;
+	Error err;
+	if (blocking) {
+		err = connection->put_data(data.ptr() + pos, avail);
+		wrote += avail;
+	} else {
+		err = connection->put_partial_data(data.ptr() + pos, avail, wrote);
+	}
+	if (err != OK) {
+		close();
+		status = STATUS_CONNECTION_ERROR;
+		return ERR_CONNECTION_ERROR;
+	}
+	pos += wrote;
+	request_buffer->seek(pos);
+	if (avail - wrote > 0) {
+		return ERR_BUSY;
+	}
+	request_buffer->clear();
+	return OK;
+}
+
+void HTTPClientTCP::_response_done() {
+	if (pipelined_head_requests.is_empty()) {
+		status = STATUS_CONNECTED;
+		return;
+	}
+	// Move on to the next pipelined response.
+	head_request = pipelined_head_requests[0];
+	pipelined_head_requests.remove_at(0);
+	status = STATUS_REQUESTING;
+}
+
 bool HTTPClientTCP::has_response() const {
 	return response_headers.size() != 0;
 }
@@ -259,6 +327,7 @@ void HTTPClientTCP::close() {
 	chunk_left = 0;
 	chunk_trailer_part = false;
 	read_until_eof = false;
+	pipelined_head_requests.clear();
 	response_num = 0;
 	handshaking = false;
 }
@@ -428,34 +497,22 @@ Error HTTPClientTCP::poll() {
 				status = STATUS_CONNECTION_ERROR;
 				return ERR_CONNECTION_ERROR;
 			}
+			// Pipelined requests are sent while receiving the current response.
+			if (_send_request_data() == ERR_CONNECTION_ERROR) {
+				return ERR_CONNECTION_ERROR;
+			}
 			// Connection established, requests can now be made.
 			return OK;
 		} break;
 		case STATUS_REQUESTING: {
-			if (request_buffer->get_available_bytes()) {
-				int avail = request_buffer->get_available_bytes();
-				int pos = request_buffer->get_position();
-				const Vector<uint8_t> data = request_buffer->get_data_array();
-				int wrote = 0;
-				Error err;
-				if (blocking) {
-					err = connection->put_data(data.ptr() + pos, avail);
-					wrote += avail;
-				} else {
-					err = connection->put_partial_data(data.ptr() + pos, avail, wrote);
-				}
-				if (err != OK) {
-					close();
-					status = STATUS_CONNECTION_ERROR;
-					return ERR_CONNECTION_ERROR;
-				}
-				pos += wrote;
-				request_buffer->seek(pos);
-				if (avail - wrote > 0) {
-					return OK;
-				}
-				request_buffer->clear();
+			Error send_err = _send_request_data();
+			if (send_err == ERR_CONNECTION_ERROR) {
+				return send_err;
+			}
+			if (send_err == ERR_BUSY && pipelined_head_requests.is_empty()) {
+				return OK;
 			}
+			// With pipelining, keep reading responses, or the server could stall on a full socket while we wait to send.
 			while (true) {
 				uint8_t byte;
 				int rec = 0;
@@ -534,7 +591,7 @@ Error HTTPClientTCP::poll() {
 						read_until_eof = true;
 						status = STATUS_BODY;
 					} else {
-						status = STATUS_CONNECTED;
+						_response_done();
 					}
 					return OK;
 				}
@@ -565,11 +622,31 @@ int64_t HTTPClientTCP::get_response_body_length() const {
 PackedByteArray HTTPClientTCP::read_response_body_chunk() {
 	ERR_FAIL_COND_V(status != STATUS_BODY, PackedByteArray());
 
+	int size = read_chunk_size;
+	if (!chunked && !read_until_eof) {
+		size = MIN(body_left, read_chunk_size);
+	}
 	PackedByteArray ret;
+	ret.resize(size);
+	int read = 0;
+	_read_body(ret.ptrw(), size, read);
+	ret.resize(read);
+	return ret;
+}
+
+Error HTTPClientTCP::read_response_body(uint8_t *p_buffer, int p_size, int &r_read) {
+	r_read = 0;
+	ERR_FAIL_COND_V(status != STATUS_BODY, ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(!p_buffer || p_size <= 0, ERR_INVALID_PARAMETER);
+	return _read_body(p_buffer, p_size, r_read);
+}
+
+Error HTTPClientTCP::_read_body(uint8_t *p_buffer, int p_size, int &r_read) {
+	r_read = 0;
 	Error err = OK;
 
 	if (chunked) {
-		while (true) {
+		while (r_read < p_size && status == STATUS_BODY) {
 			if (chunk_trailer_part) {
 				// We need to consume the trailer part too or keep-alive will break.
 				uint8_t b;
@@ -586,8 +663,8 @@ PackedByteArray HTTPClientTCP::read_response_body_chunk() {
 					if (cs == 2) {
 						// Finally over.
 						chunk_trailer_part = false;
-						status = STATUS_CONNECTED;
 						chunk.clear();
+						_response_done();
 						break;
 					} else {
 						// We do not process nor return the trailer data.
@@ -636,64 +713,69 @@ PackedByteArray HTTPClientTCP::read_response_body_chunk() {
 							break;
 						}
 					}
+					chunk.clear();
+					if (status != STATUS_BODY) {
+						break;
+					}
 
 					if (len == 0) {
 						// End reached!
 						chunk_trailer_part = true;
-						chunk.clear();
-						break;
+						continue;
 					}
 
 					chunk_left = len + 2;
-					chunk.resize(chunk_left);
 				}
-			} else {
+			} else if (chunk_left > 2) {
+				// The chunk data goes straight into the caller's buffer.
 				int rec = 0;
-				err = _get_http_data(&chunk.write[chunk.size() - chunk_left], chunk_left, rec);
+				err = _get_http_data(p_buffer + r_read, MIN(chunk_left - 2, p_size - r_read), rec);
 				if (rec == 0) {
 					break;
 				}
+				r_read += rec;
 				chunk_left -= rec;
+			} else {
+				// Chunk terminator.
+				uint8_t b;
+				int rec = 0;
+				err = _get_http_data(&b, 1, rec);
+				if (rec == 0) {
+					break;
+				}
+				chunk.push_back(b);
+				chunk_left -= 1;
 
 				if (chunk_left == 0) {
-					if (chunk[chunk.size() - 2] != '\r' || chunk[chunk.size() - 1] != '\n') {
+					if (chunk[0] != '\r' || chunk[1] != '\n') {
 						ERR_PRINT("HTTP Invalid chunk terminator (not \\r\\n)");
 						status = STATUS_CONNECTION_ERROR;
 						break;
 					}
-
-					ret.resize(chunk.size() - 2);
-					uint8_t *w = ret.ptrw();
-					memcpy(w, chunk.ptr(), chunk.size() - 2);
 					chunk.clear();
 				}
+			}
 
+			if (err != OK) {
 				break;
 			}
 		}
 
 	} else {
-		int to_read = !read_until_eof ? MIN(body_left, read_chunk_size) : read_chunk_size;
-		ret.resize(to_read);
-		int _offset = 0;
+		int to_read = !read_until_eof ? MIN(body_left, p_size) : p_size;
 		while (to_read > 0) {
 			int rec = 0;
-			{
-				uint8_t *w = ret.ptrw();
-				err = _get_http_data(w + _offset, to_read, rec);
-			}
+			err = _get_http_data(p_buffer + r_read, to_read, rec);
 			if (rec <= 0) { // Ended up reading less.
-				ret.resize(_offset);
 				break;
 			} else {
-				_offset += rec;
+				r_read += rec;
 				to_read -= rec;
 				if (!read_until_eof) {
 					body_left -= rec;
 				}
 			}
 			if (err != OK) {
-				ret.resize(_offset);
 				break;
 			}
 		}
@@ -707,11 +789,11 @@ PackedByteArray HTTPClientTCP::read_response_body_chunk() {
 		} else {
 			status = STATUS_CONNECTION_ERROR;
 		}
-	} else if (body_left == 0 && !chunked && !read_until_eof) {
-		status = STATUS_CONNECTED;
+	} else if (status == STATUS_BODY && body_left == 0 && !chunked && !read_until_eof) {
+		_response_done();
 	}
 
-	return ret;
+	return err;
 }
 
 HTTPClientTCP::Status HTTPClientTCP::get_status() const {
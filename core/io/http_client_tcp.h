@@ -33,6 +33,8 @@
 
 #include "http_client.h"
 
+#include "core/templates/local_vector.h"
+
 class HTTPClientTCP : public HTTPClient {
 private:
 	Status status = STATUS_DISCONNECTED;
@@ -61,6 +63,7 @@ private:
 	int64_t body_size = -1;
 	int64_t body_left = 0;
 	bool read_until_eof = false;
+	LocalVector<bool> pipelined_head_requests; // Responses still expected after the current one.
 
 	Ref<StreamPeerBuffer> request_buffer;
 	Ref<StreamPeerTCP> tcp_connection;
@@ -73,11 +76,16 @@ private:
 	int read_chunk_size = 65536;
 
 	Error _get_http_data(uint8_t *p_buffer, int p_bytes, int &r_received);
+	Error _queue_request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size);
+	Error _send_request_data();
+	Error _read_body(uint8_t *p_buffer, int p_size, int &r_read);
+	void _response_done();
 
 public:
 	static HTTPClient *_create_func();
 
 	Error request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size) override;
+	Error pipeline_request(Method p_method, const String &p_url, const Vector<String> &p_headers, const uint8_t *p_body, int p_body_size) override;
 
 	Error connect_to_host(const String &p_host, int p_port = -1, bool p_ssl = false, bool p_verify_host = true) override;
 	void set_connection(const Ref<StreamPeer> &p_connection) override;
@@ -90,6 +98,7 @@ public:
 	Error get_response_headers(List<String> *r_response) override;
 	int64_t get_response_body_length() const override;
 	PackedByteArray read_response_body_chunk() override;
+	Error read_response_body(uint8_t *p_buffer, int p_size, int &r_read) override;
 	void set_blocking_mode(bool p_enable) override;
 	bool is_blocking_mode_enabled() const override;
 	void set_read_chunk_size(int p_size) override;
@@ -33,6 +33,7 @@
 
 #include "core/io/ip.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class NetSocket : public RefCounted {
 protected:
@@ -78,4 +79,33 @@ public:
 	virtual Error leave_multicast_group(const IPAddress &p_multi_address, String p_if_name) = 0;
 };
 
+// Waits on many sockets at once, so servers only need to service the ones with pending I/O.
+// Sockets are registered with a caller defined ID, which is what the readiness events report.
+class NetSocketPoller : public RefCounted {
+protected:
+	static NetSocketPoller *(*_create)();
+
+public:
+	static NetSocketPoller *create(); // Returns nullptr when the platform has no poller, callers should poll each socket instead.
+
+	enum EventFlags {
+		EVENT_IN = 1,
+		EVENT_OUT = 2,
+		EVENT_ERROR = 4, // Error or hang up, the socket should be polled to update its state.
+	};
+
+	struct Event {
+		uint64_t id = 0;
+		uint32_t flags = 0;
+	};
+
+	virtual Error add_socket(const Ref<NetSocket> &p_sock, uint64_t p_id, NetSocket::PollType p_type) = 0;
+	virtual Error modify_socket(uint64_t p_id, NetSocket::PollType p_type) = 0;
+	virtual void remove_socket(uint64_t p_id) = 0; // Closed sockets can still be removed by ID.
+	virtual bool has_socket(uint64_t p_id) const = 0;
+	virtual int get_socket_count() const = 0;
+	// Fills r_events with the ready sockets. Returns ERR_BUSY if none got ready before the timeout (in milliseconds, -1 to block).
+	virtual Error wait(LocalVector<Event> &r_events, int p_timeout) = 0;
+};
+
 #endif // NET_SOCKET_H
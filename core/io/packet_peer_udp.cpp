@@ -336,6 +336,10 @@ int PacketPeerUDP::get_local_port() const {
 	return local_port;
 }
 
+Ref<NetSocket> PacketPeerUDP::get_socket() const {
+	return _sock;
+}
+
 void PacketPeerUDP::set_dest_address(const IPAddress &p_address, int p_port) {
 	ERR_FAIL_COND_MSG(connected, "Destination address cannot be set for connected sockets");
 	peer_addr = p_address;
@@ -84,6 +84,7 @@ public:
 	IPAddress get_packet_address() const;
 	int get_packet_port() const;
 	int get_local_port() const;
+	Ref<NetSocket> get_socket() const; // Used to register the socket in a NetSocketPoller.
 	void set_dest_address(const IPAddress &p_address, int p_port);
 
 	Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override;
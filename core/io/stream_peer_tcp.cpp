@@ -298,6 +298,10 @@ int StreamPeerTCP::get_local_port() const {
 	return local_port;
 }
 
+Ref<NetSocket> StreamPeerTCP::get_socket() const {
+	return _sock;
+}
+
 Error StreamPeerTCP::_connect(const String &p_address, int p_port) {
 	IPAddress ip;
 	if (p_address.is_valid_ip_address()) {
@@ -69,6 +69,7 @@ public:
 	int get_connected_port() const;
 	int get_local_port() const;
 	void disconnect_from_host();
+	Ref<NetSocket> get_socket() const; // Used to register the connection in a NetSocketPoller.
 
 	int get_available_bytes() const override;
 	Status get_status() const;
@@ -117,6 +117,10 @@ Ref<StreamPeerTCP> TCPServer::take_connection() {
 	return conn;
 }
 
+Ref<NetSocket> TCPServer::get_socket() const {
+	return _sock;
+}
+
 void TCPServer::stop() {
 	if (_sock.is_valid()) {
 		_sock->close();
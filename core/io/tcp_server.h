@@ -53,6 +53,7 @@ public:
 	bool is_listening() const;
 	bool is_connection_available() const;
 	Ref<StreamPeerTCP> take_connection();
+	Ref<NetSocket> get_socket() const; // Used to register the listening socket in a NetSocketPoller.
 
 	void stop(); // Stop listening
 
@@ -0,0 +1,546 @@
+/*************************************************************************/
+/*  variant_schema.cpp                                                   */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "variant_schema.h"
+
+#include "core/io/marshalls.h"
+#include "core/variant/variant_internal.h"
+
+namespace {
+
+// Writes up to the buffer size, or only measures with no buffer.
+struct SchemaWriter {
+	uint8_t *buf = nullptr;
+	int size = 0;
+	int ofs = 0;
+	bool overflow = false;
+
+	_FORCE_INLINE_ uint8_t *reserve(int p_bytes) {
+		uint8_t *ptr = nullptr;
+		if (buf) {
+			if (ofs + p_bytes > size) {
+				overflow = true;
+			} else {
+				ptr = buf + ofs;
+			}
+		}
+		ofs += p_bytes;
+		return ptr;
+	}
+
+	_FORCE_INLINE_ void put_u8(uint8_t p_value) {
+		uint8_t *ptr = reserve(1);
+		if (ptr) {
+			*ptr = p_value;
+		}
+	}
+
+	_FORCE_INLINE_ void put_bytes(const uint8_t *p_data, int p_bytes) {
+		uint8_t *ptr = reserve(p_bytes);
+		if (ptr) {
+			memcpy(ptr, p_data, p_bytes);
+		}
+	}
+
+	_FORCE_INLINE_ void put_varuint(uint64_t p_value) {
+		while (p_value >= 0x80) {
+			put_u8(uint8_t(p_value | 0x80));
+			p_value >>= 7;
+		}
+		put_u8(uint8_t(p_value));
+	}
+
+	_FORCE_INLINE_ void put_varint(int64_t p_value) {
+		put_varuint((uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63));
+	}
+
+	_FORCE_INLINE_ void put_float(float p_value) {
+		uint8_t *ptr = reserve(4);
+		if (ptr) {
+			encode_float(p_value, ptr);
+		}
+	}
+
+	_FORCE_INLINE_ void put_double(double p_value) {
+		uint8_t *ptr = reserve(8);
+		if (ptr) {
+			encode_double(p_value, ptr);
+		}
+	}
+
+	_FORCE_INLINE_ void put_real(real_t p_value) {
+#ifdef REAL_T_IS_DOUBLE
+		put_double(p_value);
+#else
+		put_float(p_value);
+#endif
+	}
+
+	_FORCE_INLINE_ void put_vector3(const Vector3 &p_value) {
+		put_real(p_value.x);
+		put_real(p_value.y);
+		put_real(p_value.z);
+	}
+};
+
+struct SchemaReader {
+	const uint8_t *buf = nullptr;
+	int len = 0;
+	int ofs = 0;
+	bool error = false;
+
+	_FORCE_INLINE_ const uint8_t *consume(int p_bytes) {
+		if (p_bytes < 0 || ofs + p_bytes > len) {
+			error = true;
+			return nullptr;
+		}
+		const uint8_t *ptr = buf + ofs;
+		ofs += p_bytes;
+		return ptr;
+	}
+
+	_FORCE_INLINE_ uint8_t get_u8() {
+		const uint8_t *ptr = consume(1);
+		return ptr ? *ptr : 0;
+	}
+
+	_FORCE_INLINE_ uint64_t get_varuint() {
+		uint64_t value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			const uint8_t *ptr = consume(1);
+			if (!ptr) {
+				return 0;
+			}
+			value |= uint64_t(*ptr & 0x7F) << shift;
+			if (!(*ptr & 0x80)) {
+				return value;
+			}
+		}
+		error = true; // Longer than 10 bytes.
+		return 0;
+	}
+
+	_FORCE_INLINE_ int64_t get_varint() {
+		const uint64_t value = get_varuint();
+		return int64_t(value >> 1) ^ -int64_t(value & 1);
+	}
+
+	_FORCE_INLINE_ int get_length() {
+		const uint64_t value = get_varuint();
+		if (value > uint64_t(len - ofs)) {
+			error = true;
+			return 0;
+		}
+		return int(value);
+	}
+
+	_FORCE_INLINE_ float get_float() {
+		const uint8_t *ptr = consume(4);
+		return ptr ? decode_float(ptr) : 0;
+	}
+
+	_FORCE_INLINE_ double get_double() {
+		const uint8_t *ptr = consume(8);
+		return ptr ? decode_double(ptr) : 0;
+	}
+
+	_FORCE_INLINE_ real_t get_real() {
+#ifdef REAL_T_IS_DOUBLE
+		return get_double();
+#else
+		return get_float();
+#endif
+	}
+
+	_FORCE_INLINE_ void get_vector3(Vector3 &r_value) {
+		r_value.x = get_real();
+		r_value.y = get_real();
+		r_value.z = get_real();
+	}
+};
+
+} // namespace
+
+bool VariantSchema::is_type_supported(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::NIL:
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::STRING:
+		case Variant::VECTOR2:
+		case Variant::VECTOR2I:
+		case Variant::RECT2:
+		case Variant::VECTOR3:
+		case Variant::VECTOR3I:
+		case Variant::TRANSFORM2D:
+		case Variant::PLANE:
+		case Variant::QUATERNION:
+		case Variant::AABB:
+		case Variant::BASIS:
+		case Variant::TRANSFORM3D:
+		case Variant::COLOR:
+		case Variant::STRING_NAME:
+		case Variant::PACKED_BYTE_ARRAY:
+		case Variant::PACKED_INT32_ARRAY:
+		case Variant::PACKED_FLOAT32_ARRAY:
+			return true;
+		default:
+			return false;
+	}
+}
+
+Error VariantSchema::add_field(Variant::Type p_type) {
+	ERR_FAIL_COND_V_MSG(!is_type_supported(p_type), ERR_INVALID_PARAMETER, vformat("Type '%s' is not supported by VariantSchema.", Variant::get_type_name(p_type)));
+	fields.push_back(p_type);
+	hash = hash_djb2_one_32(p_type, hash);
+	return OK;
+}
+
+Variant::Type VariantSchema::get_field_type(int p_field) const {
+	ERR_FAIL_INDEX_V(p_field, (int)fields.size(), Variant::NIL);
+	return fields[p_field];
+}
+
+void VariantSchema::clear() {
+	fields.clear();
+	hash = 5381;
+}
+
+Error VariantSchema::_encode(const Variant *p_values, int p_count, uint8_t *r_buffer, int p_buffer_size, int &r_len) const {
+	ERR_FAIL_COND_V_MSG(p_count != (int)fields.size(), ERR_INVALID_PARAMETER, vformat("Expected %d values, got %d.", fields.size(), p_count));
+
+	SchemaWriter w;
+	w.buf = r_buffer;
+	w.size = p_buffer_size;
+	for (uint32_t i = 0; i < fields.size(); i++) {
+		const Variant &v = p_values[i];
+		const Variant::Type type = fields[i];
+		ERR_FAIL_COND_V_MSG(type != Variant::NIL && v.get_type() != type, ERR_INVALID_DATA, vformat("Field %d expects type '%s', got '%s'.", i, Variant::get_type_name(type), Variant::get_type_name(v.get_type())));
+
+		switch (type) {
+			case Variant::NIL: {
+				int len = 0;
+				Error err = encode_variant(v, nullptr, len);
+				ERR_FAIL_COND_V(err != OK, err);
+				w.put_varuint(len);
+				uint8_t *ptr = w.reserve(len);
+				if (ptr) {
+					encode_variant(v, ptr, len);
+				}
+			} break;
+			case Variant::BOOL: {
+				w.put_u8(*VariantInternal::get_bool(&v) ? 1 : 0);
+			} break;
+			case Variant::INT: {
+				w.put_varint(*VariantInternal::get_int(&v));
+			} break;
+			case Variant::FLOAT: {
+				w.put_double(*VariantInternal::get_float(&v));
+			} break;
+			case Variant::STRING:
+			case Variant::STRING_NAME: {
+				const CharString utf8 = type == Variant::STRING ? VariantInternal::get_string(&v)->utf8() : String(*VariantInternal::get_string_name(&v)).utf8();
+				w.put_varuint(utf8.length());
+				w.put_bytes((const uint8_t *)utf8.get_data(), utf8.length());
+			} break;
+			case Variant::VECTOR2: {
+				const Vector2 &val = *VariantInternal::get_vector2(&v);
+				w.put_real(val.x);
+				w.put_real(val.y);
+			} break;
+			case Variant::VECTOR2I: {
+				const Vector2i &val = *VariantInternal::get_vector2i(&v);
+				w.put_varint(val.x);
+				w.put_varint(val.y);
+			} break;
+			case Variant::RECT2: {
+				const Rect2 &val = *VariantInternal::get_rect2(&v);
+				w.put_real(val.position.x);
+				w.put_real(val.position.y);
+				w.put_real(val.size.x);
+				w.put_real(val.size.y);
+			} break;
+			case Variant::VECTOR3: {
+				w.put_vector3(*VariantInternal::get_vector3(&v));
+			} break;
+			case Variant::VECTOR3I: {
+				const Vector3i &val = *VariantInternal::get_vector3i(&v);
+				w.put_varint(val.x);
+				w.put_varint(val.y);
+				w.put_varint(val.z);
+			} break;
+			case Variant::TRANSFORM2D: {
+				const Transform2D &val = *VariantInternal::get_transform2d(&v);
+				for (int j = 0; j < 3; j++) {
+					w.put_real(val.columns[j].x);
+					w.put_real(val.columns[j].y);
+				}
+			} break;
+			case Variant::PLANE: {
+				const Plane &val = *VariantInternal::get_plane(&v);
+				w.put_vector3(val.normal);
+				w.put_real(val.d);
+			} break;
+			case Variant::QUATERNION: {
+				const Quaternion &val = *VariantInternal::get_quaternion(&v);
+				w.put_real(val.x);
+				w.put_real(val.y);
+				w.put_real(val.z);
+				w.put_real(val.w);
+			} break;
+			case Variant::AABB: {
+				const ::AABB &val = *VariantInternal::get_aabb(&v);
+				w.put_vector3(val.position);
+				w.put_vector3(val.size);
+			} break;
+			case Variant::BASIS: {
+				const Basis &val = *VariantInternal::get_basis(&v);
+				for (int j = 0; j < 3; j++) {
+					w.put_vector3(val.rows[j]);
+				}
+			} break;
+			case Variant::TRANSFORM3D: {
+				const Transform3D &val = *VariantInternal::get_transform(&v);
+				for (int j = 0; j < 3; j++) {
+					w.put_vector3(val.basis.rows[j]);
+				}
+				w.put_vector3(val.origin);
+			} break;
+			case Variant::COLOR: {
+				const Color &val = *VariantInternal::get_color(&v);
+				w.put_float(val.r);
+				w.put_float(val.g);
+				w.put_float(val.b);
+				w.put_float(val.a);
+			} break;
+			case Variant::PACKED_BYTE_ARRAY: {
+				const PackedByteArray &val = *VariantInternal::get_byte_array(&v);
+				w.put_varuint(val.size());
+				w.put_bytes(val.ptr(), val.size());
+			} break;
+			case Variant::PACKED_INT32_ARRAY: {
+				const PackedInt32Array &val = *VariantInternal::get_int32_array(&v);
+				const int32_t *r = val.ptr();
+				w.put_varuint(val.size());
+				for (int j = 0; j < val.size(); j++) {
+					w.put_varint(r[j]);
+				}
+			} break;
+			case Variant::PACKED_FLOAT32_ARRAY: {
+				const PackedFloat32Array &val = *VariantInternal::get_float32_array(&v);
+				const float *r = val.ptr();
+				w.put_varuint(val.size());
+				for (int j = 0; j < val.size(); j++) {
+					w.put_float(r[j]);
+				}
+			} break;
+			default: {
+				ERR_FAIL_V(ERR_BUG);
+			}
+		}
+	}
+	r_len = w.ofs;
+	return w.overflow ? ERR_OUT_OF_MEMORY : OK;
+}
+
+int VariantSchema::get_encoded_size(const Variant *p_values, int p_count) const {
+	int len = 0;
+	Error err = _encode(p_values, p_count, nullptr, 0, len);
+	ERR_FAIL_COND_V(err != OK, -1);
+	return len;
+}
+
+Error VariantSchema::encode(const Variant *p_values, int p_count, uint8_t *r_buffer, int p_buffer_size, int &r_len) const {
+	ERR_FAIL_COND_V(!r_buffer, ERR_INVALID_PARAMETER);
+	return _encode(p_values, p_count, r_buffer, p_buffer_size, r_len);
+}
+
+Error VariantSchema::decode(const uint8_t *p_buffer, int p_len, Variant *r_values, int p_count, int *r_len) const {
+	ERR_FAIL_COND_V_MSG(p_count != (int)fields.size(), ERR_INVALID_PARAMETER, vformat("Expected %d values, got %d.", fields.size(), p_count));
+
+	SchemaReader r;
+	r.buf = p_buffer;
+	r.len = p_len;
+	for (uint32_t i = 0; i < fields.size() && !r.error; i++) {
+		Variant &v = r_values[i];
+		const Variant::Type type = fields[i];
+		// Reuse the existing storage when the type matches.
+		if (type != Variant::NIL && v.get_type() != type) {
+			VariantInternal::initialize(&v, type);
+		}
+
+		switch (type) {
+			case Variant::NIL: {
+				const int len = r.get_length();
+				const uint8_t *ptr = r.consume(len);
+				if (ptr) {
+					Error err = decode_variant(v, ptr, len);
+					ERR_FAIL_COND_V(err != OK, err);
+				}
+			} break;
+			case Variant::BOOL: {
+				*VariantInternal::get_bool(&v) = r.get_u8() != 0;
+			} break;
+			case Variant::INT: {
+				*VariantInternal::get_int(&v) = r.get_varint();
+			} break;
+			case Variant::FLOAT: {
+				*VariantInternal::get_float(&v) = r.get_double();
+			} break;
+			case Variant::STRING:
+			case Variant::STRING_NAME: {
+				const int len = r.get_length();
+				const uint8_t *ptr = r.consume(len);
+				if (!ptr) {
+					break;
+				}
+				if (type == Variant::STRING) {
+					VariantInternal::get_string(&v)->parse_utf8((const char *)ptr, len);
+				} else {
+					String str;
+					str.parse_utf8((const char *)ptr, len);
+					*VariantInternal::get_string_name(&v) = str;
+				}
+			} break;
+			case Variant::VECTOR2: {
+				Vector2 &val = *VariantInternal::get_vector2(&v);
+				val.x = r.get_real();
+				val.y = r.get_real();
+			} break;
+			case Variant::VECTOR2I: {
+				Vector2i &val = *VariantInternal::get_vector2i(&v);
+				val.x = int32_t(r.get_varint());
+				val.y = int32_t(r.get_varint());
+			} break;
+			case Variant::RECT2: {
+				Rect2 &val = *VariantInternal::get_rect2(&v);
+				val.position.x = r.get_real();
+				val.position.y = r.get_real();
+				val.size.x = r.get_real();
+				val.size.y = r.get_real();
+			} break;
+			case Variant::VECTOR3: {
+				r.get_vector3(*VariantInternal::get_vector3(&v));
+			} break;
+			case Variant::VECTOR3I: {
+				Vector3i &val = *VariantInternal::get_vector3i(&v);
+				val.x = int32_t(r.get_varint());
+				val.y = int32_t(r.get_varint());
+				val.z = int32_t(r.get_varint());
+			} break;
+			case Variant::TRANSFORM2D: {
+				Transform2D &val = *VariantInternal::get_transform2d(&v);
+				for (int j = 0; j < 3; j++) {
+					val.columns[j].x = r.get_real();
+					val.columns[j].y = r.get_real();
+				}
+			} break;
+			case Variant::PLANE: {
+				Plane &val = *VariantInternal::get_plane(&v);
+				r.get_vector3(val.normal);
+				val.d = r.get_real();
+			} break;
+			case Variant::QUATERNION: {
+				Quaternion &val = *VariantInternal::get_quaternion(&v);
+				val.x = r.get_real();
+				val.y = r.get_real();
+				val.z = r.get_real();
+				val.w = r.get_real();
+			} break;
+			case Variant::AABB: {
+				::AABB &val = *VariantInternal::get_aabb(&v);
+				r.get_vector3(val.position);
+				r.get_vector3(val.size);
+			} break;
+			case Variant::BASIS: {
+				Basis &val = *VariantInternal::get_basis(&v);
+				for (int j = 0; j < 3; j++) {
+					r.get_vector3(val.rows[j]);
+				}
+			} break;
+			case Variant::TRANSFORM3D: {
+				Transform3D &val = *VariantInternal::get_transform(&v);
+				for (int j = 0; j < 3; j++) {
+					r.get_vector3(val.basis.rows[j]);
+				}
+				r.get_vector3(val.origin);
+			} break;
+			case Variant::COLOR: {
+				Color &val = *VariantInternal::get_color(&v);
+				val.r = r.get_float();
+				val.g = r.get_float();
+				val.b = r.get_float();
+				val.a = r.get_float();
+			} break;
+			// Packed arrays can be shared with other Variants, so they get a new array instead of being written in place.
+			case Variant::PACKED_BYTE_ARRAY: {
+				const int len = r.get_length();
+				const uint8_t *ptr = r.consume(len);
+				if (!ptr) {
+					break;
+				}
+				PackedByteArray arr;
+				arr.resize(len);
+				memcpy(arr.ptrw(), ptr, len);
+				v = arr;
+			} break;
+			case Variant::PACKED_INT32_ARRAY: {
+				const int len = r.get_length(); // At least one byte per element.
+				PackedInt32Array arr;
+				arr.resize(len);
+				int32_t *w = arr.ptrw();
+				for (int j = 0; j < len; j++) {
+					w[j] = int32_t(r.get_varint());
+				}
+				v = arr;
+			} break;
+			case Variant::PACKED_FLOAT32_ARRAY: {
+				const int len = r.get_length();
+				ERR_FAIL_COND_V(len > (p_len - r.ofs) / 4, ERR_INVALID_DATA);
+				PackedFloat32Array arr;
+				arr.resize(len);
+				float *w = arr.ptrw();
+				for (int j = 0; j < len; j++) {
+					w[j] = r.get_float();
+				}
+				v = arr;
+			} break;
+			default: {
+				ERR_FAIL_V(ERR_BUG);
+			}
+		}
+	}
+	ERR_FAIL_COND_V_MSG(r.error, ERR_INVALID_DATA, "Malformed schema encoded data.");
+	if (r_len) {
+		*r_len = r.ofs;
+	}
+	return OK;
+}
@@ -0,0 +1,64 @@
+/*************************************************************************/
+/*  variant_schema.h                                                     */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef VARIANT_SCHEMA_H
+#define VARIANT_SCHEMA_H
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Compact encoder for values of a known layout, like RPC arguments or replicated properties.
+// Unlike encode_variant, fields carry no type header, integers are varints (zigzag encoded),
+// vectors and transforms are stored as real_t, and decoding writes into existing Variants
+// in place, only allocating for strings and packed arrays.
+// NIL fields accept any value, encoded with encode_variant behind a length prefix.
+class VariantSchema {
+	LocalVector<Variant::Type> fields;
+	uint32_t hash = 5381;
+
+	Error _encode(const Variant *p_values, int p_count, uint8_t *r_buffer, int p_buffer_size, int &r_len) const;
+
+public:
+	static bool is_type_supported(Variant::Type p_type);
+
+	Error add_field(Variant::Type p_type);
+	int get_field_count() const { return fields.size(); }
+	Variant::Type get_field_type(int p_field) const;
+	// Identifies the layout, so peers can check they agree on it.
+	uint32_t get_hash() const { return hash; }
+	void clear();
+
+	int get_encoded_size(const Variant *p_values, int p_count) const;
+	// Single pass, fails with ERR_OUT_OF_MEMORY if the buffer is too small.
+	Error encode(const Variant *p_values, int p_count, uint8_t *r_buffer, int p_buffer_size, int &r_len) const;
+	Error decode(const uint8_t *p_buffer, int p_len, Variant *r_values, int p_count, int *r_len = nullptr) const;
+};
+
+#endif // VARIANT_SCHEMA_H
@@ -533,6 +533,24 @@ Error MultiplayerAPI::replication_stop(Object *p_object, Variant p_config) {
 	return replicator->on_replication_stop(p_object, p_config);
 }
 
+void MultiplayerAPI::set_peer_interest_origin(int p_peer_id, const Vector3 &p_origin) {
+	replicator->set_peer_interest_origin(p_peer_id, p_origin);
+}
+
+void MultiplayerAPI::clear_peer_interest_origin(int p_peer_id) {
+	replicator->clear_peer_interest_origin(p_peer_id);
+}
+
+void MultiplayerAPI::set_replication_bandwidth_limit(int p_bytes_per_second) {
+	ERR_FAIL_COND_MSG(p_bytes_per_second < 0, "The bandwidth limit must be greater or equal to 0 (where 0 means unlimited).");
+	replication_bandwidth_limit = p_bytes_per_second;
+	replicator->set_bandwidth_limit(p_bytes_per_second);
+}
+
+int MultiplayerAPI::get_replication_bandwidth_limit() const {
+	return replication_bandwidth_limit;
+}
+
 void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_root_path", "path"), &MultiplayerAPI::set_root_path);
 	ClassDB::bind_method(D_METHOD("get_root_path"), &MultiplayerAPI::get_root_path);
@@ -551,9 +569,14 @@ void MultiplayerAPI::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_refusing_new_connections"), &MultiplayerAPI::is_refusing_new_connections);
 	ClassDB::bind_method(D_METHOD("set_allow_object_decoding", "enable"), &MultiplayerAPI::set_allow_object_decoding);
 	ClassDB::bind_method(D_METHOD("is_object_decoding_allowed"), &MultiplayerAPI::is_object_decoding_allowed);
+	ClassDB::bind_method(D_METHOD("set_peer_interest_origin", "peer_id", "origin"), &MultiplayerAPI::set_peer_interest_origin);
+	ClassDB::bind_method(D_METHOD("clear_peer_interest_origin", "peer_id"), &MultiplayerAPI::clear_peer_interest_origin);
+	ClassDB::bind_method(D_METHOD("set_replication_bandwidth_limit", "bytes_per_second"), &MultiplayerAPI::set_replication_bandwidth_limit);
+	ClassDB::bind_method(D_METHOD("get_replication_bandwidth_limit"), &MultiplayerAPI::get_replication_bandwidth_limit);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "allow_object_decoding"), "set_allow_object_decoding", "is_object_decoding_allowed");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "refuse_new_connections"), "set_refuse_new_connections", "is_refusing_new_connections");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "replication_bandwidth_limit", PROPERTY_HINT_RANGE, "0,1000000,1,or_greater"), "set_replication_bandwidth_limit", "get_replication_bandwidth_limit");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "multiplayer_peer", PROPERTY_HINT_RESOURCE_TYPE, "MultiplayerPeer", PROPERTY_USAGE_NONE), "set_multiplayer_peer", "get_multiplayer_peer");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_path"), "set_root_path", "get_root_path");
 	ADD_PROPERTY_DEFAULT("refuse_new_connections", false);
@@ -51,6 +51,9 @@ public:
 	virtual Error on_replication_start(Object *p_obj, Variant p_config) { return ERR_UNAVAILABLE; }
 	virtual Error on_replication_stop(Object *p_obj, Variant p_config) { return ERR_UNAVAILABLE; }
 	virtual void on_network_process() {}
+	virtual void set_peer_interest_origin(int p_peer, const Vector3 &p_origin) {}
+	virtual void clear_peer_interest_origin(int p_peer) {}
+	virtual void set_bandwidth_limit(int p_bytes_per_second) {}
 
 	MultiplayerReplicationInterface() {}
 };
@@ -121,6 +124,7 @@ private:
 
 	NodePath root_path;
 	bool allow_object_decoding = false;
+	int replication_bandwidth_limit = 0;
 
 	Ref<MultiplayerCacheInterface> cache;
 	Ref<MultiplayerReplicationInterface> replicator;
@@ -159,6 +163,10 @@ public:
 	Error despawn(Object *p_object, Variant p_config);
 	Error replication_start(Object *p_object, Variant p_config);
 	Error replication_stop(Object *p_object, Variant p_config);
+	void set_peer_interest_origin(int p_peer_id, const Vector3 &p_origin);
+	void clear_peer_interest_origin(int p_peer_id);
+	void set_replication_bandwidth_limit(int p_bytes_per_second);
+	int get_replication_bandwidth_limit() const;
 	// Cache API
 	bool send_object_cache(Object *p_obj, NodePath p_path, int p_target, int &p_id);
 	Object *get_cached_object(int p_from, uint32_t p_cache_id);
@@ -0,0 +1,523 @@
+/*************************************************************************/
+/*  simulated_multiplayer_peer.cpp                                       */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "simulated_multiplayer_peer.h"
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+
+static const uint8_t RECORDING_MAGIC[4] = { 'G', 'D', 'M', 'R' };
+static const int RECORDING_HEADER_SIZE = 12; // Magic, version and unique ID.
+static const int RECORDING_EVENT_SIZE = 19; // Type, channel, mode, sender, time and size.
+
+uint64_t SimulatedMultiplayerPeer::Network::get_time() const {
+	if (manual_time) {
+		return time_usec;
+	}
+	return OS::get_singleton()->get_ticks_usec() - time_usec;
+}
+
+void SimulatedMultiplayerPeer::_join(const Ref<Network> &p_network, int p_id) {
+	network = p_network;
+	unique_id = p_id;
+	active = true;
+	rng.seed(seed);
+	link_free_usec = 0;
+
+	// Both ends of each link learn about the other after their latency.
+	const int *k = nullptr;
+	while ((k = network->peers.next(k))) {
+		SimulatedMultiplayerPeer *peer = network->peers[*k];
+		_queue_event(peer, EVENT_CONNECT, nullptr, 0);
+		peer->_queue_event(this, EVENT_CONNECT, nullptr, 0);
+	}
+	network->peers[p_id] = this;
+}
+
+void SimulatedMultiplayerPeer::_queue_event(SimulatedMultiplayerPeer *p_target, EventType p_type, const uint8_t *p_buffer, int p_buffer_size) {
+	const uint64_t now = network->get_time();
+	const uint64_t latency_usec = uint64_t(Math::round(latency * 1000000.0));
+	const int target_id = p_target->unique_id;
+
+	Event event;
+	event.type = p_type;
+	event.from = unique_id;
+	event.channel = get_transfer_channel();
+	event.mode = get_transfer_mode();
+	event.seq = network->next_seq++;
+
+	if (p_type != EVENT_PACKET) {
+		// Nothing sent afterwards arrives before the connection change.
+		const uint64_t *min_usec = link_min_usec.getptr(target_id);
+		event.usec = MAX(now + latency_usec, min_usec ? *min_usec : 0);
+		link_min_usec[target_id] = event.usec;
+		p_target->in_flight.push_back(event);
+		return;
+	}
+
+	packets_sent++;
+	bytes_sent += p_buffer_size;
+
+	// Packets leave one after the other at the bandwidth limit.
+	uint64_t usec = MAX(now, link_free_usec);
+	if (bandwidth_limit > 0) {
+		usec += uint64_t(p_buffer_size) * 1000000 / bandwidth_limit;
+	}
+	link_free_usec = usec;
+	usec += latency_usec;
+	if (jitter > 0) {
+		usec += uint64_t(rng.randf() * jitter * 1000000.0);
+	}
+
+	if (event.mode != Multiplayer::TRANSFER_MODE_RELIABLE) {
+		if (packet_loss > 0 && rng.randf() < packet_loss) {
+			packets_lost++;
+			return;
+		}
+	} else {
+		// Lost reliable packets are resent, and hold back the ones after them on the channel.
+		for (int i = 0; i < MAX_RETRANSMISSIONS && packet_loss > 0 && rng.randf() < packet_loss; i++) {
+			usec += 2 * latency_usec;
+		}
+		const uint64_t key = (uint64_t(target_id) << 8) | uint64_t(event.channel);
+		const uint64_t *last_usec = ordered_usec.getptr(key);
+		if (last_usec) {
+			usec = MAX(usec, *last_usec);
+		}
+		ordered_usec[key] = usec;
+	}
+	const uint64_t *min_usec = link_min_usec.getptr(target_id);
+	event.usec = MAX(usec, min_usec ? *min_usec : 0);
+	event.data.resize(p_buffer_size);
+	memcpy(event.data.ptrw(), p_buffer, p_buffer_size);
+	p_target->in_flight.push_back(event);
+}
+
+void SimulatedMultiplayerPeer::_deliver(const Event &p_event) {
+	switch (p_event.type) {
+		case EVENT_CONNECT: {
+			connected_peers[p_event.from] = true;
+			_record(p_event);
+			emit_signal(SNAME("peer_connected"), p_event.from);
+			if (p_event.from == TARGET_PEER_SERVER && !is_server()) {
+				connection_status = CONNECTION_CONNECTED;
+				emit_signal(SNAME("connection_succeeded"));
+			}
+		} break;
+		case EVENT_DISCONNECT: {
+			if (!connected_peers.erase(p_event.from)) {
+				return;
+			}
+			_record(p_event);
+			if (p_event.from == TARGET_PEER_SERVER && !is_server()) {
+				close();
+				emit_signal(SNAME("server_disconnected"));
+				return;
+			}
+			emit_signal(SNAME("peer_disconnected"), p_event.from);
+		} break;
+		case EVENT_PACKET: {
+			if (!connected_peers.has(p_event.from)) {
+				return; // Sent before the sender disconnected.
+			}
+			if (p_event.mode == Multiplayer::TRANSFER_MODE_UNRELIABLE_ORDERED) {
+				const uint64_t key = (uint64_t(p_event.from) << 8) | uint64_t(p_event.channel);
+				const uint64_t *last_seq = last_ordered_seq.getptr(key);
+				if (last_seq && *last_seq > p_event.seq) {
+					return; // Older than a packet already delivered.
+				}
+				last_ordered_seq[key] = p_event.seq;
+			}
+			packets_received++;
+			bytes_received += p_event.data.size();
+			_record(p_event);
+			incoming.push_back(p_event);
+		} break;
+	}
+}
+
+void SimulatedMultiplayerPeer::_record(const Event &p_event) {
+	if (!recording) {
+		return;
+	}
+	const int ofs = recording_data.size();
+	recording_data.resize(ofs + RECORDING_EVENT_SIZE + p_event.data.size());
+	uint8_t *w = recording_data.ptrw() + ofs;
+	w[0] = p_event.type;
+	w[1] = p_event.channel;
+	w[2] = p_event.mode;
+	encode_uint32(p_event.from, &w[3]);
+	encode_uint64(p_event.usec > recording_start ? p_event.usec - recording_start : 0, &w[7]);
+	encode_uint32(p_event.data.size(), &w[15]);
+	if (p_event.data.size()) {
+		memcpy(&w[RECORDING_EVENT_SIZE], p_event.data.ptr(), p_event.data.size());
+	}
+}
+
+void SimulatedMultiplayerPeer::set_target_peer(int p_peer_id) {
+	target_peer = p_peer_id;
+}
+
+int SimulatedMultiplayerPeer::get_packet_peer() const {
+	ERR_FAIL_COND_V_MSG(!active, 1, "The multiplayer instance isn't currently active.");
+	ERR_FAIL_COND_V(incoming.is_empty(), 1);
+	return incoming.front()->get().from;
+}
+
+bool SimulatedMultiplayerPeer::is_server() const {
+	return active && unique_id == TARGET_PEER_SERVER;
+}
+
+void SimulatedMultiplayerPeer::poll() {
+	if (!active) {
+		return;
+	}
+	const uint64_t now = network->get_time();
+	LocalVector<Event> arrived;
+	for (uint32_t i = 0; i < in_flight.size();) {
+		if (in_flight[i].usec <= now) {
+			arrived.push_back(in_flight[i]);
+			in_flight.remove_at_unordered(i);
+		} else {
+			i++;
+		}
+	}
+	arrived.sort_custom<EventSort>();
+	for (uint32_t i = 0; i < arrived.size() && active; i++) {
+		_deliver(arrived[i]);
+	}
+}
+
+int SimulatedMultiplayerPeer::get_unique_id() const {
+	ERR_FAIL_COND_V_MSG(!active, 0, "The multiplayer instance isn't currently active.");
+	return unique_id;
+}
+
+MultiplayerPeer::ConnectionStatus SimulatedMultiplayerPeer::get_connection_status() const {
+	return connection_status;
+}
+
+int SimulatedMultiplayerPeer::get_available_packet_count() const {
+	return incoming.size();
+}
+
+Error SimulatedMultiplayerPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
+	ERR_FAIL_COND_V_MSG(incoming.is_empty(), ERR_UNAVAILABLE, "No incoming packets available.");
+	current_packet = incoming.front()->get().data;
+	incoming.pop_front();
+	*r_buffer = current_packet.ptr();
+	r_buffer_size = current_packet.size();
+	return OK;
+}
+
+Error SimulatedMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+	ERR_FAIL_COND_V_MSG(!active, ERR_UNCONFIGURED, "The multiplayer instance isn't currently active.");
+	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_CONNECTED, ERR_UNCONFIGURED, "The multiplayer instance isn't currently connected to any server or client.");
+	ERR_FAIL_COND_V(p_buffer_size > get_max_packet_size(), ERR_OUT_OF_MEMORY);
+	ERR_FAIL_COND_V_MSG(target_peer > 0 && !replay && !connected_peers.has(target_peer), ERR_INVALID_PARAMETER, vformat("Invalid target peer: %d", target_peer));
+
+	if (replay) {
+		// Nobody listens to a replay, only the statistics are kept.
+		packets_sent++;
+		bytes_sent += p_buffer_size;
+		return OK;
+	}
+	const int *k = nullptr;
+	while ((k = connected_peers.next(k))) {
+		if ((target_peer > 0 && target_peer != *k) || (target_peer < 0 && -target_peer == *k)) {
+			continue;
+		}
+		SimulatedMultiplayerPeer **peer = network->peers.getptr(*k);
+		if (peer) {
+			_queue_event(*peer, EVENT_PACKET, p_buffer, p_buffer_size);
+		}
+	}
+	return OK;
+}
+
+int SimulatedMultiplayerPeer::get_max_packet_size() const {
+	return 1 << 24;
+}
+
+Error SimulatedMultiplayerPeer::create_server(bool p_manual_time) {
+	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+	Ref<Network> new_network;
+	new_network.instantiate();
+	new_network->manual_time = p_manual_time;
+	new_network->time_usec = p_manual_time ? 0 : OS::get_singleton()->get_ticks_usec();
+	_join(new_network, TARGET_PEER_SERVER);
+	connection_status = CONNECTION_CONNECTED;
+	return OK;
+}
+
+Error SimulatedMultiplayerPeer::create_client(const Ref<SimulatedMultiplayerPeer> &p_server) {
+	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+	ERR_FAIL_COND_V_MSG(p_server.is_null() || !p_server->is_server() || p_server->replay, ERR_INVALID_PARAMETER, "The given peer isn't an active server.");
+	if (p_server->is_refusing_new_connections()) {
+		return ERR_CANT_CONNECT;
+	}
+	Ref<Network> server_network = p_server->network;
+	_join(server_network, server_network->next_id++);
+	connection_status = CONNECTION_CONNECTING;
+	return OK;
+}
+
+Error SimulatedMultiplayerPeer::create_replay(const Vector<uint8_t> &p_recording, bool p_manual_time) {
+	ERR_FAIL_COND_V_MSG(active, ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+	const uint8_t *r = p_recording.ptr();
+	const int size = p_recording.size();
+	ERR_FAIL_COND_V_MSG(size < RECORDING_HEADER_SIZE || memcmp(r, RECORDING_MAGIC, 4) != 0 || decode_uint32(&r[4]) != RECORDING_VERSION, ERR_INVALID_DATA, "Invalid multiplayer recording.");
+	const int id = decode_uint32(&r[8]);
+	ERR_FAIL_COND_V_MSG(id < 1, ERR_INVALID_DATA, "Invalid multiplayer recording.");
+
+	LocalVector<Event> events;
+	int ofs = RECORDING_HEADER_SIZE;
+	while (ofs < size) {
+		ERR_FAIL_COND_V_MSG(ofs + RECORDING_EVENT_SIZE > size, ERR_INVALID_DATA, "Truncated multiplayer recording.");
+		Event event;
+		ERR_FAIL_COND_V_MSG(r[ofs] > EVENT_DISCONNECT || r[ofs + 2] > Multiplayer::TRANSFER_MODE_RELIABLE, ERR_INVALID_DATA, "Invalid multiplayer recording.");
+		event.type = EventType(r[ofs]);
+		event.channel = r[ofs + 1];
+		event.mode = Multiplayer::TransferMode(r[ofs + 2]);
+		event.from = decode_uint32(&r[ofs + 3]);
+		event.usec = decode_uint64(&r[ofs + 7]);
+		event.seq = events.size();
+		const uint32_t data_size = decode_uint32(&r[ofs + 15]);
+		ofs += RECORDING_EVENT_SIZE;
+		ERR_FAIL_COND_V_MSG(data_size > uint32_t(size - ofs), ERR_INVALID_DATA, "Truncated multiplayer recording.");
+		event.data.resize(data_size);
+		if (data_size) {
+			memcpy(event.data.ptrw(), &r[ofs], data_size);
+		}
+		ofs += data_size;
+		events.push_back(event);
+	}
+
+	// A network of its own, where the recorded events arrive at the recorded times.
+	Ref<Network> new_network;
+	new_network.instantiate();
+	new_network->manual_time = p_manual_time;
+	new_network->time_usec = p_manual_time ? 0 : OS::get_singleton()->get_ticks_usec();
+	_join(new_network, id);
+	replay = true;
+	connection_status = is_server() ? CONNECTION_CONNECTED : CONNECTION_CONNECTING;
+	for (uint32_t i = 0; i < events.size(); i++) {
+		in_flight.push_back(events[i]);
+	}
+	return OK;
+}
+
+void SimulatedMultiplayerPeer::close() {
+	if (!active) {
+		return;
+	}
+	// The other peers see the disconnection after the latency.
+	network->peers.erase(unique_id);
+	const int *k = nullptr;
+	while ((k = network->peers.next(k))) {
+		_queue_event(network->peers[*k], EVENT_DISCONNECT, nullptr, 0);
+	}
+
+	network.unref();
+	active = false;
+	replay = false;
+	unique_id = 0;
+	connection_status = CONNECTION_DISCONNECTED;
+	recording = false;
+	in_flight.clear();
+	incoming.clear();
+	connected_peers.clear();
+	last_ordered_seq.clear();
+	ordered_usec.clear();
+	link_min_usec.clear();
+	current_packet.clear();
+}
+
+void SimulatedMultiplayerPeer::advance_time(double p_seconds) {
+	ERR_FAIL_COND_MSG(!active || !network->manual_time, "Only the networks created with manual time can be advanced.");
+	ERR_FAIL_COND(p_seconds < 0);
+	network->time_usec += uint64_t(Math::round(p_seconds * 1000000.0));
+}
+
+double SimulatedMultiplayerPeer::get_network_time() const {
+	if (!active) {
+		return 0;
+	}
+	return network->get_time() / 1000000.0;
+}
+
+bool SimulatedMultiplayerPeer::is_replay_finished() const {
+	return replay && in_flight.is_empty();
+}
+
+void SimulatedMultiplayerPeer::set_latency(double p_seconds) {
+	ERR_FAIL_COND(p_seconds < 0);
+	latency = p_seconds;
+}
+
+double SimulatedMultiplayerPeer::get_latency() const {
+	return latency;
+}
+
+void SimulatedMultiplayerPeer::set_jitter(double p_seconds) {
+	ERR_FAIL_COND(p_seconds < 0);
+	jitter = p_seconds;
+}
+
+double SimulatedMultiplayerPeer::get_jitter() const {
+	return jitter;
+}
+
+void SimulatedMultiplayerPeer::set_packet_loss(double p_ratio) {
+	ERR_FAIL_COND(p_ratio < 0 || p_ratio > 1);
+	packet_loss = p_ratio;
+}
+
+double SimulatedMultiplayerPeer::get_packet_loss() const {
+	return packet_loss;
+}
+
+void SimulatedMultiplayerPeer::set_bandwidth_limit(int p_bytes_per_second) {
+	ERR_FAIL_COND(p_bytes_per_second < 0);
+	bandwidth_limit = p_bytes_per_second;
+}
+
+int SimulatedMultiplayerPeer::get_bandwidth_limit() const {
+	return bandwidth_limit;
+}
+
+void SimulatedMultiplayerPeer::set_seed(uint64_t p_seed) {
+	seed = p_seed;
+	rng.seed(p_seed);
+}
+
+uint64_t SimulatedMultiplayerPeer::get_seed() const {
+	return seed;
+}
+
+void SimulatedMultiplayerPeer::start_recording() {
+	ERR_FAIL_COND_MSG(!active, "The multiplayer instance isn't currently active.");
+	recording = true;
+	recording_id = unique_id;
+	recording_start = network->get_time();
+	recording_data.clear();
+
+	// The peers already connected are known from the start of the replay.
+	const int *k = nullptr;
+	while ((k = connected_peers.next(k))) {
+		Event event;
+		event.type = EVENT_CONNECT;
+		event.from = *k;
+		event.usec = recording_start;
+		_record(event);
+	}
+}
+
+void SimulatedMultiplayerPeer::stop_recording() {
+	recording = false;
+}
+
+bool SimulatedMultiplayerPeer::is_recording() const {
+	return recording;
+}
+
+Vector<uint8_t> SimulatedMultiplayerPeer::get_recording() const {
+	Vector<uint8_t> out;
+	out.resize(RECORDING_HEADER_SIZE + recording_data.size());
+	uint8_t *w = out.ptrw();
+	memcpy(w, RECORDING_MAGIC, 4);
+	encode_uint32(RECORDING_VERSION, &w[4]);
+	encode_uint32(recording_id, &w[8]);
+	if (recording_data.size()) {
+		memcpy(&w[RECORDING_HEADER_SIZE], recording_data.ptr(), recording_data.size());
+	}
+	return out;
+}
+
+Dictionary SimulatedMultiplayerPeer::get_statistics() const {
+	Dictionary stats;
+	stats["packets_sent"] = packets_sent;
+	stats["bytes_sent"] = bytes_sent;
+	stats["packets_received"] = packets_received;
+	stats["bytes_received"] = bytes_received;
+	stats["packets_lost"] = packets_lost;
+	return stats;
+}
+
+void SimulatedMultiplayerPeer::reset_statistics() {
+	packets_sent = 0;
+	bytes_sent = 0;
+	packets_received = 0;
+	bytes_received = 0;
+	packets_lost = 0;
+}
+
+void SimulatedMultiplayerPeer::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("create_server", "manual_time"), &SimulatedMultiplayerPeer::create_server, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("create_client", "server"), &SimulatedMultiplayerPeer::create_client);
+	ClassDB::bind_method(D_METHOD("create_replay", "recording", "manual_time"), &SimulatedMultiplayerPeer::create_replay, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("close"), &SimulatedMultiplayerPeer::close);
+
+	ClassDB::bind_method(D_METHOD("advance_time", "seconds"), &SimulatedMultiplayerPeer::advance_time);
+	ClassDB::bind_method(D_METHOD("get_network_time"), &SimulatedMultiplayerPeer::get_network_time);
+	ClassDB::bind_method(D_METHOD("is_replay_finished"), &SimulatedMultiplayerPeer::is_replay_finished);
+
+	ClassDB::bind_method(D_METHOD("set_latency", "seconds"), &SimulatedMultiplayerPeer::set_latency);
+	ClassDB::bind_method(D_METHOD("get_latency"), &SimulatedMultiplayerPeer::get_latency);
+	ClassDB::bind_method(D_METHOD("set_jitter", "seconds"), &SimulatedMultiplayerPeer::set_jitter);
+	ClassDB::bind_method(D_METHOD("get_jitter"), &SimulatedMultiplayerPeer::get_jitter);
+	ClassDB::bind_method(D_METHOD("set_packet_loss", "ratio"), &SimulatedMultiplayerPeer::set_packet_loss);
+	ClassDB::bind_method(D_METHOD("get_packet_loss"), &SimulatedMultiplayerPeer::get_packet_loss);
+	ClassDB::bind_method(D_METHOD("set_bandwidth_limit", "bytes_per_second"), &SimulatedMultiplayerPeer::set_bandwidth_limit);
+	ClassDB::bind_method(D_METHOD("get_bandwidth_limit"), &SimulatedMultiplayerPeer::get_bandwidth_limit);
+	ClassDB::bind_method(D_METHOD("set_seed", "seed"), &SimulatedMultiplayerPeer::set_seed);
+	ClassDB::bind_method(D_METHOD("get_seed"), &SimulatedMultiplayerPeer::get_seed);
+
+	ClassDB::bind_method(D_METHOD("start_recording"), &SimulatedMultiplayerPeer::start_recording);
+	ClassDB::bind_method(D_METHOD("stop_recording"), &SimulatedMultiplayerPeer::stop_recording);
+	ClassDB::bind_method(D_METHOD("is_recording"), &SimulatedMultiplayerPeer::is_recording);
+	ClassDB::bind_method(D_METHOD("get_recording"), &SimulatedMultiplayerPeer::get_recording);
+
+	ClassDB::bind_method(D_METHOD("get_statistics"), &SimulatedMultiplayerPeer::get_statistics);
+	ClassDB::bind_method(D_METHOD("reset_statistics"), &SimulatedMultiplayerPeer::reset_statistics);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "latency", PROPERTY_HINT_RANGE, "0,10,0.001,or_greater"), "set_latency", "get_latency");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "jitter", PROPERTY_HINT_RANGE, "0,10,0.001,or_greater"), "set_jitter", "get_jitter");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "packet_loss", PROPERTY_HINT_RANGE, "0,1,0.001"), "set_packet_loss", "get_packet_loss");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "bandwidth_limit", PROPERTY_HINT_RANGE, "0,1000000000,1,or_greater"), "set_bandwidth_limit", "get_bandwidth_limit");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "seed"), "set_seed", "get_seed");
+}
+
+SimulatedMultiplayerPeer::SimulatedMultiplayerPeer() {
+}
+
+SimulatedMultiplayerPeer::~SimulatedMultiplayerPeer() {
+	close();
+}
@@ -0,0 +1,173 @@
+/*************************************************************************/
+/*  simulated_multiplayer_peer.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef SIMULATED_MULTIPLAYER_PEER_H
+#define SIMULATED_MULTIPLAYER_PEER_H
+
+#include "core/math/random_pcg.h"
+#include "core/multiplayer/multiplayer_peer.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// An in-process network, for tests and benchmarks of the multiplayer API without sockets.
+// Packets go through the latency, jitter, loss and bandwidth limit of their sender. All the
+// peers of a network must be used from the same thread.
+class SimulatedMultiplayerPeer : public MultiplayerPeer {
+	GDCLASS(SimulatedMultiplayerPeer, MultiplayerPeer);
+
+	enum {
+		RECORDING_VERSION = 1,
+		MAX_RETRANSMISSIONS = 16, // Lost reliable packets are delayed by a round trip per retry.
+	};
+
+	enum EventType {
+		EVENT_PACKET,
+		EVENT_CONNECT,
+		EVENT_DISCONNECT,
+	};
+
+	struct Event {
+		EventType type = EVENT_PACKET;
+		int from = 0;
+		int channel = 0;
+		Multiplayer::TransferMode mode = Multiplayer::TRANSFER_MODE_RELIABLE;
+		uint64_t usec = 0; // Network time of arrival.
+		uint64_t seq = 0; // Order of sending, to break ties and drop late ordered packets.
+		Vector<uint8_t> data;
+	};
+
+	struct EventSort {
+		_FORCE_INLINE_ bool operator()(const Event &p_a, const Event &p_b) const {
+			return p_a.usec < p_b.usec || (p_a.usec == p_b.usec && p_a.seq < p_b.seq);
+		}
+	};
+
+	// Shared by the peers of one network.
+	class Network : public RefCounted {
+	public:
+		HashMap<int, SimulatedMultiplayerPeer *> peers;
+		int next_id = 2;
+		uint64_t next_seq = 0;
+		bool manual_time = false;
+		uint64_t time_usec = 0; // Manual time, or when the network was created.
+
+		uint64_t get_time() const;
+	};
+
+	Ref<Network> network;
+	int unique_id = 0;
+	int target_peer = 0;
+	bool active = false;
+	bool replay = false;
+	ConnectionStatus connection_status = CONNECTION_DISCONNECTED;
+
+	// Outgoing link conditions.
+	double latency = 0;
+	double jitter = 0;
+	double packet_loss = 0;
+	int bandwidth_limit = 0;
+	RandomPCG rng;
+	uint64_t seed = 0;
+	uint64_t link_free_usec = 0; // When the link is done sending the queued bytes.
+	HashMap<int, uint64_t> link_min_usec; // Per target, nothing arrives before the connection or earlier ordered packets.
+	HashMap<uint64_t, uint64_t> ordered_usec; // Per target and channel, the arrival of the last reliable packet.
+
+	// Incoming.
+	LocalVector<Event> in_flight;
+	List<Event> incoming;
+	HashMap<uint64_t, uint64_t> last_ordered_seq; // Per sender and channel, for unreliable ordered packets.
+	HashMap<int, bool> connected_peers;
+	Vector<uint8_t> current_packet;
+
+	bool recording = false;
+	int recording_id = 0;
+	uint64_t recording_start = 0;
+	Vector<uint8_t> recording_data;
+
+	uint64_t packets_sent = 0;
+	uint64_t bytes_sent = 0;
+	uint64_t packets_received = 0;
+	uint64_t bytes_received = 0;
+	uint64_t packets_lost = 0;
+
+	void _join(const Ref<Network> &p_network, int p_id);
+	void _queue_event(SimulatedMultiplayerPeer *p_target, EventType p_type, const uint8_t *p_buffer, int p_buffer_size);
+	void _deliver(const Event &p_event);
+	void _record(const Event &p_event);
+
+protected:
+	static void _bind_methods();
+
+public:
+	virtual void set_target_peer(int p_peer_id) override;
+	virtual int get_packet_peer() const override;
+	virtual bool is_server() const override;
+	virtual void poll() override;
+	virtual int get_unique_id() const override;
+	virtual ConnectionStatus get_connection_status() const override;
+
+	virtual int get_available_packet_count() const override;
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override;
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override;
+	virtual int get_max_packet_size() const override;
+
+	Error create_server(bool p_manual_time = false);
+	Error create_client(const Ref<SimulatedMultiplayerPeer> &p_server);
+	Error create_replay(const Vector<uint8_t> &p_recording, bool p_manual_time = false);
+	void close();
+
+	void advance_time(double p_seconds);
+	double get_network_time() const;
+	bool is_replay_finished() const;
+
+	void set_latency(double p_seconds);
+	double get_latency() const;
+	void set_jitter(double p_seconds);
+	double get_jitter() const;
+	void set_packet_loss(double p_ratio);
+	double get_packet_loss() const;
+	void set_bandwidth_limit(int p_bytes_per_second);
+	int get_bandwidth_limit() const;
+	void set_seed(uint64_t p_seed);
+	uint64_t get_seed() const;
+
+	void start_recording();
+	void stop_recording();
+	bool is_recording() const;
+	Vector<uint8_t> get_recording() const;
+
+	Dictionary get_statistics() const;
+	void reset_statistics();
+
+	SimulatedMultiplayerPeer();
+	~SimulatedMultiplayerPeer();
+};
+
+#endif // SIMULATED_MULTIPLAYER_PEER_H
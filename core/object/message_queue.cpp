@@ -30,10 +30,12 @@
 
 #include "message_queue.h"
 
+#include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/core_string_names.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 MessageQueue *MessageQueue::singleton = nullptr;
 
@@ -41,16 +43,103 @@ MessageQueue *MessageQueue::get_singleton() {
 	return singleton;
 }
 
+// Assigned on a thread's first push and kept for its lifetime, so its messages stay in order.
+static thread_local int32_t message_queue_lane = -1;
+static SafeNumeric<uint32_t> message_queue_next_lane;
+
+MessageQueue::Lane &MessageQueue::_get_lane() {
+	if (unlikely(message_queue_lane < 0)) {
+		if (Thread::get_caller_id() == Thread::get_main_id()) {
+			message_queue_lane = 0;
+		} else {
+			message_queue_lane = 1 + message_queue_next_lane.postincrement() % (LANE_COUNT - 1);
+		}
+	}
+	return lanes[message_queue_lane];
+}
+
+MessageQueue::Page MessageQueue::_page_alloc(uint32_t p_size) {
+	Page page;
+
+	if (p_size <= PAGE_SIZE) {
+		free_pages_lock.lock();
+		if (free_pages.size()) {
+			page = free_pages[free_pages.size() - 1];
+			free_pages.resize(free_pages.size() - 1);
+		}
+		free_pages_lock.unlock();
+
+		if (page.data) {
+			return page;
+		}
+		p_size = PAGE_SIZE;
+	}
+
+	if (allocated_bytes.add(p_size) > max_allocated_bytes) {
+		allocated_bytes.sub(p_size);
+		return page;
+	}
+
+	page.data = (uint8_t *)memalloc(p_size);
+	page.size = p_size;
+	return page;
+}
+
+void MessageQueue::_page_free(const Page &p_page) {
+	if (p_page.size == PAGE_SIZE) {
+		Page page = p_page;
+		page.used = 0;
+		free_pages_lock.lock();
+		free_pages.push_back(page);
+		free_pages_lock.unlock();
+	} else {
+		// Oversized pages for large messages are not kept around.
+		allocated_bytes.sub(p_page.size);
+		memfree(p_page.data);
+	}
+}
+
+uint8_t *MessageQueue::_lane_alloc(Lane &p_lane, uint32_t p_size) {
+	if (p_lane.pages.size() == 0 || p_lane.pages[p_lane.pages.size() - 1].size - p_lane.pages[p_lane.pages.size() - 1].used < p_size) {
+		Page page = _page_alloc(p_size);
+		if (!page.data) {
+			return nullptr;
+		}
+		p_lane.pages.push_back(page);
+	}
+
+	Page &page = p_lane.pages[p_lane.pages.size() - 1];
+	uint8_t *ptr = page.data + page.used;
+	page.used += p_size;
+	return ptr;
+}
+
+uint32_t MessageQueue::_destroy_message(Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int i = 0; i < p_message->args; i++) {
+			args[i].~Variant();
+		}
+		size += sizeof(Variant) * p_message->args;
+	}
+	p_message->~Message();
+	return size;
+}
+
 Error MessageQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callablep(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
 
 Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	_THREAD_SAFE_METHOD_
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	uint8_t room_needed = sizeof(Message) + sizeof(Variant);
+	Lane &lane = _get_lane();
+	lane.lock.lock();
+	uint8_t *ptr = _lane_alloc(lane, room_needed);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (!ptr) {
+		lane.lock.unlock();
 		String type;
 		if (ObjectDB::get_instance(p_id)) {
 			type = ObjectDB::get_instance(p_id)->get_class();
@@ -60,41 +149,43 @@ Error MessageQueue::push_set(ObjectID p_id, const StringName &p_prop, const Vari
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(ptr, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
 
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-	buffer_end += sizeof(Variant);
+	Variant *v = memnew_placement(ptr + sizeof(Message), Variant);
 	*v = p_value;
 
+	lane.lock.unlock();
+
 	return OK;
 }
 
 Error MessageQueue::push_notification(ObjectID p_id, int p_notification) {
-	_THREAD_SAFE_METHOD_
-
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
 
-	uint8_t room_needed = sizeof(Message);
+	uint32_t room_needed = sizeof(Message);
+
+	Lane &lane = _get_lane();
+	lane.lock.lock();
+	uint8_t *ptr = _lane_alloc(lane, room_needed);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (!ptr) {
+		lane.lock.unlock();
 		print_line("Failed notification: " + itos(p_notification) + " target ID: " + itos(p_id));
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(ptr, Message);
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringNames::get_singleton()->notification); //name is meaningless but callable needs it
 	//msg->target;
 	msg->notification = p_notification;
 
-	buffer_end += sizeof(Message);
+	lane.lock.unlock();
 
 	return OK;
 }
@@ -112,17 +203,20 @@ Error MessageQueue::push_set(Object *p_object, const StringName &p_prop, const V
 }
 
 Error MessageQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
-	_THREAD_SAFE_METHOD_
+	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
-	int room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
+	Lane &lane = _get_lane();
+	lane.lock.lock();
+	uint8_t *ptr = _lane_alloc(lane, room_needed);
 
-	if ((buffer_end + room_needed) >= buffer_size) {
+	if (!ptr) {
+		lane.lock.unlock();
 		print_line("Failed method: " + p_callable);
 		statistics();
 		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_kb' in project settings.");
 	}
 
-	Message *msg = memnew_placement(&buffer[buffer_end], Message);
+	Message *msg = memnew_placement(ptr, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -130,14 +224,14 @@ Error MessageQueue::push_callablep(const Callable &p_callable, const Variant **p
 		msg->type |= FLAG_SHOW_ERROR;
 	}
 
-	buffer_end += sizeof(Message);
-
+	Variant *args = (Variant *)(ptr + sizeof(Message));
 	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(&buffer[buffer_end], Variant);
-		buffer_end += sizeof(Variant);
+		Variant *v = memnew_placement(&args[i], Variant);
 		*v = *p_args[i];
 	}
 
+	lane.lock.unlock();
+
 	return OK;
 }
 
@@ -146,56 +240,68 @@ void MessageQueue::statistics() {
 	Map<int, int> notify_count;
 	Map<Callable, int> call_count;
 	int null_count = 0;
+	uint64_t total_bytes = 0;
 
-	uint32_t read_pos = 0;
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
+	for (int i = 0; i < LANE_COUNT; i++) {
+		Lane &lane = lanes[i];
+		lane.lock.lock();
 
-		Object *target = message->callable.get_object();
+		for (uint32_t j = 0; j < lane.pages.size(); j++) {
+			const Page &page = lane.pages[j];
+			total_bytes += page.used;
 
-		if (target != nullptr) {
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (!call_count.has(message->callable)) {
-						call_count[message->callable] = 0;
-					}
+			uint32_t read_pos = 0;
+			while (read_pos < page.used) {
+				Message *message = (Message *)&page.data[read_pos];
 
-					call_count[message->callable]++;
+				Object *target = message->callable.get_object();
 
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (!notify_count.has(message->notification)) {
-						notify_count[message->notification] = 0;
-					}
+				if (target != nullptr) {
+					switch (message->type & FLAG_MASK) {
+						case TYPE_CALL: {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
 
-					notify_count[message->notification]++;
+							call_count[message->callable]++;
 
-				} break;
-				case TYPE_SET: {
-					StringName t = message->callable.get_method();
-					if (!set_count.has(t)) {
-						set_count[t] = 0;
-					}
+						} break;
+						case TYPE_NOTIFICATION: {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
 
-					set_count[t]++;
+							notify_count[message->notification]++;
 
-				} break;
-			}
+						} break;
+						case TYPE_SET: {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
 
-		} else {
-			//object was deleted
-			print_line("Object was deleted while awaiting a callback");
+							set_count[t]++;
 
-			null_count++;
-		}
+						} break;
+					}
+
+				} else {
+					//object was deleted
+					null_count++;
+				}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
+				read_pos += sizeof(Message);
+				if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+					read_pos += sizeof(Variant) * message->args;
+				}
+			}
 		}
+
+		lane.lock.unlock();
 	}
 
-	print_line("TOTAL BYTES: " + itos(buffer_end));
+	print_line("TOTAL BYTES: " + itos(total_bytes));
+	print_line("ALLOCATED BYTES: " + itos(allocated_bytes.get()));
 	print_line("NULL count: " + itos(null_count));
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -215,6 +321,14 @@ int MessageQueue::get_max_buffer_usage() const {
 	return buffer_max_used;
 }
 
+uint32_t MessageQueue::get_last_frame_message_count() const {
+	return last_frame_messages;
+}
+
+uint64_t MessageQueue::get_last_frame_bytes() const {
+	return last_frame_bytes;
+}
+
 void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error) {
 	const Variant **argptrs = nullptr;
 	if (p_argcount) {
@@ -233,77 +347,92 @@ void MessageQueue::_call_function(const Callable &p_callable, const Variant *p_a
 }
 
 void MessageQueue::flush() {
-	if (buffer_end > buffer_max_used) {
-		buffer_max_used = buffer_end;
+	ERR_FAIL_COND(flushing); //already flushing, you did something odd
+	flushing = true;
+
+	uint64_t frame = Engine::get_singleton() ? Engine::get_singleton()->get_process_frames() : 0;
+	if (frame != stats_frame) {
+		last_frame_messages = frame_messages;
+		last_frame_bytes = frame_bytes;
+		frame_messages = 0;
+		frame_bytes = 0;
+		stats_frame = frame;
 	}
 
-	uint32_t read_pos = 0;
+	uint32_t flushed_bytes = 0;
+	bool found = true;
 
-	//using reverse locking strategy
-	_THREAD_SAFE_LOCK_
+	// Messages pushed while flushing are run by the same flush, lanes are visited until all are empty.
+	while (found) {
+		found = false;
 
-	if (flushing) {
-		_THREAD_SAFE_UNLOCK_
-		ERR_FAIL_COND(flushing); //already flushing, you did something odd
-	}
-	flushing = true;
+		for (int i = 0; i < LANE_COUNT; i++) {
+			Lane &lane = lanes[i];
 
-	while (read_pos < buffer_end) {
-		//lock on each iteration, so a call can re-add itself to the message queue
+			// Take the pages out of the lane, so its thread can keep pushing while they are run.
+			lane.lock.lock();
+			for (uint32_t j = 0; j < lane.pages.size(); j++) {
+				flush_pages.push_back(lane.pages[j]);
+			}
+			lane.pages.clear();
+			lane.lock.unlock();
 
-		Message *message = (Message *)&buffer[read_pos];
+			if (flush_pages.size() == 0) {
+				continue;
+			}
+			found = true;
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+			for (uint32_t j = 0; j < flush_pages.size(); j++) {
+				const Page &page = flush_pages[j];
+				uint32_t read_pos = 0;
 
-		//pre-advance so this function is reentrant
-		read_pos += advance;
+				while (read_pos < page.used) {
+					Message *message = (Message *)&page.data[read_pos];
 
-		_THREAD_SAFE_UNLOCK_
+					Object *target = message->callable.get_object();
 
-		Object *target = message->callable.get_object();
+					if (target != nullptr) {
+						switch (message->type & FLAG_MASK) {
+							case TYPE_CALL: {
+								Variant *args = (Variant *)(message + 1);
 
-		if (target != nullptr) {
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					Variant *args = (Variant *)(message + 1);
+								// messages don't expect a return value
 
-					// messages don't expect a return value
+								_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
 
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+							} break;
+							case TYPE_NOTIFICATION: {
+								// messages don't expect a return value
+								target->notification(message->notification);
 
-				} break;
-				case TYPE_NOTIFICATION: {
-					// messages don't expect a return value
-					target->notification(message->notification);
+							} break;
+							case TYPE_SET: {
+								Variant *arg = (Variant *)(message + 1);
+								// messages don't expect a return value
+								target->set(message->callable.get_method(), *arg);
 
-				} break;
-				case TYPE_SET: {
-					Variant *arg = (Variant *)(message + 1);
-					// messages don't expect a return value
-					target->set(message->callable.get_method(), *arg);
+							} break;
+						}
+					}
 
-				} break;
-			}
-		}
+					read_pos += _destroy_message(message);
+					frame_messages++;
+				}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int i = 0; i < message->args; i++) {
-				args[i].~Variant();
+				flushed_bytes += page.used;
+				_page_free(page);
 			}
-		}
 
-		message->~Message();
+			flush_pages.clear();
+		}
+	}
 
-		_THREAD_SAFE_LOCK_
+	frame_bytes += flushed_bytes;
+	if (flushed_bytes > buffer_max_used) {
+		buffer_max_used = flushed_bytes;
 	}
 
-	buffer_end = 0; // reset buffer
 	flushing = false;
-	_THREAD_SAFE_UNLOCK_
 }
 
 bool MessageQueue::is_flushing() const {
@@ -314,32 +443,29 @@ MessageQueue::MessageQueue() {
 	ERR_FAIL_COND_MSG(singleton != nullptr, "A MessageQueue singleton already exists.");
 	singleton = this;
 
-	buffer_size = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
+	max_allocated_bytes = GLOBAL_DEF_RST("memory/limits/message_queue/max_size_kb", DEFAULT_QUEUE_SIZE_KB);
 	ProjectSettings::get_singleton()->set_custom_property_info("memory/limits/message_queue/max_size_kb", PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_kb", PROPERTY_HINT_RANGE, "1024,4096,1,or_greater"));
-	buffer_size *= 1024;
-	buffer = memnew_arr(uint8_t, buffer_size);
+	max_allocated_bytes *= 1024;
 }
 
 MessageQueue::~MessageQueue() {
-	uint32_t read_pos = 0;
-
-	while (read_pos < buffer_end) {
-		Message *message = (Message *)&buffer[read_pos];
-		Variant *args = (Variant *)(message + 1);
-		int argc = message->args;
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			for (int i = 0; i < argc; i++) {
-				args[i].~Variant();
+	for (int i = 0; i < LANE_COUNT; i++) {
+		Lane &lane = lanes[i];
+		for (uint32_t j = 0; j < lane.pages.size(); j++) {
+			const Page &page = lane.pages[j];
+			uint32_t read_pos = 0;
+			while (read_pos < page.used) {
+				read_pos += _destroy_message((Message *)&page.data[read_pos]);
 			}
+			memfree(page.data);
 		}
-		message->~Message();
+		lane.pages.clear();
+	}
 
-		read_pos += sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			read_pos += sizeof(Variant) * message->args;
-		}
+	for (uint32_t i = 0; i < free_pages.size(); i++) {
+		memfree(free_pages[i].data);
 	}
+	free_pages.clear();
 
 	singleton = nullptr;
-	memdelete_arr(buffer);
 }
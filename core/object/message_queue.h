@@ -32,16 +32,19 @@
 #define MESSAGE_QUEUE_H
 
 #include "core/object/object_id.h"
-#include "core/os/thread_safe.h"
+#include "core/os/spin_lock.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
 class Object;
 
 class MessageQueue {
-	_THREAD_SAFE_CLASS_
-
 	enum {
-		DEFAULT_QUEUE_SIZE_KB = 4096
+		DEFAULT_QUEUE_SIZE_KB = 4096,
+		PAGE_SIZE = 64 * 1024,
+		// Lane 0 belongs to the main thread, other threads are assigned the rest in turn.
+		LANE_COUNT = 16
 	};
 
 	enum {
@@ -62,10 +65,42 @@ class MessageQueue {
 		};
 	};
 
-	uint8_t *buffer = nullptr;
-	uint32_t buffer_end = 0;
+	struct Page {
+		uint8_t *data = nullptr;
+		uint32_t size = 0;
+		uint32_t used = 0;
+	};
+
+	// Messages pushed by one thread always go to the same lane, in order.
+	// The lock is only contended by threads sharing the lane and by flush(),
+	// which takes the pages out of the lane before running the messages.
+	struct Lane {
+		SpinLock lock;
+		LocalVector<Page> pages;
+	};
+
+	Lane lanes[LANE_COUNT];
+
+	SpinLock free_pages_lock;
+	LocalVector<Page> free_pages;
+	SafeNumeric<uint64_t> allocated_bytes;
+	uint64_t max_allocated_bytes = 0;
+
+	LocalVector<Page> flush_pages;
+
 	uint32_t buffer_max_used = 0;
-	uint32_t buffer_size = 0;
+
+	uint64_t stats_frame = 0;
+	uint32_t frame_messages = 0;
+	uint64_t frame_bytes = 0;
+	uint32_t last_frame_messages = 0;
+	uint64_t last_frame_bytes = 0;
+
+	_FORCE_INLINE_ Lane &_get_lane();
+	uint8_t *_lane_alloc(Lane &p_lane, uint32_t p_size);
+	Page _page_alloc(uint32_t p_size);
+	void _page_free(const Page &p_page);
+	static uint32_t _destroy_message(Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
@@ -121,6 +156,8 @@ public:
 	bool is_flushing() const;
 
 	int get_max_buffer_usage() const;
+	uint32_t get_last_frame_message_count() const;
+	uint64_t get_last_frame_bytes() const;
 
 	MessageQueue();
 	~MessageQueue();
@@ -1069,14 +1069,18 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		return ERR_UNAVAILABLE;
 	}
 
-	List<_ObjectSignalDisconnectData> disconnect_data;
-
 	//copy on write will ensure that disconnecting the signal or even deleting the object will not affect the signal calling.
 	//this happens automatically and will not change the performance of calling.
 	//awesome, isn't it?
-	VMap<Callable, SignalData::Slot> slot_map = s->slot_map;
+	//the copy must stay const, any non-const access to it would duplicate the slots on every emission.
+	const VMap<Callable, SignalData::Slot> slot_map = s->slot_map;
 
 	int ssize = slot_map.size();
+	if (ssize == 0) {
+		return OK;
+	}
+
+	List<_ObjectSignalDisconnectData> disconnect_data;
 
 	OBJ_DEBUG_LOCK
 
@@ -1085,7 +1089,8 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 	Error err = OK;
 
 	for (int i = 0; i < ssize; i++) {
-		const Connection &c = slot_map.getv(i).conn;
+		const SignalData::Slot &slot = slot_map.getv(i);
+		const Connection &c = slot.conn;
 
 		Object *target = c.callable.get_object();
 		if (!target) {
@@ -1117,7 +1122,15 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			Callable::CallError ce;
 			_emitting = true;
 			Variant ret;
-			c.callable.call(args, argc, ret, ce);
+			if (slot.method_bind && !target->script_instance) {
+				// Native method on a target without script, same result as Object::callp() without the method lookup.
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock target_lock(target);
+#endif
+				ret = slot.method_bind->call(target, args, argc, ce);
+			} else {
+				c.callable.call(args, argc, ret, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1361,6 +1374,9 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, co
 	if (p_flags & CONNECT_REFERENCE_COUNTED) {
 		slot.reference_count = 1;
 	}
+	if (!target.is_custom() && target.get_method() != CoreStringNames::get_singleton()->_free) {
+		slot.method_bind = ClassDB::get_method(target_object->get_class_name(), target.get_method());
+	}
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*target.get_base_comparator()] = slot;
@@ -1921,9 +1937,15 @@ void postinitialize_handler(Object *p_object) {
 void ObjectDB::debug_objects(DebugFunc p_func) {
 	spin_lock.lock();
 
-	for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-		if (object_slots[i].validator) {
-			p_func(object_slots[i].object);
+	for (uint32_t i = 0, count = slot_count.get(); i < slot_max && count != 0; i++) {
+		ObjectSlot &object_slot = _get_slot(i);
+		if (object_slot.tag.load(std::memory_order_acquire) == 0) {
+			continue;
+		}
+		// Removal doesn't take the lock, the slot may have been emptied since.
+		Object *object = object_slot.object.load(std::memory_order_acquire);
+		if (object) {
+			p_func(object);
 			count--;
 		}
 	}
@@ -1933,46 +1955,100 @@ void ObjectDB::debug_objects(DebugFunc p_func) {
 void Object::get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const {
 }
 
+std::atomic<ObjectDB::ObjectSlot *> ObjectDB::slot_blocks[OBJECTDB_SLOT_BLOCK_COUNT] = {};
 SpinLock ObjectDB::spin_lock;
-uint32_t ObjectDB::slot_count = 0;
+LocalVector<uint32_t> ObjectDB::free_slots;
 uint32_t ObjectDB::slot_max = 0;
-ObjectDB::ObjectSlot *ObjectDB::object_slots = nullptr;
-uint64_t ObjectDB::validator_counter = 0;
+SafeNumeric<uint32_t> ObjectDB::slot_count;
+SafeNumeric<uint64_t> ObjectDB::validator_counter;
+bool ObjectDB::slots_released = false;
 
-int ObjectDB::get_object_count() {
-	return slot_count;
-}
+// Each thread keeps a small stack of free slots, so creating and freeing objects only
+// touches the global free list (and its lock) once per batch.
+struct ObjectDB::ThreadFreeSlots {
+	enum {
+		CAPACITY = 64,
+		BATCH = CAPACITY / 2,
+	};
 
-ObjectID ObjectDB::add_instance(Object *p_object) {
-	spin_lock.lock();
-	if (unlikely(slot_count == slot_max)) {
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+	uint32_t slots[CAPACITY];
+	uint32_t count = 0;
+
+	~ThreadFreeSlots() {
+		// Hand the cached slots back when the thread exits, so they can be reused.
+		ObjectDB::_return_thread_slots(*this, count);
+	}
+};
 
-		uint32_t new_slot_max = slot_max > 0 ? slot_max * 2 : 1;
-		object_slots = (ObjectSlot *)memrealloc(object_slots, sizeof(ObjectSlot) * new_slot_max);
-		for (uint32_t i = slot_max; i < new_slot_max; i++) {
-			object_slots[i].object = nullptr;
-			object_slots[i].is_ref_counted = false;
-			object_slots[i].next_free = i;
-			object_slots[i].validator = 0;
+thread_local ObjectDB::ThreadFreeSlots ObjectDB::thread_free_slots;
+
+void ObjectDB::_return_thread_slots(ThreadFreeSlots &p_cache, uint32_t p_count) {
+	spin_lock.lock();
+	if (!slots_released) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			free_slots.push_back(p_cache.slots[--p_cache.count]);
 		}
-		slot_max = new_slot_max;
 	}
+	spin_lock.unlock();
+}
+
+uint32_t ObjectDB::_alloc_slot() {
+	ThreadFreeSlots &cache = thread_free_slots;
+	if (unlikely(cache.count == 0)) {
+		spin_lock.lock();
+		if (free_slots.size() < ThreadFreeSlots::BATCH) {
+			CRASH_COND(slot_max == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+
+			ObjectSlot *block = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * OBJECTDB_SLOT_BLOCK_SIZE);
+			for (uint32_t i = 0; i < OBJECTDB_SLOT_BLOCK_SIZE; i++) {
+				memnew_placement(&block[i].tag, std::atomic<uint64_t>(0));
+				memnew_placement(&block[i].object, std::atomic<Object *>(nullptr));
+			}
+			slot_blocks[slot_max >> OBJECTDB_SLOT_BLOCK_BITS].store(block, std::memory_order_release);
+
+			// Pushed in reverse, so lower slots are handed out first.
+			for (uint32_t i = OBJECTDB_SLOT_BLOCK_SIZE; i > 0; i--) {
+				free_slots.push_back(slot_max + i - 1);
+			}
+			slot_max += OBJECTDB_SLOT_BLOCK_SIZE;
+		}
 
-	uint32_t slot = object_slots[slot_count].next_free;
-	if (object_slots[slot].object != nullptr) {
+		for (uint32_t i = 0; i < ThreadFreeSlots::BATCH; i++) {
+			cache.slots[cache.count++] = free_slots[free_slots.size() - 1];
+			free_slots.resize(free_slots.size() - 1);
+		}
 		spin_lock.unlock();
-		ERR_FAIL_COND_V(object_slots[slot].object != nullptr, ObjectID());
 	}
-	object_slots[slot].object = p_object;
-	object_slots[slot].is_ref_counted = p_object->is_ref_counted();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
+
+	return cache.slots[--cache.count];
+}
+
+void ObjectDB::_free_slot(uint32_t p_slot) {
+	ThreadFreeSlots &cache = thread_free_slots;
+	if (unlikely(cache.count == ThreadFreeSlots::CAPACITY)) {
+		_return_thread_slots(cache, ThreadFreeSlots::BATCH);
+	}
+	cache.slots[cache.count++] = p_slot;
+}
+
+int ObjectDB::get_object_count() {
+	return slot_count.get();
+}
+
+ObjectID ObjectDB::add_instance(Object *p_object) {
+	uint32_t slot = _alloc_slot();
+	ObjectSlot &object_slot = _get_slot(slot);
+	if (unlikely(object_slot.object.load(std::memory_order_relaxed) != nullptr)) {
+		_free_slot(slot);
+		ERR_FAIL_V(ObjectID());
 	}
-	object_slots[slot].validator = validator_counter;
 
-	uint64_t id = validator_counter;
+	uint64_t validator = validator_counter.increment() & OBJECTDB_VALIDATOR_MASK;
+	while (unlikely(validator == 0)) {
+		validator = validator_counter.increment() & OBJECTDB_VALIDATOR_MASK;
+	}
+
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_COUNT_BITS;
 	id |= uint64_t(slot);
 
@@ -1980,9 +2056,11 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 		id |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
+	object_slot.object.store(p_object, std::memory_order_relaxed);
+	// Publishing the tag makes the object visible to get_instance().
+	object_slot.tag.store(id >> OBJECTDB_SLOT_MAX_COUNT_BITS, std::memory_order_release);
 
-	spin_lock.unlock();
+	slot_count.increment();
 
 	return ObjectID(id);
 }
@@ -1990,34 +2068,20 @@ ObjectID ObjectDB::add_instance(Object *p_object) {
 void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	uint32_t slot = t & OBJECTDB_SLOT_MAX_COUNT_MASK; //slot is always valid on valid object
-
-	spin_lock.lock();
+	ObjectSlot &object_slot = _get_slot(slot);
 
 #ifdef DEBUG_ENABLED
 
-	if (object_slots[slot].object != p_object) {
-		spin_lock.unlock();
-		ERR_FAIL_COND(object_slots[slot].object != p_object);
-	}
-	{
-		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (object_slots[slot].validator != validator) {
-			spin_lock.unlock();
-			ERR_FAIL_COND(object_slots[slot].validator != validator);
-		}
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
+	ERR_FAIL_COND(object_slot.tag.load(std::memory_order_relaxed) != (t >> OBJECTDB_SLOT_MAX_COUNT_BITS));
 
 #endif
-	//decrease slot count
-	slot_count--;
-	//set the free slot properly
-	object_slots[slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	object_slots[slot].validator = 0;
-	object_slots[slot].is_ref_counted = false;
-	object_slots[slot].object = nullptr;
+	//invalidate first, so lookups racing with the removal fail
+	object_slot.tag.store(0, std::memory_order_release);
+	object_slot.object.store(nullptr, std::memory_order_release);
 
-	spin_lock.unlock();
+	slot_count.decrement();
+	_free_slot(slot);
 }
 
 void ObjectDB::setup() {
@@ -2025,7 +2089,7 @@ void ObjectDB::setup() {
 }
 
 void ObjectDB::cleanup() {
-	if (slot_count > 0) {
+	if (slot_count.get() > 0) {
 		spin_lock.lock();
 
 		WARN_PRINT("ObjectDB instances leaked at exit (run with --verbose for details).");
@@ -2037,9 +2101,11 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 0, count = slot_count; i < slot_max && count != 0; i++) {
-				if (object_slots[i].validator) {
-					Object *obj = object_slots[i].object;
+			for (uint32_t i = 0, count = slot_count.get(); i < slot_max && count != 0; i++) {
+				ObjectSlot &object_slot = _get_slot(i);
+				uint64_t tag = object_slot.tag.load(std::memory_order_acquire);
+				if (tag) {
+					Object *obj = object_slot.object.load(std::memory_order_relaxed);
 
 					String extra_info;
 					if (obj->is_class("Node")) {
@@ -2049,7 +2115,7 @@ void ObjectDB::cleanup() {
 						extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 					}
 
-					uint64_t id = uint64_t(i) | (uint64_t(object_slots[i].validator) << OBJECTDB_VALIDATOR_BITS) | (object_slots[i].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+					uint64_t id = uint64_t(i) | (tag << OBJECTDB_SLOT_MAX_COUNT_BITS);
 					print_line("Leaked instance: " + String(obj->get_class()) + ":" + itos(id) + extra_info);
 
 					count--;
@@ -2060,7 +2126,15 @@ void ObjectDB::cleanup() {
 		spin_lock.unlock();
 	}
 
-	if (object_slots) {
-		memfree(object_slots);
-	}
+	spin_lock.lock();
+	for (uint32_t i = 0; i < slot_max; i += OBJECTDB_SLOT_BLOCK_SIZE) {
+		ObjectSlot *block = slot_blocks[i >> OBJECTDB_SLOT_BLOCK_BITS].exchange(nullptr);
+		memfree(block);
+	}
+	slot_max = 0;
+	free_slots.reset();
+	// Slots cached by threads that exit after this point are dropped.
+	thread_free_slots.count = 0;
+	slots_released = true;
+	spin_lock.unlock();
 }
@@ -38,6 +38,7 @@
 #include "core/os/spin_lock.h"
 #include "core/templates/hash_map.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/map.h"
 #include "core/templates/ordered_hash_map.h"
 #include "core/templates/safe_refcount.h"
@@ -490,6 +491,7 @@ private:
 			int reference_count = 0;
 			Connection conn;
 			List<Connection>::Element *cE = nullptr;
+			MethodBind *method_bind = nullptr; // Resolved on connect for native methods, lets emission skip Object::callp().
 		};
 
 		MethodInfo user;
@@ -846,18 +848,40 @@ class ObjectDB {
 #define OBJECTDB_SLOT_MAX_COUNT_MASK ((uint64_t(1) << OBJECTDB_SLOT_MAX_COUNT_BITS) - 1)
 #define OBJECTDB_REFERENCE_BIT (uint64_t(1) << (OBJECTDB_SLOT_MAX_COUNT_BITS + OBJECTDB_VALIDATOR_BITS))
 
+#define OBJECTDB_SLOT_BLOCK_BITS 12
+#define OBJECTDB_SLOT_BLOCK_SIZE (1 << OBJECTDB_SLOT_BLOCK_BITS)
+#define OBJECTDB_SLOT_BLOCK_MASK (OBJECTDB_SLOT_BLOCK_SIZE - 1)
+#define OBJECTDB_SLOT_BLOCK_COUNT (1 << (OBJECTDB_SLOT_MAX_COUNT_BITS - OBJECTDB_SLOT_BLOCK_BITS))
+
 	struct ObjectSlot { // 128 bits per slot.
-		uint64_t validator : OBJECTDB_VALIDATOR_BITS;
-		uint64_t next_free : OBJECTDB_SLOT_MAX_COUNT_BITS;
-		uint64_t is_ref_counted : 1;
-		Object *object = nullptr;
+		// Upper bits of the ObjectID (validator and reference bit), zero while the slot is free.
+		// Published after the object on add and cleared before it on remove, so get_instance() can
+		// read the slot without locking and re-check the tag to detect a concurrent removal.
+		std::atomic<uint64_t> tag;
+		std::atomic<Object *> object;
 	};
 
-	static SpinLock spin_lock;
-	static uint32_t slot_count;
+	struct ThreadFreeSlots;
+	static thread_local ThreadFreeSlots thread_free_slots;
+
+	// Slots are allocated in fixed blocks that are never moved or freed until cleanup,
+	// so readers can always dereference a published block.
+	static std::atomic<ObjectSlot *> slot_blocks[OBJECTDB_SLOT_BLOCK_COUNT];
+
+	static SpinLock spin_lock; // Protects free_slots, slot_max and block allocation.
+	static LocalVector<uint32_t> free_slots;
 	static uint32_t slot_max;
-	static ObjectSlot *object_slots;
-	static uint64_t validator_counter;
+	static SafeNumeric<uint32_t> slot_count;
+	static SafeNumeric<uint64_t> validator_counter;
+	static bool slots_released;
+
+	static uint32_t _alloc_slot();
+	static void _free_slot(uint32_t p_slot);
+	static void _return_thread_slots(ThreadFreeSlots &p_cache, uint32_t p_count);
+
+	_FORCE_INLINE_ static ObjectSlot &_get_slot(uint32_t p_slot) {
+		return slot_blocks[p_slot >> OBJECTDB_SLOT_BLOCK_BITS].load(std::memory_order_relaxed)[p_slot & OBJECTDB_SLOT_BLOCK_MASK];
+	}
 
 	friend class Object;
 	friend void unregister_core_types();
@@ -875,21 +899,25 @@ public:
 	_ALWAYS_INLINE_ static Object *get_instance(ObjectID p_instance_id) {
 		uint64_t id = p_instance_id;
 		uint32_t slot = id & OBJECTDB_SLOT_MAX_COUNT_MASK;
+		uint64_t tag = id >> OBJECTDB_SLOT_MAX_COUNT_BITS;
+		if (unlikely(tag == 0)) {
+			return nullptr; // Null ID, which would otherwise match a free slot.
+		}
 
-		ERR_FAIL_COND_V(slot >= slot_max, nullptr); // This should never happen unless RID is corrupted.
-
-		spin_lock.lock();
-
-		uint64_t validator = (id >> OBJECTDB_SLOT_MAX_COUNT_BITS) & OBJECTDB_VALIDATOR_MASK;
+		ObjectSlot *block = slot_blocks[slot >> OBJECTDB_SLOT_BLOCK_BITS].load(std::memory_order_acquire);
+		ERR_FAIL_COND_V(!block, nullptr); // This should never happen unless RID is corrupted.
 
-		if (unlikely(object_slots[slot].validator != validator)) {
-			spin_lock.unlock();
+		ObjectSlot &object_slot = block[slot & OBJECTDB_SLOT_BLOCK_MASK];
+		if (unlikely(object_slot.tag.load(std::memory_order_acquire) != tag)) {
 			return nullptr;
 		}
 
-		Object *object = object_slots[slot].object;
+		Object *object = object_slot.object.load(std::memory_order_acquire);
 
-		spin_lock.unlock();
+		// The slot may have been freed (and reused) while the object was being read.
+		if (unlikely(object_slot.tag.load(std::memory_order_relaxed) != tag)) {
+			return nullptr;
+		}
 
 		return object;
 	}
@@ -46,6 +46,7 @@
 #include "core/io/config_file.h"
 #include "core/io/dtls_server.h"
 #include "core/io/http_client.h"
+#include "core/io/http_client_pool.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
 #include "core/io/marshalls.h"
@@ -70,6 +71,7 @@
 #include "core/math/triangle_mesh.h"
 #include "core/multiplayer/multiplayer_api.h"
 #include "core/multiplayer/multiplayer_peer.h"
+#include "core/multiplayer/simulated_multiplayer_peer.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language_extension.h"
 #include "core/object/undo_redo.h"
@@ -188,6 +190,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(UDPServer);
 
 	ClassDB::register_custom_instance_class<HTTPClient>();
+	GDREGISTER_CLASS(HTTPClientPool);
 
 	// Crypto
 	GDREGISTER_CLASS(HashingContext);
@@ -207,6 +210,7 @@ void register_core_types() {
 
 	GDREGISTER_ABSTRACT_CLASS(MultiplayerPeer);
 	GDREGISTER_CLASS(MultiplayerPeerExtension);
+	GDREGISTER_CLASS(SimulatedMultiplayerPeer);
 	GDREGISTER_CLASS(MultiplayerAPI);
 	GDREGISTER_CLASS(MainLoop);
 	GDREGISTER_CLASS(Translation);
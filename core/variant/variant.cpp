@@ -39,6 +39,18 @@
 #include "core/string/print_string.h"
 #include "core/variant/variant_parser.h"
 
+#ifdef DEBUG_ENABLED
+SafeNumeric<uint64_t> Variant::allocation_count;
+#endif
+
+uint64_t Variant::get_allocation_count() {
+#ifdef DEBUG_ENABLED
+	return allocation_count.get();
+#else
+	return 0;
+#endif
+}
+
 String Variant::get_type_name(Variant::Type p_type) {
 	switch (p_type) {
 		case NIL: {
@@ -1076,7 +1088,7 @@ void Variant::reference(const Variant &p_variant) {
 			memnew_placement(_data._mem, Rect2i(*reinterpret_cast<const Rect2i *>(p_variant._data._mem)));
 		} break;
 		case TRANSFORM2D: {
-			_data._transform2d = memnew(Transform2D(*p_variant._data._transform2d));
+			_data._transform2d = _alloc_external(*p_variant._data._transform2d);
 		} break;
 		case VECTOR3: {
 			memnew_placement(_data._mem, Vector3(*reinterpret_cast<const Vector3 *>(p_variant._data._mem)));
@@ -1089,18 +1101,18 @@ void Variant::reference(const Variant &p_variant) {
 		} break;
 
 		case AABB: {
-			_data._aabb = memnew(::AABB(*p_variant._data._aabb));
+			_data._aabb = _alloc_external(*p_variant._data._aabb);
 		} break;
 		case QUATERNION: {
 			memnew_placement(_data._mem, Quaternion(*reinterpret_cast<const Quaternion *>(p_variant._data._mem)));
 
 		} break;
 		case BASIS: {
-			_data._basis = memnew(Basis(*p_variant._data._basis));
+			_data._basis = _alloc_external(*p_variant._data._basis);
 
 		} break;
 		case TRANSFORM3D: {
-			_data._transform3d = memnew(Transform3D(*p_variant._data._transform3d));
+			_data._transform3d = _alloc_external(*p_variant._data._transform3d);
 		} break;
 
 		// misc types
@@ -2390,12 +2402,12 @@ Variant::Variant(const Plane &p_plane) {
 
 Variant::Variant(const ::AABB &p_aabb) {
 	type = AABB;
-	_data._aabb = memnew(::AABB(p_aabb));
+	_data._aabb = _alloc_external(p_aabb);
 }
 
 Variant::Variant(const Basis &p_matrix) {
 	type = BASIS;
-	_data._basis = memnew(Basis(p_matrix));
+	_data._basis = _alloc_external(p_matrix);
 }
 
 Variant::Variant(const Quaternion &p_quaternion) {
@@ -2405,12 +2417,12 @@ Variant::Variant(const Quaternion &p_quaternion) {
 
 Variant::Variant(const Transform3D &p_transform) {
 	type = TRANSFORM3D;
-	_data._transform3d = memnew(Transform3D(p_transform));
+	_data._transform3d = _alloc_external(p_transform);
 }
 
 Variant::Variant(const Transform2D &p_transform) {
 	type = TRANSFORM2D;
-	_data._transform2d = memnew(Transform2D(p_transform));
+	_data._transform2d = _alloc_external(p_transform);
 }
 
 Variant::Variant(const Color &p_color) {
@@ -52,6 +52,7 @@
 #include "core/string/node_path.h"
 #include "core/string/ustring.h"
 #include "core/templates/rid.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/array.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
@@ -135,6 +136,19 @@ private:
 
 	Type type = NIL;
 
+#ifdef DEBUG_ENABLED
+	static SafeNumeric<uint64_t> allocation_count;
+#endif
+
+	// Allocates the types that don't fit in the Variant, counting them in debug builds.
+	template <class T>
+	_FORCE_INLINE_ static T *_alloc_external(const T &p_value) {
+#ifdef DEBUG_ENABLED
+		allocation_count.increment();
+#endif
+		return memnew(T(p_value));
+	}
+
 	struct ObjData {
 		ObjectID id;
 		Object *obj = nullptr;
@@ -176,9 +190,15 @@ private:
 	struct PackedArrayRef : public PackedArrayRefBase {
 		Vector<T> array;
 		static _FORCE_INLINE_ PackedArrayRef<T> *create() {
+#ifdef DEBUG_ENABLED
+			allocation_count.increment();
+#endif
 			return memnew(PackedArrayRef<T>);
 		}
 		static _FORCE_INLINE_ PackedArrayRef<T> *create(const Vector<T> &p_from) {
+#ifdef DEBUG_ENABLED
+			allocation_count.increment();
+#endif
 			return memnew(PackedArrayRef<T>(p_from));
 		}
 
@@ -295,6 +315,7 @@ public:
 		return type;
 	}
 	static String get_type_name(Variant::Type p_type);
+	static uint64_t get_allocation_count();
 	static bool can_convert(Type p_type_from, Type p_type_to);
 	static bool can_convert_strict(Type p_type_from, Type p_type_to);
 
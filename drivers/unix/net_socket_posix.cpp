@@ -162,6 +162,9 @@ void NetSocketPosix::make_default() {
 	}
 #endif
 	_create = _create_func;
+#if defined(UNIX_ENABLED)
+	NetSocketPollerPosix::make_default();
+#endif
 }
 
 void NetSocketPosix::cleanup() {
@@ -171,6 +174,9 @@ void NetSocketPosix::cleanup() {
 	}
 	_create = nullptr;
 #endif
+#if defined(UNIX_ENABLED)
+	NetSocketPollerPosix::cleanup();
+#endif
 }
 
 NetSocketPosix::NetSocketPosix() :
@@ -781,4 +787,225 @@ Error NetSocketPosix::join_multicast_group(const IPAddress &p_multi_address, Str
 Error NetSocketPosix::leave_multicast_group(const IPAddress &p_multi_address, String p_if_name) {
 	return _change_multicast_group(p_multi_address, p_if_name, false);
 }
+
+#if defined(UNIX_ENABLED)
+
+NetSocketPoller *NetSocketPollerPosix::_create_func() {
+	return memnew(NetSocketPollerPosix);
+}
+
+void NetSocketPollerPosix::make_default() {
+	_create = _create_func;
+}
+
+void NetSocketPollerPosix::cleanup() {
+	_create = nullptr;
+}
+
+Error NetSocketPollerPosix::_register(int p_fd, uint64_t p_id, NetSocket::PollType p_type, bool p_modify) {
+#if defined(__linux__)
+	ERR_FAIL_COND_V(epoll_fd < 0, ERR_UNCONFIGURED);
+
+	struct epoll_event ev = {};
+	switch (p_type) {
+		case NetSocket::POLL_TYPE_IN:
+			ev.events = EPOLLIN;
+			break;
+		case NetSocket::POLL_TYPE_OUT:
+			ev.events = EPOLLOUT;
+			break;
+		case NetSocket::POLL_TYPE_IN_OUT:
+			ev.events = EPOLLIN | EPOLLOUT;
+	}
+	ev.data.u64 = p_id;
+
+	int ret = epoll_ctl(epoll_fd, p_modify ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, p_fd, &ev);
+	if (ret != 0 && !p_modify && errno == EEXIST) {
+		// Still registered through a duplicated descriptor.
+		ret = epoll_ctl(epoll_fd, EPOLL_CTL_MOD, p_fd, &ev);
+	}
+	if (ret != 0) {
+		print_verbose("Unable to register socket for polling.");
+		return FAILED;
+	}
+#else
+	poll_dirty = true;
+#endif
+	return OK;
+}
+
+void NetSocketPollerPosix::_unregister(int p_fd) {
+#if defined(__linux__)
+	// Fails harmlessly if the descriptor was already closed, the kernel drops it then.
+	epoll_ctl(epoll_fd, EPOLL_CTL_DEL, p_fd, nullptr);
+#else
+	poll_dirty = true;
+#endif
+}
+
+Error NetSocketPollerPosix::add_socket(const Ref<NetSocket> &p_sock, uint64_t p_id, NetSocket::PollType p_type) {
+	ERR_FAIL_COND_V(p_sock.is_null() || !p_sock->is_open(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(entries.has(p_id), ERR_ALREADY_IN_USE, "A socket is already registered with this ID.");
+
+	const int fd = static_cast<const NetSocketPosix *>(p_sock.ptr())->_sock;
+	const uint64_t *owner = owners.getptr(fd);
+	if (owner) {
+		// The socket previously using this descriptor was closed without being removed.
+		entries.erase(*owner);
+		_unregister(fd);
+	}
+
+	Error err = _register(fd, p_id, p_type, false);
+	if (err != OK) {
+		owners.erase(fd);
+		return err;
+	}
+	Entry entry;
+	entry.fd = fd;
+	entry.type = p_type;
+	entries[p_id] = entry;
+	owners[fd] = p_id;
+	return OK;
+}
+
+Error NetSocketPollerPosix::modify_socket(uint64_t p_id, NetSocket::PollType p_type) {
+	Entry *entry = entries.getptr(p_id);
+	ERR_FAIL_COND_V(!entry, ERR_DOES_NOT_EXIST);
+	if (entry->type == p_type) {
+		return OK;
+	}
+	Error err = _register(entry->fd, p_id, p_type, true);
+	if (err == OK) {
+		entry->type = p_type;
+	}
+	return err;
+}
+
+void NetSocketPollerPosix::remove_socket(uint64_t p_id) {
+	const Entry *entry = entries.getptr(p_id);
+	if (!entry) {
+		return;
+	}
+	const uint64_t *owner = owners.getptr(entry->fd);
+	if (owner && *owner == p_id) {
+		_unregister(entry->fd);
+		owners.erase(entry->fd);
+	}
+	entries.erase(p_id);
+}
+
+bool NetSocketPollerPosix::has_socket(uint64_t p_id) const {
+	return entries.has(p_id);
+}
+
+int NetSocketPollerPosix::get_socket_count() const {
+	return entries.size();
+}
+
+Error NetSocketPollerPosix::wait(LocalVector<Event> &r_events, int p_timeout) {
+	r_events.clear();
+
+#if defined(__linux__)
+	ERR_FAIL_COND_V(epoll_fd < 0, ERR_UNCONFIGURED);
+
+	// Room for every socket, so none is left behind for the next wait.
+	epoll_events.resize(MAX(1, entries.size()));
+	int ret = epoll_wait(epoll_fd, epoll_events.ptr(), epoll_events.size(), p_timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return ERR_BUSY;
+		}
+		print_verbose("Error when waiting on sockets.");
+		return FAILED;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		const struct epoll_event &ev = epoll_events[i];
+		Event event;
+		event.id = ev.data.u64;
+		if (ev.events & EPOLLIN) {
+			event.flags |= EVENT_IN;
+		}
+		if (ev.events & EPOLLOUT) {
+			event.flags |= EVENT_OUT;
+		}
+		if (ev.events & (EPOLLERR | EPOLLHUP)) {
+			event.flags |= EVENT_ERROR;
+		}
+		r_events.push_back(event);
+	}
+#else
+	if (poll_dirty) {
+		poll_fds.clear();
+		poll_ids.clear();
+		const uint64_t *k = nullptr;
+		while ((k = entries.next(k))) {
+			const Entry &entry = entries[*k];
+			struct pollfd pfd;
+			pfd.fd = entry.fd;
+			pfd.revents = 0;
+			switch (entry.type) {
+				case NetSocket::POLL_TYPE_IN:
+					pfd.events = POLLIN;
+					break;
+				case NetSocket::POLL_TYPE_OUT:
+					pfd.events = POLLOUT;
+					break;
+				case NetSocket::POLL_TYPE_IN_OUT:
+					pfd.events = POLLOUT | POLLIN;
+			}
+			poll_fds.push_back(pfd);
+			poll_ids.push_back(*k);
+		}
+		poll_dirty = false;
+	}
+
+	int ret = ::poll(poll_fds.ptr(), poll_fds.size(), p_timeout);
+	if (ret < 0) {
+		if (errno == EINTR) {
+			return ERR_BUSY;
+		}
+		print_verbose("Error when waiting on sockets.");
+		return FAILED;
+	}
+
+	for (uint32_t i = 0; i < poll_fds.size() && r_events.size() < (uint32_t)ret; i++) {
+		const short revents = poll_fds[i].revents;
+		if (!revents) {
+			continue;
+		}
+		Event event;
+		event.id = poll_ids[i];
+		if (revents & POLLIN) {
+			event.flags |= EVENT_IN;
+		}
+		if (revents & POLLOUT) {
+			event.flags |= EVENT_OUT;
+		}
+		if (revents & (POLLERR | POLLHUP | POLLNVAL)) {
+			event.flags |= EVENT_ERROR;
+		}
+		r_events.push_back(event);
+	}
+#endif
+
+	return r_events.is_empty() ? ERR_BUSY : OK;
+}
+
+NetSocketPollerPosix::NetSocketPollerPosix() {
+#if defined(__linux__)
+	epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	ERR_FAIL_COND_MSG(epoll_fd < 0, "Unable to create epoll instance.");
+#endif
+}
+
+NetSocketPollerPosix::~NetSocketPollerPosix() {
+#if defined(__linux__)
+	if (epoll_fd >= 0) {
+		::close(epoll_fd);
+	}
+#endif
+}
+
+#endif // UNIX_ENABLED
 #endif
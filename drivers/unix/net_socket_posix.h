@@ -32,6 +32,7 @@
 #define NET_SOCKET_UNIX_H
 
 #include "core/io/net_socket.h"
+#include "core/templates/hash_map.h"
 
 #if defined(WINDOWS_ENABLED)
 #include <winsock2.h>
@@ -45,6 +46,8 @@
 #endif
 
 class NetSocketPosix : public NetSocket {
+	friend class NetSocketPollerPosix;
+
 private:
 	SOCKET_TYPE _sock; // NOLINT - the default value is defined in the .cpp
 	IP::Type _ip_type = IP::TYPE_NONE;
@@ -104,4 +107,55 @@ public:
 	~NetSocketPosix();
 };
 
+#if defined(UNIX_ENABLED)
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+
+class NetSocketPollerPosix : public NetSocketPoller {
+private:
+	struct Entry {
+		int fd = -1;
+		NetSocket::PollType type = NetSocket::POLL_TYPE_IN;
+	};
+
+	HashMap<uint64_t, Entry> entries;
+	// A closed descriptor can be reused by a new socket, only its latest owner may unregister it.
+	HashMap<int, uint64_t> owners;
+
+#if defined(__linux__)
+	int epoll_fd = -1;
+	LocalVector<struct epoll_event> epoll_events;
+#else
+	LocalVector<struct pollfd> poll_fds;
+	LocalVector<uint64_t> poll_ids;
+	bool poll_dirty = false;
+#endif
+
+	Error _register(int p_fd, uint64_t p_id, NetSocket::PollType p_type, bool p_modify);
+	void _unregister(int p_fd);
+
+protected:
+	static NetSocketPoller *_create_func();
+
+public:
+	static void make_default();
+	static void cleanup();
+
+	virtual Error add_socket(const Ref<NetSocket> &p_sock, uint64_t p_id, NetSocket::PollType p_type);
+	virtual Error modify_socket(uint64_t p_id, NetSocket::PollType p_type);
+	virtual void remove_socket(uint64_t p_id);
+	virtual bool has_socket(uint64_t p_id) const;
+	virtual int get_socket_count() const;
+	virtual Error wait(LocalVector<Event> &r_events, int p_timeout);
+
+	NetSocketPollerPosix();
+	~NetSocketPollerPosix();
+};
+
+#endif // UNIX_ENABLED
+
 #endif
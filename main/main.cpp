@@ -396,6 +396,7 @@ Error Main::test_setup() {
 	GLOBAL_DEF("debug/settings/crash_handler/message",
 			String("Please include this when reporting the bug on https://github.com/godotengine/godot/issues"));
 	GLOBAL_DEF_RST("rendering/occlusion_culling/bvh_build_quality", 2);
+	GLOBAL_DEF_RST("rendering/occlusion_culling/use_software_rasterizer", false);
 
 	translation_server = memnew(TranslationServer);
 	tsman = memnew(TextServerManager);
@@ -2630,6 +2631,7 @@ bool Main::is_iterating() {
 // For performance metrics.
 static uint64_t physics_process_max = 0;
 static uint64_t process_max = 0;
+static uint64_t variant_allocations_last = 0;
 
 bool Main::iteration() {
 	//for now do not error on this
@@ -2769,6 +2771,9 @@ bool Main::iteration() {
 		Engine::get_singleton()->_fps = frames;
 		performance->set_process_time(USEC_TO_SEC(process_max));
 		performance->set_physics_process_time(USEC_TO_SEC(physics_process_max));
+		uint64_t variant_allocations = Variant::get_allocation_count();
+		performance->set_variant_allocations(double(variant_allocations - variant_allocations_last) / frames);
+		variant_allocations_last = variant_allocations;
 		process_max = 0;
 		physics_process_max = 0;
 
@@ -32,6 +32,7 @@
 
 #include "core/object/message_queue.h"
 #include "core/os/os.h"
+#include "scene/animation/animation_lod.h"
 #include "scene/main/node.h"
 #include "scene/main/scene_tree.h"
 #include "servers/audio_server.h"
@@ -73,6 +74,11 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(PHYSICS_3D_COLLISION_PAIRS);
 	BIND_ENUM_CONSTANT(PHYSICS_3D_ISLAND_COUNT);
 	BIND_ENUM_CONSTANT(AUDIO_OUTPUT_LATENCY);
+	BIND_ENUM_CONSTANT(ANIMATION_TRACKS_EVALUATED);
+	BIND_ENUM_CONSTANT(ANIMATION_BONES_UPDATED);
+	BIND_ENUM_CONSTANT(OBJECT_VARIANT_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_MESSAGE_QUEUE_MESSAGES);
+	BIND_ENUM_CONSTANT(MEMORY_MESSAGE_QUEUE_BYTES);
 
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 }
@@ -112,6 +118,11 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		"physics_3d/collision_pairs",
 		"physics_3d/islands",
 		"audio/driver/output_latency",
+		"animation/tracks_evaluated",
+		"animation/bones_updated",
+		"object/variant_allocations",
+		"memory/msg_queue_messages",
+		"memory/msg_queue_bytes",
 
 	};
 
@@ -166,6 +177,16 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return PhysicsServer3D::get_singleton()->get_process_info(PhysicsServer3D::INFO_ISLAND_COUNT);
 		case AUDIO_OUTPUT_LATENCY:
 			return AudioServer::get_singleton()->get_output_latency();
+		case ANIMATION_TRACKS_EVALUATED:
+			return AnimationLOD::get_tracks_evaluated();
+		case ANIMATION_BONES_UPDATED:
+			return AnimationLOD::get_bones_updated();
+		case OBJECT_VARIANT_ALLOCATIONS:
+			return _variant_allocations;
+		case MEMORY_MESSAGE_QUEUE_MESSAGES:
+			return MessageQueue::get_singleton()->get_last_frame_message_count();
+		case MEMORY_MESSAGE_QUEUE_BYTES:
+			return MessageQueue::get_singleton()->get_last_frame_bytes();
 
 		default: {
 		}
@@ -201,6 +222,11 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_TIME,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
 
 	};
 
@@ -215,6 +241,10 @@ void Performance::set_physics_process_time(double p_pt) {
 	_physics_process_time = p_pt;
 }
 
+void Performance::set_variant_allocations(double p_allocations) {
+	_variant_allocations = p_allocations;
+}
+
 void Performance::add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args) {
 	ERR_FAIL_COND_MSG(has_custom_monitor(p_id), "Custom monitor with id '" + String(p_id) + "' already exists.");
 	_monitor_map.insert(p_id, MonitorCall(p_callable, p_args));
@@ -261,6 +291,7 @@ uint64_t Performance::get_monitor_modification_time() {
 Performance::Performance() {
 	_process_time = 0;
 	_physics_process_time = 0;
+	_variant_allocations = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
 }
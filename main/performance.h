@@ -47,6 +47,7 @@ class Performance : public Object {
 
 	double _process_time;
 	double _physics_process_time;
+	double _variant_allocations;
 
 	class MonitorCall {
 		Callable _callable;
@@ -87,6 +88,11 @@ public:
 		PHYSICS_3D_ISLAND_COUNT,
 		//physics
 		AUDIO_OUTPUT_LATENCY,
+		ANIMATION_TRACKS_EVALUATED,
+		ANIMATION_BONES_UPDATED,
+		OBJECT_VARIANT_ALLOCATIONS,
+		MEMORY_MESSAGE_QUEUE_MESSAGES,
+		MEMORY_MESSAGE_QUEUE_BYTES,
 		MONITOR_MAX
 	};
 
@@ -103,6 +109,7 @@ public:
 
 	void set_process_time(double p_pt);
 	void set_physics_process_time(double p_pt);
+	void set_variant_allocations(double p_allocations);
 
 	void add_custom_monitor(const StringName &p_id, const Callable &p_callable, const Vector<Variant> &p_args);
 	void remove_custom_monitor(const StringName &p_id);
@@ -58,6 +58,9 @@ Error ENetMultiplayerPeer::create_server(int p_port, int p_max_clients, int p_ma
 	unique_id = 1;
 	connection_status = CONNECTION_CONNECTED;
 	hosts[0] = host;
+	if (network_thread_enabled) {
+		_start_network_thread();
+	}
 	return OK;
 }
 
@@ -89,6 +92,9 @@ Error ENetMultiplayerPeer::create_client(const String &p_address, int p_port, in
 	active_mode = MODE_CLIENT;
 	peers[1] = peer;
 	hosts[0] = host;
+	if (network_thread_enabled) {
+		_start_network_thread();
+	}
 
 	return OK;
 }
@@ -96,6 +102,7 @@ Error ENetMultiplayerPeer::create_client(const String &p_address, int p_port, in
 Error ENetMultiplayerPeer::create_mesh(int p_id) {
 	ERR_FAIL_COND_V_MSG(p_id <= 0, ERR_INVALID_PARAMETER, "The unique ID must be greater then 0");
 	ERR_FAIL_COND_V_MSG(_is_active(), ERR_ALREADY_IN_USE, "The multiplayer instance is already active.");
+	ERR_FAIL_COND_V_MSG(network_thread_enabled, ERR_UNAVAILABLE, "The network thread is not supported in mesh mode.");
 	active_mode = MODE_MESH;
 	unique_id = p_id;
 	connection_status = CONNECTION_CONNECTED;
@@ -130,7 +137,7 @@ bool ENetMultiplayerPeer::_parse_server_event(ENetConnection::EventType p_type,
 			p_event.peer->set_meta(SNAME("_net_id"), id);
 			peers[id] = p_event.peer;
 
-			emit_signal(SNAME("peer_connected"), id);
+			_emit_peer_signal(id, true);
 			if (server_relay) {
 				_notify_peers(id, true);
 			}
@@ -143,7 +150,7 @@ bool ENetMultiplayerPeer::_parse_server_event(ENetConnection::EventType p_type,
 				return false;
 			}
 
-			emit_signal(SNAME("peer_disconnected"), id);
+			_emit_peer_signal(id, false);
 			peers.erase(id);
 			if (server_relay) {
 				_notify_peers(id, false);
@@ -178,7 +185,7 @@ bool ENetMultiplayerPeer::_parse_server_event(ENetConnection::EventType p_type,
 				// Even if relaying is disabled, these targets are valid as incoming packets.
 				if (target == 1 || target == 0 || target < -1) {
 					packet.packet->referenceCount++;
-					incoming_packets.push_back(packet);
+					_queue_incoming(packet);
 				}
 
 				if (server_relay && target != 1) {
@@ -250,7 +257,7 @@ bool ENetMultiplayerPeer::_parse_client_event(ENetConnection::EventType p_type,
 				packet.channel = p_event.channel_id;
 
 				packet.packet->referenceCount++;
-				incoming_packets.push_back(packet);
+				_queue_incoming(packet);
 				// Destroy packet later
 			}
 			return false;
@@ -296,6 +303,11 @@ bool ENetMultiplayerPeer::_parse_mesh_event(ENetConnection::EventType p_type, EN
 void ENetMultiplayerPeer::poll() {
 	ERR_FAIL_COND_MSG(!_is_active(), "The multiplayer instance isn't currently active.");
 
+	if (network_thread.is_started()) {
+		_poll_network_thread();
+		return;
+	}
+
 	_pop_current_packet();
 
 	switch (active_mode) {
@@ -381,6 +393,7 @@ void ENetMultiplayerPeer::close_connection(uint32_t wait_usec) {
 		return;
 	}
 
+	_stop_network_thread();
 	_pop_current_packet();
 
 	bool peers_disconnected = false;
@@ -402,6 +415,20 @@ void ENetMultiplayerPeer::close_connection(uint32_t wait_usec) {
 	}
 
 	active_mode = MODE_NONE;
+	for (const ThreadEvent &E : thread_events) {
+		if (E.event.packet) {
+			_destroy_unused(E.event.packet);
+		}
+	}
+	thread_events.clear();
+	for (const Packet &E : thread_packets) {
+		incoming_packets.push_back(E);
+	}
+	thread_packets.clear();
+	for (Packet &E : incoming_packets) {
+		E.packet->referenceCount--;
+		_destroy_unused(E.packet);
+	}
 	incoming_packets.clear();
 	peers.clear();
 	hosts.clear();
@@ -417,11 +444,19 @@ int ENetMultiplayerPeer::get_available_packet_count() const {
 Error ENetMultiplayerPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 	ERR_FAIL_COND_V_MSG(incoming_packets.size() == 0, ERR_UNAVAILABLE, "No incoming packets available.");
 
+	MutexLock lock(enet_mutex);
 	_pop_current_packet();
 
 	current_packet = incoming_packets.front()->get();
 	incoming_packets.pop_front();
 
+	if (current_packet.usec) {
+		const uint64_t latency = OS::get_singleton()->get_ticks_usec() - current_packet.usec;
+		metrics_packets++;
+		metrics_latency_usec += latency;
+		metrics_max_latency_usec = MAX(metrics_max_latency_usec, latency);
+	}
+
 	*r_buffer = (const uint8_t *)(&current_packet.packet->data[8]);
 	r_buffer_size = current_packet.packet->dataLength - 8;
 
@@ -431,8 +466,17 @@ Error ENetMultiplayerPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_si
 Error ENetMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 	ERR_FAIL_COND_V_MSG(!_is_active(), ERR_UNCONFIGURED, "The multiplayer instance isn't currently active.");
 	ERR_FAIL_COND_V_MSG(connection_status != CONNECTION_CONNECTED, ERR_UNCONFIGURED, "The multiplayer instance isn't currently connected to any server or client.");
+
+	// The network thread adds and removes peers, only access them while holding the lock.
+	MutexLock lock(enet_mutex);
+
 	ERR_FAIL_COND_V_MSG(target_peer != 0 && !peers.has(ABS(target_peer)), ERR_INVALID_PARAMETER, vformat("Invalid target peer: %d", target_peer));
-	ERR_FAIL_COND_V(active_mode == MODE_CLIENT && !peers.has(1), ERR_BUG);
+	Ref<ENetPacketPeer> direct_peer; // Unless broadcasting.
+	if (active_mode == MODE_CLIENT || target_peer > 0) {
+		const Map<int, Ref<ENetPacketPeer>>::Element *E = peers.find(active_mode == MODE_CLIENT ? 1 : target_peer);
+		ERR_FAIL_COND_V(!E || E->get().is_null(), ERR_BUG);
+		direct_peer = E->get();
+	}
 
 	int packet_flags = 0;
 	int channel = SYSCH_RELIABLE;
@@ -482,13 +526,13 @@ Error ENetMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size
 			}
 			_destroy_unused(packet);
 		} else {
-			peers[target_peer]->send(channel, packet);
+			direct_peer->send(channel, packet);
 		}
 		ERR_FAIL_COND_V(!hosts.has(0), ERR_BUG);
 		hosts[0]->flush();
 
 	} else if (active_mode == MODE_CLIENT) {
-		peers[1]->send(channel, packet); // Send to server for broadcast.
+		direct_peer->send(channel, packet); // Send to server for broadcast.
 		ERR_FAIL_COND_V(!hosts.has(0), ERR_BUG);
 		hosts[0]->flush();
 
@@ -505,7 +549,7 @@ Error ENetMultiplayerPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size
 			}
 			_destroy_unused(packet);
 		} else {
-			peers[target_peer]->send(channel, packet);
+			direct_peer->send(channel, packet);
 			ERR_FAIL_COND_V(!hosts.has(target_peer), ERR_BUG);
 			hosts[target_peer]->flush();
 		}
@@ -539,6 +583,7 @@ int ENetMultiplayerPeer::get_unique_id() const {
 
 void ENetMultiplayerPeer::set_refuse_new_connections(bool p_enabled) {
 #ifdef GODOT_ENET
+	MutexLock lock(enet_mutex);
 	if (_is_active()) {
 		for (KeyValue<int, Ref<ENetConnection>> &E : hosts) {
 			E.value->refuse_new_connections(p_enabled);
@@ -558,6 +603,157 @@ bool ENetMultiplayerPeer::is_server_relay_enabled() const {
 	return server_relay;
 }
 
+void ENetMultiplayerPeer::set_network_thread_enabled(bool p_enabled) {
+	ERR_FAIL_COND_MSG(_is_active(), "The network thread can't be toggled while the multiplayer instance is active.");
+
+	network_thread_enabled = p_enabled;
+}
+
+bool ENetMultiplayerPeer::is_network_thread_enabled() const {
+	return network_thread_enabled;
+}
+
+Dictionary ENetMultiplayerPeer::pop_network_thread_metrics() {
+	MutexLock lock(enet_mutex);
+	Dictionary metrics;
+	metrics["queue_depth"] = thread_packets.size() + incoming_packets.size();
+	metrics["max_queue_depth"] = metrics_max_queue_depth;
+	metrics["packets"] = metrics_packets;
+	metrics["average_latency_usec"] = metrics_packets ? metrics_latency_usec / metrics_packets : 0;
+	metrics["max_latency_usec"] = metrics_max_latency_usec;
+	metrics_packets = 0;
+	metrics_latency_usec = 0;
+	metrics_max_latency_usec = 0;
+	metrics_max_queue_depth = 0;
+	return metrics;
+}
+
+void ENetMultiplayerPeer::_queue_incoming(const Packet &p_packet) {
+	if (_is_network_thread()) {
+		Packet packet = p_packet;
+		packet.usec = OS::get_singleton()->get_ticks_usec();
+		thread_packets.push_back(packet);
+	} else {
+		incoming_packets.push_back(p_packet);
+	}
+}
+
+void ENetMultiplayerPeer::_emit_peer_signal(int p_id, bool p_connected) {
+	if (_is_network_thread()) {
+		ThreadEvent event;
+		event.type = p_connected ? ENetConnection::EVENT_CONNECT : ENetConnection::EVENT_DISCONNECT;
+		event.peer_id = p_id;
+		thread_events.push_back(event);
+	} else if (p_connected) {
+		emit_signal(SNAME("peer_connected"), p_id);
+	} else {
+		emit_signal(SNAME("peer_disconnected"), p_id);
+	}
+}
+
+void ENetMultiplayerPeer::_network_thread_func(void *p_userdata) {
+	ENetMultiplayerPeer *peer = static_cast<ENetMultiplayerPeer *>(p_userdata);
+	while (!peer->network_thread_exit.is_set()) {
+		bool busy = false;
+		// Never block on the lock, the main thread may be holding it while waiting for us to exit.
+		if (peer->enet_mutex.try_lock() == OK) {
+			// Not taken from network_thread, the main thread may still be writing it in Thread::start().
+			peer->network_thread_id = Thread::get_caller_id();
+			busy = peer->_network_thread_service();
+			peer->enet_mutex.unlock();
+		}
+		if (!busy) {
+			OS::get_singleton()->delay_usec(NETWORK_THREAD_INTERVAL_USEC);
+		}
+	}
+}
+
+bool ENetMultiplayerPeer::_network_thread_service() {
+	ERR_FAIL_COND_V(!hosts.has(0), false);
+	Ref<ENetConnection> host = hosts[0];
+	ENetConnection::Event event;
+	ENetConnection::EventType ret = host->service(0, event);
+	if (ret == ENetConnection::EVENT_ERROR || ret == ENetConnection::EVENT_NONE) {
+		return false;
+	}
+	do {
+		if (active_mode == MODE_SERVER) {
+			if (_parse_server_event(ret, event)) {
+				break;
+			}
+		} else if (ret == ENetConnection::EVENT_RECEIVE && event.channel_id != SYSCH_CONFIG) {
+			_parse_client_event(ret, event);
+		} else {
+			// Connection changes close the client, leave them to the main thread.
+			ThreadEvent thread_event;
+			thread_event.type = ret;
+			thread_event.event = event;
+			thread_events.push_back(thread_event);
+			if (ret == ENetConnection::EVENT_DISCONNECT) {
+				break;
+			}
+		}
+	} while (host->check_events(ret, event) > 0);
+	return true;
+}
+
+void ENetMultiplayerPeer::_start_network_thread() {
+	network_thread_exit.clear();
+	network_thread.start(_network_thread_func, this);
+}
+
+void ENetMultiplayerPeer::_stop_network_thread() {
+	if (!network_thread.is_started()) {
+		return;
+	}
+	network_thread_exit.set();
+	network_thread.wait_to_finish();
+	network_thread_id = 0;
+}
+
+void ENetMultiplayerPeer::_poll_network_thread() {
+	MutexLock lock(enet_mutex);
+	_pop_current_packet();
+
+	if (active_mode == MODE_CLIENT && peers.has(1) && !peers[1]->is_active()) {
+		if (connection_status == CONNECTION_CONNECTED) {
+			emit_signal(SNAME("server_disconnected"));
+		} else {
+			emit_signal(SNAME("connection_failed"));
+		}
+		close_connection();
+		return;
+	}
+	if (active_mode == MODE_SERVER) {
+		for (const KeyValue<int, Ref<ENetPacketPeer>> &E : peers) {
+			if (!(E.value->is_active())) {
+				emit_signal(SNAME("peer_disconnected"), E.value->get_meta(SNAME("_net_id")));
+				peers.erase(E.key);
+			}
+		}
+	}
+
+	while (!thread_events.is_empty()) {
+		ThreadEvent event = thread_events.front()->get();
+		thread_events.pop_front();
+		if (event.peer_id) {
+			_emit_peer_signal(event.peer_id, event.type == ENetConnection::EVENT_CONNECT);
+		} else if (_parse_client_event(event.type, event.event)) {
+			return;
+		}
+		if (!_is_active()) {
+			return; // Closed by a signal callback.
+		}
+	}
+
+	// Received packets are only visible to the main thread after polling, like without the network thread.
+	metrics_max_queue_depth = MAX(metrics_max_queue_depth, thread_packets.size());
+	while (!thread_packets.is_empty()) {
+		incoming_packets.push_back(thread_packets.front()->get());
+		thread_packets.pop_front();
+	}
+}
+
 Ref<ENetConnection> ENetMultiplayerPeer::get_host() const {
 	ERR_FAIL_COND_V(!_is_active(), nullptr);
 	ERR_FAIL_COND_V(active_mode == MODE_MESH, nullptr);
@@ -566,9 +762,11 @@ Ref<ENetConnection> ENetMultiplayerPeer::get_host() const {
 
 Ref<ENetPacketPeer> ENetMultiplayerPeer::get_peer(int p_id) const {
 	ERR_FAIL_COND_V(!_is_active(), nullptr);
-	ERR_FAIL_COND_V(!peers.has(p_id), nullptr);
 	ERR_FAIL_COND_V(active_mode == MODE_CLIENT && p_id != 1, nullptr);
-	return peers[p_id];
+	MutexLock lock(enet_mutex);
+	const Map<int, Ref<ENetPacketPeer>>::Element *E = peers.find(p_id);
+	ERR_FAIL_COND_V(!E, nullptr);
+	return E->get();
 }
 
 void ENetMultiplayerPeer::_destroy_unused(ENetPacket *p_packet) {
@@ -599,8 +797,8 @@ void ENetMultiplayerPeer::_relay(int p_from, int p_to, enet_uint8 p_channel, ENe
 	} else {
 		// To someone else, specifically
 		ERR_FAIL_COND(!peers.has(p_to));
-		ENetPacket *packet = enet_packet_create(p_packet->data, p_packet->dataLength, p_packet->flags);
-		peers[p_to]->send(p_channel, packet);
+		// Packets are reference counted, no need to copy it.
+		peers[p_to]->send(p_channel, p_packet);
 	}
 }
 
@@ -651,10 +849,14 @@ void ENetMultiplayerPeer::_bind_methods() {
 
 	ClassDB::bind_method(D_METHOD("set_server_relay_enabled", "enabled"), &ENetMultiplayerPeer::set_server_relay_enabled);
 	ClassDB::bind_method(D_METHOD("is_server_relay_enabled"), &ENetMultiplayerPeer::is_server_relay_enabled);
+	ClassDB::bind_method(D_METHOD("set_network_thread_enabled", "enabled"), &ENetMultiplayerPeer::set_network_thread_enabled);
+	ClassDB::bind_method(D_METHOD("is_network_thread_enabled"), &ENetMultiplayerPeer::is_network_thread_enabled);
+	ClassDB::bind_method(D_METHOD("pop_network_thread_metrics"), &ENetMultiplayerPeer::pop_network_thread_metrics);
 	ClassDB::bind_method(D_METHOD("get_host"), &ENetMultiplayerPeer::get_host);
 	ClassDB::bind_method(D_METHOD("get_peer", "id"), &ENetMultiplayerPeer::get_peer);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "server_relay"), "set_server_relay_enabled", "is_server_relay_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "network_thread_enabled"), "set_network_thread_enabled", "is_network_thread_enabled");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "host", PROPERTY_HINT_RESOURCE_TYPE, "ENetConnection", PROPERTY_USAGE_NONE), "", "get_host");
 }
 
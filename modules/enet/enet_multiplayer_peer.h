@@ -33,6 +33,9 @@
 
 #include "core/crypto/crypto.h"
 #include "core/multiplayer/multiplayer_peer.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 
 #include "enet_connection.h"
 #include <enet/enet.h>
@@ -53,6 +56,10 @@ private:
 		SYSCH_MAX = 3
 	};
 
+	enum {
+		NETWORK_THREAD_INTERVAL_USEC = 1000, // How long the network thread sleeps when ENet has no events.
+	};
+
 	enum Mode {
 		MODE_NONE,
 		MODE_SERVER,
@@ -67,6 +74,7 @@ private:
 	int target_peer = 0;
 
 	bool server_relay = true;
+	bool network_thread_enabled = false;
 
 	ConnectionStatus connection_status = CONNECTION_DISCONNECTED;
 
@@ -77,10 +85,33 @@ private:
 		ENetPacket *packet = nullptr;
 		int from = 0;
 		int channel = 0;
+		uint64_t usec = 0; // When it was received by the network thread.
 	};
 
 	List<Packet> incoming_packets;
 
+	// When the network thread is running, it services ENet, relays packets and tracks
+	// server peers. The main thread only emits signals and handles the client events.
+	// Every ENet access is guarded by enet_mutex, which the network thread only tries
+	// to lock, so the main thread can stop it while holding the lock.
+	struct ThreadEvent {
+		ENetConnection::EventType type = ENetConnection::EVENT_NONE;
+		ENetConnection::Event event; // Client event to parse on the main thread.
+		int peer_id = 0; // Server peer whose connection changed, only the signal is left.
+	};
+
+	Thread network_thread;
+	Thread::ID network_thread_id = 0; // Set by the network thread itself while holding enet_mutex, 0 when not running.
+	SafeFlag network_thread_exit;
+	mutable Mutex enet_mutex;
+	List<ThreadEvent> thread_events;
+	List<Packet> thread_packets;
+
+	uint64_t metrics_packets = 0;
+	uint64_t metrics_latency_usec = 0;
+	uint64_t metrics_max_latency_usec = 0;
+	int metrics_max_queue_depth = 0;
+
 	Packet current_packet;
 
 	void _pop_current_packet();
@@ -90,7 +121,16 @@ private:
 	void _relay(int p_from, int p_to, enet_uint8 p_channel, ENetPacket *p_packet);
 	void _notify_peers(int p_id, bool p_connected);
 	void _destroy_unused(ENetPacket *p_packet);
+	void _queue_incoming(const Packet &p_packet);
+	void _emit_peer_signal(int p_id, bool p_connected);
 	_FORCE_INLINE_ bool _is_active() const { return active_mode != MODE_NONE; }
+	_FORCE_INLINE_ bool _is_network_thread() const { return network_thread_id != 0 && Thread::get_caller_id() == network_thread_id; }
+
+	static void _network_thread_func(void *p_userdata);
+	bool _network_thread_service();
+	void _start_network_thread();
+	void _stop_network_thread();
+	void _poll_network_thread();
 
 	IPAddress bind_ip;
 
@@ -127,6 +167,9 @@ public:
 	void set_bind_ip(const IPAddress &p_ip);
 	void set_server_relay_enabled(bool p_enabled);
 	bool is_server_relay_enabled() const;
+	void set_network_thread_enabled(bool p_enabled);
+	bool is_network_thread_enabled() const;
+	Dictionary pop_network_thread_metrics();
 
 	Ref<ENetConnection> get_host() const;
 	Ref<ENetPacketPeer> get_peer(int p_id) const;
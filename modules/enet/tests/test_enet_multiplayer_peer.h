@@ -0,0 +1,153 @@
+/*************************************************************************/
+/*  modules/enet/tests/test_enet_multiplayer_peer.h                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_ENET_MULTIPLAYER_PEER_H
+#define TEST_ENET_MULTIPLAYER_PEER_H
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "modules/enet/enet_multiplayer_peer.h"
+
+#include "tests/test_macros.h"
+
+namespace TestENetMultiplayerPeer {
+
+// Counts the peer signals, and whether they were all emitted on the main thread.
+class SignalHandler : public Object {
+public:
+	int connected = 0;
+	int disconnected = 0;
+	bool main_thread_only = true;
+
+	void on_peer_connected(int p_id) {
+		connected++;
+		main_thread_only = main_thread_only && Thread::get_caller_id() == Thread::get_main_id();
+	}
+
+	void on_peer_disconnected(int p_id) {
+		disconnected++;
+		main_thread_only = main_thread_only && Thread::get_caller_id() == Thread::get_main_id();
+	}
+
+	explicit SignalHandler(ENetMultiplayerPeer *p_peer) {
+		p_peer->connect("peer_connected", callable_mp(this, &SignalHandler::on_peer_connected));
+		p_peer->connect("peer_disconnected", callable_mp(this, &SignalHandler::on_peer_disconnected));
+	}
+};
+
+static int create_loopback_server(Ref<ENetMultiplayerPeer> &p_server) {
+	p_server->set_bind_ip(IPAddress("127.0.0.1"));
+	ERR_PRINT_OFF;
+	for (int port = 28360; port < 28460; port++) {
+		if (p_server->create_server(port) == OK) {
+			ERR_PRINT_ON;
+			return port;
+		}
+	}
+	ERR_PRINT_ON;
+	return -1;
+}
+
+TEST_CASE("[ENetMultiplayerPeer] Loopback with the network thread") {
+	const int message_count = 32;
+
+	Ref<ENetMultiplayerPeer> server;
+	server.instantiate();
+	server->set_network_thread_enabled(true);
+	SignalHandler server_handler(server.ptr());
+	const int port = create_loopback_server(server);
+	REQUIRE(port != -1);
+
+	Ref<ENetMultiplayerPeer> client;
+	client.instantiate();
+	client->set_network_thread_enabled(true);
+	SignalHandler client_handler(client.ptr());
+	REQUIRE(client->create_client("127.0.0.1", port) == OK);
+
+	for (int i = 0; i < 5000 && (server_handler.connected < 1 || client->get_connection_status() != MultiplayerPeer::CONNECTION_CONNECTED); i++) {
+		server->poll();
+		client->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	REQUIRE(server_handler.connected == 1);
+	REQUIRE(client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTED);
+	CHECK(client_handler.connected == 1); // The server.
+
+	client->set_target_peer(1);
+	for (int i = 0; i < message_count; i++) {
+		const CharString message = vformat("message %d", i).utf8();
+		CHECK(client->put_packet((const uint8_t *)message.get_data(), message.length()) == OK);
+	}
+
+	int received = 0;
+	bool in_order = true;
+	for (int i = 0; i < 5000 && received < message_count; i++) {
+		server->poll();
+		client->poll();
+		while (server->get_available_packet_count() > 0) {
+			CHECK(server->get_packet_peer() == client->get_unique_id());
+			const uint8_t *buffer = nullptr;
+			int size = 0;
+			REQUIRE(server->get_packet(&buffer, size) == OK);
+			in_order = in_order && String::utf8((const char *)buffer, size) == vformat("message %d", received);
+			received++;
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	CHECK(received == message_count);
+	CHECK_MESSAGE(in_order, "Reliable packets should be received in the order they were sent.");
+
+	Dictionary metrics = server->pop_network_thread_metrics();
+	CHECK(int(metrics["packets"]) == message_count);
+	CHECK(int(metrics["queue_depth"]) == 0);
+	CHECK(int(metrics["max_queue_depth"]) >= 1);
+	CHECK(uint64_t(metrics["max_latency_usec"]) >= uint64_t(metrics["average_latency_usec"]));
+
+	// Metrics are reset once popped.
+	metrics = server->pop_network_thread_metrics();
+	CHECK(int(metrics["packets"]) == 0);
+	CHECK(int(metrics["max_queue_depth"]) == 0);
+
+	client->close_connection();
+	for (int i = 0; i < 5000 && server_handler.disconnected < 1; i++) {
+		server->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	CHECK(server_handler.disconnected == 1);
+	CHECK_MESSAGE(server_handler.main_thread_only, "Peer signals should only be emitted on the main thread.");
+	CHECK_MESSAGE(client_handler.main_thread_only, "Peer signals should only be emitted on the main thread.");
+
+	server->close_connection();
+	CHECK(server->get_connection_status() == MultiplayerPeer::CONNECTION_DISCONNECTED);
+}
+
+} // namespace TestENetMultiplayerPeer
+
+#endif // TEST_ENET_MULTIPLAYER_PEER_H
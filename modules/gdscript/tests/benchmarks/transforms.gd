@@ -0,0 +1,42 @@
+# Transform-heavy code, every Transform3D/Basis/AABB/Transform2D value passed around is a Variant copy.
+# Run with `godot --test gdscript-benchmark modules/gdscript/tests/benchmarks/transforms.gd`.
+
+const ITERATIONS = 1000000
+
+
+static func benchmark_transform3d_chain():
+	var xform := Transform3D()
+	var step := Transform3D(Basis(Vector3.UP, 0.001), Vector3(0.1, 0.0, 0.0))
+	for i in ITERATIONS:
+		xform = xform * step
+	return xform
+
+
+static func benchmark_transform3d_array():
+	var xforms := []
+	xforms.resize(1000)
+	for i in ITERATIONS:
+		xforms[i % 1000] = Transform3D(Basis(), Vector3(i, 0, 0))
+	return xforms
+
+
+static func benchmark_basis_rotation():
+	var basis := Basis()
+	for i in ITERATIONS:
+		basis = basis.rotated(Vector3.RIGHT, 0.001)
+	return basis
+
+
+static func benchmark_aabb_merge():
+	var aabb := AABB()
+	for i in ITERATIONS:
+		aabb = aabb.merge(AABB(Vector3(i % 100, 0, 0), Vector3.ONE))
+	return aabb
+
+
+static func benchmark_transform2d_chain():
+	var xform := Transform2D()
+	var step := Transform2D(0.001, Vector2(0.1, 0.0))
+	for i in ITERATIONS:
+		xform = xform * step
+	return xform
@@ -191,6 +191,43 @@ static void test_compiler(const String &p_code, const String &p_script_path, con
 	}
 }
 
+// Runs every static function starting with "benchmark_" and reports its run time and Variant allocations.
+static void test_benchmark(const String &p_code, const String &p_script_path) {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_path(p_script_path);
+	script->set_source_code(p_code);
+
+	Error err = script->reload();
+	if (err != OK) {
+		print_line("Error compiling the benchmark script.");
+		return;
+	}
+
+	List<MethodInfo> methods;
+	script->get_script_method_list(&methods);
+	for (const MethodInfo &method : methods) {
+		if (!method.name.begins_with("benchmark_")) {
+			continue;
+		}
+
+		const uint64_t allocations_begin = Variant::get_allocation_count();
+		const uint64_t time_begin = OS::get_singleton()->get_ticks_usec();
+
+		Callable::CallError call_error;
+		static_cast<Object *>(script.ptr())->callp(method.name, nullptr, 0, call_error);
+
+		const uint64_t time = OS::get_singleton()->get_ticks_usec() - time_begin;
+		const uint64_t allocations = Variant::get_allocation_count() - allocations_begin;
+
+		if (call_error.error != Callable::CallError::CALL_OK) {
+			print_line(vformat("%s: failed, benchmark functions must be static and take no arguments.", method.name));
+			continue;
+		}
+		print_line(vformat("%s: %d usec, %d Variant allocations.", method.name, time, allocations));
+	}
+}
+
 void test(TestType p_type) {
 	List<String> cmdlargs = OS::get_singleton()->get_cmdline_args();
 
@@ -240,6 +277,10 @@ void test(TestType p_type) {
 			break;
 		case TEST_BYTECODE:
 			print_line("Not implemented.");
+			break;
+		case TEST_BENCHMARK:
+			test_benchmark(code, test);
+			break;
 	}
 
 	finish_language();
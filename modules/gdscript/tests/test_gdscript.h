@@ -41,6 +41,7 @@ enum TestType {
 	TEST_PARSER,
 	TEST_COMPILER,
 	TEST_BYTECODE,
+	TEST_BENCHMARK,
 };
 
 void test(TestType p_type);
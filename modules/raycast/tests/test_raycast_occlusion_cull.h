@@ -0,0 +1,202 @@
+/*************************************************************************/
+/*  test_raycast_occlusion_cull.h                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RAYCAST_OCCLUSION_CULL_H
+#define TEST_RAYCAST_OCCLUSION_CULL_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/thread_work_pool.h"
+#include "modules/raycast/raycast_occlusion_cull.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/servers/test_raster_occlusion_cull.h"
+#include "tests/test_macros.h"
+
+namespace TestRaycastOcclusionCull {
+
+// Scatters randomly sized and rotated boxes in front of the camera, like buildings in a city block.
+// The same seed produces the same scene in every backend.
+static void populate_scenario(RendererSceneOcclusionCull *p_cull, RID p_scenario, RID p_occluder, int p_count, uint64_t p_seed) {
+	RandomPCG rng(p_seed);
+	for (int i = 0; i < p_count; i++) {
+		Vector3 size(rng.random(1.0f, 8.0f), rng.random(2.0f, 20.0f), rng.random(1.0f, 8.0f));
+		Vector3 position(rng.random(-100.0f, 100.0f), rng.random(-5.0f, 0.0f), rng.random(-200.0f, -5.0f));
+		Basis basis = Basis(Vector3(0, 1, 0), rng.random(0.0f, float(Math_TAU))).scaled(size);
+		p_cull->scenario_set_instance(p_scenario, RID::from_uint64(1000 + i), p_occluder, Transform3D(basis, position), true);
+	}
+}
+
+// The raycast backend builds its Embree scene on a separate thread, so keep updating until a frame has used it.
+static bool update_until_ready(RendererSceneOcclusionCull *p_cull, RID p_buffer, const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, ThreadWorkPool &p_thread_pool) {
+	for (int i = 0; i < 5000; i++) {
+		p_cull->buffer_update(p_buffer, p_cam_transform, p_cam_projection, false, p_thread_pool);
+
+		const RendererSceneOcclusionCull::HZBuffer *buffer = p_cull->buffer_get_ptr(p_buffer);
+		const Size2i size = buffer->get_size();
+		const float *depth = buffer->get_depth();
+		for (int j = 0; j < size.x * size.y; j++) {
+			if (depth[j] < p_cam_projection.get_z_far()) {
+				return true;
+			}
+		}
+
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return false;
+}
+
+struct Backend {
+	RendererSceneOcclusionCull *cull = nullptr;
+	RID scenario = RID::from_uint64(1);
+	RID buffer = RID::from_uint64(2);
+	RID occluder;
+
+	void init(RendererSceneOcclusionCull *p_cull, const Size2i &p_size, int p_count) {
+		cull = p_cull;
+		cull->add_scenario(scenario);
+		cull->add_buffer(buffer);
+		cull->buffer_set_scenario(buffer, scenario);
+		cull->buffer_set_size(buffer, p_size);
+		occluder = TestRasterOcclusionCull::create_box_occluder(cull, AABB(Vector3(-0.5, 0, -0.5), Vector3(1, 1, 1)));
+		populate_scenario(cull, scenario, occluder, p_count, 1234);
+	}
+
+	void finish() {
+		cull->free_occluder(occluder);
+		cull->remove_buffer(buffer);
+		cull->remove_scenario(scenario);
+		memdelete(cull);
+	}
+};
+
+TEST_CASE("[RaycastOcclusionCull] Software rasterizer matches the raycast backend") {
+	ThreadWorkPool thread_pool;
+	thread_pool.init(4);
+
+	const Size2i size(128, 72);
+	const Transform3D cam_transform(Basis(), Vector3(0, 3, 0));
+	CameraMatrix cam_projection;
+	cam_projection.set_perspective(70, float(size.x) / size.y, 0.1, 300);
+
+	Backend raycast;
+	raycast.init(memnew(RaycastOcclusionCull), size, 400);
+	Backend raster;
+	raster.init(memnew(RasterOcclusionCull), size, 400);
+
+	REQUIRE_MESSAGE(update_until_ready(raycast.cull, raycast.buffer, cam_transform, cam_projection, thread_pool),
+			"The raycast backend should finish building its scene.");
+	raster.cull->buffer_update(raster.buffer, cam_transform, cam_projection, false, thread_pool);
+
+	// Both backends sample depth at pixel centers, so they should only disagree on pixels where an edge
+	// passes almost exactly through the center.
+	const float *raycast_depth = raycast.cull->buffer_get_ptr(raycast.buffer)->get_depth();
+	const float *raster_depth = raster.cull->buffer_get_ptr(raster.buffer)->get_depth();
+	int depth_mismatches = 0;
+	for (int i = 0; i < size.x * size.y; i++) {
+		if (Math::abs(raycast_depth[i] - raster_depth[i]) > 0.01f * raycast_depth[i]) {
+			depth_mismatches++;
+		}
+	}
+	CHECK_MESSAGE(depth_mismatches <= size.x * size.y / 100,
+			vformat("Depth should match on at least 99%% of the pixels (%d of %d differ).", depth_mismatches, size.x * size.y));
+
+	RandomPCG rng(5678);
+	const int box_count = 2000;
+	int occluded = 0;
+	int result_mismatches = 0;
+	for (int i = 0; i < box_count; i++) {
+		AABB box(Vector3(rng.random(-100.0f, 100.0f), rng.random(0.0f, 10.0f), rng.random(-250.0f, -5.0f)), Vector3(1, 1, 1) * rng.random(0.5f, 3.0f));
+		bool raycast_occluded = TestRasterOcclusionCull::is_box_occluded(raycast.cull, raycast.buffer, box, cam_transform, cam_projection);
+		bool raster_occluded = TestRasterOcclusionCull::is_box_occluded(raster.cull, raster.buffer, box, cam_transform, cam_projection);
+		occluded += raycast_occluded ? 1 : 0;
+		result_mismatches += raycast_occluded != raster_occluded ? 1 : 0;
+	}
+	CHECK_MESSAGE(occluded > 0, "The test scene should occlude some of the boxes.");
+	CHECK_MESSAGE(result_mismatches <= box_count / 100,
+			vformat("Occlusion results should match for at least 99%% of the boxes (%d of %d differ).", result_mismatches, box_count));
+
+	raster.finish();
+	raycast.finish();
+	thread_pool.finish();
+}
+
+// Compares the per-frame cost of both occlusion culling backends for a camera flying through a city of box occluders.
+// Run with `godot --test occlusion-cull-benchmark`.
+static void benchmark_occlusion_cull() {
+	ThreadWorkPool thread_pool;
+	thread_pool.init();
+
+	// Same buffer size as a 1920x1080 viewport with the default number of rays per thread, see RendererViewport.
+	const float aspect = 1920.0f / 1080.0f;
+	const float height = Math::sqrt(512.0f * thread_pool.get_thread_count() / aspect);
+	const Size2i size(height * aspect, height);
+	const int occluder_count = 5000;
+	const int frames = 300;
+
+	CameraMatrix cam_projection;
+	cam_projection.set_perspective(70, aspect, 0.1, 300);
+
+	print_line(vformat("Occlusion cull benchmark: %d box occluders, %dx%d buffer, %d threads, %d frames.", occluder_count, size.x, size.y, thread_pool.get_thread_count(), frames));
+
+	for (int pass = 0; pass < 2; pass++) {
+		const bool use_raster = pass == 1;
+
+		Backend backend;
+		if (use_raster) {
+			backend.init(memnew(RasterOcclusionCull), size, occluder_count);
+		} else {
+			backend.init(memnew(RaycastOcclusionCull), size, occluder_count);
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		ERR_FAIL_COND(!update_until_ready(backend.cull, backend.buffer, Transform3D(), cam_projection, thread_pool));
+		const uint64_t build_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < frames; i++) {
+			const Transform3D cam_transform(Basis(Vector3(0, 1, 0), Math::sin(i * 0.02f) * 0.5f), Vector3(0, 3, -float(i) * 0.5f));
+			backend.cull->buffer_update(backend.buffer, cam_transform, cam_projection, false, thread_pool);
+		}
+		const uint64_t frame_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("    %s: first frame %.3f msec, %.3f msec per frame", use_raster ? "software rasterizer" : "Embree raycast", double(build_usec) / 1000.0, double(frame_usec) / frames / 1000.0));
+
+		backend.finish();
+	}
+
+	thread_pool.finish();
+}
+
+REGISTER_TEST_COMMAND("occlusion-cull-benchmark", &benchmark_occlusion_cull);
+
+} // namespace TestRaycastOcclusionCull
+
+#endif // TEST_RAYCAST_OCCLUSION_CULL_H
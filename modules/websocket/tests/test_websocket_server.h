@@ -0,0 +1,324 @@
+/*************************************************************************/
+/*  test_websocket_server.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_WEBSOCKET_SERVER_H
+#define TEST_WEBSOCKET_SERVER_H
+
+#include "core/io/marshalls.h"
+#include "core/os/os.h"
+#include "core/templates/sort_array.h"
+#include "modules/websocket/websocket_client.h"
+#include "modules/websocket/websocket_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWebSocketServer {
+
+// Echoes every message back to its sender, and counts the server signals.
+class EchoHandler : public Object {
+public:
+	WebSocketServer *server = nullptr;
+	int connected = 0;
+	int disconnected = 0;
+	int received = 0;
+
+	void on_client_connected(int p_id, const String &p_protocol, const String &p_resource_name) {
+		connected++;
+	}
+
+	void on_client_disconnected(int p_id, bool p_was_clean) {
+		disconnected++;
+	}
+
+	void on_data_received(int p_id) {
+		Ref<WebSocketPeer> peer = server->get_peer(p_id);
+		const uint8_t *buffer = nullptr;
+		int size = 0;
+		if (peer->get_packet(&buffer, size) == OK) {
+			received++;
+			peer->put_packet(buffer, size);
+		}
+	}
+
+	explicit EchoHandler(WebSocketServer *p_server) {
+		server = p_server;
+		server->connect("client_connected", callable_mp(this, &EchoHandler::on_client_connected));
+		server->connect("client_disconnected", callable_mp(this, &EchoHandler::on_client_disconnected));
+		server->connect("data_received", callable_mp(this, &EchoHandler::on_data_received));
+	}
+};
+
+static int listen_loopback(Ref<WebSocketServer> &p_server) {
+	p_server->set_bind_ip(IPAddress("127.0.0.1"));
+	ERR_PRINT_OFF;
+	for (int port = 28160; port < 28260; port++) {
+		if (p_server->listen(port) == OK) {
+			ERR_PRINT_ON;
+			return port;
+		}
+	}
+	ERR_PRINT_ON;
+	return -1;
+}
+
+static void poll_all(Ref<WebSocketServer> &p_server, LocalVector<Ref<WebSocketClient>> &p_clients) {
+	p_server->poll();
+	for (uint32_t i = 0; i < p_clients.size(); i++) {
+		p_clients[i]->poll();
+	}
+}
+
+static bool all_connected(LocalVector<Ref<WebSocketClient>> &p_clients) {
+	for (uint32_t i = 0; i < p_clients.size(); i++) {
+		if (p_clients[i]->get_connection_status() != MultiplayerPeer::CONNECTION_CONNECTED) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[WebSocketServer] Echo with and without network threads") {
+	const int client_count = 4;
+	const int message_count = 16;
+
+	for (int threads = 0; threads <= 2; threads += 2) {
+		Ref<WebSocketServer> server = WebSocketServer::create_ref();
+		server->set_network_threads(threads);
+		EchoHandler handler(server.ptr());
+		const int port = listen_loopback(server);
+		REQUIRE(port != -1);
+
+		LocalVector<Ref<WebSocketClient>> clients;
+		for (int i = 0; i < client_count; i++) {
+			Ref<WebSocketClient> client = WebSocketClient::create_ref();
+			REQUIRE(client->connect_to_url(vformat("ws://127.0.0.1:%d", port)) == OK);
+			clients.push_back(client);
+		}
+		for (int i = 0; i < 5000 && (handler.connected < client_count || !all_connected(clients)); i++) {
+			poll_all(server, clients);
+			OS::get_singleton()->delay_usec(1000);
+		}
+		REQUIRE(handler.connected == client_count);
+		REQUIRE(all_connected(clients));
+
+		for (int i = 0; i < client_count; i++) {
+			for (int j = 0; j < message_count; j++) {
+				const CharString message = vformat("client %d message %d", i, j).utf8();
+				CHECK(clients[i]->get_peer(1)->put_packet((const uint8_t *)message.get_data(), message.length()) == OK);
+			}
+		}
+
+		// Echoes must come back complete and in order.
+		Vector<int> echoed;
+		echoed.resize(client_count);
+		echoed.fill(0);
+		bool in_order = true;
+		int total = 0;
+		for (int i = 0; i < 5000 && total < client_count * message_count; i++) {
+			poll_all(server, clients);
+			for (int c = 0; c < client_count; c++) {
+				Ref<WebSocketPeer> peer = clients[c]->get_peer(1);
+				while (peer->get_available_packet_count() > 0) {
+					const uint8_t *buffer = nullptr;
+					int size = 0;
+					peer->get_packet(&buffer, size);
+					in_order = in_order && String::utf8((const char *)buffer, size) == vformat("client %d message %d", c, echoed[c]);
+					echoed.write[c]++;
+					total++;
+				}
+			}
+			OS::get_singleton()->delay_usec(1000);
+		}
+		CHECK_MESSAGE(in_order, "Echoes should be received in the order they were sent.");
+		CHECK(total == client_count * message_count);
+		CHECK(handler.received == client_count * message_count);
+
+		clients[0]->disconnect_from_host();
+		for (int i = 0; i < 5000 && handler.disconnected < 1; i++) {
+			poll_all(server, clients);
+			OS::get_singleton()->delay_usec(1000);
+		}
+		CHECK(handler.disconnected == 1);
+		CHECK(server->get_network_threads() == threads);
+
+		server->stop();
+		CHECK_FALSE(server->is_listening());
+	}
+}
+
+// Closes the peer on the first message, optionally stopping the server from the callback.
+class CloseHandler : public Object {
+public:
+	WebSocketServer *server = nullptr;
+	bool stop_server = false;
+	int received = 0;
+
+	void on_data_received(int p_id) {
+		received++;
+		if (stop_server) {
+			server->stop();
+		} else {
+			server->get_peer(p_id)->close();
+		}
+	}
+
+	explicit CloseHandler(WebSocketServer *p_server) {
+		server = p_server;
+		server->connect("data_received", callable_mp(this, &CloseHandler::on_data_received));
+	}
+};
+
+TEST_CASE("[WebSocketServer] No packets are reported after closing from a signal callback") {
+	const int message_count = 64;
+
+	for (int stop_server = 0; stop_server <= 1; stop_server++) {
+		Ref<WebSocketServer> server = WebSocketServer::create_ref();
+		server->set_network_threads(1);
+		CloseHandler handler(server.ptr());
+		handler.stop_server = stop_server;
+		const int port = listen_loopback(server);
+		REQUIRE(port != -1);
+
+		LocalVector<Ref<WebSocketClient>> clients;
+		Ref<WebSocketClient> client = WebSocketClient::create_ref();
+		REQUIRE(client->connect_to_url(vformat("ws://127.0.0.1:%d", port)) == OK);
+		clients.push_back(client);
+		for (int i = 0; i < 5000 && !all_connected(clients); i++) {
+			poll_all(server, clients);
+			OS::get_singleton()->delay_usec(1000);
+		}
+		REQUIRE(all_connected(clients));
+
+		// Let the network thread receive everything before dispatching, so one event carries several packets.
+		for (int i = 0; i < message_count; i++) {
+			const CharString message = vformat("message %d", i).utf8();
+			CHECK(client->get_peer(1)->put_packet((const uint8_t *)message.get_data(), message.length()) == OK);
+		}
+		client->poll();
+		OS::get_singleton()->delay_usec(100000);
+
+		for (int i = 0; i < 100; i++) {
+			poll_all(server, clients);
+			OS::get_singleton()->delay_usec(1000);
+		}
+		CHECK_MESSAGE(handler.received == 1, "Packets dropped by closing should not be reported.");
+
+		server->stop();
+	}
+}
+
+// Measures the round trip of messages echoed by the server to many loopback clients, with each
+// number of network threads. The clients run on the main thread along with the server dispatch.
+// Run with `godot --test websocket-server-benchmark`.
+static void benchmark_websocket_server() {
+	const int client_count = 64;
+	const int messages_per_client = 200;
+	const int in_flight = 4; // Messages each client sends before waiting for their echo.
+	const int message_size = 64;
+	const int thread_counts[] = { 0, 1, 4 };
+
+	print_line(vformat("WebSocket server benchmark: %d clients, %d messages of %d bytes each, %d in flight.", client_count, messages_per_client, message_size, in_flight));
+
+	for (const int threads : thread_counts) {
+		Ref<WebSocketServer> server = WebSocketServer::create_ref();
+		server->set_network_threads(threads);
+		EchoHandler handler(server.ptr());
+		const int port = listen_loopback(server);
+		ERR_FAIL_COND(port == -1);
+
+		LocalVector<Ref<WebSocketClient>> clients;
+		for (int i = 0; i < client_count; i++) {
+			Ref<WebSocketClient> client = WebSocketClient::create_ref();
+			ERR_FAIL_COND(client->connect_to_url(vformat("ws://127.0.0.1:%d", port)) != OK);
+			clients.push_back(client);
+		}
+		for (int i = 0; i < 10000 && (handler.connected < client_count || !all_connected(clients)); i++) {
+			poll_all(server, clients);
+			OS::get_singleton()->delay_usec(100);
+		}
+		ERR_FAIL_COND(!all_connected(clients));
+
+		Vector<int> sent;
+		sent.resize(client_count);
+		sent.fill(0);
+		Vector<int> received;
+		received.resize(client_count);
+		received.fill(0);
+		LocalVector<uint64_t> latencies;
+		latencies.reserve(client_count * messages_per_client);
+		uint8_t message[message_size] = {};
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		const uint64_t timeout = begin + 60 * 1000000;
+		while (int(latencies.size()) < client_count * messages_per_client && OS::get_singleton()->get_ticks_usec() < timeout) {
+			for (int c = 0; c < client_count; c++) {
+				Ref<WebSocketPeer> peer = clients[c]->get_peer(1);
+				while (sent[c] < messages_per_client && sent[c] - received[c] < in_flight) {
+					encode_uint64(OS::get_singleton()->get_ticks_usec(), message);
+					peer->put_packet(message, message_size);
+					sent.write[c]++;
+				}
+			}
+			poll_all(server, clients);
+			const uint64_t now = OS::get_singleton()->get_ticks_usec();
+			for (int c = 0; c < client_count; c++) {
+				Ref<WebSocketPeer> peer = clients[c]->get_peer(1);
+				while (peer->get_available_packet_count() > 0) {
+					const uint8_t *buffer = nullptr;
+					int size = 0;
+					if (peer->get_packet(&buffer, size) == OK && size == message_size) {
+						latencies.push_back(now - decode_uint64(buffer));
+						received.write[c]++;
+					}
+				}
+			}
+		}
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+
+		server->stop();
+		for (int i = 0; i < client_count; i++) {
+			clients[i]->disconnect_from_host();
+		}
+
+		ERR_FAIL_COND_MSG(latencies.is_empty(), "No message was echoed.");
+		SortArray<uint64_t> sorter;
+		sorter.sort(latencies.ptr(), latencies.size());
+		const uint32_t count = latencies.size();
+		const String rate = vformat("%d messages/sec%s", int(double(count) * 1000000.0 / elapsed), int(count) < client_count * messages_per_client ? " (timed out)" : "");
+		print_line(vformat("    %d network threads: %s, latency p50 %.3f msec, p90 %.3f msec, p99 %.3f msec", threads, rate,
+				latencies[count / 2] / 1000.0, latencies[count * 9 / 10] / 1000.0, latencies[count * 99 / 100] / 1000.0));
+	}
+}
+
+REGISTER_TEST_COMMAND("websocket-server-benchmark", &benchmark_websocket_server);
+
+} // namespace TestWebSocketServer
+
+#endif // TEST_WEBSOCKET_SERVER_H
@@ -70,6 +70,10 @@ void WebSocketServer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_handshake_timeout", "timeout"), &WebSocketServer::set_handshake_timeout);
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "handshake_timeout"), "set_handshake_timeout", "get_handshake_timeout");
 
+	ClassDB::bind_method(D_METHOD("get_network_threads"), &WebSocketServer::get_network_threads);
+	ClassDB::bind_method(D_METHOD("set_network_threads", "threads"), &WebSocketServer::set_network_threads);
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "network_threads", PROPERTY_HINT_RANGE, "0,64,1"), "set_network_threads", "get_network_threads");
+
 	ADD_SIGNAL(MethodInfo("client_close_request", PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::INT, "code"), PropertyInfo(Variant::STRING, "reason")));
 	ADD_SIGNAL(MethodInfo("client_disconnected", PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::BOOL, "was_clean_close")));
 	ADD_SIGNAL(MethodInfo("client_connected", PropertyInfo(Variant::INT, "id"), PropertyInfo(Variant::STRING, "protocol"), PropertyInfo(Variant::STRING, "resource_name")));
@@ -122,6 +126,16 @@ void WebSocketServer::set_handshake_timeout(float p_timeout) {
 	handshake_timeout = p_timeout * 1000;
 }
 
+int WebSocketServer::get_network_threads() const {
+	return network_threads;
+}
+
+void WebSocketServer::set_network_threads(int p_threads) {
+	ERR_FAIL_COND(is_listening());
+	ERR_FAIL_COND(p_threads < 0);
+	network_threads = p_threads;
+}
+
 MultiplayerPeer::ConnectionStatus WebSocketServer::get_connection_status() const {
 	if (is_listening()) {
 		return CONNECTION_CONNECTED;
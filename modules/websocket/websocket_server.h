@@ -49,6 +49,7 @@ protected:
 	Ref<X509Certificate> ssl_cert;
 	Ref<X509Certificate> ca_chain;
 	uint32_t handshake_timeout = 3000;
+	int network_threads = 0;
 
 public:
 	virtual void set_extra_headers(const Vector<String> &p_headers) = 0;
@@ -83,6 +84,9 @@ public:
 	float get_handshake_timeout() const;
 	void set_handshake_timeout(float p_timeout);
 
+	int get_network_threads() const;
+	void set_network_threads(int p_threads);
+
 	WebSocketServer();
 	~WebSocketServer();
 };
@@ -148,8 +148,8 @@ void wsl_msg_recv_callback(wslay_event_context_ptr ctx, const struct wslay_event
 	}
 	WSLPeer *peer = static_cast<WSLPeer *>(peer_data->peer);
 
-	if (peer->parse_message(arg) != OK) {
-		return;
+	if (peer->parse_message(arg) != OK || peer->threaded) {
+		return; // Threaded peers queue their packet events for the main thread.
 	}
 
 	if (peer_data->is_server) {
@@ -183,7 +183,9 @@ Error WSLPeer::parse_message(const wslay_event_on_msg_recv_arg *arg) {
 			close_reason.parse_utf8((char *)arg->msg + 2, len - 2);
 		}
 		if (!wslay_event_get_close_sent(_data->ctx)) {
-			if (_data->is_server) {
+			if (threaded) {
+				_threaded_events.close_request = true;
+			} else if (_data->is_server) {
 				WSLServer *helper = static_cast<WSLServer *>(_data->obj);
 				helper->_on_close_request(_data->id, close_code, close_reason);
 			} else {
@@ -196,8 +198,12 @@ Error WSLPeer::parse_message(const wslay_event_on_msg_recv_arg *arg) {
 		// Ping or pong
 		return ERR_SKIP;
 	}
-	_in_buffer.write_packet(arg->msg, arg->msg_length, &is_string);
-	return OK;
+	// Don't report dropped packets.
+	Error err = _in_buffer.write_packet(arg->msg, arg->msg_length, &is_string);
+	if (err == OK && threaded) {
+		_threaded_events.packets++;
+	}
+	return err;
 }
 
 void WSLPeer::make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size) {
@@ -229,7 +235,17 @@ WSLPeer::WriteMode WSLPeer::get_write_mode() const {
 	return write_mode;
 }
 
+bool WSLPeer::has_pending_io() const {
+	MutexLock lock(_mutex);
+	if (!_data) {
+		return false;
+	}
+	// SSL can hold decrypted data the socket readiness doesn't tell about.
+	return _data->conn != _data->tcp || wslay_event_want_write(_data->ctx);
+}
+
 void WSLPeer::poll() {
+	MutexLock lock(_mutex);
 	if (!_data) {
 		return;
 	}
@@ -239,7 +255,18 @@ void WSLPeer::poll() {
 	}
 }
 
+void WSLPeer::poll_threaded(ThreadedEvents &r_events) {
+	MutexLock lock(_mutex);
+	poll();
+	r_events = _threaded_events;
+	r_events.connected = _data != nullptr;
+	r_events.close_code = close_code;
+	r_events.close_reason = close_reason;
+	_threaded_events = ThreadedEvents();
+}
+
 Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
+	MutexLock lock(_mutex);
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
 	ERR_FAIL_COND_V(_out_pkt_size && (wslay_event_get_queued_msg_count(_data->ctx) >= (1ULL << _out_pkt_size)), ERR_OUT_OF_MEMORY);
 	ERR_FAIL_COND_V(_out_buf_size && (wslay_event_get_queued_msg_length(_data->ctx) + p_buffer_size >= (1ULL << _out_buf_size)), ERR_OUT_OF_MEMORY);
@@ -249,8 +276,8 @@ Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 	msg.msg = p_buffer;
 	msg.msg_length = p_buffer_size;
 
-	// Queue & send message.
-	if (wslay_event_queue_msg(_data->ctx, &msg) != 0 || wslay_event_send(_data->ctx) != 0) {
+	// Queue & send message, the network thread sends it when threaded.
+	if (wslay_event_queue_msg(_data->ctx, &msg) != 0 || (!threaded && wslay_event_send(_data->ctx) != 0)) {
 		close_now();
 		return FAILED;
 	}
@@ -258,6 +285,7 @@ Error WSLPeer::put_packet(const uint8_t *p_buffer, int p_buffer_size) {
 }
 
 Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
+	MutexLock lock(_mutex);
 	r_buffer_size = 0;
 
 	ERR_FAIL_COND_V(!is_connected_to_host(), FAILED);
@@ -277,6 +305,7 @@ Error WSLPeer::get_packet(const uint8_t **r_buffer, int &r_buffer_size) {
 }
 
 int WSLPeer::get_available_packet_count() const {
+	MutexLock lock(_mutex);
 	if (!is_connected_to_host()) {
 		return 0;
 	}
@@ -285,6 +314,7 @@ int WSLPeer::get_available_packet_count() const {
 }
 
 int WSLPeer::get_current_outbound_buffered_amount() const {
+	MutexLock lock(_mutex);
 	ERR_FAIL_COND_V(!_data, 0);
 
 	return wslay_event_get_queued_msg_length(_data->ctx);
@@ -295,15 +325,23 @@ bool WSLPeer::was_string_packet() const {
 }
 
 bool WSLPeer::is_connected_to_host() const {
+	MutexLock lock(_mutex);
 	return _data != nullptr;
 }
 
+bool WSLPeer::is_closing() const {
+	MutexLock lock(_mutex);
+	return _data && _data->closing;
+}
+
 void WSLPeer::close_now() {
+	MutexLock lock(_mutex);
 	close(1000, "");
 	_wsl_destroy(&_data);
 }
 
 void WSLPeer::close(int p_code, String p_reason) {
+	MutexLock lock(_mutex);
 	if (_data && !wslay_event_get_close_sent(_data->ctx)) {
 		CharString cs = p_reason.utf8();
 		wslay_event_queue_close(_data->ctx, p_code, (uint8_t *)cs.ptr(), cs.size());
@@ -316,23 +354,27 @@ void WSLPeer::close(int p_code, String p_reason) {
 }
 
 IPAddress WSLPeer::get_connected_host() const {
+	MutexLock lock(_mutex);
 	ERR_FAIL_COND_V(!is_connected_to_host() || _data->tcp.is_null(), IPAddress());
 
 	return _data->tcp->get_connected_host();
 }
 
 uint16_t WSLPeer::get_connected_port() const {
+	MutexLock lock(_mutex);
 	ERR_FAIL_COND_V(!is_connected_to_host() || _data->tcp.is_null(), 0);
 
 	return _data->tcp->get_connected_port();
 }
 
 void WSLPeer::set_no_delay(bool p_enabled) {
+	MutexLock lock(_mutex);
 	ERR_FAIL_COND(!is_connected_to_host() || _data->tcp.is_null());
 	_data->tcp->set_no_delay(p_enabled);
 }
 
 void WSLPeer::invalidate() {
+	MutexLock lock(_mutex);
 	if (_data) {
 		_data->valid = false;
 	}
@@ -36,6 +36,7 @@
 #include "core/error/error_list.h"
 #include "core/io/packet_peer.h"
 #include "core/io/stream_peer_tcp.h"
+#include "core/os/mutex.h"
 #include "core/templates/ring_buffer.h"
 #include "packet_buffer.h"
 #include "websocket_peer.h"
@@ -61,6 +62,15 @@ public:
 		wslay_event_context_ptr ctx = nullptr;
 	};
 
+	// Events of a peer polled by a server network thread, to be handed to the main thread.
+	struct ThreadedEvents {
+		int packets = 0;
+		bool close_request = false;
+		int close_code = -1;
+		String close_reason;
+		bool connected = true;
+	};
+
 	static String compute_key_response(String p_key);
 	static String generate_key();
 
@@ -69,6 +79,9 @@ private:
 	static void _wsl_destroy(struct PeerData **p_data);
 
 	struct PeerData *_data = nullptr;
+	// Guards the wslay context and the buffers, the peer may be polled by a server network thread.
+	mutable Mutex _mutex;
+	ThreadedEvents _threaded_events;
 	uint8_t _is_string = 0;
 	// Our packet info is just a boolean (is_string), using uint8_t for it.
 	PacketBuffer<uint8_t> _in_buffer;
@@ -83,7 +96,10 @@ private:
 public:
 	int close_code = -1;
 	String close_reason;
+	// When polled by a network thread, sends are left to it and events are queued instead of emitted.
+	bool threaded = false;
 	void poll(); // Used by client and server.
+	void poll_threaded(ThreadedEvents &r_events);
 
 	virtual int get_available_packet_count() const override;
 	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override;
@@ -102,6 +118,8 @@ public:
 	virtual bool was_string_packet() const override;
 	virtual void set_no_delay(bool p_enabled) override;
 
+	bool has_pending_io() const;
+	bool is_closing() const;
 	void make_context(PeerData *p_data, unsigned int p_in_buf_size, unsigned int p_in_pkt_size, unsigned int p_out_buf_size, unsigned int p_out_pkt_size);
 	Error parse_message(const wslay_event_on_msg_recv_arg *arg);
 	void invalidate();
@@ -184,15 +184,290 @@ Error WSLServer::listen(int p_port, const Vector<String> p_protocols, bool gd_mp
 	for (int i = 0; i < p_protocols.size(); i++) {
 		pw[i] = p_protocols[i].strip_edges();
 	}
-	return _server->listen(p_port, bind_ip);
+	Error err = _server->listen(p_port, bind_ip);
+	if (err != OK) {
+		return err;
+	}
+	if (network_threads > 0) {
+		_start_threads();
+		return OK;
+	}
+	// Wait on all the connections at once when the platform supports it, instead of polling each one.
+	_poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+	if (_poller.is_valid() && _poller->add_socket(_server->get_socket(), POLLER_SERVER_ID, NetSocket::POLL_TYPE_IN) != OK) {
+		_poller.unref();
+	}
+	return OK;
+}
+
+Ref<WSLServer::PendingPeer> WSLServer::_create_pending_peer(Ref<StreamPeerTCP> p_conn) {
+	Ref<PendingPeer> peer = memnew(PendingPeer);
+	if (private_key.is_valid() && ssl_cert.is_valid()) {
+		Ref<StreamPeerSSL> ssl = Ref<StreamPeerSSL>(StreamPeerSSL::create());
+		ssl->set_blocking_handshake_enabled(false);
+		ssl->accept_stream(p_conn, private_key, ssl_cert, ca_chain);
+		peer->connection = ssl;
+		peer->use_ssl = true;
+	} else {
+		peer->connection = p_conn;
+	}
+	peer->tcp = p_conn;
+	peer->time = OS::get_singleton()->get_ticks_msec();
+	return peer;
+}
+
+void WSLServer::_start_threads() {
+	_threads_exit.clear();
+	for (int i = 0; i < network_threads; i++) {
+		NetworkThread *thread = memnew(NetworkThread);
+		thread->server = this;
+		thread->poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+		thread->protocols = _protocols;
+		thread->extra_headers = _extra_headers;
+		thread->handshake_timeout = handshake_timeout;
+		thread->events = memnew(LocalVector<ThreadEvent>);
+		thread->thread.start(_network_thread_func, thread);
+		_threads.push_back(thread);
+	}
+}
+
+void WSLServer::_stop_threads() {
+	if (_threads.is_empty()) {
+		return;
+	}
+	_threads_exit.set();
+	for (uint32_t i = 0; i < _threads.size(); i++) {
+		_threads[i]->thread.wait_to_finish();
+	}
+	for (uint32_t i = 0; i < _threads.size(); i++) {
+		NetworkThread *thread = _threads[i];
+		// Also closes the peers whose connection was not dispatched yet.
+		for (KeyValue<int, Ref<WSLPeer>> &E : thread->peers) {
+			E.value->close_now();
+		}
+		memdelete(thread->events);
+		memdelete(thread);
+	}
+	_threads.clear();
+	_thread_events->clear();
+}
+
+void WSLServer::_network_thread_func(void *p_userdata) {
+	NetworkThread *thread = static_cast<NetworkThread *>(p_userdata);
+	while (!thread->server->_threads_exit.is_set()) {
+		thread->server->_network_thread_service(*thread);
+	}
+}
+
+void WSLServer::_network_thread_service(NetworkThread &p_thread) {
+	{
+		MutexLock lock(p_thread.mutex);
+		for (const Ref<PendingPeer> &E : p_thread.incoming) {
+			p_thread.pending.push_back(E);
+		}
+		p_thread.incoming.clear();
+	}
+
+	List<Ref<PendingPeer>>::Element *E = p_thread.pending.front();
+	while (E) {
+		List<Ref<PendingPeer>>::Element *N = E->next();
+		Ref<PendingPeer> ppeer = E->get();
+		String resource_name;
+		Error err = ppeer->do_handshake(p_thread.protocols, p_thread.handshake_timeout, resource_name, p_thread.extra_headers);
+		if (err == ERR_BUSY) {
+			E = N;
+			continue;
+		}
+		E->erase();
+		E = N;
+		if (err != OK) {
+			p_thread.load.decrement();
+			continue;
+		}
+
+		WSLPeer::PeerData *data = memnew(struct WSLPeer::PeerData);
+		data->obj = this;
+		data->conn = ppeer->connection;
+		data->tcp = ppeer->tcp;
+		data->is_server = true;
+		data->id = ppeer->id;
+
+		Ref<WSLPeer> ws_peer = memnew(WSLPeer);
+		ws_peer->threaded = true;
+		ws_peer->make_context(data, _in_buf_size, _in_pkt_size, _out_buf_size, _out_pkt_size);
+		ws_peer->set_no_delay(true);
+
+		p_thread.peers[ppeer->id] = ws_peer;
+		if (p_thread.poller.is_valid()) {
+			p_thread.poller->add_socket(ppeer->tcp->get_socket(), ppeer->id, NetSocket::POLL_TYPE_IN);
+		}
+		ThreadEvent event;
+		event.type = ThreadEvent::EVENT_CONNECT;
+		event.id = ppeer->id;
+		event.peer = ws_peer;
+		event.protocol = ppeer->protocol;
+		event.text = resource_name;
+		p_thread.local_events.push_back(event);
+	}
+
+	// Sleep until a socket is ready. Messages put by the main thread wait for the next wake up.
+	bool poll_all = true;
+	if (p_thread.poller.is_valid()) {
+		p_thread.poll_ready.clear();
+		Error err = p_thread.poller->wait(p_thread.poll_events, NETWORK_THREAD_WAIT_MSEC);
+		poll_all = err == FAILED;
+		for (uint32_t i = 0; i < p_thread.poll_events.size(); i++) {
+			p_thread.poll_ready.insert(int(p_thread.poll_events[i].id));
+		}
+	} else {
+		OS::get_singleton()->delay_usec(NETWORK_THREAD_WAIT_MSEC * 1000);
+	}
+
+	List<int> remove_ids;
+	for (KeyValue<int, Ref<WSLPeer>> &P : p_thread.peers) {
+		Ref<WSLPeer> &peer = P.value;
+		const bool ready = poll_all || p_thread.poll_ready.has(P.key) || peer->has_pending_io() || !p_thread.poller->has_socket(P.key);
+		if (!ready && peer->is_connected_to_host()) {
+			continue; // Idle, and not closed by the main thread.
+		}
+		WSLPeer::ThreadedEvents peer_events;
+		peer->poll_threaded(peer_events);
+		ThreadEvent event;
+		event.id = P.key;
+		if (peer_events.packets) {
+			event.type = ThreadEvent::EVENT_PACKETS;
+			event.value = peer_events.packets;
+			p_thread.local_events.push_back(event);
+		}
+		if (peer_events.close_request) {
+			event.type = ThreadEvent::EVENT_CLOSE_REQUEST;
+			event.value = peer_events.close_code;
+			event.text = peer_events.close_reason;
+			p_thread.local_events.push_back(event);
+		}
+		if (!peer_events.connected) {
+			if (p_thread.poller.is_valid()) {
+				p_thread.poller->remove_socket(P.key);
+			}
+			event.type = ThreadEvent::EVENT_DISCONNECT;
+			event.value = peer_events.close_code != -1;
+			event.text = String();
+			p_thread.local_events.push_back(event);
+			remove_ids.push_back(P.key);
+			p_thread.load.decrement();
+		}
+	}
+	for (const int &id : remove_ids) {
+		p_thread.peers.erase(id);
+	}
+
+	if (!p_thread.local_events.is_empty()) {
+		MutexLock lock(p_thread.mutex);
+		for (uint32_t i = 0; i < p_thread.local_events.size(); i++) {
+			p_thread.events->push_back(p_thread.local_events[i]);
+		}
+		p_thread.local_events.clear();
+	}
+}
+
+void WSLServer::_poll_threads() {
+	// Hand the new connections to the least busy thread, which also does their handshake.
+	while (_server->is_listening() && _server->is_connection_available()) {
+		Ref<StreamPeerTCP> conn = _server->take_connection();
+		if (is_refusing_new_connections()) {
+			continue; // Conn will go out-of-scope and be closed.
+		}
+		Ref<PendingPeer> ppeer = _create_pending_peer(conn);
+		ppeer->id = generate_unique_id();
+		NetworkThread *target = _threads[0];
+		for (uint32_t i = 1; i < _threads.size(); i++) {
+			if (_threads[i]->load.get() < target->load.get()) {
+				target = _threads[i];
+			}
+		}
+		target->load.increment();
+		MutexLock lock(target->mutex);
+		target->incoming.push_back(ppeer);
+	}
+
+	for (uint32_t i = 0; i < _threads.size(); i++) {
+		// Take the whole batch at once, the signals below may stop the server.
+		{
+			NetworkThread *thread = _threads[i];
+			MutexLock lock(thread->mutex);
+			SWAP(thread->events, _thread_events);
+		}
+		for (uint32_t j = 0; j < _thread_events->size() && is_listening(); j++) {
+			// Copied, stop() clears the events when called from a signal callback.
+			const ThreadEvent event = (*_thread_events)[j];
+			switch (event.type) {
+				case ThreadEvent::EVENT_CONNECT: {
+					_peer_map[event.id] = event.peer;
+					_on_connect(event.id, event.protocol, event.text);
+				} break;
+				case ThreadEvent::EVENT_PACKETS: {
+					for (int k = 0; k < event.value; k++) {
+						// Closing the peer drops the packets it received, the remaining count is stale.
+						Map<int, Ref<WebSocketPeer>>::Element *E = _peer_map.find(event.id);
+						if (!E) {
+							break;
+						}
+						const WSLPeer *peer = static_cast<const WSLPeer *>(E->get().ptr());
+						if (peer->is_closing() || !peer->is_connected_to_host()) {
+							break;
+						}
+						_on_peer_packet(event.id);
+					}
+				} break;
+				case ThreadEvent::EVENT_CLOSE_REQUEST: {
+					if (_peer_map.has(event.id)) {
+						_on_close_request(event.id, event.value, event.text);
+					}
+				} break;
+				case ThreadEvent::EVENT_DISCONNECT: {
+					if (_peer_map.erase(event.id)) {
+						_on_disconnect(event.id, event.value);
+					}
+				} break;
+			}
+		}
+		_thread_events->clear();
+	}
 }
 
 void WSLServer::poll() {
+	if (!_threads.is_empty()) {
+		_poll_threads();
+		return;
+	}
+
+	bool poll_all = true;
+	bool server_ready = true;
+	if (_poller.is_valid()) {
+		_poll_ready.clear();
+		Error err = _poller->wait(_poll_events, 0);
+		poll_all = err == FAILED;
+		server_ready = poll_all;
+		for (uint32_t i = 0; i < _poll_events.size(); i++) {
+			if (_poll_events[i].id == POLLER_SERVER_ID) {
+				server_ready = true;
+			} else {
+				_poll_ready.insert(int(_poll_events[i].id));
+			}
+		}
+	}
+
 	List<int> remove_ids;
 	for (const KeyValue<int, Ref<WebSocketPeer>> &E : _peer_map) {
 		Ref<WSLPeer> peer = const_cast<WSLPeer *>(static_cast<const WSLPeer *>(E.value.ptr()));
-		peer->poll();
+		// Idle peers are skipped, they have nothing to read nor to write.
+		if (poll_all || _poll_ready.has(E.key) || peer->has_pending_io() || !_poller->has_socket(E.key)) {
+			peer->poll();
+		}
 		if (!peer->is_connected_to_host()) {
+			if (_poller.is_valid()) {
+				_poller->remove_socket(E.key);
+			}
 			_on_disconnect(E.key, peer->close_code != -1);
 			remove_ids.push_back(E.key);
 		}
@@ -228,6 +503,9 @@ void WSLServer::poll() {
 		ws_peer->set_no_delay(true);
 
 		_peer_map[id] = ws_peer;
+		if (_poller.is_valid()) {
+			_poller->add_socket(ppeer->tcp->get_socket(), id, NetSocket::POLL_TYPE_IN);
+		}
 		remove_peers.push_back(ppeer);
 		_on_connect(id, ppeer->protocol, resource_name);
 	}
@@ -236,7 +514,7 @@ void WSLServer::poll() {
 	}
 	remove_peers.clear();
 
-	if (!_server->is_listening()) {
+	if (!_server->is_listening() || !server_ready) {
 		return;
 	}
 
@@ -245,20 +523,7 @@ void WSLServer::poll() {
 		if (is_refusing_new_connections()) {
 			continue; // Conn will go out-of-scope and be closed.
 		}
-
-		Ref<PendingPeer> peer = memnew(PendingPeer);
-		if (private_key.is_valid() && ssl_cert.is_valid()) {
-			Ref<StreamPeerSSL> ssl = Ref<StreamPeerSSL>(StreamPeerSSL::create());
-			ssl->set_blocking_handshake_enabled(false);
-			ssl->accept_stream(conn, private_key, ssl_cert, ca_chain);
-			peer->connection = ssl;
-			peer->use_ssl = true;
-		} else {
-			peer->connection = conn;
-		}
-		peer->tcp = conn;
-		peer->time = OS::get_singleton()->get_ticks_msec();
-		_pending.push_back(peer);
+		_pending.push_back(_create_pending_peer(conn));
 	}
 }
 
@@ -272,6 +537,7 @@ int WSLServer::get_max_packet_size() const {
 
 void WSLServer::stop() {
 	_server->stop();
+	_stop_threads();
 	for (const KeyValue<int, Ref<WebSocketPeer>> &E : _peer_map) {
 		Ref<WSLPeer> peer = const_cast<WSLPeer *>(static_cast<const WSLPeer *>(E.value.ptr()));
 		peer->close_now();
@@ -279,6 +545,7 @@ void WSLServer::stop() {
 	_pending.clear();
 	_peer_map.clear();
 	_protocols.clear();
+	_poller.unref();
 }
 
 bool WSLServer::has_peer(int p_id) const {
@@ -320,10 +587,12 @@ Error WSLServer::set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer
 
 WSLServer::WSLServer() {
 	_server.instantiate();
+	_thread_events = memnew(LocalVector<ThreadEvent>);
 }
 
 WSLServer::~WSLServer() {
 	stop();
+	memdelete(_thread_events);
 }
 
 #endif // JAVASCRIPT_ENABLED
@@ -39,6 +39,9 @@
 #include "core/io/stream_peer_ssl.h"
 #include "core/io/stream_peer_tcp.h"
 #include "core/io/tcp_server.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 
 class WSLServer : public WebSocketServer {
 	GDCIIMPL(WSLServer, WebSocketServer);
@@ -58,6 +61,7 @@ private:
 		int req_pos = 0;
 		String key;
 		String protocol;
+		int id = 0; // Assigned on accept when the handshake happens on a network thread.
 		bool has_request = false;
 		CharString response;
 		int response_sent = 0;
@@ -70,10 +74,66 @@ private:
 	int _out_buf_size = DEF_BUF_SHIFT;
 	int _out_pkt_size = DEF_PKT_SHIFT;
 
+	enum {
+		POLLER_SERVER_ID = 0, // Peer IDs are never 0.
+		NETWORK_THREAD_WAIT_MSEC = 1, // How long a network thread waits for socket events.
+	};
+
+	// Event of a network thread, handed to the main thread which emits the signals.
+	struct ThreadEvent {
+		enum Type {
+			EVENT_CONNECT,
+			EVENT_PACKETS,
+			EVENT_CLOSE_REQUEST,
+			EVENT_DISCONNECT,
+		};
+		Type type = EVENT_CONNECT;
+		int id = 0;
+		int value = 0; // Packet count, close code or clean close.
+		Ref<WSLPeer> peer;
+		String protocol;
+		String text; // Resource name or close reason.
+	};
+
+	// Each network thread owns the handshakes and the peers assigned to it, the main thread
+	// only touches the incoming connections and the events under mutex. The events are
+	// swapped with an empty batch once per poll, and dispatched outside of the lock.
+	struct NetworkThread {
+		WSLServer *server = nullptr;
+		Thread thread;
+		Ref<NetSocketPoller> poller;
+		LocalVector<NetSocketPoller::Event> poll_events;
+		Set<int> poll_ready;
+		List<Ref<PendingPeer>> pending;
+		Map<int, Ref<WSLPeer>> peers;
+		LocalVector<ThreadEvent> local_events;
+		Vector<String> protocols;
+		Vector<String> extra_headers;
+		uint64_t handshake_timeout = 0;
+		SafeNumeric<uint32_t> load;
+
+		Mutex mutex;
+		List<Ref<PendingPeer>> incoming;
+		LocalVector<ThreadEvent> *events = nullptr;
+	};
+
 	List<Ref<PendingPeer>> _pending;
 	Ref<TCPServer> _server;
+	Ref<NetSocketPoller> _poller;
+	LocalVector<NetSocketPoller::Event> _poll_events;
+	Set<int> _poll_ready;
 	Vector<String> _protocols;
 	Vector<String> _extra_headers;
+	LocalVector<NetworkThread *> _threads;
+	LocalVector<ThreadEvent> *_thread_events = nullptr;
+	SafeFlag _threads_exit;
+
+	Ref<PendingPeer> _create_pending_peer(Ref<StreamPeerTCP> p_conn);
+	void _start_threads();
+	void _stop_threads();
+	void _poll_threads();
+	static void _network_thread_func(void *p_userdata);
+	void _network_thread_service(NetworkThread &p_thread);
 
 public:
 	Error set_buffers(int p_in_buffer, int p_in_packets, int p_out_buffer, int p_out_packets) override;
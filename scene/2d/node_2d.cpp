@@ -132,6 +132,7 @@ void Node2D::_update_transform() {
 }
 
 void Node2D::set_position(const Point2 &p_pos) {
+	ERR_THREAD_GUARD;
 	if (_xform_dirty) {
 		const_cast<Node2D *>(this)->_update_xform_values();
 	}
@@ -140,6 +141,7 @@ void Node2D::set_position(const Point2 &p_pos) {
 }
 
 void Node2D::set_rotation(real_t p_radians) {
+	ERR_THREAD_GUARD;
 	if (_xform_dirty) {
 		const_cast<Node2D *>(this)->_update_xform_values();
 	}
@@ -148,6 +150,7 @@ void Node2D::set_rotation(real_t p_radians) {
 }
 
 void Node2D::set_skew(real_t p_radians) {
+	ERR_THREAD_GUARD;
 	if (_xform_dirty) {
 		const_cast<Node2D *>(this)->_update_xform_values();
 	}
@@ -156,6 +159,7 @@ void Node2D::set_skew(real_t p_radians) {
 }
 
 void Node2D::set_scale(const Size2 &p_scale) {
+	ERR_THREAD_GUARD;
 	if (_xform_dirty) {
 		const_cast<Node2D *>(this)->_update_xform_values();
 	}
@@ -282,6 +286,7 @@ void Node2D::set_global_scale(const Size2 &p_scale) {
 }
 
 void Node2D::set_transform(const Transform2D &p_transform) {
+	ERR_THREAD_GUARD;
 	transform = p_transform;
 	_xform_dirty = true;
 
@@ -295,6 +300,7 @@ void Node2D::set_transform(const Transform2D &p_transform) {
 }
 
 void Node2D::set_global_transform(const Transform2D &p_transform) {
+	ERR_THREAD_GUARD;
 	CanvasItem *pi = get_parent_item();
 	if (pi) {
 		set_transform(pi->get_global_transform().affine_inverse() * p_transform);
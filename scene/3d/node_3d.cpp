@@ -80,7 +80,7 @@ void Node3D::_notify_dirty() {
 	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 
 #endif
-		get_tree()->xform_change_list.add(&xform_change);
+		get_tree()->_add_xform_change(&xform_change);
 	}
 }
 
@@ -111,7 +111,7 @@ void Node3D::_propagate_transform_changed(Node3D *p_origin) {
 #else
 	if (data.notify_transform && !data.ignore_notification && !xform_change.in_list()) {
 #endif
-		get_tree()->xform_change_list.add(&xform_change);
+		get_tree()->_add_xform_change(&xform_change);
 	}
 	data.dirty |= DIRTY_GLOBAL;
 
@@ -216,6 +216,7 @@ void Node3D::set_quaternion(const Quaternion &p_quaternion) {
 }
 
 void Node3D::set_transform(const Transform3D &p_transform) {
+	ERR_THREAD_GUARD;
 	data.local_transform = p_transform;
 	data.dirty |= DIRTY_VECTORS;
 	_propagate_transform_changed(this);
@@ -232,6 +233,7 @@ Quaternion Node3D::get_quaternion() const {
 }
 
 void Node3D::set_global_transform(const Transform3D &p_transform) {
+	ERR_THREAD_GUARD;
 	Transform3D xform = (data.parent && !data.top_level_active)
 			? data.parent->get_global_transform().affine_inverse() * p_transform
 			: p_transform;
@@ -248,6 +250,9 @@ Transform3D Node3D::get_transform() const {
 }
 Transform3D Node3D::get_global_transform() const {
 	ERR_FAIL_COND_V(!is_inside_tree(), Transform3D());
+	// Sub-thread process groups read their ancestors processed on the main thread. SceneTree updates those
+	// before processing the groups, so the cache below is only written by the thread owning the node.
+	ERR_READ_THREAD_GUARD_V(Transform3D());
 
 	if (data.dirty & DIRTY_GLOBAL) {
 		if (data.dirty & DIRTY_LOCAL) {
@@ -303,6 +308,7 @@ Transform3D Node3D::get_relative_transform(const Node *p_parent) const {
 }
 
 void Node3D::set_position(const Vector3 &p_position) {
+	ERR_THREAD_GUARD;
 	data.local_transform.origin = p_position;
 	_propagate_transform_changed(this);
 	if (data.notify_local_transform) {
@@ -358,6 +364,7 @@ Node3D::RotationOrder Node3D::get_rotation_order() const {
 }
 
 void Node3D::set_rotation(const Vector3 &p_euler_rad) {
+	ERR_THREAD_GUARD;
 	if (data.dirty & DIRTY_VECTORS) {
 		data.scale = data.local_transform.basis.get_scale();
 		data.dirty &= ~DIRTY_VECTORS;
@@ -372,6 +379,7 @@ void Node3D::set_rotation(const Vector3 &p_euler_rad) {
 }
 
 void Node3D::set_scale(const Vector3 &p_scale) {
+	ERR_THREAD_GUARD;
 	if (data.dirty & DIRTY_VECTORS) {
 		data.rotation = data.local_transform.basis.get_euler_normalized(data.rotation_order);
 		data.dirty &= ~DIRTY_VECTORS;
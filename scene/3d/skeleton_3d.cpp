@@ -33,6 +33,8 @@
 #include "core/object/message_queue.h"
 #include "core/variant/type_info.h"
 #include "scene/3d/physics_body_3d.h"
+#include "scene/animation/animation_lod.h"
+#include "scene/main/scene_tree.h"
 #include "scene/resources/skeleton_modification_3d.h"
 #include "scene/resources/surface_tool.h"
 #include "scene/scene_string_names.h"
@@ -247,79 +249,27 @@ void Skeleton3D::_update_process_order() {
 		}
 	}
 
+	bone_process_order.clear();
+	for (int i = 0; i < parentless_bones.size(); i++) {
+		bone_process_order.push_back(parentless_bones[i]);
+	}
+	for (uint32_t i = 0; i < bone_process_order.size(); i++) {
+		const Bone &b = bonesptr[bone_process_order[i]];
+		for (int j = 0; j < b.child_bones.size(); j++) {
+			bone_process_order.push_back(b.child_bones[j]);
+		}
+	}
+
 	process_order_dirty = false;
 }
 
 void Skeleton3D::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_UPDATE_SKELETON: {
-			RenderingServer *rs = RenderingServer::get_singleton();
-			Bone *bonesptr = bones.ptrw();
-
-			int len = bones.size();
-			dirty = false;
-
-			// Update bone transforms.
-			force_update_all_bone_transforms();
-
-			// Update skins.
-			for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
-				const Skin *skin = E->get()->skin.operator->();
-				RID skeleton = E->get()->skeleton;
-				uint32_t bind_count = skin->get_bind_count();
-
-				if (E->get()->bind_count != bind_count) {
-					RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
-					E->get()->bind_count = bind_count;
-					E->get()->skin_bone_indices.resize(bind_count);
-					E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
-				}
-
-				if (E->get()->skeleton_version != version) {
-					for (uint32_t i = 0; i < bind_count; i++) {
-						StringName bind_name = skin->get_bind_name(i);
-
-						if (bind_name != StringName()) {
-							// Bind name used, use this.
-							bool found = false;
-							for (int j = 0; j < len; j++) {
-								if (bonesptr[j].name == bind_name) {
-									E->get()->skin_bone_indices_ptrs[i] = j;
-									found = true;
-									break;
-								}
-							}
-
-							if (!found) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							}
-						} else if (skin->get_bind_bone(i) >= 0) {
-							int bind_index = skin->get_bind_bone(i);
-							if (bind_index >= len) {
-								ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
-								E->get()->skin_bone_indices_ptrs[i] = 0;
-							} else {
-								E->get()->skin_bone_indices_ptrs[i] = bind_index;
-							}
-						} else {
-							ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
-							E->get()->skin_bone_indices_ptrs[i] = 0;
-						}
-					}
-
-					E->get()->skeleton_version = version;
-				}
-
-				for (uint32_t i = 0; i < bind_count; i++) {
-					uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
-					ERR_CONTINUE(bone_index >= (uint32_t)len);
-					rs->skeleton_bone_set_transform(skeleton, i, bonesptr[bone_index].pose_global * skin->get_bind_pose(i));
-				}
+			if (dirty) {
+				// Update every skeleton waiting for it at once, so they can be processed in parallel.
+				_update_dirty_skeletons();
 			}
-#ifdef TOOLS_ENABLED
-			emit_signal(SceneStringNames::get_singleton()->pose_updated);
-#endif // TOOLS_ENABLED
 		} break;
 
 #ifndef _3D_DISABLED
@@ -388,7 +338,7 @@ Transform3D Skeleton3D::get_bone_global_pose(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_update_skeleton();
 	}
 	return bones[p_bone].pose_global;
 }
@@ -397,7 +347,7 @@ Transform3D Skeleton3D::get_bone_global_pose_no_override(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_update_skeleton();
 	}
 	return bones[p_bone].pose_global_no_override;
 }
@@ -662,7 +612,7 @@ Transform3D Skeleton3D::get_bone_global_rest(int p_bone) const {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX_V(p_bone, bone_size, Transform3D());
 	if (rest_dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_update_skeleton();
 	}
 	return bones[p_bone].global_rest;
 }
@@ -763,6 +713,11 @@ void Skeleton3D::_make_dirty() {
 	}
 
 	MessageQueue::get_singleton()->push_notification(this, NOTIFICATION_UPDATE_SKELETON);
+	{
+		// Skeletons can be animated from sub-thread process groups.
+		MutexLock lock(dirty_skeletons_mutex);
+		dirty_skeletons.add(&dirty_element);
+	}
 	dirty = true;
 }
 
@@ -1026,87 +981,266 @@ Ref<SkinReference> Skeleton3D::register_skin(const Ref<Skin> &p_skin) {
 
 void Skeleton3D::force_update_all_dirty_bones() {
 	if (dirty) {
-		const_cast<Skeleton3D *>(this)->notification(NOTIFICATION_UPDATE_SKELETON);
+		const_cast<Skeleton3D *>(this)->_update_skeleton();
 	}
 }
 
 void Skeleton3D::force_update_all_bone_transforms() {
 	_update_process_order();
 
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		force_update_bone_children_transforms(parentless_bones[i]);
+	for (uint32_t i = 0; i < bone_process_order.size(); i++) {
+		_update_bone_global_pose(bone_process_order[i]);
+	}
+	rest_dirty = false;
+
+	for (uint32_t i = 0; i < bone_process_order.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, bone_process_order[i]);
 	}
+
+	AnimationLOD::add_bones_updated(bone_process_order.size());
 }
 
 void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
 
-	Bone *bonesptr = bones.ptrw();
-	List<int> bones_to_process = List<int>();
+	_update_process_order();
+
+	const Bone *bonesptr = bones.ptr();
+	LocalVector<int> bones_to_process;
 	bones_to_process.push_back(p_bone_idx);
 
-	while (bones_to_process.size() > 0) {
-		int current_bone_idx = bones_to_process[0];
-		bones_to_process.erase(current_bone_idx);
+	for (uint32_t i = 0; i < bones_to_process.size(); i++) {
+		int current_bone_idx = bones_to_process[i];
+		_update_bone_global_pose(current_bone_idx);
 
-		Bone &b = bonesptr[current_bone_idx];
-		bool bone_enabled = b.enabled && !show_rest_only;
+		// Add the bone's children to the list of bones to be processed.
+		const Bone &b = bonesptr[current_bone_idx];
+		for (int j = 0; j < b.child_bones.size(); j++) {
+			bones_to_process.push_back(b.child_bones[j]);
+		}
+	}
+	rest_dirty = false;
 
-		if (bone_enabled) {
-			b.update_pose_cache();
-			Transform3D pose = b.pose_cache;
+	for (uint32_t i = 0; i < bones_to_process.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, bones_to_process[i]);
+	}
 
-			if (b.parent >= 0) {
-				b.pose_global = bonesptr[b.parent].pose_global * pose;
-				b.pose_global_no_override = b.pose_global;
-			} else {
-				b.pose_global = pose;
-				b.pose_global_no_override = b.pose_global;
-			}
+	AnimationLOD::add_bones_updated(bones_to_process.size());
+}
+
+void Skeleton3D::_update_bone_global_pose(int p_bone) {
+	Bone *bonesptr = bones.ptrw();
+	Bone &b = bonesptr[p_bone];
+	bool bone_enabled = b.enabled && !show_rest_only;
+
+	if (bone_enabled) {
+		b.update_pose_cache();
+		Transform3D pose = b.pose_cache;
+
+		if (b.parent >= 0) {
+			b.pose_global = bonesptr[b.parent].pose_global * pose;
+			b.pose_global_no_override = b.pose_global;
 		} else {
-			if (b.parent >= 0) {
-				b.pose_global = bonesptr[b.parent].pose_global * b.rest;
-				b.pose_global_no_override = b.pose_global;
-			} else {
-				b.pose_global = b.rest;
-				b.pose_global_no_override = b.pose_global;
-			}
+			b.pose_global = pose;
+			b.pose_global_no_override = b.pose_global;
+		}
+	} else {
+		if (b.parent >= 0) {
+			b.pose_global = bonesptr[b.parent].pose_global * b.rest;
+			b.pose_global_no_override = b.pose_global;
+		} else {
+			b.pose_global = b.rest;
+			b.pose_global_no_override = b.pose_global;
 		}
-		if (rest_dirty) {
-			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
+	}
+	if (rest_dirty) {
+		b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
+	}
+
+	if (b.local_pose_override_amount >= CMP_EPSILON) {
+		Transform3D override_local_pose;
+		if (b.parent >= 0) {
+			override_local_pose = bonesptr[b.parent].pose_global * b.local_pose_override;
+		} else {
+			override_local_pose = b.local_pose_override;
 		}
+		b.pose_global = b.pose_global.interpolate_with(override_local_pose, b.local_pose_override_amount);
+	}
 
-		if (b.local_pose_override_amount >= CMP_EPSILON) {
-			Transform3D override_local_pose;
-			if (b.parent >= 0) {
-				override_local_pose = bonesptr[b.parent].pose_global * b.local_pose_override;
-			} else {
-				override_local_pose = b.local_pose_override;
+	if (b.global_pose_override_amount >= CMP_EPSILON) {
+		b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+	}
+
+	if (b.local_pose_override_reset) {
+		b.local_pose_override_amount = 0.0;
+	}
+	if (b.global_pose_override_reset) {
+		b.global_pose_override_amount = 0.0;
+	}
+}
+
+void Skeleton3D::_update_skeleton() {
+	_update_skeleton_prepare();
+	_update_skeleton_poses();
+	_update_skeleton_commit();
+}
+
+void Skeleton3D::_update_skeleton_prepare() {
+	dirty = false;
+	dirty_element.remove_from_list();
+
+	_update_process_order();
+
+	const Bone *bonesptr = bones.ptr();
+	int len = bones.size();
+
+	// Resolve skin binds here, as it talks to the RenderingServer.
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		const Skin *skin = E->get()->skin.operator->();
+		RID skeleton = E->get()->skeleton;
+		uint32_t bind_count = skin->get_bind_count();
+
+		if (E->get()->bind_count != bind_count) {
+			RS::get_singleton()->skeleton_allocate_data(skeleton, bind_count);
+			E->get()->bind_count = bind_count;
+			E->get()->skin_bone_indices.resize(bind_count);
+			E->get()->skin_bone_indices_ptrs = E->get()->skin_bone_indices.ptrw();
+			E->get()->bone_buffers[0].resize(bind_count * 12);
+			E->get()->bone_buffers[1].resize(bind_count * 12);
+		}
+
+		if (E->get()->skeleton_version != version) {
+			for (uint32_t i = 0; i < bind_count; i++) {
+				StringName bind_name = skin->get_bind_name(i);
+
+				if (bind_name != StringName()) {
+					// Bind name used, use this.
+					bool found = false;
+					for (int j = 0; j < len; j++) {
+						if (bonesptr[j].name == bind_name) {
+							E->get()->skin_bone_indices_ptrs[i] = j;
+							found = true;
+							break;
+						}
+					}
+
+					if (!found) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains named bind '" + String(bind_name) + "' but Skeleton3D has no bone by that name.");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					}
+				} else if (skin->get_bind_bone(i) >= 0) {
+					int bind_index = skin->get_bind_bone(i);
+					if (bind_index >= len) {
+						ERR_PRINT("Skin bind #" + itos(i) + " contains bone index bind: " + itos(bind_index) + " , which is greater than the skeleton bone count: " + itos(len) + ".");
+						E->get()->skin_bone_indices_ptrs[i] = 0;
+					} else {
+						E->get()->skin_bone_indices_ptrs[i] = bind_index;
+					}
+				} else {
+					ERR_PRINT("Skin bind #" + itos(i) + " does not contain a name nor a bone index.");
+					E->get()->skin_bone_indices_ptrs[i] = 0;
+				}
 			}
-			b.pose_global = b.pose_global.interpolate_with(override_local_pose, b.local_pose_override_amount);
+
+			E->get()->skeleton_version = version;
 		}
+	}
+}
+
+void Skeleton3D::_update_skeleton_poses() {
+	// Only touches data owned by this skeleton, so it can run on a worker thread.
+	for (uint32_t i = 0; i < bone_process_order.size(); i++) {
+		_update_bone_global_pose(bone_process_order[i]);
+	}
+	rest_dirty = false;
 
-		if (b.global_pose_override_amount >= CMP_EPSILON) {
-			b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+	const Bone *bonesptr = bones.ptr();
+	uint32_t len = bones.size();
+
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		const Skin *skin = E->get()->skin.operator->();
+		uint32_t bind_count = E->get()->bind_count;
+		if (bind_count == 0) {
+			continue;
 		}
 
-		if (b.local_pose_override_reset) {
-			b.local_pose_override_amount = 0.0;
+		E->get()->bone_buffer_index ^= 1;
+		float *dataptr = E->get()->bone_buffers[E->get()->bone_buffer_index].ptrw();
+		for (uint32_t i = 0; i < bind_count; i++) {
+			uint32_t bone_index = E->get()->skin_bone_indices_ptrs[i];
+			ERR_CONTINUE(bone_index >= len);
+			Transform3D t = bonesptr[bone_index].pose_global * skin->get_bind_pose(i);
+
+			float *d = dataptr + i * 12;
+			d[0] = t.basis.rows[0][0];
+			d[1] = t.basis.rows[0][1];
+			d[2] = t.basis.rows[0][2];
+			d[3] = t.origin.x;
+			d[4] = t.basis.rows[1][0];
+			d[5] = t.basis.rows[1][1];
+			d[6] = t.basis.rows[1][2];
+			d[7] = t.origin.y;
+			d[8] = t.basis.rows[2][0];
+			d[9] = t.basis.rows[2][1];
+			d[10] = t.basis.rows[2][2];
+			d[11] = t.origin.z;
 		}
-		if (b.global_pose_override_reset) {
-			b.global_pose_override_amount = 0.0;
+	}
+}
+
+void Skeleton3D::_update_skeleton_poses_threaded(uint32_t p_index, Skeleton3D **p_skeletons) {
+	p_skeletons[p_index]->_update_skeleton_poses();
+}
+
+void Skeleton3D::_update_skeleton_commit() {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	// One buffer per skin instead of one call per bone.
+	for (Set<SkinReference *>::Element *E = skin_bindings.front(); E; E = E->next()) {
+		if (E->get()->bind_count > 0) {
+			rs->skeleton_set_buffer(E->get()->skeleton, E->get()->bone_buffers[E->get()->bone_buffer_index]);
 		}
+	}
 
-		// Add the bone's children to the list of bones to be processed.
-		int child_bone_size = b.child_bones.size();
-		for (int i = 0; i < child_bone_size; i++) {
-			bones_to_process.push_back(b.child_bones[i]);
+	for (uint32_t i = 0; i < bone_process_order.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, bone_process_order[i]);
+	}
+
+	AnimationLOD::add_bones_updated(bone_process_order.size());
+
+#ifdef TOOLS_ENABLED
+	emit_signal(SceneStringNames::get_singleton()->pose_updated);
+#endif // TOOLS_ENABLED
+}
+
+void Skeleton3D::_update_dirty_skeletons() {
+	LocalVector<Skeleton3D *> skeletons;
+	LocalVector<ObjectID> skeleton_ids;
+
+	while (dirty_skeletons.first()) {
+		Skeleton3D *skeleton = dirty_skeletons.first()->self();
+		skeleton->_update_skeleton_prepare(); // Removes it from the list.
+		skeletons.push_back(skeleton);
+		skeleton_ids.push_back(skeleton->get_instance_id());
+	}
+
+	SceneTree *tree = SceneTree::get_singleton();
+	if (skeletons.size() > 1 && tree && Thread::get_caller_id() == Thread::get_main_id() && !tree->get_thread_work_pool().is_working()) {
+		tree->get_thread_work_pool().do_work(skeletons.size(), skeletons[0], &Skeleton3D::_update_skeleton_poses_threaded, skeletons.ptr());
+	} else {
+		for (uint32_t i = 0; i < skeletons.size(); i++) {
+			skeletons[i]->_update_skeleton_poses();
 		}
+	}
 
-		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, current_bone_idx);
+	// Signal callbacks may free other skeletons of the batch.
+	for (uint32_t i = 0; i < skeleton_ids.size(); i++) {
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(skeleton_ids[i]));
+		if (skeleton) {
+			skeleton->_update_skeleton_commit();
+		}
 	}
-	rest_dirty = false;
 }
 
 // Helper functions
@@ -1298,7 +1432,11 @@ void Skeleton3D::_bind_methods() {
 	BIND_CONSTANT(NOTIFICATION_UPDATE_SKELETON);
 }
 
-Skeleton3D::Skeleton3D() {
+SelfList<Skeleton3D>::List Skeleton3D::dirty_skeletons;
+Mutex Skeleton3D::dirty_skeletons_mutex;
+
+Skeleton3D::Skeleton3D() :
+		dirty_element(this) {
 }
 
 Skeleton3D::~Skeleton3D() {
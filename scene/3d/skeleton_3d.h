@@ -51,6 +51,10 @@ class SkinReference : public RefCounted {
 	uint64_t skeleton_version = 0;
 	Vector<uint32_t> skin_bone_indices;
 	uint32_t *skin_bone_indices_ptrs = nullptr;
+	// Double buffered: the RenderingServer keeps a reference to the last buffer it received,
+	// writing to it again would copy the whole buffer.
+	Vector<float> bone_buffers[2];
+	uint32_t bone_buffer_index = 0;
 	void _skin_changed();
 
 protected:
@@ -140,6 +144,11 @@ private:
 	bool process_order_dirty = false;
 
 	Vector<int> parentless_bones;
+	LocalVector<int> bone_process_order; // Parents always come before their children.
+
+	SelfList<Skeleton3D> dirty_element;
+	static SelfList<Skeleton3D>::List dirty_skeletons;
+	static Mutex dirty_skeletons_mutex;
 
 	void _make_dirty();
 	bool dirty = false;
@@ -151,6 +160,14 @@ private:
 
 	void _update_process_order();
 
+	void _update_bone_global_pose(int p_bone);
+	void _update_skeleton();
+	void _update_skeleton_prepare();
+	void _update_skeleton_poses();
+	void _update_skeleton_poses_threaded(uint32_t p_index, Skeleton3D **p_skeletons);
+	void _update_skeleton_commit();
+	static void _update_dirty_skeletons();
+
 protected:
 	bool _get(const StringName &p_path, Variant &r_ret) const;
 	bool _set(const StringName &p_path, const Variant &p_value);
@@ -0,0 +1,102 @@
+/*************************************************************************/
+/*  animation_lod.cpp                                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "animation_lod.h"
+
+#include "core/config/engine.h"
+#include "scene/main/viewport.h"
+
+#ifndef _3D_DISABLED
+#include "scene/3d/camera_3d.h"
+#include "scene/3d/visible_on_screen_notifier_3d.h"
+#endif // _3D_DISABLED
+
+AnimationLOD::FrameCounter AnimationLOD::tracks_evaluated;
+AnimationLOD::FrameCounter AnimationLOD::bones_updated;
+
+uint32_t AnimationLOD::FrameCounter::get() {
+	uint64_t process_frame = Engine::get_singleton()->get_process_frames();
+	if (process_frame != read_frame) {
+		uint64_t current_total = total.get();
+		average = (current_total - read_total) / (process_frame - read_frame);
+		read_total = current_total;
+		read_frame = process_frame;
+	}
+	return average;
+}
+
+bool AnimationLOD::process(Node *p_owner, double p_delta, double &r_delta) {
+	delta_accum += p_delta;
+	offscreen = false;
+
+	if (max_frame_skip <= 0 || Engine::get_singleton()->is_editor_hint()) {
+		r_delta = delta_accum;
+		delta_accum = 0.0;
+		frames_skipped = 0;
+		return true;
+	}
+
+	real_t effective_importance = CLAMP(importance, 0.0, 1.0);
+
+#ifndef _3D_DISABLED
+	if (!visibility_notifier.is_empty()) {
+		VisibleOnScreenNotifier3D *notifier = Object::cast_to<VisibleOnScreenNotifier3D>(p_owner->get_node_or_null(visibility_notifier));
+		if (notifier) {
+			if (!notifier->is_on_screen()) {
+				offscreen = true;
+				effective_importance = 0.0;
+			} else if (distance_end > distance_begin) {
+				Camera3D *camera = p_owner->get_viewport() ? p_owner->get_viewport()->get_camera_3d() : nullptr;
+				if (camera) {
+					real_t distance = camera->get_global_transform().origin.distance_to(notifier->get_global_transform().origin);
+					effective_importance *= 1.0 - CLAMP((distance - distance_begin) / (distance_end - distance_begin), 0.0, 1.0);
+				}
+			}
+		}
+	}
+#endif // _3D_DISABLED
+
+	int interval = Math::round((1.0 - effective_importance) * max_frame_skip);
+	if (frames_skipped < interval) {
+		frames_skipped++;
+		return false;
+	}
+
+	r_delta = delta_accum;
+	delta_accum = 0.0;
+	frames_skipped = 0;
+	return true;
+}
+
+void AnimationLOD::reset() {
+	delta_accum = 0.0;
+	frames_skipped = 0;
+	offscreen = false;
+}
@@ -0,0 +1,86 @@
+/*************************************************************************/
+/*  animation_lod.h                                                      */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef ANIMATION_LOD_H
+#define ANIMATION_LOD_H
+
+#include "core/math/math_defs.h"
+#include "core/string/node_path.h"
+#include "core/templates/safe_refcount.h"
+
+class Node;
+
+// Update-rate throttling shared by AnimationPlayer and AnimationTree.
+// Skipped frames accumulate their delta, so the next evaluated frame catches
+// up and no method or audio keys are lost.
+class AnimationLOD {
+	// Animations can be processed from several threads (see Node::process_thread_group),
+	// so counts are added atomically and averaged when read from the main thread.
+	struct FrameCounter {
+		SafeNumeric<uint64_t> total;
+		uint64_t read_total = 0;
+		uint64_t read_frame = 0;
+		uint32_t average = 0;
+
+		void add(uint32_t p_amount) { total.add(p_amount); }
+		uint32_t get();
+	};
+
+	static FrameCounter tracks_evaluated;
+	static FrameCounter bones_updated;
+
+	double delta_accum = 0.0;
+	int frames_skipped = 0;
+	bool offscreen = false;
+
+public:
+	real_t importance = 1.0;
+	int max_frame_skip = 0;
+	NodePath visibility_notifier;
+	real_t distance_begin = 10.0;
+	real_t distance_end = 100.0;
+
+	// Returns true when the owner should evaluate this frame, with the
+	// accumulated delta in r_delta.
+	bool process(Node *p_owner, double p_delta, double &r_delta);
+	void reset();
+
+	// Visual-only tracks (blend shapes) can be skipped while off screen.
+	_FORCE_INLINE_ bool is_offscreen() const { return offscreen; }
+
+	static void add_tracks_evaluated(uint32_t p_count) { tracks_evaluated.add(p_count); }
+	static void add_bones_updated(uint32_t p_count) { bones_updated.add(p_count); }
+
+	// Averages per frame since the previous call, for the Performance monitors.
+	static uint32_t get_tracks_evaluated() { return tracks_evaluated.get(); }
+	static uint32_t get_bones_updated() { return bones_updated.get(); }
+};
+
+#endif // ANIMATION_LOD_H
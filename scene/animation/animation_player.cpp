@@ -245,8 +245,9 @@ void AnimationPlayer::_notification(int p_what) {
 				break;
 			}
 
-			if (processing) {
-				_animation_process(get_process_delta_time());
+			double delta = 0.0;
+			if (processing && lod.process(this, get_process_delta_time(), delta)) {
+				_animation_process(delta);
 			}
 		} break;
 
@@ -255,8 +256,9 @@ void AnimationPlayer::_notification(int p_what) {
 				break;
 			}
 
-			if (processing) {
-				_animation_process(get_physics_process_delta_time());
+			double delta = 0.0;
+			if (processing && lod.process(this, get_physics_process_delta_time(), delta)) {
+				_animation_process(delta);
 			}
 		} break;
 
@@ -279,6 +281,8 @@ void AnimationPlayer::_ensure_node_caches(AnimationData *p_anim, Node *p_root_ov
 	Animation *a = p_anim->animation.operator->();
 
 	p_anim->node_cache.resize(a->get_track_count());
+	p_anim->compressed_cursors.clear();
+	p_anim->compressed_cursors.resize(a->get_track_count());
 
 	setup_pass++;
 
@@ -452,6 +456,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 	Animation *a = p_anim->animation.operator->();
 	bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
 	bool backward = signbit(p_delta);
+	uint32_t tracks_evaluated = 0;
 
 	for (int i = 0; i < a->get_track_count(); i++) {
 		// If an animation changes this animation (or it animates itself)
@@ -474,6 +479,12 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 			continue; // do nothing if track is empty
 		}
 
+		if (a->track_get_type(i) == Animation::TYPE_BLEND_SHAPE && lod.is_offscreen()) {
+			continue; // not visible, blend shapes can wait
+		}
+
+		tracks_evaluated++;
+
 		switch (a->track_get_type(i)) {
 			case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
@@ -483,7 +494,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 
 				Vector3 loc;
 
-				Error err = a->position_track_interpolate(i, p_time, &loc);
+				Error err = a->position_track_interpolate(i, p_time, &loc, &p_anim->compressed_cursors[i]);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK) {
@@ -510,7 +521,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 
 				Quaternion rot;
 
-				Error err = a->rotation_track_interpolate(i, p_time, &rot);
+				Error err = a->rotation_track_interpolate(i, p_time, &rot, &p_anim->compressed_cursors[i]);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK) {
@@ -537,7 +548,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 
 				Vector3 scale;
 
-				Error err = a->scale_track_interpolate(i, p_time, &scale);
+				Error err = a->scale_track_interpolate(i, p_time, &scale, &p_anim->compressed_cursors[i]);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK) {
@@ -564,7 +575,7 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 
 				float blend;
 
-				Error err = a->blend_shape_track_interpolate(i, p_time, &blend);
+				Error err = a->blend_shape_track_interpolate(i, p_time, &blend, &p_anim->compressed_cursors[i]);
 				//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 				if (err != OK) {
@@ -934,6 +945,8 @@ void AnimationPlayer::_animation_process_animation(AnimationData *p_anim, double
 			} break;
 		}
 	}
+
+	AnimationLOD::add_tracks_evaluated(tracks_evaluated);
 }
 
 void AnimationPlayer::_animation_process_data(PlaybackData &cd, double p_delta, float p_blend, bool p_seeked, bool p_started) {
@@ -1793,6 +1806,7 @@ void AnimationPlayer::clear_caches() {
 
 	for (KeyValue<StringName, AnimationData> &E : animation_set) {
 		E.value.node_cache.clear();
+		E.value.compressed_cursors.clear();
 	}
 
 	cache_update_size = 0;
@@ -1879,6 +1893,47 @@ AnimationPlayer::AnimationMethodCallMode AnimationPlayer::get_method_call_mode()
 	return method_call_mode;
 }
 
+void AnimationPlayer::set_lod_importance(real_t p_importance) {
+	lod.importance = CLAMP(p_importance, 0.0, 1.0);
+}
+
+real_t AnimationPlayer::get_lod_importance() const {
+	return lod.importance;
+}
+
+void AnimationPlayer::set_lod_max_frame_skip(int p_frames) {
+	lod.max_frame_skip = MAX(p_frames, 0);
+	lod.reset();
+}
+
+int AnimationPlayer::get_lod_max_frame_skip() const {
+	return lod.max_frame_skip;
+}
+
+void AnimationPlayer::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod.visibility_notifier = p_path;
+}
+
+NodePath AnimationPlayer::get_lod_visibility_notifier() const {
+	return lod.visibility_notifier;
+}
+
+void AnimationPlayer::set_lod_distance_begin(real_t p_distance) {
+	lod.distance_begin = p_distance;
+}
+
+real_t AnimationPlayer::get_lod_distance_begin() const {
+	return lod.distance_begin;
+}
+
+void AnimationPlayer::set_lod_distance_end(real_t p_distance) {
+	lod.distance_end = p_distance;
+}
+
+real_t AnimationPlayer::get_lod_distance_end() const {
+	return lod.distance_end;
+}
+
 void AnimationPlayer::_set_process(bool p_process, bool p_force) {
 	if (processing == p_process && !p_force) {
 		return;
@@ -2099,6 +2154,17 @@ void AnimationPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_method_call_mode", "mode"), &AnimationPlayer::set_method_call_mode);
 	ClassDB::bind_method(D_METHOD("get_method_call_mode"), &AnimationPlayer::get_method_call_mode);
 
+	ClassDB::bind_method(D_METHOD("set_lod_importance", "importance"), &AnimationPlayer::set_lod_importance);
+	ClassDB::bind_method(D_METHOD("get_lod_importance"), &AnimationPlayer::get_lod_importance);
+	ClassDB::bind_method(D_METHOD("set_lod_max_frame_skip", "frames"), &AnimationPlayer::set_lod_max_frame_skip);
+	ClassDB::bind_method(D_METHOD("get_lod_max_frame_skip"), &AnimationPlayer::get_lod_max_frame_skip);
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationPlayer::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationPlayer::get_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("set_lod_distance_begin", "distance"), &AnimationPlayer::set_lod_distance_begin);
+	ClassDB::bind_method(D_METHOD("get_lod_distance_begin"), &AnimationPlayer::get_lod_distance_begin);
+	ClassDB::bind_method(D_METHOD("set_lod_distance_end", "distance"), &AnimationPlayer::set_lod_distance_end);
+	ClassDB::bind_method(D_METHOD("get_lod_distance_end"), &AnimationPlayer::get_lod_distance_end);
+
 	ClassDB::bind_method(D_METHOD("get_current_animation_position"), &AnimationPlayer::get_current_animation_position);
 	ClassDB::bind_method(D_METHOD("get_current_animation_length"), &AnimationPlayer::get_current_animation_length);
 
@@ -2120,6 +2186,13 @@ void AnimationPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "playback_speed", PROPERTY_HINT_RANGE, "-64,64,0.01"), "set_speed_scale", "get_speed_scale");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "method_call_mode", PROPERTY_HINT_ENUM, "Deferred,Immediate"), "set_method_call_mode", "get_method_call_mode");
 
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_importance", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_lod_importance", "get_lod_importance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_frame_skip", PROPERTY_HINT_RANGE, "0,60,1"), "set_lod_max_frame_skip", "get_lod_max_frame_skip");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance_begin", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_lod_distance_begin", "get_lod_distance_begin");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance_end", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_lod_distance_end", "get_lod_distance_end");
+
 	ADD_SIGNAL(MethodInfo("animation_finished", PropertyInfo(Variant::STRING_NAME, "anim_name")));
 	ADD_SIGNAL(MethodInfo("animation_changed", PropertyInfo(Variant::STRING_NAME, "old_name"), PropertyInfo(Variant::STRING_NAME, "new_name")));
 	ADD_SIGNAL(MethodInfo("animation_started", PropertyInfo(Variant::STRING_NAME, "anim_name")));
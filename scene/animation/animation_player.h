@@ -35,6 +35,7 @@
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
+#include "scene/animation/animation_lod.h"
 #include "scene/resources/animation.h"
 #include "scene/resources/animation_library.h"
 
@@ -184,6 +185,7 @@ private:
 		String name;
 		StringName next;
 		Vector<TrackNodeCache *> node_cache;
+		LocalVector<Animation::CompressedCursor> compressed_cursors;
 		Ref<Animation> animation;
 		StringName animation_library;
 		uint64_t last_update = 0;
@@ -242,6 +244,8 @@ private:
 
 	NodePath root;
 
+	AnimationLOD lod;
+
 	void _animation_process_animation(AnimationData *p_anim, double p_time, double p_delta, float p_interp, bool p_is_current = true, bool p_seeked = false, bool p_started = false, int p_pingponged = 0);
 
 	void _ensure_node_caches(AnimationData *p_anim, Node *p_root_override = nullptr);
@@ -346,6 +350,21 @@ public:
 	void set_method_call_mode(AnimationMethodCallMode p_mode);
 	AnimationMethodCallMode get_method_call_mode() const;
 
+	void set_lod_importance(real_t p_importance);
+	real_t get_lod_importance() const;
+
+	void set_lod_max_frame_skip(int p_frames);
+	int get_lod_max_frame_skip() const;
+
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+
+	void set_lod_distance_begin(real_t p_distance);
+	real_t get_lod_distance_begin() const;
+
+	void set_lod_distance_end(real_t p_distance);
+	real_t get_lod_distance_end() const;
+
 	void seek(double p_time, bool p_update = false);
 	void seek_delta(double p_time, float p_delta);
 	float get_current_animation_position() const;
@@ -523,6 +523,47 @@ AnimationTree::AnimationProcessCallback AnimationTree::get_process_callback() co
 	return process_callback;
 }
 
+void AnimationTree::set_lod_importance(real_t p_importance) {
+	lod.importance = CLAMP(p_importance, 0.0, 1.0);
+}
+
+real_t AnimationTree::get_lod_importance() const {
+	return lod.importance;
+}
+
+void AnimationTree::set_lod_max_frame_skip(int p_frames) {
+	lod.max_frame_skip = MAX(p_frames, 0);
+	lod.reset();
+}
+
+int AnimationTree::get_lod_max_frame_skip() const {
+	return lod.max_frame_skip;
+}
+
+void AnimationTree::set_lod_visibility_notifier(const NodePath &p_path) {
+	lod.visibility_notifier = p_path;
+}
+
+NodePath AnimationTree::get_lod_visibility_notifier() const {
+	return lod.visibility_notifier;
+}
+
+void AnimationTree::set_lod_distance_begin(real_t p_distance) {
+	lod.distance_begin = p_distance;
+}
+
+real_t AnimationTree::get_lod_distance_begin() const {
+	return lod.distance_begin;
+}
+
+void AnimationTree::set_lod_distance_end(real_t p_distance) {
+	lod.distance_end = p_distance;
+}
+
+real_t AnimationTree::get_lod_distance_end() const {
+	return lod.distance_end;
+}
+
 void AnimationTree::_node_removed(Node *p_node) {
 	cache_valid = false;
 }
@@ -957,6 +998,7 @@ void AnimationTree::_process_graph(double p_delta) {
 
 	{
 		bool can_call = is_inside_tree() && !Engine::get_singleton()->is_editor_hint();
+		uint32_t tracks_evaluated = 0;
 
 		for (const AnimationNode::AnimationState &as : state.animation_states) {
 			Ref<Animation> a = as.animation;
@@ -991,6 +1033,12 @@ void AnimationTree::_process_graph(double p_delta) {
 
 				real_t blend = (*as.track_blends)[blend_idx] * weight;
 
+				if (ttype == Animation::TYPE_BLEND_SHAPE && lod.is_offscreen()) {
+					continue; // Not visible, blend shapes can wait.
+				}
+
+				tracks_evaluated++;
+
 				switch (ttype) {
 					case Animation::TYPE_POSITION_3D: {
 #ifndef _3D_DISABLED
@@ -1079,7 +1127,7 @@ void AnimationTree::_process_graph(double p_delta) {
 							}
 							Vector3 loc;
 
-							Error err = a->position_track_interpolate(i, time, &loc);
+							Error err = a->position_track_interpolate(i, time, &loc, &t->loc_cursor);
 							if (err != OK) {
 								continue;
 							}
@@ -1175,7 +1223,7 @@ void AnimationTree::_process_graph(double p_delta) {
 							}
 							Quaternion rot;
 
-							Error err = a->rotation_track_interpolate(i, time, &rot);
+							Error err = a->rotation_track_interpolate(i, time, &rot, &t->rot_cursor);
 							if (err != OK) {
 								continue;
 							}
@@ -1271,7 +1319,7 @@ void AnimationTree::_process_graph(double p_delta) {
 							}
 							Vector3 scale;
 
-							Error err = a->scale_track_interpolate(i, time, &scale);
+							Error err = a->scale_track_interpolate(i, time, &scale, &t->scale_cursor);
 							if (err != OK) {
 								continue;
 							}
@@ -1291,7 +1339,7 @@ void AnimationTree::_process_graph(double p_delta) {
 
 						float value;
 
-						Error err = a->blend_shape_track_interpolate(i, time, &value);
+						Error err = a->blend_shape_track_interpolate(i, time, &value, &t->cursor);
 						//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 
 						if (err != OK) {
@@ -1565,6 +1613,8 @@ void AnimationTree::_process_graph(double p_delta) {
 				}
 			}
 		}
+
+		AnimationLOD::add_tracks_evaluated(tracks_evaluated);
 	}
 
 	{
@@ -1666,14 +1716,16 @@ void AnimationTree::_notification(int p_what) {
 		} break;
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
-			if (active && process_callback == ANIMATION_PROCESS_IDLE) {
-				_process_graph(get_process_delta_time());
+			double delta = 0.0;
+			if (active && process_callback == ANIMATION_PROCESS_IDLE && lod.process(this, get_process_delta_time(), delta)) {
+				_process_graph(delta);
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
-			if (active && process_callback == ANIMATION_PROCESS_PHYSICS) {
-				_process_graph(get_physics_process_delta_time());
+			double delta = 0.0;
+			if (active && process_callback == ANIMATION_PROCESS_PHYSICS && lod.process(this, get_physics_process_delta_time(), delta)) {
+				_process_graph(delta);
 			}
 		} break;
 	}
@@ -1880,6 +1932,17 @@ void AnimationTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_process_callback", "mode"), &AnimationTree::set_process_callback);
 	ClassDB::bind_method(D_METHOD("get_process_callback"), &AnimationTree::get_process_callback);
 
+	ClassDB::bind_method(D_METHOD("set_lod_importance", "importance"), &AnimationTree::set_lod_importance);
+	ClassDB::bind_method(D_METHOD("get_lod_importance"), &AnimationTree::get_lod_importance);
+	ClassDB::bind_method(D_METHOD("set_lod_max_frame_skip", "frames"), &AnimationTree::set_lod_max_frame_skip);
+	ClassDB::bind_method(D_METHOD("get_lod_max_frame_skip"), &AnimationTree::get_lod_max_frame_skip);
+	ClassDB::bind_method(D_METHOD("set_lod_visibility_notifier", "path"), &AnimationTree::set_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("get_lod_visibility_notifier"), &AnimationTree::get_lod_visibility_notifier);
+	ClassDB::bind_method(D_METHOD("set_lod_distance_begin", "distance"), &AnimationTree::set_lod_distance_begin);
+	ClassDB::bind_method(D_METHOD("get_lod_distance_begin"), &AnimationTree::get_lod_distance_begin);
+	ClassDB::bind_method(D_METHOD("set_lod_distance_end", "distance"), &AnimationTree::set_lod_distance_end);
+	ClassDB::bind_method(D_METHOD("get_lod_distance_end"), &AnimationTree::get_lod_distance_end);
+
 	ClassDB::bind_method(D_METHOD("set_animation_player", "root"), &AnimationTree::set_animation_player);
 	ClassDB::bind_method(D_METHOD("get_animation_player"), &AnimationTree::get_animation_player);
 
@@ -1900,6 +1963,12 @@ void AnimationTree::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_callback", PROPERTY_HINT_ENUM, "Physics,Idle,Manual"), "set_process_callback", "get_process_callback");
 	ADD_GROUP("Root Motion", "root_motion_");
 	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "root_motion_track"), "set_root_motion_track", "get_root_motion_track");
+	ADD_GROUP("LOD", "lod_");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_importance", PROPERTY_HINT_RANGE, "0,1,0.01"), "set_lod_importance", "get_lod_importance");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "lod_max_frame_skip", PROPERTY_HINT_RANGE, "0,60,1"), "set_lod_max_frame_skip", "get_lod_max_frame_skip");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "lod_visibility_notifier", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "VisibleOnScreenNotifier3D"), "set_lod_visibility_notifier", "get_lod_visibility_notifier");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance_begin", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_lod_distance_begin", "get_lod_distance_begin");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "lod_distance_end", PROPERTY_HINT_RANGE, "0,4096,0.01,or_greater,suffix:m"), "set_lod_distance_end", "get_lod_distance_end");
 
 	BIND_ENUM_CONSTANT(ANIMATION_PROCESS_PHYSICS);
 	BIND_ENUM_CONSTANT(ANIMATION_PROCESS_IDLE);
@@ -213,6 +213,9 @@ private:
 		Vector3 loc;
 		Quaternion rot;
 		Vector3 scale;
+		Animation::CompressedCursor loc_cursor;
+		Animation::CompressedCursor rot_cursor;
+		Animation::CompressedCursor scale_cursor;
 
 		TrackCacheTransform() {
 			type = Animation::TYPE_POSITION_3D;
@@ -224,6 +227,7 @@ private:
 		float init_value = 0;
 		float value = 0;
 		int shape_index = -1;
+		Animation::CompressedCursor cursor;
 		TrackCacheBlendShape() { type = Animation::TYPE_BLEND_SHAPE; }
 	};
 
@@ -274,6 +278,8 @@ private:
 	bool active = false;
 	NodePath animation_player;
 
+	AnimationLOD lod;
+
 	AnimationNode::State state;
 	bool cache_valid = false;
 	void _node_removed(Node *p_node);
@@ -328,6 +334,21 @@ public:
 	void set_process_callback(AnimationProcessCallback p_mode);
 	AnimationProcessCallback get_process_callback() const;
 
+	void set_lod_importance(real_t p_importance);
+	real_t get_lod_importance() const;
+
+	void set_lod_max_frame_skip(int p_frames);
+	int get_lod_max_frame_skip() const;
+
+	void set_lod_visibility_notifier(const NodePath &p_path);
+	NodePath get_lod_visibility_notifier() const;
+
+	void set_lod_distance_begin(real_t p_distance);
+	real_t get_lod_distance_begin() const;
+
+	void set_lod_distance_end(real_t p_distance);
+	real_t get_lod_distance_end() const;
+
 	void set_animation_player(const NodePath &p_player);
 	NodePath get_animation_player() const;
 
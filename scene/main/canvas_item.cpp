@@ -178,6 +178,9 @@ Transform2D CanvasItem::get_global_transform() const {
 #ifdef DEBUG_ENABLED
 	ERR_FAIL_COND_V(!is_inside_tree(), get_transform());
 #endif
+	// Sub-thread process groups read their ancestors processed on the main thread. SceneTree updates those
+	// before processing the groups, so the cache below is only written by the thread owning the node.
+	ERR_READ_THREAD_GUARD_V(Transform2D());
 	if (global_invalid) {
 		const CanvasItem *pi = get_parent_item();
 		if (pi) {
@@ -310,7 +313,7 @@ void CanvasItem::_notification(int p_what) {
 			_update_texture_repeat_changed(false);
 
 			if (!block_transform_notify && !xform_change.in_list()) {
-				get_tree()->xform_change_list.add(&xform_change);
+				get_tree()->_add_xform_change(&xform_change);
 			}
 		} break;
 
@@ -694,7 +697,7 @@ void CanvasItem::_notify_transform(CanvasItem *p_node) {
 	if (p_node->notify_transform && !p_node->xform_change.in_list()) {
 		if (!p_node->block_transform_notify) {
 			if (p_node->is_inside_tree()) {
-				get_tree()->xform_change_list.add(&p_node->xform_change);
+				get_tree()->_add_xform_change(&p_node->xform_change);
 			}
 		}
 	}
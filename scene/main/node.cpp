@@ -35,6 +35,7 @@
 #include "core/io/resource_loader.h"
 #include "core/multiplayer/multiplayer_api.h"
 #include "core/object/message_queue.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "instance_placeholder.h"
 #include "scene/animation/tween.h"
@@ -46,10 +47,13 @@
 #include <stdint.h>
 
 VARIANT_ENUM_CAST(Node::ProcessMode);
+VARIANT_ENUM_CAST(Node::ProcessThreadGroup);
 VARIANT_ENUM_CAST(Node::InternalMode);
 
 int Node::orphan_node_count = 0;
 
+thread_local Node *Node::current_process_thread_group = nullptr;
+
 void Node::_notification(int p_notification) {
 	switch (p_notification) {
 		case NOTIFICATION_PROCESS: {
@@ -76,6 +80,8 @@ void Node::_notification(int p_notification) {
 				data.process_owner = this;
 			}
 
+			data.process_thread_group_owner = _get_inherited_process_thread_group_owner();
+
 			if (data.input) {
 				add_to_group("_vp_input" + itos(get_viewport()->get_instance_id()));
 			}
@@ -114,6 +120,7 @@ void Node::_notification(int p_notification) {
 			}
 
 			data.process_owner = nullptr;
+			data.process_thread_group_owner = nullptr;
 			if (data.path_cache) {
 				memdelete(data.path_cache);
 				data.path_cache = nullptr;
@@ -323,6 +330,7 @@ void Node::_propagate_exit_tree() {
 }
 
 void Node::move_child(Node *p_child, int p_pos) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(p_child->data.parent != this, "Child is not a child of this node.");
 
@@ -425,6 +433,13 @@ void Node::set_physics_process(bool p_process) {
 		return;
 	}
 
+	if (!is_tree_accessible_from_caller_thread()) {
+		// Changing the process groups is not thread-safe, apply it at the next sync point instead.
+		ERR_THREAD_GUARD;
+		call_deferred(SNAME("set_physics_process"), p_process);
+		return;
+	}
+
 	data.physics_process = p_process;
 
 	if (data.physics_process) {
@@ -443,6 +458,13 @@ void Node::set_physics_process_internal(bool p_process_internal) {
 		return;
 	}
 
+	if (!is_tree_accessible_from_caller_thread()) {
+		// Changing the process groups is not thread-safe, apply it at the next sync point instead.
+		ERR_THREAD_GUARD;
+		call_deferred(SNAME("set_physics_process_internal"), p_process_internal);
+		return;
+	}
+
 	data.physics_process_internal = p_process_internal;
 
 	if (data.physics_process_internal) {
@@ -457,6 +479,7 @@ bool Node::is_physics_processing_internal() const {
 }
 
 void Node::set_process_mode(ProcessMode p_mode) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.process_mode == p_mode) {
 		return;
 	}
@@ -549,6 +572,107 @@ void Node::_propagate_process_owner(Node *p_owner, int p_pause_notification, int
 	}
 }
 
+void Node::set_process_thread_group(ProcessThreadGroup p_group) {
+	ERR_MAIN_THREAD_GUARD;
+	if (data.process_thread_group == p_group) {
+		return;
+	}
+
+	data.process_thread_group = p_group;
+
+	if (is_inside_tree()) {
+		_propagate_process_thread_group_owner(_get_inherited_process_thread_group_owner());
+	}
+}
+
+Node::ProcessThreadGroup Node::get_process_thread_group() const {
+	return data.process_thread_group;
+}
+
+Node *Node::_get_inherited_process_thread_group_owner() {
+	switch (data.process_thread_group) {
+		case PROCESS_THREAD_GROUP_SUB_THREAD:
+			return this;
+		case PROCESS_THREAD_GROUP_MAIN_THREAD:
+			return nullptr;
+		default:
+			return data.parent ? data.parent->data.process_thread_group_owner : nullptr;
+	}
+}
+
+void Node::_propagate_process_thread_group_owner(Node *p_owner) {
+	data.process_thread_group_owner = p_owner;
+
+	for (int i = 0; i < data.children.size(); i++) {
+		Node *c = data.children[i];
+		if (c->data.process_thread_group == PROCESS_THREAD_GROUP_INHERIT) {
+			c->_propagate_process_thread_group_owner(p_owner);
+		}
+	}
+}
+
+bool Node::is_accessible_from_caller_thread() const {
+	if (current_process_thread_group) {
+		// While processing a sub-thread group, only the nodes in that group can be used.
+		return data.process_thread_group_owner == current_process_thread_group;
+	}
+	// Nodes outside of the tree can be used from any thread, nodes inside of it only from the main thread.
+	return !data.inside_tree || Thread::get_caller_id() == Thread::get_main_id();
+}
+
+bool Node::is_readable_from_caller_thread() const {
+	if (current_process_thread_group) {
+		// Nodes processed on the main thread don't change while the groups are processed, any group can read them.
+		return data.process_thread_group_owner == current_process_thread_group || !data.process_thread_group_owner;
+	}
+	return is_accessible_from_caller_thread();
+}
+
+bool Node::is_tree_accessible_from_caller_thread() const {
+	return !data.inside_tree || (!current_process_thread_group && Thread::get_caller_id() == Thread::get_main_id());
+}
+
+Variant Node::_call_thread_safe_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error) {
+	if (p_argcount < 1) {
+		r_error.error = Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS;
+		r_error.argument = 0;
+		return Variant();
+	}
+
+	if (p_args[0]->get_type() != Variant::STRING_NAME && p_args[0]->get_type() != Variant::STRING) {
+		r_error.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
+		r_error.argument = 0;
+		r_error.expected = Variant::STRING_NAME;
+		return Variant();
+	}
+
+	StringName method = *p_args[0];
+
+	if (is_accessible_from_caller_thread()) {
+		return callp(method, &p_args[1], p_argcount - 1, r_error);
+	}
+
+	r_error.error = Callable::CallError::CALL_OK;
+	MessageQueue::get_singleton()->push_callp(get_instance_id(), method, &p_args[1], p_argcount - 1, true);
+	return Variant();
+}
+
+void Node::set_thread_safe(const StringName &p_property, const Variant &p_value) {
+	if (is_accessible_from_caller_thread()) {
+		set(p_property, p_value);
+	} else {
+		set_deferred(p_property, p_value);
+	}
+}
+
+void Node::notify_thread_safe(int p_notification) {
+	if (is_accessible_from_caller_thread()) {
+		notification(p_notification);
+	} else {
+		MessageQueue::get_singleton()->push_notification(this, p_notification);
+	}
+}
+
 void Node::set_multiplayer_authority(int p_peer_id, bool p_recursive) {
 	data.multiplayer_authority = p_peer_id;
 
@@ -756,6 +880,13 @@ void Node::set_process(bool p_process) {
 		return;
 	}
 
+	if (!is_tree_accessible_from_caller_thread()) {
+		// Changing the process groups is not thread-safe, apply it at the next sync point instead.
+		ERR_THREAD_GUARD;
+		call_deferred(SNAME("set_process"), p_process);
+		return;
+	}
+
 	data.process = p_process;
 
 	if (data.process) {
@@ -774,6 +905,13 @@ void Node::set_process_internal(bool p_process_internal) {
 		return;
 	}
 
+	if (!is_tree_accessible_from_caller_thread()) {
+		// Changing the process groups is not thread-safe, apply it at the next sync point instead.
+		ERR_THREAD_GUARD;
+		call_deferred(SNAME("set_process_internal"), p_process_internal);
+		return;
+	}
+
 	data.process_internal = p_process_internal;
 
 	if (data.process_internal) {
@@ -788,6 +926,7 @@ bool Node::is_processing_internal() const {
 }
 
 void Node::set_process_priority(int p_priority) {
+	ERR_MAIN_THREAD_GUARD;
 	data.process_priority = p_priority;
 
 	// Make sure we are in SceneTree.
@@ -817,6 +956,7 @@ int Node::get_process_priority() const {
 }
 
 void Node::set_process_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.input) {
 		return;
 	}
@@ -838,6 +978,7 @@ bool Node::is_processing_input() const {
 }
 
 void Node::set_process_shortcut_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.shortcut_input) {
 		return;
 	}
@@ -858,6 +999,7 @@ bool Node::is_processing_shortcut_input() const {
 }
 
 void Node::set_process_unhandled_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.unhandled_input) {
 		return;
 	}
@@ -878,6 +1020,7 @@ bool Node::is_processing_unhandled_input() const {
 }
 
 void Node::set_process_unhandled_key_input(bool p_enable) {
+	ERR_MAIN_THREAD_GUARD;
 	if (p_enable == data.unhandled_key_input) {
 		return;
 	}
@@ -906,6 +1049,7 @@ void Node::_set_name_nocheck(const StringName &p_name) {
 }
 
 void Node::set_name(const String &p_name) {
+	ERR_MAIN_THREAD_GUARD;
 	String name = p_name.validate_node_name();
 
 	ERR_FAIL_COND(name.is_empty());
@@ -1129,6 +1273,7 @@ void Node::_add_child_nocheck(Node *p_child, const StringName &p_name) {
 }
 
 void Node::add_child(Node *p_child, bool p_legible_unique_name, InternalMode p_internal) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(p_child == this, vformat("Can't add child '%s' to itself.", p_child->get_name())); // adding to itself!
 	ERR_FAIL_COND_MSG(p_child->data.parent, vformat("Can't add child '%s' to '%s', already has a parent '%s'.", p_child->get_name(), get_name(), p_child->data.parent->get_name())); //Fail if node has a parent
@@ -1152,6 +1297,7 @@ void Node::add_child(Node *p_child, bool p_legible_unique_name, InternalMode p_i
 }
 
 void Node::add_sibling(Node *p_sibling, bool p_legible_unique_name) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_sibling);
 	ERR_FAIL_NULL(data.parent);
 	ERR_FAIL_COND_MSG(p_sibling == this, vformat("Can't add sibling '%s' to itself.", p_sibling->get_name())); // adding to itself!
@@ -1169,6 +1315,7 @@ void Node::add_sibling(Node *p_sibling, bool p_legible_unique_name) {
 }
 
 void Node::remove_child(Node *p_child) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_child);
 	ERR_FAIL_COND_MSG(data.blocked > 0, "Parent node is busy setting up children, remove_node() failed. Consider using call_deferred(\"remove_child\", child) instead.");
 
@@ -1592,6 +1739,7 @@ bool Node::is_unique_name_in_owner() const {
 }
 
 void Node::set_owner(Node *p_owner) {
+	ERR_MAIN_THREAD_GUARD;
 	if (data.owner) {
 		if (data.unique_name_in_owner) {
 			_release_unique_name_in_owner();
@@ -1741,6 +1889,7 @@ bool Node::is_in_group(const StringName &p_identifier) const {
 }
 
 void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_COND(!p_identifier.operator String().length());
 
 	if (data.grouped.has(p_identifier)) {
@@ -1761,6 +1910,7 @@ void Node::add_to_group(const StringName &p_identifier, bool p_persistent) {
 }
 
 void Node::remove_from_group(const StringName &p_identifier) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_COND(!data.grouped.has(p_identifier));
 
 	Map<StringName, GroupData>::Element *E = data.grouped.find(p_identifier);
@@ -1912,6 +2062,7 @@ int Node::get_index(bool p_include_internal) const {
 
 Ref<Tween> Node::create_tween() {
 	ERR_FAIL_COND_V_MSG(!data.tree, nullptr, "Can't create Tween when not inside scene tree.");
+	ERR_MAIN_THREAD_GUARD_V(nullptr);
 	Ref<Tween> tween = get_tree()->create_tween();
 	tween->bind_node(this);
 	return tween;
@@ -2421,6 +2572,7 @@ static void find_owned_by(Node *p_by, Node *p_node, List<Node *> *p_owned) {
 }
 
 void Node::replace_by(Node *p_node, bool p_keep_groups) {
+	ERR_MAIN_THREAD_GUARD;
 	ERR_FAIL_NULL(p_node);
 	ERR_FAIL_COND(p_node->data.parent);
 
@@ -2846,6 +2998,11 @@ void Node::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("is_processing_unhandled_key_input"), &Node::is_processing_unhandled_key_input);
 	ClassDB::bind_method(D_METHOD("set_process_mode", "mode"), &Node::set_process_mode);
 	ClassDB::bind_method(D_METHOD("get_process_mode"), &Node::get_process_mode);
+	ClassDB::bind_method(D_METHOD("set_process_thread_group", "group"), &Node::set_process_thread_group);
+	ClassDB::bind_method(D_METHOD("get_process_thread_group"), &Node::get_process_thread_group);
+	ClassDB::bind_method(D_METHOD("is_accessible_from_caller_thread"), &Node::is_accessible_from_caller_thread);
+	ClassDB::bind_method(D_METHOD("set_thread_safe", "property", "value"), &Node::set_thread_safe);
+	ClassDB::bind_method(D_METHOD("notify_thread_safe", "what"), &Node::notify_thread_safe);
 	ClassDB::bind_method(D_METHOD("can_process"), &Node::can_process);
 	ClassDB::bind_method(D_METHOD("print_orphan_nodes"), &Node::_print_orphan_nodes);
 
@@ -2912,6 +3069,14 @@ void Node::_bind_methods() {
 		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "rpc_id", &Node::_rpc_id_bind, mi);
 	}
 
+	{
+		MethodInfo mi;
+		mi.name = "call_thread_safe";
+		mi.arguments.push_back(PropertyInfo(Variant::STRING_NAME, "method"));
+
+		ClassDB::bind_vararg_method(METHOD_FLAGS_DEFAULT, "call_thread_safe", &Node::_call_thread_safe_bind, mi);
+	}
+
 	ClassDB::bind_method(D_METHOD("update_configuration_warnings"), &Node::update_configuration_warnings);
 
 	BIND_CONSTANT(NOTIFICATION_ENTER_TREE);
@@ -2964,6 +3129,10 @@ void Node::_bind_methods() {
 	BIND_ENUM_CONSTANT(PROCESS_MODE_ALWAYS);
 	BIND_ENUM_CONSTANT(PROCESS_MODE_DISABLED);
 
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_INHERIT);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_MAIN_THREAD);
+	BIND_ENUM_CONSTANT(PROCESS_THREAD_GROUP_SUB_THREAD);
+
 	BIND_ENUM_CONSTANT(DUPLICATE_SIGNALS);
 	BIND_ENUM_CONSTANT(DUPLICATE_GROUPS);
 	BIND_ENUM_CONSTANT(DUPLICATE_SCRIPTS);
@@ -2990,6 +3159,7 @@ void Node::_bind_methods() {
 	ADD_GROUP("Process", "process_");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_mode", PROPERTY_HINT_ENUM, "Inherit,Pausable,When Paused,Always,Disabled"), "set_process_mode", "get_process_mode");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_priority"), "set_process_priority", "get_process_priority");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "process_thread_group", PROPERTY_HINT_ENUM, "Inherit,Main Thread,Sub Thread"), "set_process_thread_group", "get_process_thread_group");
 
 	ADD_GROUP("Editor Description", "editor_");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "editor_description", PROPERTY_HINT_MULTILINE_TEXT), "set_editor_description", "get_editor_description");
@@ -36,6 +36,23 @@
 #include "core/variant/typed_array.h"
 #include "scene/main/scene_tree.h"
 
+#ifdef DEBUG_ENABLED
+// Guards for nodes processed in sub-thread process groups, use them at the top of methods that are not thread-safe.
+// ERR_THREAD_GUARD fails if the caller thread doesn't own the node, ERR_READ_THREAD_GUARD if it can't even read it,
+// ERR_MAIN_THREAD_GUARD fails if the method changes the SceneTree.
+#define ERR_THREAD_GUARD ERR_FAIL_COND_MSG(!is_accessible_from_caller_thread(), "Caller thread can't call this function in this node. Use call_deferred() or call_thread_safe() instead.");
+#define ERR_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_accessible_from_caller_thread(), (m_ret), "Caller thread can't call this function in this node. Use call_deferred() or call_thread_safe() instead.");
+#define ERR_READ_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_readable_from_caller_thread(), (m_ret), "Caller thread can't read this node, it belongs to another thread group. Use call_deferred() or call_thread_safe() instead.");
+#define ERR_MAIN_THREAD_GUARD ERR_FAIL_COND_MSG(!is_tree_accessible_from_caller_thread(), "This function changes the SceneTree and can only be called from the main thread. Use call_deferred() instead.");
+#define ERR_MAIN_THREAD_GUARD_V(m_ret) ERR_FAIL_COND_V_MSG(!is_tree_accessible_from_caller_thread(), (m_ret), "This function changes the SceneTree and can only be called from the main thread. Use call_deferred() instead.");
+#else
+#define ERR_THREAD_GUARD
+#define ERR_THREAD_GUARD_V(m_ret)
+#define ERR_READ_THREAD_GUARD_V(m_ret)
+#define ERR_MAIN_THREAD_GUARD
+#define ERR_MAIN_THREAD_GUARD_V(m_ret)
+#endif
+
 class Viewport;
 class SceneState;
 class Tween;
@@ -53,6 +70,12 @@ public:
 		PROCESS_MODE_DISABLED, // never process
 	};
 
+	enum ProcessThreadGroup {
+		PROCESS_THREAD_GROUP_INHERIT, // same as parent node
+		PROCESS_THREAD_GROUP_MAIN_THREAD, // process on the main thread
+		PROCESS_THREAD_GROUP_SUB_THREAD, // process this subtree on a worker thread, concurrently with other sub-thread groups
+	};
+
 	enum DuplicateFlags {
 		DUPLICATE_SIGNALS = 1,
 		DUPLICATE_GROUPS = 2,
@@ -126,6 +149,9 @@ private:
 		ProcessMode process_mode = PROCESS_MODE_INHERIT;
 		Node *process_owner = nullptr;
 
+		ProcessThreadGroup process_thread_group = PROCESS_THREAD_GROUP_INHERIT;
+		Node *process_thread_group_owner = nullptr; // Null when processed on the main thread.
+
 		int multiplayer_authority = 1; // Server by default.
 		Vector<Multiplayer::RPCConfig> rpc_methods;
 
@@ -174,6 +200,8 @@ private:
 	void _propagate_after_exit_tree();
 	void _print_orphan_nodes();
 	void _propagate_process_owner(Node *p_owner, int p_pause_notification, int p_enabled_notification);
+	void _propagate_process_thread_group_owner(Node *p_owner);
+	Node *_get_inherited_process_thread_group_owner();
 	Array _get_node_and_resource(const NodePath &p_path);
 
 	void _duplicate_signals(const Node *p_original, Node *p_copy) const;
@@ -184,12 +212,16 @@ private:
 
 	void _rpc_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	void _rpc_id_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
+	Variant _call_thread_safe_bind(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
 	_FORCE_INLINE_ bool _is_internal_front() const { return data.parent && data.pos < data.parent->data.internal_children_front; }
 	_FORCE_INLINE_ bool _is_internal_back() const { return data.parent && data.pos >= data.parent->data.children.size() - data.parent->data.internal_children_back; }
 
 	friend class SceneTree;
 
+	// Sub-thread group being processed by the current thread, if any.
+	static thread_local Node *current_process_thread_group;
+
 	void _set_tree(SceneTree *p_tree);
 	void _propagate_pause_notification(bool p_enable);
 
@@ -450,6 +482,18 @@ public:
 	bool can_process_notification(int p_what) const;
 	bool is_enabled() const;
 
+	void set_process_thread_group(ProcessThreadGroup p_group);
+	ProcessThreadGroup get_process_thread_group() const;
+	_FORCE_INLINE_ Node *get_process_thread_group_owner() const { return data.process_thread_group_owner; }
+	_FORCE_INLINE_ static bool is_processing_thread_group() { return current_process_thread_group != nullptr; }
+
+	bool is_accessible_from_caller_thread() const;
+	bool is_readable_from_caller_thread() const;
+	bool is_tree_accessible_from_caller_thread() const;
+
+	void set_thread_safe(const StringName &p_property, const Variant &p_value);
+	void notify_thread_safe(int p_notification);
+
 	void request_ready();
 
 	static void print_orphan_nodes();
@@ -42,8 +42,10 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 #include "node.h"
+#include "scene/3d/node_3d.h"
 #include "scene/animation/tween.h"
 #include "scene/debugger/scene_debugger.h"
+#include "scene/main/canvas_item.h"
 #include "scene/main/viewport.h"
 #include "scene/resources/font.h"
 #include "scene/resources/material.h"
@@ -828,7 +830,8 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 		return;
 	}
 
-	_update_group_order(g, p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS);
+	bool process_notification = p_notification == Node::NOTIFICATION_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PROCESS || p_notification == Node::NOTIFICATION_PHYSICS_PROCESS || p_notification == Node::NOTIFICATION_INTERNAL_PHYSICS_PROCESS;
+	_update_group_order(g, process_notification);
 
 	//copy, so copy on write happens in case something is removed from process while being called
 	//performance is not lost because only if something is added/removed the vector is copied.
@@ -839,12 +842,19 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 
 	call_lock++;
 
+	// Sub-thread groups run first and concurrently, then the rest of the nodes in order on the main thread.
+	bool threaded = process_notification && _notify_process_thread_groups(nodes, node_count, p_notification);
+
 	for (int i = 0; i < node_count; i++) {
 		Node *n = nodes[i];
 		if (call_lock && call_skip.has(n)) {
 			continue;
 		}
 
+		if (threaded && n->data.process_thread_group_owner) {
+			continue;
+		}
+
 		if (!n->can_process()) {
 			continue;
 		}
@@ -862,6 +872,79 @@ void SceneTree::_notify_group_pause(const StringName &p_group, int p_notificatio
 	}
 }
 
+bool SceneTree::_notify_process_thread_groups(Node **p_nodes, int p_node_count, int p_notification) {
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false; // Tool scripts always run on the main thread.
+	}
+#endif
+
+	uint32_t task_count = 0;
+	process_thread_group_task_map.clear();
+
+	for (int i = 0; i < p_node_count; i++) {
+		Node *n = p_nodes[i];
+		Node *owner = n->data.process_thread_group_owner;
+		if (!owner) {
+			continue;
+		}
+
+		if (call_skip.has(n) || !n->can_process() || !n->can_process_notification(p_notification)) {
+			continue;
+		}
+
+		uint32_t *task_index = process_thread_group_task_map.getptr(owner->get_instance_id());
+		if (!task_index) {
+			if (task_count == process_thread_group_tasks.size()) {
+				process_thread_group_tasks.resize(task_count + 1);
+			}
+			process_thread_group_tasks[task_count].owner = owner;
+			process_thread_group_tasks[task_count].nodes.clear();
+			_update_thread_group_ancestors(owner);
+			process_thread_group_task_map.set(owner->get_instance_id(), task_count);
+			task_index = process_thread_group_task_map.getptr(owner->get_instance_id());
+			task_count++;
+		}
+
+		process_thread_group_tasks[*task_index].nodes.push_back(n);
+	}
+
+	if (task_count == 0) {
+		return false;
+	}
+
+	processing_thread_groups = true;
+	thread_work_pool.do_work(task_count, this, &SceneTree::_process_thread_group_task, p_notification);
+	processing_thread_groups = false;
+
+	return true;
+}
+
+void SceneTree::_update_thread_group_ancestors(Node *p_owner) {
+	// The groups may read the global transform of their ancestors. Update the cached transforms here,
+	// so they are only read concurrently.
+	Node *parent = p_owner->get_parent();
+	Node3D *parent_3d = Object::cast_to<Node3D>(parent);
+	if (parent_3d) {
+		parent_3d->get_global_transform();
+		return;
+	}
+	CanvasItem *parent_item = Object::cast_to<CanvasItem>(parent);
+	if (parent_item && parent_item->is_inside_tree()) {
+		parent_item->get_global_transform();
+	}
+}
+
+void SceneTree::_process_thread_group_task(uint32_t p_index, int p_notification) {
+	ProcessThreadGroupTask &task = process_thread_group_tasks[p_index];
+
+	Node::current_process_thread_group = task.owner;
+	for (uint32_t i = 0; i < task.nodes.size(); i++) {
+		task.nodes[i]->notification(p_notification);
+	}
+	Node::current_process_thread_group = nullptr;
+}
+
 void SceneTree::_call_input_pause(const StringName &p_group, CallInputType p_call_type, const Ref<InputEvent> &p_input, Viewport *p_viewport) {
 	Map<StringName, Group>::Element *E = group_map.find(p_group);
 	if (!E) {
@@ -1332,6 +1415,7 @@ SceneTree::SceneTree() {
 	if (singleton == nullptr) {
 		singleton = this;
 	}
+	thread_work_pool.init();
 	debug_collisions_color = GLOBAL_DEF("debug/shapes/collision/shape_color", Color(0.0, 0.6, 0.7, 0.42));
 	debug_collision_contact_color = GLOBAL_DEF("debug/shapes/collision/contact_color", Color(1.0, 0.2, 0.1, 0.8));
 	debug_navigation_color = GLOBAL_DEF("debug/shapes/navigation/geometry_color", Color(0.1, 1.0, 0.7, 0.4));
@@ -1467,6 +1551,8 @@ SceneTree::~SceneTree() {
 		memdelete(root);
 	}
 
+	thread_work_pool.finish();
+
 	if (singleton == this) {
 		singleton = nullptr;
 	}
@@ -33,7 +33,10 @@
 
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/self_list.h"
+#include "core/templates/thread_work_pool.h"
 #include "scene/resources/mesh.h"
 
 #undef Window
@@ -175,7 +178,19 @@ private:
 	void remove_from_group(const StringName &p_group, Node *p_node);
 	void make_group_changed(const StringName &p_group);
 
+	// Nodes of a sub-thread process group, processed together on a worker thread.
+	struct ProcessThreadGroupTask {
+		Node *owner = nullptr;
+		LocalVector<Node *> nodes;
+	};
+
+	LocalVector<ProcessThreadGroupTask> process_thread_group_tasks;
+	HashMap<ObjectID, uint32_t> process_thread_group_task_map;
+
 	void _notify_group_pause(const StringName &p_group, int p_notification);
+	bool _notify_process_thread_groups(Node **p_nodes, int p_node_count, int p_notification);
+	void _update_thread_group_ancestors(Node *p_owner);
+	void _process_thread_group_task(uint32_t p_index, int p_notification);
 	void _call_group_flags(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 	void _call_group(const Variant **p_args, int p_argcount, Callable::CallError &r_error);
 
@@ -186,6 +201,21 @@ private:
 	friend class Viewport;
 
 	SelfList<Node>::List xform_change_list;
+	Mutex xform_change_mutex;
+	bool processing_thread_groups = false;
+
+	// Nodes processed in sub-thread groups can queue transform notifications concurrently.
+	_FORCE_INLINE_ void _add_xform_change(SelfList<Node> *p_xform_change) {
+		if (unlikely(processing_thread_groups)) {
+			MutexLock lock(xform_change_mutex);
+			xform_change_list.add(p_xform_change);
+		} else {
+			xform_change_list.add(p_xform_change);
+		}
+	}
+
+	// Shared by scene systems that batch work across nodes (e.g. Skeleton3D).
+	ThreadWorkPool thread_work_pool;
 
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
@@ -348,6 +378,8 @@ public:
 
 	static SceneTree *get_singleton() { return singleton; }
 
+	ThreadWorkPool &get_thread_work_pool() { return thread_work_pool; }
+
 	void get_argument_options(const StringName &p_function, int p_idx, List<String> *r_options) const override;
 
 	//network API
@@ -94,6 +94,22 @@ void MultiplayerSynchronizer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_replication_interval"), &MultiplayerSynchronizer::get_replication_interval);
 	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "replication_interval", PROPERTY_HINT_RANGE, "0,5,0.001"), "set_replication_interval", "get_replication_interval");
 
+	ClassDB::bind_method(D_METHOD("set_sync_quantization", "quantization"), &MultiplayerSynchronizer::set_sync_quantization);
+	ClassDB::bind_method(D_METHOD("get_sync_quantization"), &MultiplayerSynchronizer::get_sync_quantization);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "sync_quantization", PROPERTY_HINT_RANGE, "0,1,0.0001,or_greater"), "set_sync_quantization", "get_sync_quantization");
+
+	ClassDB::bind_method(D_METHOD("set_relevancy_radius", "radius"), &MultiplayerSynchronizer::set_relevancy_radius);
+	ClassDB::bind_method(D_METHOD("get_relevancy_radius"), &MultiplayerSynchronizer::get_relevancy_radius);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "relevancy_radius", PROPERTY_HINT_RANGE, "0,1000,0.01,or_greater"), "set_relevancy_radius", "get_relevancy_radius");
+
+	ClassDB::bind_method(D_METHOD("set_sync_priority", "priority"), &MultiplayerSynchronizer::set_sync_priority);
+	ClassDB::bind_method(D_METHOD("get_sync_priority"), &MultiplayerSynchronizer::get_sync_priority);
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "sync_priority", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_sync_priority", "get_sync_priority");
+
+	ClassDB::bind_method(D_METHOD("add_visibility_filter", "filter"), &MultiplayerSynchronizer::add_visibility_filter);
+	ClassDB::bind_method(D_METHOD("remove_visibility_filter", "filter"), &MultiplayerSynchronizer::remove_visibility_filter);
+	ClassDB::bind_method(D_METHOD("is_visible_to", "peer"), &MultiplayerSynchronizer::is_visible_to);
+
 	ClassDB::bind_method(D_METHOD("set_replication_config", "config"), &MultiplayerSynchronizer::set_replication_config);
 	ClassDB::bind_method(D_METHOD("get_replication_config"), &MultiplayerSynchronizer::get_replication_config);
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "resource", PROPERTY_HINT_RESOURCE_TYPE, "SceneReplicationConfig"), "set_replication_config", "get_replication_config");
@@ -133,6 +149,60 @@ uint64_t MultiplayerSynchronizer::get_replication_interval_msec() const {
 	return interval_msec;
 }
 
+void MultiplayerSynchronizer::set_sync_quantization(real_t p_quantization) {
+	ERR_FAIL_COND_MSG(p_quantization < 0, "Quantization must be greater or equal to 0 (where 0 means disabled)");
+	sync_quantization = p_quantization;
+}
+
+real_t MultiplayerSynchronizer::get_sync_quantization() const {
+	return sync_quantization;
+}
+
+void MultiplayerSynchronizer::set_relevancy_radius(real_t p_radius) {
+	ERR_FAIL_COND_MSG(p_radius < 0, "Relevancy radius must be greater or equal to 0 (where 0 means always relevant)");
+	relevancy_radius = p_radius;
+}
+
+real_t MultiplayerSynchronizer::get_relevancy_radius() const {
+	return relevancy_radius;
+}
+
+void MultiplayerSynchronizer::set_sync_priority(real_t p_priority) {
+	ERR_FAIL_COND_MSG(p_priority < 0, "Priority must be greater or equal to 0");
+	sync_priority = p_priority;
+}
+
+real_t MultiplayerSynchronizer::get_sync_priority() const {
+	return sync_priority;
+}
+
+void MultiplayerSynchronizer::add_visibility_filter(const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(visibility_filters.has(p_callback), "Visibility filter already added.");
+	visibility_filters.push_back(p_callback);
+}
+
+void MultiplayerSynchronizer::remove_visibility_filter(const Callable &p_callback) {
+	visibility_filters.erase(p_callback);
+}
+
+bool MultiplayerSynchronizer::is_visible_to(int p_peer) const {
+	if (visibility_filters.is_empty()) {
+		return true;
+	}
+	Variant arg = p_peer;
+	const Variant *argp = &arg;
+	for (int i = 0; i < visibility_filters.size(); i++) {
+		Variant ret;
+		Callable::CallError ce;
+		visibility_filters[i].call(&argp, 1, ret, ce);
+		ERR_CONTINUE_MSG(ce.error != Callable::CallError::CALL_OK, vformat("Error calling visibility filter: %s", Variant::get_callable_error_text(visibility_filters[i], &argp, 1, ce)));
+		if (ret.get_type() != Variant::BOOL || !ret.operator bool()) {
+			return false;
+		}
+	}
+	return true;
+}
+
 void MultiplayerSynchronizer::set_replication_config(Ref<SceneReplicationConfig> p_config) {
 	replication_config = p_config;
 }
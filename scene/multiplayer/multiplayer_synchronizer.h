@@ -42,6 +42,10 @@ private:
 	Ref<SceneReplicationConfig> replication_config;
 	NodePath root_path;
 	uint64_t interval_msec = 0;
+	real_t sync_quantization = 0;
+	real_t relevancy_radius = 0;
+	real_t sync_priority = 1;
+	Vector<Callable> visibility_filters;
 
 	static Object *_get_prop_target(Object *p_obj, const NodePath &p_prop);
 	void _start();
@@ -59,6 +63,19 @@ public:
 	double get_replication_interval() const;
 	uint64_t get_replication_interval_msec() const;
 
+	void set_sync_quantization(real_t p_quantization);
+	real_t get_sync_quantization() const;
+
+	void set_relevancy_radius(real_t p_radius);
+	real_t get_relevancy_radius() const;
+
+	void set_sync_priority(real_t p_priority);
+	real_t get_sync_priority() const;
+
+	void add_visibility_filter(const Callable &p_callback);
+	void remove_visibility_filter(const Callable &p_callback);
+	bool is_visible_to(int p_peer) const;
+
 	void set_replication_config(Ref<SceneReplicationConfig> p_config);
 	Ref<SceneReplicationConfig> get_replication_config();
 
@@ -59,8 +59,33 @@ void SceneCacheInterface::on_peer_change(int p_id, bool p_connected) {
 	}
 }
 
+bool SceneCacheInterface::_is_node_at_path(const Node *p_root, const Node *p_node, const NodePath &p_path) {
+	// Walk up from the node matching names, which is much cheaper than resolving the path.
+	const Node *node = p_node;
+	for (int i = p_path.get_name_count() - 1; i >= 0; i--) {
+		if (!node || node == p_root || node->get_name() != p_path.get_name(i)) {
+			return false;
+		}
+		node = node->get_parent();
+	}
+	return node == p_root;
+}
+
+Node *SceneCacheInterface::_get_root_node() {
+	const NodePath path = multiplayer->get_root_path();
+	Node *root_node = Object::cast_to<Node>(ObjectDB::get_instance(root_instance));
+	// Absolute paths start above the scene root window, relative ones from it.
+	const Node *scene_root = path.is_absolute() ? nullptr : SceneTree::get_singleton()->get_root();
+	if (!root_node || !root_node->is_inside_tree() || path != root_path || !_is_node_at_path(scene_root, root_node, path)) {
+		root_node = SceneTree::get_singleton()->get_root()->get_node(path);
+		root_instance = root_node ? root_node->get_instance_id() : ObjectID();
+		root_path = path;
+	}
+	return root_node;
+}
+
 void SceneCacheInterface::process_simplify_path(int p_from, const uint8_t *p_packet, int p_packet_len) {
-	Node *root_node = SceneTree::get_singleton()->get_root()->get_node(multiplayer->get_root_path());
+	Node *root_node = _get_root_node();
 	ERR_FAIL_COND(!root_node);
 	ERR_FAIL_COND_MSG(p_packet_len < 38, "Invalid packet received. Size too small.");
 	int ofs = 1;
@@ -90,6 +115,7 @@ void SceneCacheInterface::process_simplify_path(int p_from, const uint8_t *p_pac
 
 	PathGetCache::NodeInfo ni;
 	ni.path = path;
+	ni.instance = node->get_instance_id();
 
 	path_get_cache[p_from].nodes[id] = ni;
 
@@ -242,19 +268,26 @@ bool SceneCacheInterface::send_object_cache(Object *p_obj, NodePath p_path, int
 }
 
 Object *SceneCacheInterface::get_cached_object(int p_from, uint32_t p_cache_id) {
-	Node *root_node = SceneTree::get_singleton()->get_root()->get_node(multiplayer->get_root_path());
+	Node *root_node = _get_root_node();
 	ERR_FAIL_COND_V(!root_node, nullptr);
 	Map<int, PathGetCache>::Element *E = path_get_cache.find(p_from);
 	ERR_FAIL_COND_V_MSG(!E, nullptr, vformat("No cache found for peer %d.", p_from));
 
-	Map<int, PathGetCache::NodeInfo>::Element *F = E->get().nodes.find(p_cache_id);
-	ERR_FAIL_COND_V_MSG(!F, nullptr, vformat("ID %d not found in cache of peer %d.", p_cache_id, p_from));
+	PathGetCache::NodeInfo *ni = E->get().nodes.getptr(p_cache_id);
+	ERR_FAIL_COND_V_MSG(!ni, nullptr, vformat("ID %d not found in cache of peer %d.", p_cache_id, p_from));
 
-	PathGetCache::NodeInfo *ni = &F->get();
-	Node *node = root_node->get_node(ni->path);
+	Node *node = Object::cast_to<Node>(ObjectDB::get_instance(ni->instance));
+	if (node && node->is_inside_tree() && _is_node_at_path(root_node, node, ni->path)) {
+		return node;
+	}
+	// The node was freed, moved or renamed, resolve the path again.
+	node = root_node->get_node(ni->path);
 	if (!node) {
 		ERR_PRINT("Failed to get cached path: " + String(ni->path) + ".");
+		ni->instance = ObjectID();
+		return nullptr;
 	}
+	ni->instance = node->get_instance_id();
 	return node;
 }
 
@@ -262,4 +295,5 @@ void SceneCacheInterface::clear() {
 	path_get_cache.clear();
 	path_send_cache.clear();
 	last_send_cache_id = 1;
+	root_instance = ObjectID();
 }
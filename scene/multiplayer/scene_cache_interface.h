@@ -49,15 +49,20 @@ private:
 	struct PathGetCache {
 		struct NodeInfo {
 			NodePath path;
-			ObjectID instance;
+			ObjectID instance; // Resolved node, used while it is still at path.
 		};
 
-		Map<int, NodeInfo> nodes;
+		HashMap<int, NodeInfo> nodes;
 	};
 
 	HashMap<NodePath, PathSentCache> path_send_cache;
 	Map<int, PathGetCache> path_get_cache;
 	int last_send_cache_id = 1;
+	ObjectID root_instance;
+	NodePath root_path; // Path root_instance was resolved from.
+
+	static bool _is_node_at_path(const Node *p_root, const Node *p_node, const NodePath &p_path);
+	Node *_get_root_node();
 
 protected:
 	Error _send_confirm_path(Node *p_node, NodePath p_path, PathSentCache *psc, const List<int> &p_peers);
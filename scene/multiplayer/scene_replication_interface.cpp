@@ -31,6 +31,8 @@
 #include "scene_replication_interface.h"
 
 #include "core/io/marshalls.h"
+#include "scene/2d/node_2d.h"
+#include "scene/3d/node_3d.h"
 #include "scene/main/node.h"
 #include "scene/multiplayer/multiplayer_spawner.h"
 #include "scene/multiplayer/multiplayer_synchronizer.h"
@@ -39,6 +41,102 @@
 	if (packet_cache.size() < m_amount) \
 		packet_cache.resize(m_amount);
 
+// Quantized sync values reuse the meta byte of MultiplayerAPI::encode_and_compress_variant,
+// with an encoding mode that is never used for Vector3 and Quaternion.
+#define SYNC_META_TYPE_MASK 0x1F
+#define SYNC_META_EMODE_MASK 0x60
+#define SYNC_META_QUANTIZED (1 << 5)
+
+static int _encode_zigzag(int64_t p_value, uint8_t *r_buffer) {
+	uint64_t value = (uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63);
+	int len = 0;
+	do {
+		uint8_t byte = value & 0x7F;
+		value >>= 7;
+		if (value) {
+			byte |= 0x80;
+		}
+		if (r_buffer) {
+			r_buffer[len] = byte;
+		}
+		len++;
+	} while (value);
+	return len;
+}
+
+static int _decode_zigzag(int64_t &r_value, const uint8_t *p_buffer, int p_len) {
+	uint64_t value = 0;
+	for (int i = 0; i < p_len && i < 10; i++) {
+		value |= uint64_t(p_buffer[i] & 0x7F) << (7 * i);
+		if (!(p_buffer[i] & 0x80)) {
+			r_value = int64_t(value >> 1) ^ -int64_t(value & 1);
+			return i + 1;
+		}
+	}
+	return -1;
+}
+
+// Stores the three smallest components in 10 bits each, and the index of the largest one in the top 2 bits.
+static uint32_t _pack_quaternion(const Quaternion &p_quat) {
+	const Quaternion quat = p_quat.normalized();
+	const real_t c[4] = { quat.x, quat.y, quat.z, quat.w };
+	int largest = 0;
+	for (int i = 1; i < 4; i++) {
+		if (Math::abs(c[i]) > Math::abs(c[largest])) {
+			largest = i;
+		}
+	}
+	const real_t sign = c[largest] < 0 ? -1 : 1;
+	uint32_t packed = largest;
+	for (int i = 0; i < 4; i++) {
+		if (i == largest) {
+			continue;
+		}
+		// The smaller components are within [-sqrt(0.5), sqrt(0.5)].
+		const real_t value = c[i] * sign * Math_SQRT2;
+		packed = (packed << 10) | uint32_t(CLAMP(Math::round((value * 0.5 + 0.5) * 1023), 0, 1023));
+	}
+	return packed;
+}
+
+static Quaternion _unpack_quaternion(uint32_t p_packed) {
+	const int largest = p_packed >> 30;
+	real_t c[4];
+	real_t sum = 0;
+	int shift = 0;
+	for (int i = 3; i >= 0; i--) {
+		if (i == largest) {
+			continue;
+		}
+		const real_t value = real_t((p_packed >> shift) & 1023) / 1023 * 2 - 1;
+		c[i] = value * Math_SQRT12;
+		sum += c[i] * c[i];
+		shift += 10;
+	}
+	c[largest] = Math::sqrt(MAX(0, 1 - sum));
+	return Quaternion(c[0], c[1], c[2], c[3]);
+}
+
+static bool _is_quantizable(const Variant &p_value, real_t p_quantization) {
+	if (p_quantization <= 0) {
+		return false;
+	}
+	switch (p_value.get_type()) {
+		case Variant::VECTOR3: {
+			const Vector3 vec = p_value;
+			const real_t limit = real_t(int64_t(1) << 62) * p_quantization;
+			// Also false for NaN and infinity.
+			return Math::abs(vec.x) < limit && Math::abs(vec.y) < limit && Math::abs(vec.z) < limit;
+		}
+		case Variant::QUATERNION: {
+			const real_t length_squared = Quaternion(p_value).length_squared();
+			return length_squared > CMP_EPSILON && length_squared < 1e30;
+		}
+		default:
+			return false;
+	}
+}
+
 MultiplayerReplicationInterface *SceneReplicationInterface::_create(MultiplayerAPI *p_multiplayer) {
 	return memnew(SceneReplicationInterface(p_multiplayer));
 }
@@ -86,11 +184,28 @@ void SceneReplicationInterface::on_reset() {
 
 void SceneReplicationInterface::on_network_process() {
 	uint64_t msec = OS::get_singleton()->get_ticks_msec();
+	sync_frame++;
+	_update_interest();
 	for (int peer : rep_state->get_peers()) {
+		if (rep_state->peer_take_sync_acks(peer, sync_acks)) {
+			_send_sync_acks(peer);
+		}
 		_send_sync(peer, msec);
 	}
 }
 
+void SceneReplicationInterface::set_peer_interest_origin(int p_peer, const Vector3 &p_origin) {
+	rep_state->peer_set_interest_origin(p_peer, p_origin);
+}
+
+void SceneReplicationInterface::clear_peer_interest_origin(int p_peer) {
+	rep_state->peer_clear_interest_origin(p_peer);
+}
+
+void SceneReplicationInterface::set_bandwidth_limit(int p_bytes_per_second) {
+	sync_bandwidth_limit = p_bytes_per_second;
+}
+
 Error SceneReplicationInterface::on_spawn(Object *p_obj, Variant p_config) {
 	Node *node = Object::cast_to<Node>(p_obj);
 	ERR_FAIL_COND_V(!node || p_config.get_type() != Variant::OBJECT, ERR_INVALID_PARAMETER);
@@ -313,74 +428,460 @@ Error SceneReplicationInterface::on_despawn_receive(int p_from, const uint8_t *p
 	return OK;
 }
 
+Variant SceneReplicationInterface::_quantize_sync_value(const Variant &p_value, real_t p_quantization) {
+	if (!_is_quantizable(p_value, p_quantization)) {
+		return p_value;
+	}
+	// Must produce exactly what _decode_sync_value() will read on the other side.
+	if (p_value.get_type() == Variant::VECTOR3) {
+		const Vector3 vec = p_value;
+		return Vector3(
+				real_t(int64_t(Math::round(vec.x / p_quantization))) * p_quantization,
+				real_t(int64_t(Math::round(vec.y / p_quantization))) * p_quantization,
+				real_t(int64_t(Math::round(vec.z / p_quantization))) * p_quantization);
+	}
+	return _unpack_quaternion(_pack_quaternion(p_value));
+}
+
+Error SceneReplicationInterface::_encode_sync_value(const Variant &p_value, real_t p_quantization, uint8_t *r_buffer, int &r_len) {
+	if (!_is_quantizable(p_value, p_quantization)) {
+		return MultiplayerAPI::encode_and_compress_variant(p_value, r_buffer, r_len, false);
+	}
+	if (r_buffer) {
+		r_buffer[0] = p_value.get_type() | SYNC_META_QUANTIZED;
+	}
+	r_len = 1;
+	if (p_value.get_type() == Variant::VECTOR3) {
+		const Vector3 vec = p_value;
+		for (int i = 0; i < 3; i++) {
+			r_len += _encode_zigzag(int64_t(Math::round(vec[i] / p_quantization)), r_buffer ? r_buffer + r_len : nullptr);
+		}
+	} else {
+		if (r_buffer) {
+			encode_uint32(_pack_quaternion(p_value), r_buffer + r_len);
+		}
+		r_len += 4;
+	}
+	return OK;
+}
+
+Error SceneReplicationInterface::_decode_sync_value(Variant &r_value, real_t p_quantization, const uint8_t *p_buffer, int p_len, int &r_len) {
+	ERR_FAIL_COND_V(p_len < 1, ERR_INVALID_DATA);
+	const uint8_t type = p_buffer[0] & SYNC_META_TYPE_MASK;
+	if ((p_buffer[0] & SYNC_META_EMODE_MASK) != SYNC_META_QUANTIZED || (type != Variant::VECTOR3 && type != Variant::QUATERNION)) {
+		return MultiplayerAPI::decode_and_decompress_variant(r_value, p_buffer, p_len, &r_len, false);
+	}
+	r_len = 1;
+	if (type == Variant::VECTOR3) {
+		ERR_FAIL_COND_V_MSG(p_quantization <= 0, ERR_INVALID_DATA, "Received a quantized Vector3, but quantization is disabled on this synchronizer.");
+		Vector3 vec;
+		for (int i = 0; i < 3; i++) {
+			int64_t value = 0;
+			const int len = _decode_zigzag(value, p_buffer + r_len, p_len - r_len);
+			ERR_FAIL_COND_V(len < 0, ERR_INVALID_DATA);
+			vec[i] = real_t(value) * p_quantization;
+			r_len += len;
+		}
+		r_value = vec;
+	} else {
+		ERR_FAIL_COND_V(p_len < 5, ERR_INVALID_DATA);
+		r_value = _unpack_quaternion(decode_uint32(p_buffer + 1));
+		r_len += 4;
+	}
+	return OK;
+}
+
+Error SceneReplicationInterface::_encode_sync_state(const Vector<Variant> &p_state, const Vector<Variant> *p_baseline, real_t p_quantization, uint8_t *r_buffer, int &r_len) {
+	r_len = 0;
+	int size = 0;
+	if (!p_baseline) {
+		for (int i = 0; i < p_state.size(); i++) {
+			Error err = _encode_sync_value(p_state[i], p_quantization, r_buffer ? r_buffer + r_len : nullptr, size);
+			ERR_FAIL_COND_V(err != OK, err);
+			r_len += size;
+		}
+		return OK;
+	}
+
+	// Dirty mask, one bit per property, followed by the changed values.
+	ERR_FAIL_COND_V(p_baseline->size() != p_state.size(), ERR_INVALID_PARAMETER);
+	const int mask_size = (p_state.size() + 7) / 8;
+	if (r_buffer) {
+		memset(r_buffer, 0, mask_size);
+	}
+	r_len = mask_size;
+	bool dirty = false;
+	for (int i = 0; i < p_state.size(); i++) {
+		if (p_state[i] == (*p_baseline)[i]) {
+			continue;
+		}
+		dirty = true;
+		if (r_buffer) {
+			r_buffer[i / 8] |= 1 << (i % 8);
+		}
+		Error err = _encode_sync_value(p_state[i], p_quantization, r_buffer ? r_buffer + r_len : nullptr, size);
+		ERR_FAIL_COND_V(err != OK, err);
+		r_len += size;
+	}
+	if (!dirty) {
+		r_len = 0; // Nothing to send.
+	}
+	return OK;
+}
+
+Error SceneReplicationInterface::_decode_sync_state(Vector<Variant> &r_state, bool p_delta, real_t p_quantization, const uint8_t *p_buffer, int p_len) {
+	const uint8_t *mask = nullptr;
+	int ofs = 0;
+	if (p_delta) {
+		const int mask_size = (r_state.size() + 7) / 8;
+		ERR_FAIL_COND_V(p_len < mask_size, ERR_INVALID_DATA);
+		mask = p_buffer;
+		ofs = mask_size;
+	}
+	for (int i = 0; i < r_state.size(); i++) {
+		if (mask && !(mask[i / 8] & (1 << (i % 8)))) {
+			continue; // Unchanged from the baseline.
+		}
+		ERR_FAIL_COND_V_MSG(ofs >= p_len, ERR_INVALID_DATA, "Invalid packet received. Size too small.");
+		int len = 0;
+		Error err = _decode_sync_value(r_state.write[i], p_quantization, &p_buffer[ofs], p_len - ofs, len);
+		ERR_FAIL_COND_V_MSG(err != OK, err, "Invalid packet received. Unable to decode state variable.");
+		ofs += len;
+	}
+	return OK;
+}
+
+const SceneReplicationState::SyncSnapshot *SceneReplicationInterface::_capture_sync_state(const ObjectID &p_oid, MultiplayerSynchronizer *p_sync, Node *p_node) {
+	// The state is read once per frame, and shared by all peers.
+	if (rep_state->get_sync_capture_frame(p_oid) != sync_frame) {
+		Vector<Variant> vars;
+		Vector<const Variant *> varp;
+		const List<NodePath> props = p_sync->get_replication_config()->get_sync_properties();
+		Error err = MultiplayerSynchronizer::get_state(props, p_node, vars, varp);
+		ERR_FAIL_COND_V_MSG(err != OK, nullptr, "Unable to retrieve sync state.");
+		const real_t quantization = p_sync->get_sync_quantization();
+		if (quantization > 0) {
+			// Keep the values as the peers will see them, so baselines match on both sides.
+			for (int i = 0; i < vars.size(); i++) {
+				vars.write[i] = _quantize_sync_value(vars[i], quantization);
+			}
+		}
+		rep_state->push_sync_snapshot(p_oid, sync_frame, vars);
+	}
+	return rep_state->get_sync_snapshot(p_oid);
+}
+
+void SceneReplicationInterface::_send_sync_acks(int p_peer) {
+	// Every decoded packet is acknowledged, as ranges of consecutive sequences (first, count).
+	sync_acks.sort();
+	MAKE_ROOM(sync_mtu);
+	uint8_t *ptr = packet_cache.ptrw();
+	ptr[0] = MultiplayerAPI::NETWORK_COMMAND_SYNC | SYNC_ACK_FLAG;
+	int ofs = 1;
+	uint32_t i = 0;
+	while (i < sync_acks.size()) {
+		const uint16_t first = sync_acks[i];
+		uint16_t count = 1;
+		for (i++; i < sync_acks.size() && sync_acks[i] == uint16_t(first + count); i++) {
+			count++;
+		}
+		if (ofs + 4 > sync_mtu) {
+			_send_raw(ptr, ofs, p_peer, false);
+			ofs = 1;
+		}
+		ofs += encode_uint16(first, &ptr[ofs]);
+		ofs += encode_uint16(count, &ptr[ofs]);
+	}
+	_send_raw(ptr, ofs, p_peer, false);
+}
+
+static _FORCE_INLINE_ uint64_t _interest_cell_key(int64_t p_x, int64_t p_y, int64_t p_z) {
+	// Distant cells may share a key, which only costs some extra distance checks.
+	return ((uint64_t(p_x) & 0x1FFFFF) << 42) | ((uint64_t(p_y) & 0x1FFFFF) << 21) | (uint64_t(p_z) & 0x1FFFFF);
+}
+
+void SceneReplicationInterface::_update_interest() {
+	interest_enabled = false;
+	interest_global.clear();
+	interest_peers.clear();
+
+	struct PeerOrigin {
+		int peer = 0;
+		Vector3 origin;
+	};
+	LocalVector<PeerOrigin> origins;
+	for (int peer : rep_state->get_peers()) {
+		PeerOrigin po;
+		if (rep_state->peer_get_interest_origin(peer, po.origin)) {
+			po.peer = peer;
+			origins.push_back(po);
+		}
+	}
+	if (origins.is_empty()) {
+		return; // Every node is relevant to every peer.
+	}
+	interest_enabled = true;
+
+	struct SpatialNode {
+		ObjectID id;
+		Vector3 position;
+		real_t radius = 0;
+	};
+	LocalVector<SpatialNode> spatial;
+	real_t cell_size = 0;
+	for (const ObjectID &oid : rep_state->get_synced_nodes()) {
+		MultiplayerSynchronizer *sync = rep_state->get_synchronizer(oid);
+		Node *node = rep_state->get_node(oid);
+		if (!sync || !node) {
+			continue;
+		}
+		InterestEntry entry;
+		entry.id = oid;
+		const real_t radius = sync->get_relevancy_radius();
+		Node3D *node_3d = Object::cast_to<Node3D>(node);
+		Node2D *node_2d = Object::cast_to<Node2D>(node);
+		if (radius <= 0 || !node->is_inside_tree() || (!node_3d && !node_2d)) {
+			interest_global.push_back(entry);
+			continue;
+		}
+		SpatialNode snode;
+		snode.id = oid;
+		snode.radius = radius;
+		if (node_3d) {
+			snode.position = node_3d->get_global_transform().origin;
+		} else {
+			const Vector2 pos = node_2d->get_global_position();
+			snode.position = Vector3(pos.x, pos.y, 0);
+		}
+		spatial.push_back(snode);
+		cell_size = MAX(cell_size, radius);
+	}
+	if (spatial.is_empty()) {
+		return;
+	}
+
+	// Bucket the origins in a grid with cells as big as the largest radius,
+	// so each node only checks the peers in the (at most 3x3x3) cells it overlaps.
+	HashMap<uint64_t, LocalVector<uint32_t>> grid;
+	for (uint32_t i = 0; i < origins.size(); i++) {
+		const Vector3 cell = (origins[i].origin / cell_size).floor();
+		grid[_interest_cell_key(int64_t(cell.x), int64_t(cell.y), int64_t(cell.z))].push_back(i);
+	}
+	for (uint32_t i = 0; i < spatial.size(); i++) {
+		const SpatialNode &snode = spatial[i];
+		const Vector3 from = ((snode.position - Vector3(snode.radius, snode.radius, snode.radius)) / cell_size).floor();
+		const Vector3 to = ((snode.position + Vector3(snode.radius, snode.radius, snode.radius)) / cell_size).floor();
+		for (int64_t x = int64_t(from.x); x <= int64_t(to.x); x++) {
+			for (int64_t y = int64_t(from.y); y <= int64_t(to.y); y++) {
+				for (int64_t z = int64_t(from.z); z <= int64_t(to.z); z++) {
+					const LocalVector<uint32_t> *cell = grid.getptr(_interest_cell_key(x, y, z));
+					if (!cell) {
+						continue;
+					}
+					for (uint32_t j = 0; j < cell->size(); j++) {
+						const PeerOrigin &po = origins[(*cell)[j]];
+						const real_t dist = po.origin.distance_to(snode.position);
+						if (dist > snode.radius) {
+							continue;
+						}
+						InterestEntry entry;
+						entry.id = snode.id;
+						entry.weight = 1.0 - 0.9 * dist / snode.radius;
+						interest_peers[po.peer].push_back(entry);
+					}
+				}
+			}
+		}
+	}
+}
+
+void SceneReplicationInterface::_add_sync_candidate(int p_peer, uint64_t p_msec, const ObjectID &p_oid, real_t p_weight) {
+	MultiplayerSynchronizer *sync = rep_state->get_synchronizer(p_oid);
+	if (!sync) {
+		return;
+	}
+	// States delayed by the bandwidth budget don't wait for the next interval.
+	if (rep_state->peer_get_sync_interest(p_peer, p_oid) < 1 && !rep_state->update_sync_time(p_oid, p_msec)) {
+		return; // nothing to sync.
+	}
+	if (!sync->is_visible_to(p_peer)) {
+		return;
+	}
+	Node *node = rep_state->get_node(p_oid);
+	ERR_FAIL_COND(!node);
+	const SceneReplicationState::SyncSnapshot *snapshot = _capture_sync_state(p_oid, sync, node);
+	if (!snapshot) {
+		return;
+	}
+	// Send the changes since the last state acknowledged by the peer, or the full state if there is none.
+	uint16_t baseline_seq = 0;
+	const SceneReplicationState::SyncSnapshot *baseline = rep_state->peer_get_sync_baseline(p_peer, p_oid, baseline_seq);
+	if (baseline && baseline->frame == snapshot->frame) {
+		return; // The peer is up to date.
+	}
+	if (baseline && baseline->state.size() != snapshot->state.size()) {
+		baseline = nullptr; // The replication config changed.
+	}
+	// Each state is encoded once for all the peers sharing the same baseline.
+	const uint32_t baseline_frame = baseline ? baseline->frame : 0;
+	const uint8_t *data = nullptr;
+	int size = 0;
+	if (!rep_state->get_encoded_sync_state(p_oid, snapshot->frame, baseline_frame, data, size)) {
+		const Vector<Variant> *baseline_state = baseline ? &baseline->state : nullptr;
+		const real_t quantization = sync->get_sync_quantization();
+		Error err = _encode_sync_state(snapshot->state, baseline_state, quantization, nullptr, size);
+		ERR_FAIL_COND_MSG(err != OK, "Unable to encode sync state.");
+		uint8_t *buffer = rep_state->add_encoded_sync_state(p_oid, snapshot->frame, baseline_frame, size);
+		if (size) {
+			_encode_sync_state(snapshot->state, baseline_state, quantization, buffer, size);
+		}
+	}
+	if (!size) {
+		return;
+	}
+	// Distant nodes only get sent once they accumulated enough relevancy.
+	const real_t interest = rep_state->peer_add_sync_interest(p_peer, p_oid, p_weight);
+	if (interest < 1) {
+		return;
+	}
+	SyncCandidate candidate;
+	candidate.id = p_oid;
+	candidate.priority = interest * sync->get_sync_priority();
+	candidate.snapshot = snapshot;
+	candidate.baseline = baseline;
+	candidate.baseline_seq = baseline_seq;
+	candidate.size = size;
+	sync_candidates.push_back(candidate);
+}
+
 void SceneReplicationInterface::_send_sync(int p_peer, uint64_t p_msec) {
 	const Set<ObjectID> &known = rep_state->get_known_nodes(p_peer);
 	if (known.is_empty()) {
 		return;
 	}
+	// Can only send updates for already notified nodes.
+	sync_candidates.clear();
+	Vector3 origin;
+	if (interest_enabled && rep_state->peer_get_interest_origin(p_peer, origin)) {
+		for (uint32_t i = 0; i < interest_global.size(); i++) {
+			if (known.has(interest_global[i].id)) {
+				_add_sync_candidate(p_peer, p_msec, interest_global[i].id, interest_global[i].weight);
+			}
+		}
+		const LocalVector<InterestEntry> *relevant = interest_peers.getptr(p_peer);
+		for (uint32_t i = 0; relevant && i < relevant->size(); i++) {
+			if (known.has((*relevant)[i].id)) {
+				_add_sync_candidate(p_peer, p_msec, (*relevant)[i].id, (*relevant)[i].weight);
+			}
+		}
+	} else {
+		for (const ObjectID &oid : known) {
+			_add_sync_candidate(p_peer, p_msec, oid, 1);
+		}
+	}
+	if (sync_candidates.is_empty()) {
+		return;
+	}
+	int budget = -1;
+	if (sync_bandwidth_limit > 0) {
+		budget = rep_state->peer_refill_sync_budget(p_peer, sync_bandwidth_limit, MAX(sync_bandwidth_limit / 10, sync_mtu), p_msec);
+		// The most relevant and starved states first, the others keep their priority for the next frame.
+		sync_candidates.sort();
+	}
+	int used = 0;
+
 	MAKE_ROOM(sync_mtu);
 	uint8_t *ptr = packet_cache.ptrw();
 	ptr[0] = MultiplayerAPI::NETWORK_COMMAND_SYNC;
+	// Each packet gets its own sequence number, so the peer can acknowledge it on its own.
+	uint16_t seq = rep_state->peer_sync_next(p_peer);
 	int ofs = 1;
-	ofs += encode_uint16(rep_state->peer_sync_next(p_peer), &ptr[1]);
-	// Can only send updates for already notified nodes.
-	// This is a lazy implementation, we could optimize much more here with by grouping by replication config.
-	for (const ObjectID &oid : known) {
-		if (!rep_state->update_sync_time(oid, p_msec)) {
-			continue; // nothing to sync.
-		}
+	ofs += encode_uint16(seq, &ptr[1]);
+	for (uint32_t i = 0; i < sync_candidates.size(); i++) {
+		const SyncCandidate &candidate = sync_candidates[i];
+		const ObjectID oid = candidate.id;
 		MultiplayerSynchronizer *sync = rep_state->get_synchronizer(oid);
-		ERR_CONTINUE(!sync);
-		Node *node = rep_state->get_node(oid);
-		ERR_CONTINUE(!node);
-		int size;
-		Vector<Variant> vars;
-		Vector<const Variant *> varp;
-		const List<NodePath> props = sync->get_replication_config()->get_sync_properties();
-		Error err = MultiplayerSynchronizer::get_state(props, node, vars, varp);
-		ERR_CONTINUE_MSG(err != OK, "Unable to retrieve sync state.");
-		err = MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), nullptr, size);
-		ERR_CONTINUE_MSG(err != OK, "Unable to encode sync state.");
+		const int size = candidate.size;
+		const int header_size = 4 + 1 + (candidate.baseline ? 2 : 0) + 2;
 		// TODO Handle single state above MTU.
-		ERR_CONTINUE_MSG(size > 3 + 4 + 4 + sync_mtu, vformat("Node states bigger then MTU will not be sent (%d > %d): %s", size, sync_mtu, node->get_path()));
-		if (ofs + 4 + 4 + size > sync_mtu) {
+		ERR_CONTINUE_MSG(3 + header_size + size > sync_mtu, vformat("Node states bigger then MTU will not be sent (%d > %d): %s", size, sync_mtu, rep_state->get_node(oid)->get_path()));
+		if (budget >= 0 && used + header_size + size > budget) {
+			break;
+		}
+		if (ofs + header_size + size > sync_mtu) {
 			// Send what we got, and reset write.
 			_send_raw(packet_cache.ptr(), ofs, p_peer, false);
+			seq = rep_state->peer_sync_next(p_peer);
+			encode_uint16(seq, &ptr[1]);
 			ofs = 3;
 		}
-		if (size) {
-			uint32_t net_id = rep_state->get_net_id(oid);
-			if (net_id == 0 || (net_id & 0x80000000)) {
-				// First time path based ID.
-				NodePath rel_path = multiplayer->get_root_path().rel_path_to(sync->get_path());
-				int path_id = 0;
-				multiplayer->send_object_cache(sync, rel_path, p_peer, path_id);
-				ERR_CONTINUE_MSG(net_id && net_id != (uint32_t(path_id) | 0x80000000), "This should never happen!");
-				net_id = path_id;
-				rep_state->set_net_id(oid, net_id | 0x80000000);
-			}
-			ofs += encode_uint32(rep_state->get_net_id(oid), &ptr[ofs]);
-			ofs += encode_uint32(size, &ptr[ofs]);
-			MultiplayerAPI::encode_and_compress_variants(varp.ptrw(), varp.size(), &ptr[ofs], size);
-			ofs += size;
+		uint32_t net_id = rep_state->get_net_id(oid);
+		if (net_id == 0 || (net_id & 0x80000000)) {
+			// First time path based ID.
+			NodePath rel_path = multiplayer->get_root_path().rel_path_to(sync->get_path());
+			int path_id = 0;
+			multiplayer->send_object_cache(sync, rel_path, p_peer, path_id);
+			ERR_CONTINUE_MSG(net_id && net_id != (uint32_t(path_id) | 0x80000000), "This should never happen!");
+			net_id = path_id;
+			rep_state->set_net_id(oid, net_id | 0x80000000);
+		}
+		ofs += encode_uint32(rep_state->get_net_id(oid), &ptr[ofs]);
+		ptr[ofs++] = candidate.baseline ? SYNC_STATE_DELTA : 0;
+		if (candidate.baseline) {
+			ofs += encode_uint16(candidate.baseline_seq, &ptr[ofs]);
 		}
+		ofs += encode_uint16(size, &ptr[ofs]);
+		const uint8_t *data = nullptr;
+		int data_size = 0;
+		rep_state->get_encoded_sync_state(oid, candidate.snapshot->frame, candidate.baseline ? candidate.baseline->frame : 0, data, data_size);
+		CRASH_COND(data_size != size);
+		memcpy(&ptr[ofs], data, size);
+		ofs += size;
+		used += header_size + size;
+		rep_state->peer_sync_sent(p_peer, seq, oid, candidate.snapshot->frame);
 	}
 	if (ofs > 3) {
 		// Got some left over to send.
 		_send_raw(packet_cache.ptr(), ofs, p_peer, false);
 	}
+	if (budget >= 0) {
+		rep_state->peer_consume_sync_budget(p_peer, used);
+	}
 }
 
 Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) {
-	ERR_FAIL_COND_V_MSG(p_buffer_len < 11, ERR_INVALID_DATA, "Invalid sync packet received");
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 3, ERR_INVALID_DATA, "Invalid sync packet received");
+	if (p_buffer[0] & SYNC_ACK_FLAG) {
+		ERR_FAIL_COND_V_MSG((p_buffer_len - 1) % 4 != 0, ERR_INVALID_DATA, "Invalid sync ack packet received");
+		for (int ofs = 1; ofs < p_buffer_len; ofs += 4) {
+			const uint16_t first = decode_uint16(&p_buffer[ofs]);
+			const uint16_t count = decode_uint16(&p_buffer[ofs + 2]);
+			for (uint16_t i = 0; i < count; i++) {
+				rep_state->peer_sync_ack(p_from, first + i);
+			}
+		}
+		return OK;
+	}
+	ERR_FAIL_COND_V_MSG(p_buffer_len < 10, ERR_INVALID_DATA, "Invalid sync packet received");
 	uint16_t time = decode_uint16(&p_buffer[1]);
 	int ofs = 3;
 	rep_state->peer_sync_recv(p_from, time);
-	while (ofs + 8 < p_buffer_len) {
+	// The packet is only acknowledged if every state in it could be decoded, and can be used as a baseline.
+	bool decoded = true;
+	while (ofs + 7 <= p_buffer_len) {
 		uint32_t net_id = decode_uint32(&p_buffer[ofs]);
 		ofs += 4;
-		uint32_t size = decode_uint32(&p_buffer[ofs]);
-		ofs += 4;
+		const bool delta = p_buffer[ofs] & SYNC_STATE_DELTA;
+		ofs += 1;
+		uint16_t baseline_seq = 0;
+		if (delta) {
+			ERR_FAIL_COND_V(ofs + 4 > p_buffer_len, ERR_INVALID_DATA);
+			baseline_seq = decode_uint16(&p_buffer[ofs]);
+			ofs += 2;
+		}
+		uint32_t size = decode_uint16(&p_buffer[ofs]);
+		ofs += 2;
+		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_INVALID_DATA);
 		Node *node = nullptr;
 		if (net_id & 0x80000000) {
 			MultiplayerSynchronizer *sync = Object::cast_to<MultiplayerSynchronizer>(multiplayer->get_cached_object(p_from, net_id & 0x7FFFFFFF));
@@ -392,26 +893,40 @@ Error SceneReplicationInterface::on_sync_receive(int p_from, const uint8_t *p_bu
 		if (!node) {
 			// Not received yet.
 			ofs += size;
+			decoded = false;
 			continue;
 		}
 		const ObjectID oid = node->get_instance_id();
-		if (!rep_state->update_last_node_sync(oid, time)) {
-			// State is too old.
-			ofs += size;
-			continue;
-		}
 		MultiplayerSynchronizer *sync = rep_state->get_synchronizer(oid);
 		ERR_FAIL_COND_V(!sync, ERR_BUG);
-		ERR_FAIL_COND_V(size > uint32_t(p_buffer_len - ofs), ERR_BUG);
 		const List<NodePath> props = sync->get_replication_config()->get_sync_properties();
 		Vector<Variant> vars;
-		vars.resize(props.size());
-		int consumed;
-		Error err = MultiplayerAPI::decode_and_decompress_variants(vars, &p_buffer[ofs], size, consumed);
+		if (delta) {
+			const Vector<Variant> *baseline = rep_state->peer_get_recv_sync_state(p_from, net_id, baseline_seq);
+			if (!baseline || baseline->size() != props.size()) {
+				// Baseline not available anymore, wait for a full state.
+				ofs += size;
+				decoded = false;
+				continue;
+			}
+			vars = *baseline;
+		} else {
+			vars.resize(props.size());
+		}
+		Error err = _decode_sync_state(vars, delta, sync->get_sync_quantization(), &p_buffer[ofs], size);
 		ERR_FAIL_COND_V(err, err);
+		ofs += size;
+		// Even an outdated state can still be used as a baseline by the sender.
+		rep_state->peer_store_recv_sync_state(p_from, net_id, time, vars);
+		if (!rep_state->update_last_node_sync(oid, time)) {
+			// State is too old.
+			continue;
+		}
 		err = MultiplayerSynchronizer::set_state(props, node, vars);
 		ERR_FAIL_COND_V(err, err);
-		ofs += size;
+	}
+	if (decoded) {
+		rep_state->peer_sync_decoded(p_from, time);
 	}
 	return OK;
 }
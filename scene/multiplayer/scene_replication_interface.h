@@ -39,7 +39,44 @@ class SceneReplicationInterface : public MultiplayerReplicationInterface {
 	GDCLASS(SceneReplicationInterface, MultiplayerReplicationInterface);
 
 private:
+	// The sync command byte uses the first custom flag to mark acknowledgements.
+	enum {
+		SYNC_ACK_SHIFT = MultiplayerAPI::CMD_FLAG_0_SHIFT,
+		SYNC_ACK_FLAG = (1 << SYNC_ACK_SHIFT),
+	};
+
+	// Flags for each node state in a sync packet.
+	enum {
+		SYNC_STATE_DELTA = 1, // Only the properties set in the dirty mask follow, relative to an acknowledged baseline.
+	};
+
+	struct InterestEntry {
+		ObjectID id;
+		real_t weight = 1; // Decreases with the distance to the peer's interest origin.
+	};
+
+	struct SyncCandidate {
+		ObjectID id;
+		real_t priority = 0;
+		const SceneReplicationState::SyncSnapshot *snapshot = nullptr;
+		const SceneReplicationState::SyncSnapshot *baseline = nullptr;
+		uint16_t baseline_seq = 0;
+		int size = 0;
+
+		bool operator<(const SyncCandidate &p_other) const { return priority > p_other.priority; }
+	};
+
+	static Error _encode_sync_value(const Variant &p_value, real_t p_quantization, uint8_t *r_buffer, int &r_len);
+	static Error _decode_sync_value(Variant &r_value, real_t p_quantization, const uint8_t *p_buffer, int p_len, int &r_len);
+	static Variant _quantize_sync_value(const Variant &p_value, real_t p_quantization);
+	static Error _encode_sync_state(const Vector<Variant> &p_state, const Vector<Variant> *p_baseline, real_t p_quantization, uint8_t *r_buffer, int &r_len);
+	static Error _decode_sync_state(Vector<Variant> &r_state, bool p_delta, real_t p_quantization, const uint8_t *p_buffer, int p_len);
+
+	const SceneReplicationState::SyncSnapshot *_capture_sync_state(const ObjectID &p_oid, MultiplayerSynchronizer *p_sync, Node *p_node);
+	void _update_interest();
+	void _add_sync_candidate(int p_peer, uint64_t p_msec, const ObjectID &p_oid, real_t p_weight);
 	void _send_sync(int p_peer, uint64_t p_msec);
+	void _send_sync_acks(int p_peer);
 	Error _send_spawn(Node *p_node, MultiplayerSpawner *p_spawner, int p_peer);
 	Error _send_despawn(Node *p_node, int p_peer);
 	Error _send_raw(const uint8_t *p_buffer, int p_size, int p_peer, bool p_reliable);
@@ -50,6 +87,15 @@ private:
 	MultiplayerAPI *multiplayer = nullptr;
 	PackedByteArray packet_cache;
 	int sync_mtu = 1350; // Highly dependent on underlying protocol.
+	uint32_t sync_frame = 0;
+	int sync_bandwidth_limit = 0; // Bytes per second for each peer, 0 means unlimited.
+
+	// Rebuilt each network frame when at least one peer has an interest origin.
+	bool interest_enabled = false;
+	LocalVector<InterestEntry> interest_global; // Synced nodes relevant to every peer.
+	HashMap<int, LocalVector<InterestEntry>> interest_peers; // Synced nodes in range of each peer origin.
+	LocalVector<SyncCandidate> sync_candidates;
+	LocalVector<uint16_t> sync_acks;
 
 	// An hack to apply the initial state before ready.
 	ObjectID pending_spawn;
@@ -70,6 +116,9 @@ public:
 	virtual Error on_replication_start(Object *p_obj, Variant p_config) override;
 	virtual Error on_replication_stop(Object *p_obj, Variant p_config) override;
 	virtual void on_network_process() override;
+	virtual void set_peer_interest_origin(int p_peer, const Vector3 &p_origin) override;
+	virtual void clear_peer_interest_origin(int p_peer) override;
+	virtual void set_bandwidth_limit(int p_bytes_per_second) override;
 
 	virtual Error on_spawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) override;
 	virtual Error on_despawn_receive(int p_from, const uint8_t *p_buffer, int p_buffer_len) override;
@@ -49,6 +49,7 @@ void SceneReplicationState::_untrack(const ObjectID &p_id) {
 		uint32_t net_id = tracked_nodes[p_id].net_id;
 		uint32_t peer = tracked_nodes[p_id].remote_peer;
 		tracked_nodes.erase(p_id);
+		synced_nodes.erase(p_id);
 		// If it was spawned by a remote, remove it from the received nodes.
 		if (peer && peers_info.has(peer)) {
 			peers_info[peer].recv_nodes.erase(net_id);
@@ -58,6 +59,7 @@ void SceneReplicationState::_untrack(const ObjectID &p_id) {
 			const int *k = nullptr;
 			while ((k = peers_info.next(k))) {
 				peers_info.get(*k).known_nodes.erase(p_id);
+				peers_info.get(*k).sync_states.erase(p_id);
 			}
 		}
 	}
@@ -140,6 +142,11 @@ void SceneReplicationState::reset() {
 		tobj.net_id = 0;
 		tobj.remote_peer = 0;
 		tobj.last_sync = 0;
+		tobj.last_capture_frame = 0;
+		tobj.sync_history.clear();
+		tobj.encoded_frame = 0;
+		tobj.encoded_states.clear();
+		tobj.encoded_data.clear();
 	}
 }
 
@@ -169,6 +176,7 @@ Error SceneReplicationState::config_add_sync(Node *p_node, MultiplayerSynchroniz
 	TrackedNode &tobj = _track(oid);
 	ERR_FAIL_COND_V(tobj.synchronizer != ObjectID(), ERR_ALREADY_IN_USE);
 	tobj.synchronizer = p_sync->get_instance_id();
+	synced_nodes.insert(oid);
 	// If it doesn't have a spawner, we might need to assign ID for this node using it's path.
 	if (tobj.spawner.is_null()) {
 		path_only_nodes.insert(oid);
@@ -182,6 +190,7 @@ Error SceneReplicationState::config_del_sync(Node *p_node, MultiplayerSynchroniz
 	TrackedNode &tobj = _track(oid);
 	ERR_FAIL_COND_V(tobj.synchronizer != p_sync->get_instance_id(), ERR_INVALID_PARAMETER);
 	tobj.synchronizer = ObjectID();
+	synced_nodes.erase(oid);
 	if (path_only_nodes.has(oid)) {
 		p_node->disconnect(SceneStringNames::get_singleton()->tree_exited, callable_mp(this, &SceneReplicationState::_untrack));
 		_untrack(oid);
@@ -207,10 +216,12 @@ Error SceneReplicationState::peer_del_node(int p_peer, const ObjectID &p_id) {
 	if (p_peer) {
 		ERR_FAIL_COND_V(!peers_info.has(p_peer), ERR_INVALID_PARAMETER);
 		peers_info[p_peer].known_nodes.erase(p_id);
+		peers_info[p_peer].sync_states.erase(p_id);
 	} else {
 		const int *pid = nullptr;
 		while ((pid = peers_info.next(pid))) {
 			peers_info.get(*pid).known_nodes.erase(p_id);
+			peers_info.get(*pid).sync_states.erase(p_id);
 		}
 	}
 	return OK;
@@ -243,16 +254,246 @@ Error SceneReplicationState::peer_del_remote(int p_peer, uint32_t p_net_id, Node
 	ERR_FAIL_COND_V(!info.recv_nodes.has(p_net_id), ERR_UNAUTHORIZED);
 	*r_node = Object::cast_to<Node>(ObjectDB::get_instance(info.recv_nodes[p_net_id]));
 	info.recv_nodes.erase(p_net_id);
+	info.recv_sync_states.erase(p_net_id);
 	return OK;
 }
 
 uint16_t SceneReplicationState::peer_sync_next(int p_peer) {
 	ERR_FAIL_COND_V(!peers_info.has(p_peer), 0);
 	PeerInfo &info = peers_info[p_peer];
-	return ++info.last_sent_sync;
+	const uint16_t seq = ++info.last_sent_sync;
+	// Forget the packet sent SYNC_SENT_HISTORY_SIZE sequences ago, if it was never acknowledged.
+	info.sent_syncs.erase(uint16_t(seq - SYNC_SENT_HISTORY_SIZE));
+	return seq;
 }
 
 void SceneReplicationState::peer_sync_recv(int p_peer, uint16_t p_time) {
 	ERR_FAIL_COND(!peers_info.has(p_peer));
 	peers_info[p_peer].last_recv_sync = p_time;
 }
+
+uint32_t SceneReplicationState::get_sync_capture_frame(const ObjectID &p_id) const {
+	const TrackedNode *tnode = tracked_nodes.getptr(p_id);
+	ERR_FAIL_COND_V(!tnode, 0);
+	return tnode->last_capture_frame;
+}
+
+const SceneReplicationState::SyncSnapshot *SceneReplicationState::get_sync_snapshot(const ObjectID &p_id, uint32_t p_frame) const {
+	const TrackedNode *tnode = tracked_nodes.getptr(p_id);
+	ERR_FAIL_COND_V(!tnode, nullptr);
+	if (tnode->sync_history.is_empty()) {
+		return nullptr;
+	}
+	if (p_frame == 0) {
+		return &tnode->sync_history[tnode->sync_history.size() - 1];
+	}
+	for (uint32_t i = 0; i < tnode->sync_history.size(); i++) {
+		if (tnode->sync_history[i].frame == p_frame) {
+			return &tnode->sync_history[i];
+		}
+	}
+	return nullptr;
+}
+
+void SceneReplicationState::push_sync_snapshot(const ObjectID &p_id, uint32_t p_frame, const Vector<Variant> &p_state) {
+	TrackedNode *tnode = tracked_nodes.getptr(p_id);
+	ERR_FAIL_COND(!tnode);
+	tnode->last_capture_frame = p_frame;
+	LocalVector<SyncSnapshot> &history = tnode->sync_history;
+	if (!history.is_empty() && history[history.size() - 1].state == p_state) {
+		return; // Unchanged, keep referencing the frame it was first captured in.
+	}
+	if (history.size() == SYNC_HISTORY_SIZE) {
+		history.remove_at(0);
+	}
+	SyncSnapshot snapshot;
+	snapshot.frame = p_frame;
+	snapshot.state = p_state;
+	history.push_back(snapshot);
+}
+
+bool SceneReplicationState::get_encoded_sync_state(const ObjectID &p_id, uint32_t p_frame, uint32_t p_baseline_frame, const uint8_t *&r_data, int &r_size) const {
+	const TrackedNode *tnode = tracked_nodes.getptr(p_id);
+	ERR_FAIL_COND_V(!tnode, false);
+	if (tnode->encoded_frame != p_frame) {
+		return false;
+	}
+	for (uint32_t i = 0; i < tnode->encoded_states.size(); i++) {
+		const EncodedSyncState &encoded = tnode->encoded_states[i];
+		if (encoded.baseline_frame == p_baseline_frame) {
+			r_data = tnode->encoded_data.ptr() + encoded.offset;
+			r_size = encoded.size;
+			return true;
+		}
+	}
+	return false;
+}
+
+uint8_t *SceneReplicationState::add_encoded_sync_state(const ObjectID &p_id, uint32_t p_frame, uint32_t p_baseline_frame, int p_size) {
+	TrackedNode *tnode = tracked_nodes.getptr(p_id);
+	ERR_FAIL_COND_V(!tnode, nullptr);
+	if (tnode->encoded_frame != p_frame) {
+		// A new state was captured, previous encodings are stale (keep the capacity).
+		tnode->encoded_frame = p_frame;
+		tnode->encoded_states.clear();
+		tnode->encoded_data.clear();
+	}
+	EncodedSyncState encoded;
+	encoded.baseline_frame = p_baseline_frame;
+	encoded.offset = tnode->encoded_data.size();
+	encoded.size = p_size;
+	tnode->encoded_states.push_back(encoded);
+	tnode->encoded_data.resize(encoded.offset + p_size);
+	return tnode->encoded_data.ptr() + encoded.offset;
+}
+
+const SceneReplicationState::SyncSnapshot *SceneReplicationState::peer_get_sync_baseline(int p_peer, const ObjectID &p_id, uint16_t &r_seq) const {
+	const PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, nullptr);
+	const PeerSyncState *pstate = info->sync_states.getptr(p_id);
+	if (!pstate || pstate->acked_frame == 0) {
+		return nullptr;
+	}
+	// The receiver only keeps the last SYNC_HISTORY_SIZE states it got for each node.
+	if (pstate->sent_count - pstate->acked_sent_count >= SYNC_HISTORY_SIZE - 1) {
+		return nullptr;
+	}
+	r_seq = pstate->acked_seq;
+	return get_sync_snapshot(p_id, pstate->acked_frame);
+}
+
+void SceneReplicationState::peer_sync_sent(int p_peer, uint16_t p_seq, const ObjectID &p_id, uint32_t p_frame) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND(!info);
+	PeerSyncState &pstate = info->sync_states[p_id];
+	pstate.sent_count++;
+	pstate.interest = 0;
+
+	SentSync::Node node;
+	node.id = p_id;
+	node.frame = p_frame;
+	node.sent_count = pstate.sent_count;
+	info->sent_syncs[p_seq].nodes.push_back(node);
+}
+
+void SceneReplicationState::peer_sync_ack(int p_peer, uint16_t p_seq) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND(!info);
+	const SentSync *sent = info->sent_syncs.getptr(p_seq);
+	if (!sent) {
+		return; // Acknowledged twice, or too old.
+	}
+	// Every state in the acknowledged packet is now a valid baseline for that node, unless a newer one was acknowledged first.
+	for (uint32_t i = 0; i < sent->nodes.size(); i++) {
+		const SentSync::Node &node = sent->nodes[i];
+		PeerSyncState *pstate = info->sync_states.getptr(node.id);
+		if (pstate && (pstate->acked_frame == 0 || node.sent_count > pstate->acked_sent_count)) {
+			pstate->acked_frame = node.frame;
+			pstate->acked_seq = p_seq;
+			pstate->acked_sent_count = node.sent_count;
+		}
+	}
+	info->sent_syncs.erase(p_seq);
+}
+
+const Vector<Variant> *SceneReplicationState::peer_get_recv_sync_state(int p_peer, uint32_t p_net_id, uint16_t p_seq) const {
+	const PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, nullptr);
+	const LocalVector<SyncSnapshot> *history = info->recv_sync_states.getptr(p_net_id);
+	if (!history) {
+		return nullptr;
+	}
+	for (int i = int(history->size()) - 1; i >= 0; i--) {
+		if ((*history)[i].frame == p_seq) {
+			return &(*history)[i].state;
+		}
+	}
+	return nullptr;
+}
+
+void SceneReplicationState::peer_store_recv_sync_state(int p_peer, uint32_t p_net_id, uint16_t p_seq, const Vector<Variant> &p_state) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND(!info);
+	LocalVector<SyncSnapshot> &history = info->recv_sync_states[p_net_id];
+	if (history.size() == SYNC_HISTORY_SIZE) {
+		history.remove_at(0);
+	}
+	SyncSnapshot snapshot;
+	snapshot.frame = p_seq;
+	snapshot.state = p_state;
+	history.push_back(snapshot);
+}
+
+void SceneReplicationState::peer_sync_decoded(int p_peer, uint16_t p_seq) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND(!info);
+	info->sync_acks.push_back(p_seq);
+}
+
+bool SceneReplicationState::peer_take_sync_acks(int p_peer, LocalVector<uint16_t> &r_seqs) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, false);
+	if (info->sync_acks.is_empty()) {
+		return false;
+	}
+	r_seqs = info->sync_acks;
+	info->sync_acks.clear();
+	return true;
+}
+
+void SceneReplicationState::peer_set_interest_origin(int p_peer, const Vector3 &p_origin) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND(!info);
+	info->has_interest_origin = true;
+	info->interest_origin = p_origin;
+}
+
+void SceneReplicationState::peer_clear_interest_origin(int p_peer) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND(!info);
+	info->has_interest_origin = false;
+}
+
+bool SceneReplicationState::peer_get_interest_origin(int p_peer, Vector3 &r_origin) const {
+	const PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, false);
+	r_origin = info->interest_origin;
+	return info->has_interest_origin;
+}
+
+real_t SceneReplicationState::peer_get_sync_interest(int p_peer, const ObjectID &p_id) const {
+	const PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, 0);
+	const PeerSyncState *pstate = info->sync_states.getptr(p_id);
+	return pstate ? pstate->interest : 0;
+}
+
+real_t SceneReplicationState::peer_add_sync_interest(int p_peer, const ObjectID &p_id, real_t p_amount) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, 0);
+	PeerSyncState &pstate = info->sync_states[p_id];
+	pstate.interest += p_amount;
+	return pstate.interest;
+}
+
+int SceneReplicationState::peer_refill_sync_budget(int p_peer, int p_bytes_per_second, int p_burst, uint64_t p_msec) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND_V(!info, 0);
+	if (info->sync_budget < 0) {
+		info->sync_budget = p_burst;
+		info->sync_budget_msec = p_msec;
+	} else if (p_msec > info->sync_budget_msec) {
+		const uint64_t refill = uint64_t(p_bytes_per_second) * (p_msec - info->sync_budget_msec) / 1000;
+		if (refill) { // Otherwise keep accumulating time, so low rates still refill.
+			info->sync_budget = int(MIN(uint64_t(info->sync_budget) + refill, uint64_t(p_burst)));
+			info->sync_budget_msec = p_msec;
+		}
+	}
+	return info->sync_budget;
+}
+
+void SceneReplicationState::peer_consume_sync_budget(int p_peer, int p_bytes) {
+	PeerInfo *info = peers_info.getptr(p_peer);
+	ERR_FAIL_COND(!info);
+	info->sync_budget = MAX(info->sync_budget - p_bytes, 0);
+}
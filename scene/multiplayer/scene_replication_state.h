@@ -32,13 +32,35 @@
 #define SCENE_REPLICATON_STATE_H
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class MultiplayerSpawner;
 class MultiplayerSynchronizer;
 class Node;
 
 class SceneReplicationState : public RefCounted {
+public:
+	enum {
+		// How many sync states are kept per node, both by the sender (to rebuild
+		// acknowledged baselines) and by the receiver (to apply deltas against them).
+		SYNC_HISTORY_SIZE = 16,
+		// How many sent sync packets per peer are remembered while waiting for an ack.
+		// A tick can span many packets, and acks take at least a round trip.
+		SYNC_SENT_HISTORY_SIZE = 1024,
+	};
+
+	struct SyncSnapshot {
+		uint32_t frame = 0; // Sync frame on the sender, packet sequence on the receiver.
+		Vector<Variant> state;
+	};
+
 private:
+	struct EncodedSyncState {
+		uint32_t baseline_frame = 0; // Zero for the full state.
+		uint32_t offset = 0;
+		uint32_t size = 0;
+	};
+
 	struct TrackedNode {
 		ObjectID id;
 		uint32_t net_id = 0;
@@ -47,6 +69,12 @@ private:
 		ObjectID synchronizer;
 		uint16_t last_sync = 0;
 		uint64_t last_sync_msec = 0;
+		uint32_t last_capture_frame = 0;
+		LocalVector<SyncSnapshot> sync_history; // Distinct captured states, oldest first.
+		// Encodings of the latest state, shared by all the peers using the same baseline.
+		uint32_t encoded_frame = 0;
+		LocalVector<EncodedSyncState> encoded_states;
+		LocalVector<uint8_t> encoded_data;
 
 		bool operator==(const ObjectID &p_other) { return id == p_other; }
 
@@ -61,11 +89,42 @@ private:
 		}
 	};
 
+	struct PeerSyncState {
+		uint32_t sent_count = 0;
+		uint32_t acked_frame = 0; // Zero until the peer acknowledged a state.
+		uint32_t acked_sent_count = 0;
+		uint16_t acked_seq = 0;
+		real_t interest = 0; // Accumulated relevancy since the last state was sent.
+	};
+
+	struct SentSync {
+		struct Node {
+			ObjectID id;
+			uint32_t frame = 0;
+			uint32_t sent_count = 0;
+		};
+		LocalVector<Node> nodes;
+	};
+
 	struct PeerInfo {
 		Set<ObjectID> known_nodes;
 		HashMap<uint32_t, ObjectID> recv_nodes;
 		uint16_t last_sent_sync = 0;
 		uint16_t last_recv_sync = 0;
+
+		// Sender side delta tracking.
+		HashMap<ObjectID, PeerSyncState> sync_states;
+		HashMap<uint16_t, SentSync> sent_syncs; // By packet sequence.
+
+		// Receiver side delta baselines, by net ID.
+		HashMap<uint32_t, LocalVector<SyncSnapshot>> recv_sync_states;
+		LocalVector<uint16_t> sync_acks; // Decoded packets not acknowledged yet.
+
+		// Interest management.
+		bool has_interest_origin = false;
+		Vector3 interest_origin;
+		int sync_budget = -1; // Bytes that can still be sent, -1 until first refilled.
+		uint64_t sync_budget_msec = 0;
 	};
 
 	Set<int> known_peers;
@@ -74,6 +133,7 @@ private:
 	HashMap<int, PeerInfo> peers_info;
 	Set<ObjectID> spawned_nodes;
 	Set<ObjectID> path_only_nodes;
+	Set<ObjectID> synced_nodes;
 
 	TrackedNode &_track(const ObjectID &p_id);
 	void _untrack(const ObjectID &p_id);
@@ -83,6 +143,7 @@ public:
 	const Set<int> get_peers() const { return known_peers; }
 	const Set<ObjectID> get_spawned_nodes() const { return spawned_nodes; }
 	const Set<ObjectID> get_path_only_nodes() const { return path_only_nodes; }
+	const Set<ObjectID> &get_synced_nodes() const { return synced_nodes; }
 
 	MultiplayerSynchronizer *get_synchronizer(const ObjectID &p_id) { return tracked_nodes.has(p_id) ? tracked_nodes[p_id].get_synchronizer() : nullptr; }
 	MultiplayerSpawner *get_spawner(const ObjectID &p_id) { return tracked_nodes.has(p_id) ? tracked_nodes[p_id].get_spawner() : nullptr; }
@@ -115,6 +176,29 @@ public:
 	uint16_t peer_sync_next(int p_peer);
 	void peer_sync_recv(int p_peer, uint16_t p_time);
 
+	uint32_t get_sync_capture_frame(const ObjectID &p_id) const;
+	const SyncSnapshot *get_sync_snapshot(const ObjectID &p_id, uint32_t p_frame = 0) const;
+	void push_sync_snapshot(const ObjectID &p_id, uint32_t p_frame, const Vector<Variant> &p_state);
+	bool get_encoded_sync_state(const ObjectID &p_id, uint32_t p_frame, uint32_t p_baseline_frame, const uint8_t *&r_data, int &r_size) const;
+	uint8_t *add_encoded_sync_state(const ObjectID &p_id, uint32_t p_frame, uint32_t p_baseline_frame, int p_size);
+
+	const SyncSnapshot *peer_get_sync_baseline(int p_peer, const ObjectID &p_id, uint16_t &r_seq) const;
+	void peer_sync_sent(int p_peer, uint16_t p_seq, const ObjectID &p_id, uint32_t p_frame);
+	void peer_sync_ack(int p_peer, uint16_t p_seq);
+
+	const Vector<Variant> *peer_get_recv_sync_state(int p_peer, uint32_t p_net_id, uint16_t p_seq) const;
+	void peer_store_recv_sync_state(int p_peer, uint32_t p_net_id, uint16_t p_seq, const Vector<Variant> &p_state);
+	void peer_sync_decoded(int p_peer, uint16_t p_seq);
+	bool peer_take_sync_acks(int p_peer, LocalVector<uint16_t> &r_seqs);
+
+	void peer_set_interest_origin(int p_peer, const Vector3 &p_origin);
+	void peer_clear_interest_origin(int p_peer);
+	bool peer_get_interest_origin(int p_peer, Vector3 &r_origin) const;
+	real_t peer_get_sync_interest(int p_peer, const ObjectID &p_id) const;
+	real_t peer_add_sync_interest(int p_peer, const ObjectID &p_id, real_t p_amount);
+	int peer_refill_sync_budget(int p_peer, int p_bytes_per_second, int p_burst, uint64_t p_msec);
+	void peer_consume_sync_budget(int p_peer, int p_bytes);
+
 	SceneReplicationState() {}
 };
 
@@ -1063,7 +1063,7 @@ Error Animation::position_track_get_key(int p_track, int p_key, Vector3 *r_posit
 	return OK;
 }
 
-Error Animation::position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation) const {
+Error Animation::position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_POSITION_3D, ERR_INVALID_PARAMETER);
@@ -1071,7 +1071,7 @@ Error Animation::position_track_interpolate(int p_track, double p_time, Vector3
 	PositionTrack *tt = static_cast<PositionTrack *>(t);
 
 	if (tt->compressed_track >= 0) {
-		if (_pos_scale_interpolate_compressed(tt->compressed_track, p_time, *r_interpolation)) {
+		if (_pos_scale_interpolate_compressed(tt->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1135,7 +1135,7 @@ Error Animation::rotation_track_get_key(int p_track, int p_key, Quaternion *r_ro
 	return OK;
 }
 
-Error Animation::rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation) const {
+Error Animation::rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_ROTATION_3D, ERR_INVALID_PARAMETER);
@@ -1143,7 +1143,7 @@ Error Animation::rotation_track_interpolate(int p_track, double p_time, Quaterni
 	RotationTrack *rt = static_cast<RotationTrack *>(t);
 
 	if (rt->compressed_track >= 0) {
-		if (_rotation_interpolate_compressed(rt->compressed_track, p_time, *r_interpolation)) {
+		if (_rotation_interpolate_compressed(rt->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1207,7 +1207,7 @@ Error Animation::scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) c
 	return OK;
 }
 
-Error Animation::scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation) const {
+Error Animation::scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_SCALE_3D, ERR_INVALID_PARAMETER);
@@ -1215,7 +1215,7 @@ Error Animation::scale_track_interpolate(int p_track, double p_time, Vector3 *r_
 	ScaleTrack *st = static_cast<ScaleTrack *>(t);
 
 	if (st->compressed_track >= 0) {
-		if (_pos_scale_interpolate_compressed(st->compressed_track, p_time, *r_interpolation)) {
+		if (_pos_scale_interpolate_compressed(st->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -1277,7 +1277,7 @@ Error Animation::blend_shape_track_get_key(int p_track, int p_key, float *r_blen
 	return OK;
 }
 
-Error Animation::blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation) const {
+Error Animation::blend_shape_track_interpolate(int p_track, double p_time, float *r_interpolation, CompressedCursor *r_cursor) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), ERR_INVALID_PARAMETER);
 	Track *t = tracks[p_track];
 	ERR_FAIL_COND_V(t->type != TYPE_BLEND_SHAPE, ERR_INVALID_PARAMETER);
@@ -1285,7 +1285,7 @@ Error Animation::blend_shape_track_interpolate(int p_track, double p_time, float
 	BlendShapeTrack *bst = static_cast<BlendShapeTrack *>(t);
 
 	if (bst->compressed_track >= 0) {
-		if (_blend_shape_interpolate_compressed(bst->compressed_track, p_time, *r_interpolation)) {
+		if (_blend_shape_interpolate_compressed(bst->compressed_track, p_time, *r_interpolation, r_cursor)) {
 			return OK;
 		} else {
 			return ERR_UNAVAILABLE;
@@ -4923,13 +4923,13 @@ void Animation::compress(uint32_t p_page_size, uint32_t p_fps, float p_split_tol
 #endif
 }
 
-bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const {
+bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret, CompressedCursor *r_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -4947,13 +4947,13 @@ bool Animation::_rotation_interpolate_compressed(uint32_t p_compressed_track, do
 	return true;
 }
 
-bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const {
+bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret, CompressedCursor *r_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<3>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -4970,13 +4970,13 @@ bool Animation::_pos_scale_interpolate_compressed(uint32_t p_compressed_track, d
 
 	return true;
 }
-bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const {
+bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret, CompressedCursor *r_cursor) const {
 	Vector3i current;
 	Vector3i next;
 	double time_current;
 	double time_next;
 
-	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next)) {
+	if (!_fetch_compressed<1>(p_compressed_track, p_time, current, time_current, next, time_next, nullptr, r_cursor)) {
 		return false; //some sort of problem
 	}
 
@@ -4995,7 +4995,7 @@ bool Animation::_blend_shape_interpolate_compressed(uint32_t p_compressed_track,
 }
 
 template <uint32_t COMPONENTS>
-bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index, CompressedCursor *r_cursor) const {
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 	p_time = CLAMP(p_time, 0, length);
@@ -5005,12 +5005,23 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 
 	double frame_to_sec = 1.0 / double(compression.fps);
 
+	uint32_t page_count = compression.pages.size();
 	int32_t page_index = -1;
-	for (uint32_t i = 0; i < compression.pages.size(); i++) {
-		if (compression.pages[i].time_offset > p_time) {
-			break;
+	if (r_cursor && r_cursor->page < page_count && compression.pages[r_cursor->page].time_offset <= p_time && (r_cursor->page + 1 == page_count || compression.pages[r_cursor->page + 1].time_offset > p_time)) {
+		page_index = r_cursor->page;
+	} else {
+		// Pages are sorted by time, find the last one starting before p_time.
+		uint32_t low = 0;
+		uint32_t high = page_count;
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+			if (compression.pages[middle].time_offset > p_time) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
 		}
-		page_index = i;
+		page_index = int32_t(low) - 1;
 	}
 
 	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
@@ -5024,27 +5035,48 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 	const uint16_t *time_keys = (const uint16_t *)&page_data[indices[p_compressed_track * 3 + 0]];
 	uint32_t time_key_count = indices[p_compressed_track * 3 + 1];
 
-	int32_t packet_idx = 0;
-	double packet_time = double(time_keys[0]) * frame_to_sec + page_base_time;
-	uint32_t base_frame = time_keys[0];
-
-	for (uint32_t i = 1; i < time_key_count; i++) {
-		uint32_t f = time_keys[i * 2 + 0];
-		double frame_time = double(f) * frame_to_sec + page_base_time;
+	// Find the last time key starting at or before p_time (or the first one).
+	// When sampling forward in time, it is usually the cursor key or the one after it.
+	int32_t packet_idx = -1;
+	if (r_cursor && r_cursor->page == uint32_t(page_index)) {
+		for (uint32_t i = r_cursor->packet; i < MIN(r_cursor->packet + 2, time_key_count); i++) {
+			bool starts_before = i == 0 || double(time_keys[i * 2 + 0]) * frame_to_sec + page_base_time <= p_time;
+			bool next_starts_after = i + 1 == time_key_count || double(time_keys[(i + 1) * 2 + 0]) * frame_to_sec + page_base_time > p_time;
+			if (starts_before && next_starts_after) {
+				packet_idx = i;
+				break;
+			}
+		}
+	}
 
-		if (frame_time > p_time) {
-			break;
+	if (packet_idx == -1) {
+		uint32_t low = 1;
+		uint32_t high = time_key_count;
+		while (low < high) {
+			uint32_t middle = (low + high) / 2;
+			if (double(time_keys[middle * 2 + 0]) * frame_to_sec + page_base_time > p_time) {
+				high = middle;
+			} else {
+				low = middle + 1;
+			}
 		}
+		packet_idx = int32_t(low) - 1;
+	}
 
-		if (key_index) {
-			(*key_index) += (time_keys[(i - 1) * 2 + 1] >> 12) + 1;
+	if (key_index) {
+		for (int32_t i = 0; i < packet_idx; i++) {
+			(*key_index) += (time_keys[i * 2 + 1] >> 12) + 1;
 		}
+	}
 
-		packet_idx = i;
-		packet_time = frame_time;
-		base_frame = f;
+	if (r_cursor) {
+		r_cursor->page = page_index;
+		r_cursor->packet = packet_idx;
 	}
 
+	uint32_t base_frame = time_keys[packet_idx * 2 + 0];
+	double packet_time = double(base_frame) * frame_to_sec + page_base_time;
+
 	const uint8_t *data_keys_base = (const uint8_t *)&page_data[indices[p_compressed_track * 3 + 2]];
 
 	uint16_t time_key_data = time_keys[packet_idx * 2 + 1];
@@ -77,6 +77,13 @@ public:
 		HANDLE_MODE_BALANCED,
 	};
 
+	// Remembers where a compressed track was last sampled, so sampling it
+	// again at the same or a slightly later time skips the page and time key search.
+	struct CompressedCursor {
+		uint32_t page = UINT32_MAX;
+		uint32_t packet = 0;
+	};
+
 private:
 	struct Track {
 		TrackType type = TrackType::TYPE_ANIMATION;
@@ -314,11 +321,11 @@ private:
 	} compression;
 
 	Vector3i _compress_key(uint32_t p_track, const AABB &p_bounds, int32_t p_key = -1, float p_time = 0.0);
-	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret) const;
-	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret) const;
-	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const;
+	bool _rotation_interpolate_compressed(uint32_t p_compressed_track, double p_time, Quaternion &r_ret, CompressedCursor *r_cursor = nullptr) const;
+	bool _pos_scale_interpolate_compressed(uint32_t p_compressed_track, double p_time, Vector3 &r_ret, CompressedCursor *r_cursor = nullptr) const;
+	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret, CompressedCursor *r_cursor = nullptr) const;
 	template <uint32_t COMPONENTS>
-	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
+	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr, CompressedCursor *r_cursor = nullptr) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Vector3i &r_value, double &r_time) const;
 	int _get_compressed_key_count(uint32_t p_compressed_track) const;
@@ -407,19 +414,19 @@ public:
 
 	int position_track_insert_key(int p_track, double p_time, const Vector3 &p_position);
 	Error position_track_get_key(int p_track, int p_key, Vector3 *r_position) const;
-	Error position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation) const;
+	Error position_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, CompressedCursor *r_cursor = nullptr) const;
 
 	int rotation_track_insert_key(int p_track, double p_time, const Quaternion &p_rotation);
 	Error rotation_track_get_key(int p_track, int p_key, Quaternion *r_rotation) const;
-	Error rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation) const;
+	Error rotation_track_interpolate(int p_track, double p_time, Quaternion *r_interpolation, CompressedCursor *r_cursor = nullptr) const;
 
 	int scale_track_insert_key(int p_track, double p_time, const Vector3 &p_scale);
 	Error scale_track_get_key(int p_track, int p_key, Vector3 *r_scale) const;
-	Error scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation) const;
+	Error scale_track_interpolate(int p_track, double p_time, Vector3 *r_interpolation, CompressedCursor *r_cursor = nullptr) const;
 
 	int blend_shape_track_insert_key(int p_track, double p_time, float p_blend);
 	Error blend_shape_track_get_key(int p_track, int p_key, float *r_blend) const;
-	Error blend_shape_track_interpolate(int p_track, double p_time, float *r_blend) const;
+	Error blend_shape_track_interpolate(int p_track, double p_time, float *r_blend, CompressedCursor *r_cursor = nullptr) const;
 
 	void track_set_interpolation_type(int p_track, InterpolationType p_interp);
 	InterpolationType track_get_interpolation_type(int p_track) const;
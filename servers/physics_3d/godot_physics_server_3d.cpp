@@ -1611,11 +1611,16 @@ void GodotPhysicsServer3D::step(real_t p_step) {
 	island_count = 0;
 	active_objects = 0;
 	collision_pairs = 0;
+	history_memory = 0;
 	for (Set<const GodotSpace3D *>::Element *E = active_spaces.front(); E; E = E->next()) {
-		stepper->step(const_cast<GodotSpace3D *>(E->get()), p_step);
-		island_count += E->get()->get_island_count();
-		active_objects += E->get()->get_active_objects();
-		collision_pairs += E->get()->get_collision_pairs();
+		GodotSpace3D *space = const_cast<GodotSpace3D *>(E->get());
+		// Recorded before stepping, as the state queries in the past see.
+		space->record_history();
+		stepper->step(space, p_step);
+		island_count += space->get_island_count();
+		active_objects += space->get_active_objects();
+		collision_pairs += space->get_collision_pairs();
+		history_memory += space->get_history_memory();
 	}
 #endif
 }
@@ -1696,6 +1701,9 @@ int GodotPhysicsServer3D::get_process_info(ProcessInfo p_info) {
 		case INFO_ISLAND_COUNT: {
 			return island_count;
 		} break;
+		case INFO_HISTORY_MEMORY: {
+			return history_memory;
+		} break;
 	}
 
 	return 0;
@@ -48,6 +48,7 @@ class GodotPhysicsServer3D : public PhysicsServer3D {
 	int island_count = 0;
 	int active_objects = 0;
 	int collision_pairs = 0;
+	int history_memory = 0;
 
 	bool using_threads = false;
 	bool doing_sync = false;
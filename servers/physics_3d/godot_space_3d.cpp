@@ -114,7 +114,7 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 	end = p_parameters.to;
 	normal = (end - begin).normalized();
 
-	int amount = space->broadphase->cull_segment(begin, end, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->_cull_query_segment(begin, end, p_parameters.rewind_ticks);
 
 	//todo, create another array that references results, compute AABBs and check closest point to ray origin, sort, and stop evaluating results when beyond first collision
 
@@ -140,7 +140,12 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
 
 		int shape_idx = space->intersection_query_subindex_results[i];
-		Transform3D inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
+		Transform3D inv_xform;
+		if (p_parameters.rewind_ticks > 0) {
+			inv_xform = space->intersection_query_transform_results[i].affine_inverse();
+		} else {
+			inv_xform = col_obj->get_shape_inv_transform(shape_idx) * col_obj->get_inv_transform();
+		}
 
 		Vector3 local_from = inv_xform.xform(begin);
 		Vector3 local_to = inv_xform.xform(end);
@@ -166,7 +171,7 @@ bool GodotPhysicsDirectSpaceState3D::intersect_ray(const RayParameters &p_parame
 		}
 
 		if (shape->intersect_segment(local_from, local_to, shape_point, shape_normal, p_parameters.hit_back_faces)) {
-			Transform3D xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+			Transform3D xform = space->_get_query_shape_transform(i, p_parameters.rewind_ticks);
 			shape_point = xform.xform(shape_point);
 
 			real_t ld = normal.dot(shape_point);
@@ -210,7 +215,7 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 
 	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->_cull_query_aabb(aabb, p_parameters.rewind_ticks);
 
 	int cc = 0;
 
@@ -234,7 +239,7 @@ int GodotPhysicsDirectSpaceState3D::intersect_shape(const ShapeParameters &p_par
 		const GodotCollisionObject3D *col_obj = space->intersection_query_results[i];
 		int shape_idx = space->intersection_query_subindex_results[i];
 
-		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
+		if (!GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), space->_get_query_shape_transform(i, p_parameters.rewind_ticks), nullptr, nullptr, nullptr, p_parameters.margin, 0)) {
 			continue;
 		}
 
@@ -263,7 +268,7 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 	aabb = aabb.merge(AABB(aabb.position + p_parameters.motion, aabb.size)); //motion
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->_cull_query_aabb(aabb, p_parameters.rewind_ticks);
 
 	real_t best_safe = 1;
 	real_t best_unsafe = 1;
@@ -294,7 +299,7 @@ bool GodotPhysicsDirectSpaceState3D::cast_motion(const ShapeParameters &p_parame
 		Vector3 point_A, point_B;
 		Vector3 sep_axis = motion_normal;
 
-		Transform3D col_obj_xform = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+		Transform3D col_obj_xform = space->_get_query_shape_transform(i, p_parameters.rewind_ticks);
 		//test initial overlap, does it collide if going all the way?
 		if (GodotCollisionSolver3D::solve_distance(&mshape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj_xform, point_A, point_B, aabb, &sep_axis)) {
 			continue;
@@ -385,7 +390,7 @@ bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_para
 	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
 	aabb = aabb.grow(p_parameters.margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->_cull_query_aabb(aabb, p_parameters.rewind_ticks);
 
 	bool collided = false;
 	r_result_count = 0;
@@ -411,7 +416,7 @@ bool GodotPhysicsDirectSpaceState3D::collide_shape(const ShapeParameters &p_para
 
 		int shape_idx = space->intersection_query_subindex_results[i];
 
-		if (GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), cbkres, cbkptr, nullptr, p_parameters.margin)) {
+		if (GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), space->_get_query_shape_transform(i, p_parameters.rewind_ticks), cbkres, cbkptr, nullptr, p_parameters.margin)) {
 			collided = true;
 		}
 	}
@@ -513,7 +518,7 @@ bool GodotPhysicsDirectSpaceState3D::rest_info(const ShapeParameters &p_paramete
 	AABB aabb = p_parameters.transform.xform(shape->get_aabb());
 	aabb = aabb.grow(margin);
 
-	int amount = space->broadphase->cull_aabb(aabb, space->intersection_query_results, GodotSpace3D::INTERSECTION_QUERY_MAX, space->intersection_query_subindex_results);
+	int amount = space->_cull_query_aabb(aabb, p_parameters.rewind_ticks);
 
 	_RestCallbackData rcd;
 
@@ -537,7 +542,7 @@ bool GodotPhysicsDirectSpaceState3D::rest_info(const ShapeParameters &p_paramete
 
 		rcd.object = col_obj;
 		rcd.shape = shape_idx;
-		bool sc = GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), col_obj->get_transform() * col_obj->get_shape_transform(shape_idx), _rest_cbk_result, &rcd, nullptr, margin);
+		bool sc = GodotCollisionSolver3D::solve_static(shape, p_parameters.transform, col_obj->get_shape(shape_idx), space->_get_query_shape_transform(i, p_parameters.rewind_ticks), _rest_cbk_result, &rcd, nullptr, margin);
 		if (!sc) {
 			continue;
 		}
@@ -1094,6 +1099,18 @@ void GodotSpace3D::add_object(GodotCollisionObject3D *p_object) {
 void GodotSpace3D::remove_object(GodotCollisionObject3D *p_object) {
 	ERR_FAIL_COND(!objects.has(p_object));
 	objects.erase(p_object);
+
+	for (uint32_t i = 0; i < history.size(); i++) {
+		LocalVector<HistoryShape> &snapshot = history[i];
+		uint32_t j = 0;
+		while (j < snapshot.size()) {
+			if (snapshot[j].object == p_object) {
+				snapshot.remove_at_unordered(j);
+			} else {
+				j++;
+			}
+		}
+	}
 }
 
 const Set<GodotCollisionObject3D *> &GodotSpace3D::get_objects() const {
@@ -1166,6 +1183,144 @@ void GodotSpace3D::update() {
 	broadphase->update();
 }
 
+void GodotSpace3D::_set_history_ticks(int p_ticks) {
+	ERR_FAIL_COND(p_ticks < 0);
+	history_ticks = p_ticks;
+	history_head = 0;
+	history_count = 0;
+	history_memory = 0;
+	history.reset();
+	if (history_ticks == 0) {
+		intersection_query_transform_results.reset();
+		return;
+	}
+	history.resize(history_ticks);
+	intersection_query_transform_results.resize(INTERSECTION_QUERY_MAX);
+}
+
+void GodotSpace3D::record_history() {
+	if (history_ticks == 0) {
+		return;
+	}
+
+	history_head = (history_head + 1) % history_ticks;
+	history_count = MIN(history_count + 1, history_ticks);
+
+	// Snapshots keep their capacity, so a steady scene stops allocating once the ring is full.
+	LocalVector<HistoryShape> &snapshot = history[history_head];
+	snapshot.clear();
+	for (const Set<GodotCollisionObject3D *>::Element *E = objects.front(); E; E = E->next()) {
+		GodotCollisionObject3D *object = E->get();
+		if (!_is_history_tracked(object)) {
+			continue;
+		}
+
+		for (int i = 0; i < object->get_shape_count(); i++) {
+			if (object->is_shape_disabled(i)) {
+				continue;
+			}
+
+			HistoryShape hs;
+			hs.object = object;
+			hs.shape = object->get_shape(i);
+			hs.index = i;
+			hs.aabb = object->get_shape_aabb(i);
+			hs.transform = object->get_transform() * object->get_shape_transform(i);
+			snapshot.push_back(hs);
+		}
+	}
+
+	history_memory = intersection_query_transform_results.get_capacity() * sizeof(Transform3D);
+	for (uint32_t i = 0; i < history.size(); i++) {
+		history_memory += history[i].get_capacity() * sizeof(HistoryShape);
+	}
+}
+
+int GodotSpace3D::_cull_history(const AABB &p_aabb, const Vector3 *p_segment, int p_rewind_ticks) {
+	ERR_FAIL_COND_V(p_rewind_ticks < 0, 0);
+	ERR_FAIL_COND_V_MSG(history_ticks == 0, 0, "Querying a past step requires SPACE_PARAM_HISTORY_TICKS to be set on the space.");
+
+	int amount;
+	if (p_segment) {
+		amount = broadphase->cull_segment(p_segment[0], p_segment[1], intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	} else {
+		amount = broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	}
+
+	// Further back than recorded uses the oldest snapshot, and the current state before the first step.
+	const LocalVector<HistoryShape> *snapshot = nullptr;
+	if (history_count > 0) {
+		int ticks = MIN(p_rewind_ticks, history_count);
+		snapshot = &history[(history_head - ticks + 1 + history_ticks) % history_ticks];
+	}
+
+	// Keep what the history doesn't track from the present, the rest comes from the snapshot.
+	int count = 0;
+	for (int i = 0; i < amount; i++) {
+		GodotCollisionObject3D *col_obj = intersection_query_results[i];
+		if (snapshot && _is_history_tracked(col_obj)) {
+			continue;
+		}
+
+		int shape_idx = intersection_query_subindex_results[i];
+		intersection_query_results[count] = col_obj;
+		intersection_query_subindex_results[count] = shape_idx;
+		intersection_query_transform_results[count] = col_obj->get_transform() * col_obj->get_shape_transform(shape_idx);
+		count++;
+	}
+
+	if (!snapshot) {
+		return count;
+	}
+
+	for (uint32_t i = 0; i < snapshot->size() && count < INTERSECTION_QUERY_MAX; i++) {
+		const HistoryShape &hs = (*snapshot)[i];
+		if (!hs.aabb.intersects(p_aabb)) {
+			continue;
+		}
+
+		if (p_segment && !hs.aabb.intersects_segment(p_segment[0], p_segment[1])) {
+			continue;
+		}
+
+		// Skip shapes removed or replaced since.
+		if (hs.index >= hs.object->get_shape_count() || hs.object->get_shape(hs.index) != hs.shape) {
+			continue;
+		}
+
+		// Skip objects made static since, the broadphase already returned their current state.
+		if (!_is_history_tracked(hs.object)) {
+			continue;
+		}
+
+		intersection_query_results[count] = hs.object;
+		intersection_query_subindex_results[count] = hs.index;
+		intersection_query_transform_results[count] = hs.transform;
+		count++;
+	}
+
+	return count;
+}
+
+int GodotSpace3D::_cull_query_aabb(const AABB &p_aabb, int p_rewind_ticks) {
+	if (p_rewind_ticks == 0) {
+		return broadphase->cull_aabb(p_aabb, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	}
+
+	return _cull_history(p_aabb, nullptr, p_rewind_ticks);
+}
+
+int GodotSpace3D::_cull_query_segment(const Vector3 &p_from, const Vector3 &p_to, int p_rewind_ticks) {
+	if (p_rewind_ticks == 0) {
+		return broadphase->cull_segment(p_from, p_to, intersection_query_results, INTERSECTION_QUERY_MAX, intersection_query_subindex_results);
+	}
+
+	AABB aabb(p_from, Vector3());
+	aabb.expand_to(p_to);
+	const Vector3 segment[2] = { p_from, p_to };
+	return _cull_history(aabb, segment, p_rewind_ticks);
+}
+
 void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_value) {
 	switch (p_param) {
 		case PhysicsServer3D::SPACE_PARAM_CONTACT_RECYCLE_RADIUS:
@@ -1192,6 +1347,9 @@ void GodotSpace3D::set_param(PhysicsServer3D::SpaceParameter p_param, real_t p_v
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			solver_iterations = p_value;
 			break;
+		case PhysicsServer3D::SPACE_PARAM_HISTORY_TICKS:
+			_set_history_ticks(p_value);
+			break;
 	}
 }
 
@@ -1213,6 +1371,8 @@ real_t GodotSpace3D::get_param(PhysicsServer3D::SpaceParameter p_param) const {
 			return body_time_to_sleep;
 		case PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS:
 			return solver_iterations;
+		case PhysicsServer3D::SPACE_PARAM_HISTORY_TICKS:
+			return history_ticks;
 	}
 	return 0;
 }
@@ -41,6 +41,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 
 class GodotPhysicsDirectSpaceState3D : public PhysicsDirectSpaceState3D {
@@ -106,6 +107,27 @@ private:
 
 	GodotCollisionObject3D *intersection_query_results[INTERSECTION_QUERY_MAX];
 	int intersection_query_subindex_results[INTERSECTION_QUERY_MAX];
+	// Global shape transforms of the results, only filled by queries in the past.
+	LocalVector<Transform3D> intersection_query_transform_results;
+
+	// State of a moving shape at the start of a past step, for lag compensation.
+	struct HistoryShape {
+		GodotCollisionObject3D *object = nullptr;
+		GodotShape3D *shape = nullptr;
+		int index = 0;
+		AABB aabb;
+		Transform3D transform;
+	};
+
+	// Ring buffer with one snapshot per step, history_head being the latest.
+	LocalVector<LocalVector<HistoryShape>> history;
+	int history_ticks = 0;
+	int history_head = 0;
+	int history_count = 0;
+	int history_memory = 0;
+
+	void _set_history_ticks(int p_ticks);
+	int _cull_history(const AABB &p_aabb, const Vector3 *p_segment, int p_rewind_ticks);
 
 	real_t body_linear_velocity_sleep_threshold = 0.0;
 	real_t body_angular_velocity_sleep_threshold = 0.0;
@@ -128,6 +150,28 @@ private:
 
 	int _cull_aabb_for_body(GodotBody3D *p_body, const AABB &p_aabb);
 
+	// Static bodies and soft bodies are left out of the history, queries in the past use their current state.
+	_FORCE_INLINE_ static bool _is_history_tracked(const GodotCollisionObject3D *p_object) {
+		switch (p_object->get_type()) {
+			case GodotCollisionObject3D::TYPE_AREA:
+				return true;
+			case GodotCollisionObject3D::TYPE_BODY:
+				return static_cast<const GodotBody3D *>(p_object)->get_mode() != PhysicsServer3D::BODY_MODE_STATIC;
+			default:
+				return false;
+		}
+	}
+
+	int _cull_query_aabb(const AABB &p_aabb, int p_rewind_ticks);
+	int _cull_query_segment(const Vector3 &p_from, const Vector3 &p_to, int p_rewind_ticks);
+	_FORCE_INLINE_ Transform3D _get_query_shape_transform(int p_result, int p_rewind_ticks) const {
+		if (p_rewind_ticks > 0) {
+			return intersection_query_transform_results[p_result];
+		}
+		const GodotCollisionObject3D *col_obj = intersection_query_results[p_result];
+		return col_obj->get_transform() * col_obj->get_shape_transform(intersection_query_subindex_results[p_result]);
+	}
+
 public:
 	_FORCE_INLINE_ void set_self(const RID &p_self) { self = p_self; }
 	_FORCE_INLINE_ RID get_self() const { return self; }
@@ -191,6 +235,9 @@ public:
 
 	int get_collision_pairs() const { return collision_pairs; }
 
+	void record_history();
+	int get_history_memory() const { return history_memory; }
+
 	GodotPhysicsDirectSpaceState3D *get_direct_state();
 
 	void set_debug_contacts(int p_amount) { contact_debug.resize(p_amount); }
@@ -143,6 +143,8 @@ public:
 		bool hit_back_faces = true;
 
 		bool pick_ray = false;
+
+		int rewind_ticks = 0;
 	};
 
 	struct RayResult {
@@ -184,6 +186,8 @@ public:
 
 		bool collide_with_bodies = true;
 		bool collide_with_areas = false;
+
+		int rewind_ticks = 0;
 	};
 
 	struct ShapeRestInfo {
@@ -291,6 +295,7 @@ public:
 		SPACE_PARAM_BODY_ANGULAR_VELOCITY_SLEEP_THRESHOLD,
 		SPACE_PARAM_BODY_TIME_TO_SLEEP,
 		SPACE_PARAM_SOLVER_ITERATIONS,
+		SPACE_PARAM_HISTORY_TICKS,
 	};
 
 	virtual void space_set_param(RID p_space, SpaceParameter p_param, real_t p_value) = 0;
@@ -797,7 +802,8 @@ public:
 	enum ProcessInfo {
 		INFO_ACTIVE_OBJECTS,
 		INFO_COLLISION_PAIRS,
-		INFO_ISLAND_COUNT
+		INFO_ISLAND_COUNT,
+		INFO_HISTORY_MEMORY
 	};
 
 	virtual int get_process_info(ProcessInfo p_info) = 0;
@@ -838,6 +844,9 @@ public:
 	void set_hit_back_faces(bool p_enable) { parameters.hit_back_faces = p_enable; }
 	bool is_hit_back_faces_enabled() const { return parameters.hit_back_faces; }
 
+	void set_rewind_ticks(int p_ticks) { parameters.rewind_ticks = p_ticks; }
+	int get_rewind_ticks() const { return parameters.rewind_ticks; }
+
 	void set_exclude(const Vector<RID> &p_exclude);
 	Vector<RID> get_exclude() const;
 };
@@ -906,6 +915,9 @@ public:
 	void set_collide_with_areas(bool p_enable) { parameters.collide_with_areas = p_enable; }
 	bool is_collide_with_areas_enabled() const { return parameters.collide_with_areas; }
 
+	void set_rewind_ticks(int p_ticks) { parameters.rewind_ticks = p_ticks; }
+	int get_rewind_ticks() const { return parameters.rewind_ticks; }
+
 	void set_exclude(const Vector<RID> &p_exclude);
 	Vector<RID> get_exclude() const;
 };
@@ -0,0 +1,659 @@
+/*************************************************************************/
+/*  raster_occlusion_cull.cpp                                            */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Triangles are clipped against a guard band this many times larger than the viewport (in NDC),
+// so screen space coordinates stay small enough for the edge functions to remain precise in single precision.
+static const float GUARD_BAND = 8.0f;
+
+enum {
+	OUTCODE_LEFT = 1,
+	OUTCODE_RIGHT = 2,
+	OUTCODE_BOTTOM = 4,
+	OUTCODE_TOP = 8,
+	OUTCODE_NEAR = 16,
+	OUTCODE_GUARD_BAND = 32,
+
+	OUTCODE_REJECT_MASK = OUTCODE_LEFT | OUTCODE_RIGHT | OUTCODE_BOTTOM | OUTCODE_TOP | OUTCODE_NEAR,
+	OUTCODE_CLIP_MASK = OUTCODE_NEAR | OUTCODE_GUARD_BAND,
+};
+
+static _FORCE_INLINE_ uint8_t _get_outcode(const Plane &p_clip, float p_depth, float p_z_near) {
+	const float w = p_clip.d;
+	uint8_t code = 0;
+	code |= p_clip.normal.x < -w ? OUTCODE_LEFT : 0;
+	code |= p_clip.normal.x > w ? OUTCODE_RIGHT : 0;
+	code |= p_clip.normal.y < -w ? OUTCODE_BOTTOM : 0;
+	code |= p_clip.normal.y > w ? OUTCODE_TOP : 0;
+	code |= p_depth < p_z_near ? OUTCODE_NEAR : 0;
+	code |= (Math::abs(p_clip.normal.x) > GUARD_BAND * w || Math::abs(p_clip.normal.y) > GUARD_BAND * w) ? OUTCODE_GUARD_BAND : 0;
+	return code;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::set_depth_range(float p_z_far) {
+	// Match the raycast backend, where rays that hit nothing report a slightly extended far distance.
+	clear_depth = p_z_far * 1.05f;
+	debug_tex_range = clear_depth;
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(ThreadWorkPool &p_thread_pool) {
+	ERR_FAIL_COND(is_empty());
+
+	// Use more bands than threads, so a band full of large triangles doesn't stall the whole pass.
+	RasterThreadData td;
+	td.band_count = MIN((uint32_t)sizes[0].y, (uint32_t)p_thread_pool.get_thread_count() * 4);
+	p_thread_pool.do_work(td.band_count, this, &RasterHZBuffer::_rasterize_thread, &td);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_thread(uint32_t p_band, const RasterThreadData *p_data) {
+	uint32_t total_rows = sizes[0].y;
+	uint32_t total_bands = p_data->band_count;
+	uint32_t from = p_band * total_rows / total_bands;
+	uint32_t to = (p_band + 1 == total_bands) ? total_rows : ((p_band + 1) * total_rows / total_bands);
+	_rasterize_band(from, to);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_band(int p_from_y, int p_to_y) {
+	const int width = sizes[0].x;
+	float *depth = mips[0];
+
+	for (int i = p_from_y * width; i < p_to_y * width; i++) {
+		depth[i] = clear_depth;
+	}
+
+	for (uint32_t l = 0; l < thread_setup.size(); l++) {
+		const LocalVector<Triangle> &triangles = thread_setup[l].triangles;
+
+		for (uint32_t t = 0; t < triangles.size(); t++) {
+			const Triangle &tri = triangles[t];
+
+			const int from_y = MAX(tri.min_y, p_from_y);
+			const int to_y = MIN(tri.max_y, p_to_y - 1);
+
+			for (int y = from_y; y <= to_y; y++) {
+				const float py = float(y) + 0.5f;
+
+				// Find the span of pixel centers inside all three edges.
+				int span_begin = tri.min_x;
+				int span_end = tri.max_x;
+				float row_edge[3];
+
+				for (int e = 0; e < 3; e++) {
+					const float a = tri.edge_a[e];
+					row_edge[e] = tri.edge_b[e] * py + tri.edge_c[e];
+					if (a > 0.0f) {
+						float bound = CLAMP(-row_edge[e] / a - 0.5f, float(tri.min_x), float(tri.max_x + 1));
+						span_begin = MAX(span_begin, int(Math::ceil(bound)));
+					} else if (a < 0.0f) {
+						float bound = CLAMP(-row_edge[e] / a - 0.5f, float(tri.min_x - 1), float(tri.max_x));
+						span_end = MIN(span_end, int(Math::floor(bound)));
+					} else if (row_edge[e] < 0.0f) {
+						span_begin = span_end + 1;
+					}
+				}
+
+				// The analytic bounds can be off by one due to rounding, tighten them with the exact per-pixel test.
+#define INSIDE(m_x) (tri.edge_a[0] * (float(m_x) + 0.5f) + row_edge[0] >= 0.0f && tri.edge_a[1] * (float(m_x) + 0.5f) + row_edge[1] >= 0.0f && tri.edge_a[2] * (float(m_x) + 0.5f) + row_edge[2] >= 0.0f)
+				while (span_begin <= span_end && !INSIDE(span_begin)) {
+					span_begin++;
+				}
+				while (span_end >= span_begin && !INSIDE(span_end)) {
+					span_end--;
+				}
+#undef INSIDE
+
+				if (span_begin > span_end) {
+					continue;
+				}
+
+				float *row = &depth[y * width];
+				const float row_inv_w = tri.inv_w[0] + tri.inv_w[2] * py;
+				const float row_depth_w = tri.depth_w[0] + tri.depth_w[2] * py;
+				int x = span_begin;
+
+#ifdef __SSE2__
+				const __m128 inv_w_row = _mm_set1_ps(row_inv_w);
+				const __m128 inv_w_dx = _mm_set1_ps(tri.inv_w[1]);
+				const __m128 depth_w_row = _mm_set1_ps(row_depth_w);
+				const __m128 depth_w_dx = _mm_set1_ps(tri.depth_w[1]);
+				const __m128 step = _mm_set1_ps(4.0f);
+				__m128 px = _mm_add_ps(_mm_set1_ps(float(x)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+
+				for (; x + 3 <= span_end; x += 4) {
+					__m128 inv_w = _mm_add_ps(inv_w_row, _mm_mul_ps(inv_w_dx, px));
+					__m128 depth_w = _mm_add_ps(depth_w_row, _mm_mul_ps(depth_w_dx, px));
+					__m128 d = _mm_div_ps(depth_w, inv_w);
+					_mm_storeu_ps(&row[x], _mm_min_ps(_mm_loadu_ps(&row[x]), d));
+					px = _mm_add_ps(px, step);
+				}
+#endif
+
+				for (; x <= span_end; x++) {
+					const float px_s = float(x) + 0.5f;
+					const float d = (row_depth_w + tri.depth_w[1] * px_s) / (row_inv_w + tri.inv_w[1] * px_s);
+					row[x] = MIN(row[x], d);
+				}
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	for (Set<InstanceID>::Element *E = occluder->users.front(); E; E = E->next()) {
+		RID scenario_rid = E->get().scenario;
+		RID instance_rid = E->get().instance;
+		ERR_CONTINUE(!scenarios.has(scenario_rid));
+		Scenario &scenario = scenarios[scenario_rid];
+		ERR_CONTINUE(!scenario.instances.has(instance_rid));
+
+		if (!scenario.dirty_instances.has(instance_rid)) {
+			scenario.dirty_instances.insert(instance_rid);
+			scenario.dirty_instances_array.push_back(instance_rid);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_COND(!occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	if (scenarios.has(p_scenario)) {
+		scenarios[p_scenario].removed = false;
+	} else {
+		scenarios[p_scenario] = Scenario();
+		scenarios[p_scenario].raster = this;
+	}
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+	scenario.removed = true;
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (!scenario.instances.has(p_instance)) {
+		scenario.instances[p_instance] = OccluderInstance();
+	}
+
+	OccluderInstance &instance = scenario.instances[p_instance];
+
+	bool changed = false;
+
+	if (instance.removed) {
+		instance.removed = false;
+		scenario.removed_instances.erase(p_instance);
+		changed = true; // It was removed and re-added, we might have missed some changes
+	}
+
+	if (instance.occluder != p_occluder) {
+		Occluder *old_occluder = occluder_owner.get_or_null(instance.occluder);
+		if (old_occluder) {
+			old_occluder->users.erase(InstanceID(p_scenario, p_instance));
+		}
+
+		instance.occluder = p_occluder;
+
+		if (p_occluder.is_valid()) {
+			Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+			ERR_FAIL_COND(!occluder);
+			occluder->users.insert(InstanceID(p_scenario, p_instance));
+		}
+		changed = true;
+	}
+
+	if (instance.xform != p_xform) {
+		instance.xform = p_xform;
+		changed = true;
+	}
+
+	if (instance.enabled != p_enabled) {
+		instance.enabled = p_enabled;
+		scenario.dirty = true; // The active instance list needs a rebuild, but the instance doesn't need update
+	}
+
+	if (changed && !scenario.dirty_instances.has(p_instance)) {
+		scenario.dirty_instances.insert(p_instance);
+		scenario.dirty_instances_array.push_back(p_instance);
+		scenario.dirty = true;
+	}
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	Scenario &scenario = scenarios[p_scenario];
+
+	if (scenario.instances.has(p_instance)) {
+		OccluderInstance &instance = scenario.instances[p_instance];
+
+		if (!instance.removed) {
+			Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+			if (occluder) {
+				occluder->users.erase(InstanceID(p_scenario, p_instance));
+			}
+
+			scenario.removed_instances.push_back(p_instance);
+			instance.removed = true;
+		}
+	}
+}
+
+void RasterOcclusionCull::Scenario::_update_dirty_instance_thread(uint32_t p_idx, RID *p_instances) {
+	OccluderInstance *occ_inst = instances.getptr(p_instances[p_idx]);
+
+	if (!occ_inst) {
+		return;
+	}
+
+	Occluder *occ = raster->occluder_owner.get_or_null(occ_inst->occluder);
+
+	if (!occ) {
+		occ_inst->xformed_vertices.clear();
+		occ_inst->indices.clear();
+		return;
+	}
+
+	const uint32_t vertex_count = occ->vertices.size();
+	const Vector3 *read = occ->vertices.ptr();
+
+	occ_inst->xformed_vertices.resize(vertex_count);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		occ_inst->xformed_vertices[i] = occ_inst->xform.xform(read[i]);
+		if (i == 0) {
+			occ_inst->aabb.position = occ_inst->xformed_vertices[i];
+			occ_inst->aabb.size = Vector3();
+		} else {
+			occ_inst->aabb.expand_to(occ_inst->xformed_vertices[i]);
+		}
+	}
+
+	// Only keep complete triangles with valid indices, so the setup pass doesn't need to check them every frame.
+	const int32_t *indices = occ->indices.ptr();
+	const uint32_t index_count = occ->indices.size() - occ->indices.size() % 3;
+
+	occ_inst->indices.clear();
+	occ_inst->indices.reserve(index_count);
+	for (uint32_t i = 0; i < index_count; i += 3) {
+		if (uint32_t(indices[i]) >= vertex_count || uint32_t(indices[i + 1]) >= vertex_count || uint32_t(indices[i + 2]) >= vertex_count) {
+			continue;
+		}
+		occ_inst->indices.push_back(indices[i]);
+		occ_inst->indices.push_back(indices[i + 1]);
+		occ_inst->indices.push_back(indices[i + 2]);
+	}
+}
+
+bool RasterOcclusionCull::Scenario::update(ThreadWorkPool &p_thread_pool) {
+	if (removed) {
+		return true;
+	}
+
+	if (!dirty && removed_instances.is_empty() && dirty_instances_array.is_empty()) {
+		return false;
+	}
+
+	for (unsigned int i = 0; i < removed_instances.size(); i++) {
+		instances.erase(removed_instances[i]);
+	}
+
+	if (dirty_instances_array.size() > (uint32_t)p_thread_pool.get_thread_count()) {
+		p_thread_pool.do_work(dirty_instances_array.size(), this, &Scenario::_update_dirty_instance_thread, dirty_instances_array.ptr());
+	} else {
+		for (unsigned int i = 0; i < dirty_instances_array.size(); i++) {
+			_update_dirty_instance_thread(i, dirty_instances_array.ptr());
+		}
+	}
+
+	dirty_instances.clear();
+	dirty_instances_array.clear();
+	removed_instances.clear();
+
+	active_instances.clear();
+
+	const RID *inst_rid = nullptr;
+	while ((inst_rid = instances.next(inst_rid))) {
+		const OccluderInstance *occ_inst = instances.getptr(*inst_rid);
+		if (occ_inst->enabled && !occ_inst->indices.is_empty()) {
+			active_instances.push_back(occ_inst);
+		}
+	}
+
+	dirty = false;
+	return false;
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::_add_triangle(LocalVector<Triangle> &r_triangles, const Plane *p_clip, const float *p_depth, const Size2i &p_size) {
+	float x[3];
+	float y[3];
+	float inv_w[3];
+	float depth_w[3];
+
+	for (int i = 0; i < 3; i++) {
+		inv_w[i] = 1.0f / p_clip[i].d;
+		x[i] = (p_clip[i].normal.x * inv_w[i] * 0.5f + 0.5f) * p_size.x;
+		y[i] = (p_clip[i].normal.y * inv_w[i] * 0.5f + 0.5f) * p_size.y;
+		depth_w[i] = p_depth[i] * inv_w[i];
+	}
+
+	const float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (Math::abs(area) < CMP_EPSILON) {
+		return;
+	}
+
+	// Pixel centers are at half-integer coordinates.
+	Triangle tri;
+	tri.min_x = MAX(0, int(Math::ceil(MIN(x[0], MIN(x[1], x[2])) - 0.5f)));
+	tri.min_y = MAX(0, int(Math::ceil(MIN(y[0], MIN(y[1], y[2])) - 0.5f)));
+	tri.max_x = MIN(p_size.x - 1, int(Math::floor(MAX(x[0], MAX(x[1], x[2])) - 0.5f)));
+	tri.max_y = MIN(p_size.y - 1, int(Math::floor(MAX(y[0], MAX(y[1], y[2])) - 0.5f)));
+
+	if (tri.min_x > tri.max_x || tri.min_y > tri.max_y) {
+		return;
+	}
+
+	// Occluders are double sided, flip the edges of clockwise triangles so the inside is always positive.
+	const float sign = area > 0.0f ? 1.0f : -1.0f;
+	for (int i = 0; i < 3; i++) {
+		const int j = (i + 1) % 3;
+		tri.edge_a[i] = (y[i] - y[j]) * sign;
+		tri.edge_b[i] = (x[j] - x[i]) * sign;
+		tri.edge_c[i] = -(tri.edge_a[i] * x[i] + tri.edge_b[i] * y[i]);
+	}
+
+	const float inv_area = 1.0f / area;
+	const float dx1 = x[1] - x[0];
+	const float dx2 = x[2] - x[0];
+	const float dy1 = y[1] - y[0];
+	const float dy2 = y[2] - y[0];
+
+#define SETUP_PLANE(m_plane, m_values)                                                             \
+	{                                                                                              \
+		const float df1 = m_values[1] - m_values[0];                                               \
+		const float df2 = m_values[2] - m_values[0];                                               \
+		m_plane[1] = (df1 * dy2 - df2 * dy1) * inv_area;                                           \
+		m_plane[2] = (df2 * dx1 - df1 * dx2) * inv_area;                                           \
+		m_plane[0] = m_values[0] - m_plane[1] * x[0] - m_plane[2] * y[0];                          \
+	}
+
+	SETUP_PLANE(tri.inv_w, inv_w);
+	SETUP_PLANE(tri.depth_w, depth_w);
+#undef SETUP_PLANE
+
+	r_triangles.push_back(tri);
+}
+
+void RasterOcclusionCull::_clip_triangle(RasterHZBuffer::SetupData &r_setup, const uint32_t *p_indices, float p_z_near, const Size2i &p_size) {
+	// Sutherland-Hodgman against the near plane and the guard band. Both the clip space position and the
+	// view depth are affine in view space, so they can be interpolated linearly along the edges.
+	const int MAX_VERTICES = 9;
+	Plane clip[2][MAX_VERTICES];
+	float depth[2][MAX_VERTICES];
+	int count = 3;
+	int current = 0;
+
+	for (int i = 0; i < 3; i++) {
+		clip[0][i] = r_setup.clip_vertices[p_indices[i]];
+		depth[0][i] = r_setup.view_depths[p_indices[i]];
+	}
+
+	for (int p = 0; p < 5 && count >= 3; p++) {
+		float dist[MAX_VERTICES];
+		bool any_outside = false;
+
+		for (int i = 0; i < count; i++) {
+			const Plane &c = clip[current][i];
+			switch (p) {
+				case 0:
+					dist[i] = depth[current][i] - p_z_near;
+					break;
+				case 1:
+					dist[i] = GUARD_BAND * c.d + c.normal.x;
+					break;
+				case 2:
+					dist[i] = GUARD_BAND * c.d - c.normal.x;
+					break;
+				case 3:
+					dist[i] = GUARD_BAND * c.d + c.normal.y;
+					break;
+				default:
+					dist[i] = GUARD_BAND * c.d - c.normal.y;
+					break;
+			}
+			any_outside = any_outside || dist[i] < 0.0f;
+		}
+
+		if (!any_outside) {
+			continue;
+		}
+
+		const int next = 1 - current;
+		int next_count = 0;
+
+		for (int i = 0; i < count; i++) {
+			const int j = (i + 1) % count;
+
+			if (dist[i] >= 0.0f) {
+				clip[next][next_count] = clip[current][i];
+				depth[next][next_count] = depth[current][i];
+				next_count++;
+			}
+
+			if ((dist[i] >= 0.0f) != (dist[j] >= 0.0f)) {
+				const float t = dist[i] / (dist[i] - dist[j]);
+				const Plane &a = clip[current][i];
+				const Plane &b = clip[current][j];
+				clip[next][next_count] = Plane(a.normal.lerp(b.normal, t), Math::lerp(a.d, b.d, t));
+				depth[next][next_count] = Math::lerp(depth[current][i], depth[current][j], t);
+				next_count++;
+			}
+		}
+
+		current = next;
+		count = next_count;
+	}
+
+	for (int i = 2; i < count; i++) {
+		const Plane fan_clip[3] = { clip[current][0], clip[current][i - 1], clip[current][i] };
+		const float fan_depth[3] = { depth[current][0], depth[current][i - 1], depth[current][i] };
+		_add_triangle(r_setup.triangles, fan_clip, fan_depth, p_size);
+	}
+}
+
+void RasterOcclusionCull::_setup_triangles_thread(uint32_t p_thread, const SetupThreadData *p_data) {
+	RasterHZBuffer::SetupData &setup = p_data->buffer->thread_setup[p_thread];
+	setup.triangles.clear();
+
+	const LocalVector<const OccluderInstance *> &instances = p_data->scenario->active_instances;
+	const uint32_t total_instances = instances.size();
+	const uint32_t total_threads = p_data->thread_count;
+	const uint32_t from = p_thread * total_instances / total_threads;
+	const uint32_t to = (p_thread + 1 == total_threads) ? total_instances : ((p_thread + 1) * total_instances / total_threads);
+
+	const Size2i size = p_data->buffer->get_size();
+	const float z_near = p_data->z_near;
+
+	for (uint32_t i = from; i < to; i++) {
+		const OccluderInstance *occ_inst = instances[i];
+
+		// Skip instances that are entirely outside one of the frustum planes.
+		uint8_t aabb_code = 0xFF;
+		for (int j = 0; j < 8; j++) {
+			Vector3 view = p_data->cam_inv_transform.xform(occ_inst->aabb.get_endpoint(j));
+			Plane clip = p_data->cam_projection.xform4(Plane(view, 1.0));
+			aabb_code &= _get_outcode(clip, -view.z, z_near);
+		}
+		if (aabb_code & OUTCODE_REJECT_MASK) {
+			continue;
+		}
+
+		const uint32_t vertex_count = occ_inst->xformed_vertices.size();
+		setup.clip_vertices.resize(vertex_count);
+		setup.view_depths.resize(vertex_count);
+		setup.outcodes.resize(vertex_count);
+
+		for (uint32_t j = 0; j < vertex_count; j++) {
+			Vector3 view = p_data->cam_inv_transform.xform(occ_inst->xformed_vertices[j]);
+			setup.clip_vertices[j] = p_data->cam_projection.xform4(Plane(view, 1.0));
+			setup.view_depths[j] = -view.z;
+			setup.outcodes[j] = _get_outcode(setup.clip_vertices[j], setup.view_depths[j], z_near);
+		}
+
+		const uint32_t *indices = occ_inst->indices.ptr();
+		const uint32_t index_count = occ_inst->indices.size();
+
+		for (uint32_t j = 0; j < index_count; j += 3) {
+			const uint8_t c0 = setup.outcodes[indices[j]];
+			const uint8_t c1 = setup.outcodes[indices[j + 1]];
+			const uint8_t c2 = setup.outcodes[indices[j + 2]];
+
+			if (c0 & c1 & c2 & OUTCODE_REJECT_MASK) {
+				continue;
+			}
+
+			if ((c0 | c1 | c2) & OUTCODE_CLIP_MASK) {
+				_clip_triangle(setup, &indices[j], z_near, size);
+			} else {
+				const Plane clip[3] = { setup.clip_vertices[indices[j]], setup.clip_vertices[indices[j + 1]], setup.clip_vertices[indices[j + 2]] };
+				const float depth[3] = { setup.view_depths[indices[j]], setup.view_depths[indices[j + 1]], setup.view_depths[indices[j + 2]] };
+				_add_triangle(setup.triangles, clip, depth, size);
+			}
+		}
+	}
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_pool) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	Scenario &scenario = scenarios[buffer.scenario_rid];
+
+	bool removed = scenario.update(p_thread_pool);
+
+	if (removed) {
+		scenarios.erase(buffer.scenario_rid);
+		return;
+	}
+
+	// Depth is interpolated from the clip space w, so orthogonal projections need no special handling.
+	SetupThreadData td;
+	td.thread_count = p_thread_pool.get_thread_count();
+	td.scenario = &scenario;
+	td.buffer = &buffer;
+	td.cam_inv_transform = p_cam_transform.affine_inverse();
+	td.cam_projection = p_cam_projection;
+	td.z_near = p_cam_projection.get_z_near();
+
+	buffer.set_depth_range(p_cam_projection.get_z_far());
+	buffer.thread_setup.resize(td.thread_count);
+
+	p_thread_pool.do_work(td.thread_count, this, &RasterOcclusionCull::_setup_triangles_thread, &td);
+
+	buffer.rasterize(p_thread_pool);
+	buffer.update_mips();
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
@@ -0,0 +1,175 @@
+/*************************************************************************/
+/*  raster_occlusion_cull.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RASTER_OCCLUSION_CULL_H
+#define RASTER_OCCLUSION_CULL_H
+
+#include "core/math/camera_matrix.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/rid_owner.h"
+#include "servers/rendering/renderer_scene_occlusion_cull.h"
+
+// Occlusion culling backend that rasterizes the occluder meshes into the depth buffer on the CPU.
+// It has no third-party dependencies, so it is available in every build and is used whenever the
+// Embree based backend (modules/raycast) is not compiled in or is disabled in the project settings.
+class RasterOcclusionCull : public RendererSceneOcclusionCull {
+public:
+	// Screen space triangle, ready to be rasterized.
+	// Edge functions are evaluated as e(x, y) = a * x + b * y + c, and are non-negative inside the triangle.
+	// Depth is interpolated perspective-correctly as (depth / w) / (1 / w), both of which are linear in screen space.
+	struct Triangle {
+		int min_x = 0;
+		int min_y = 0;
+		int max_x = 0; // Inclusive.
+		int max_y = 0; // Inclusive.
+
+		float edge_a[3];
+		float edge_b[3];
+		float edge_c[3];
+
+		float inv_w[3]; // Value at the origin, x gradient, y gradient.
+		float depth_w[3];
+	};
+
+	class RasterHZBuffer : public HZBuffer {
+	private:
+		struct RasterThreadData {
+			uint32_t band_count;
+		};
+
+		void _rasterize_thread(uint32_t p_band, const RasterThreadData *p_data);
+		void _rasterize_band(int p_from_y, int p_to_y);
+
+	public:
+		// Per-thread output and scratch memory of the triangle setup pass, kept around to avoid reallocating every frame.
+		struct SetupData {
+			LocalVector<Triangle> triangles;
+			LocalVector<Plane> clip_vertices;
+			LocalVector<float> view_depths;
+			LocalVector<uint8_t> outcodes;
+		};
+
+		RID scenario_rid;
+		float clear_depth = FLT_MAX;
+		LocalVector<SetupData> thread_setup;
+
+		void set_depth_range(float p_z_far);
+		void rasterize(ThreadWorkPool &p_thread_pool);
+	};
+
+private:
+	struct InstanceID {
+		RID scenario;
+		RID instance;
+
+		bool operator<(const InstanceID &rhs) const {
+			if (instance == rhs.instance) {
+				return rhs.scenario < scenario;
+			}
+			return instance < rhs.instance;
+		}
+
+		InstanceID() {}
+		InstanceID(RID s, RID i) :
+				scenario(s), instance(i) {}
+	};
+
+	struct Occluder {
+		PackedVector3Array vertices;
+		PackedInt32Array indices;
+		Set<InstanceID> users;
+	};
+
+	struct OccluderInstance {
+		RID occluder;
+		LocalVector<uint32_t> indices;
+		LocalVector<Vector3> xformed_vertices;
+		AABB aabb;
+		Transform3D xform;
+		bool enabled = true;
+		bool removed = false;
+	};
+
+	struct Scenario {
+		RasterOcclusionCull *raster = nullptr;
+		bool dirty = false;
+		bool removed = false;
+
+		HashMap<RID, OccluderInstance> instances;
+		Set<RID> dirty_instances; // To avoid duplicates
+		LocalVector<RID> dirty_instances_array; // To iterate and split into threads
+		LocalVector<RID> removed_instances;
+
+		// Enabled instances with geometry, rebuilt whenever the scenario is dirty.
+		LocalVector<const OccluderInstance *> active_instances;
+
+		void _update_dirty_instance_thread(uint32_t p_idx, RID *p_instances);
+		bool update(ThreadWorkPool &p_thread_pool);
+	};
+
+	struct SetupThreadData {
+		uint32_t thread_count;
+		const Scenario *scenario;
+		RasterHZBuffer *buffer;
+		Transform3D cam_inv_transform;
+		CameraMatrix cam_projection;
+		float z_near;
+	};
+
+	RID_PtrOwner<Occluder> occluder_owner;
+	HashMap<RID, Scenario> scenarios;
+	HashMap<RID, RasterHZBuffer> buffers;
+
+	void _setup_triangles_thread(uint32_t p_thread, const SetupThreadData *p_data);
+	static void _clip_triangle(RasterHZBuffer::SetupData &r_setup, const uint32_t *p_indices, float p_z_near, const Size2i &p_size);
+	static void _add_triangle(LocalVector<Triangle> &r_triangles, const Plane *p_clip, const float *p_depth, const Size2i &p_size);
+
+public:
+	virtual bool is_occluder(RID p_rid) override;
+	virtual RID occluder_allocate() override;
+	virtual void occluder_initialize(RID p_occluder) override;
+	virtual void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) override;
+	virtual void free_occluder(RID p_occluder) override;
+
+	virtual void add_scenario(RID p_scenario) override;
+	virtual void remove_scenario(RID p_scenario) override;
+	virtual void scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) override;
+	virtual void scenario_remove_instance(RID p_scenario, RID p_instance) override;
+
+	virtual void add_buffer(RID p_buffer) override;
+	virtual void remove_buffer(RID p_buffer) override;
+	virtual HZBuffer *buffer_get_ptr(RID p_buffer) override;
+	virtual void buffer_set_scenario(RID p_buffer, RID p_scenario) override;
+	virtual void buffer_set_size(RID p_buffer, const Vector2i &p_size) override;
+	virtual void buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, ThreadWorkPool &p_thread_pool) override;
+	virtual RID buffer_get_debug_texture(RID p_buffer) override;
+};
+
+#endif // RASTER_OCCLUSION_CULL_H
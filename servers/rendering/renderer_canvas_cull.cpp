@@ -30,6 +30,7 @@
 
 #include "renderer_canvas_cull.h"
 
+#include "core/config/project_settings.h"
 #include "core/math/geometry_2d.h"
 #include "renderer_viewport.h"
 #include "rendering_server_default.h"
@@ -322,6 +323,10 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 			canvas_group_from = z_last_list[zidx];
 		}
 
+		if (bvh_culling && child_item_count >= bvh_culling_min_children) {
+			child_item_count = _children_bvh_cull(ci, xform, p_clip_rect, child_items);
+		}
+
 		for (int i = 0; i < child_item_count; i++) {
 			if (!child_items[i]->behind && !use_canvas_group) {
 				continue;
@@ -338,11 +343,116 @@ void RendererCanvasCull::_cull_canvas_item(Item *p_canvas_item, const Transform2
 	}
 }
 
+bool RendererCanvasCull::_is_item_bvh_cullable(const Item *p_item) {
+	// Only items whose visibility depends on nothing but their own rect can be skipped by the query,
+	// everything else is always handed to _cull_canvas_item().
+	return p_item->child_items.is_empty() && !p_item->sort_y && !p_item->update_when_visible && !p_item->vp_render && p_item->copy_back_buffer == nullptr && p_item->canvas_group == nullptr && p_item->skeleton.is_null();
+}
+
+void RendererCanvasCull::_children_bvh_flush(Item *p_item) {
+	ChildrenBVH *children_bvh = p_item->children_bvh;
+
+	for (uint32_t i = 0; i < children_bvh->dirty_items.size(); i++) {
+		Item *child = children_bvh->dirty_items[i];
+		child->bvh_dirty = false;
+
+		if (_is_item_bvh_cullable(child)) {
+			Rect2 rect = child->get_rect();
+			if (child->visibility_notifier && child->visibility_notifier->area.size != Vector2()) {
+				rect = rect.merge(child->visibility_notifier->area);
+			}
+			rect = child->xform.xform(rect);
+
+			if (child->bvh_unculled) {
+				children_bvh->unculled_items.erase(child);
+				child->bvh_unculled = false;
+			}
+
+			if (child->bvh_handle.is_invalid()) {
+				child->bvh_handle = children_bvh->bvh.create(child, true, 0, 1, rect);
+			} else {
+				children_bvh->bvh.move(child->bvh_handle, rect);
+			}
+		} else {
+			if (!child->bvh_handle.is_invalid()) {
+				children_bvh->bvh.erase(child->bvh_handle);
+				child->bvh_handle.set_invalid();
+			}
+
+			if (!child->bvh_unculled) {
+				children_bvh->unculled_items.push_back(child);
+				child->bvh_unculled = true;
+			}
+		}
+	}
+
+	children_bvh->dirty_items.clear();
+	children_bvh->bvh.update();
+}
+
+int RendererCanvasCull::_children_bvh_cull(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, Item **&r_child_items) {
+	if (!p_item->children_bvh) {
+		p_item->children_bvh = memnew(ChildrenBVH);
+		for (int i = 0; i < p_item->child_items.size(); i++) {
+			Item *child = p_item->child_items[i];
+			child->bvh_owner = p_item;
+			_item_bvh_mark_dirty(child);
+		}
+	}
+
+	_children_bvh_flush(p_item);
+
+	if (p_xform.basis_determinant() == 0) {
+		return p_item->child_items.size();
+	}
+
+	ChildrenBVH *children_bvh = p_item->children_bvh;
+
+	// Clip rect in the parent's local space, grown by one unit to account for transform snapping.
+	Rect2 local_clip_rect = p_xform.affine_inverse().xform(Rect2(Point2(), p_clip_rect.size)).grow(1.0);
+
+	int max_items = p_item->child_items.size();
+	children_bvh->visible_items.resize(max_items);
+	Item **items = children_bvh->visible_items.ptr();
+
+	int item_count = children_bvh->bvh.cull_aabb(local_clip_rect, items, max_items, nullptr);
+	for (uint32_t i = 0; i < children_bvh->unculled_items.size(); i++) {
+		items[item_count++] = children_bvh->unculled_items[i];
+	}
+
+	// The query returns items in tree order, restore the draw order.
+	SortArray<Item *, ItemIndexSort> sorter;
+	sorter.sort(items, item_count);
+
+	r_child_items = items;
+	return item_count;
+}
+
+void RendererCanvasCull::_children_bvh_remove(Item *p_item) {
+	ChildrenBVH *children_bvh = p_item->bvh_owner->children_bvh;
+
+	if (!p_item->bvh_handle.is_invalid()) {
+		children_bvh->bvh.erase(p_item->bvh_handle);
+		p_item->bvh_handle.set_invalid();
+	}
+	if (p_item->bvh_unculled) {
+		children_bvh->unculled_items.erase(p_item);
+		p_item->bvh_unculled = false;
+	}
+	if (p_item->bvh_dirty) {
+		children_bvh->dirty_items.erase(p_item);
+		p_item->bvh_dirty = false;
+	}
+
+	p_item->bvh_owner = nullptr;
+}
+
 void RendererCanvasCull::render_canvas(RID p_render_target, Canvas *p_canvas, const Transform2D &p_transform, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, const Rect2 &p_clip_rect, RenderingServer::CanvasItemTextureFilter p_default_filter, RenderingServer::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_transforms_to_pixel, bool p_snap_2d_vertices_to_pixel) {
 	RENDER_TIMESTAMP("> Render Canvas");
 
 	sdf_used = false;
 	snapping_2d_transforms_to_pixel = p_snap_2d_transforms_to_pixel;
+	bvh_culling = p_canvas->use_bvh_culling;
 
 	if (p_canvas->children_order_dirty) {
 		p_canvas->child_items.sort();
@@ -397,6 +507,9 @@ RID RendererCanvasCull::canvas_allocate() {
 }
 void RendererCanvasCull::canvas_initialize(RID p_rid) {
 	canvas_owner.initialize_rid(p_rid);
+
+	Canvas *canvas = canvas_owner.get_or_null(p_rid);
+	canvas->use_bvh_culling = bvh_culling_default;
 }
 
 void RendererCanvasCull::canvas_set_item_mirroring(RID p_canvas, RID p_item, const Point2 &p_mirroring) {
@@ -420,6 +533,13 @@ void RendererCanvasCull::canvas_set_disable_scale(bool p_disable) {
 	disable_scale = p_disable;
 }
 
+void RendererCanvasCull::canvas_set_use_bvh_culling(RID p_canvas, bool p_enable) {
+	Canvas *canvas = canvas_owner.get_or_null(p_canvas);
+	ERR_FAIL_COND(!canvas);
+
+	canvas->use_bvh_culling = p_enable;
+}
+
 void RendererCanvasCull::canvas_set_parent(RID p_canvas, RID p_parent, float p_scale) {
 	Canvas *canvas = canvas_owner.get_or_null(p_canvas);
 	ERR_FAIL_COND(!canvas);
@@ -450,6 +570,11 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 			if (item_owner->sort_y) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
+
+			if (canvas_item->bvh_owner) {
+				_children_bvh_remove(canvas_item);
+			}
+			_item_bvh_mark_dirty(item_owner);
 		}
 
 		canvas_item->parent = RID();
@@ -471,6 +596,12 @@ void RendererCanvasCull::canvas_item_set_parent(RID p_item, RID p_parent) {
 				_mark_ysort_dirty(item_owner, canvas_item_owner);
 			}
 
+			if (item_owner->children_bvh) {
+				canvas_item->bvh_owner = item_owner;
+				_item_bvh_mark_dirty(canvas_item);
+			}
+			_item_bvh_mark_dirty(item_owner);
+
 		} else {
 			ERR_FAIL_MSG("Invalid parent.");
 		}
@@ -498,6 +629,7 @@ void RendererCanvasCull::canvas_item_set_light_mask(RID p_item, int p_mask) {
 void RendererCanvasCull::canvas_item_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	canvas_item->xform = p_transform;
 }
@@ -519,6 +651,7 @@ void RendererCanvasCull::canvas_item_set_distance_field_mode(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_custom_rect(RID p_item, bool p_custom_rect, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	canvas_item->custom_rect = p_custom_rect;
 	canvas_item->rect = p_rect;
@@ -548,6 +681,7 @@ void RendererCanvasCull::canvas_item_set_draw_behind_parent(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_update) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	canvas_item->update_when_visible = p_update;
 }
@@ -555,6 +689,7 @@ void RendererCanvasCull::canvas_item_set_update_when_visible(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_add_line(RID p_item, const Point2 &p_from, const Point2 &p_to, const Color &p_color, float p_width, bool p_antialiased) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandPrimitive *line = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!line);
@@ -740,6 +875,7 @@ void RendererCanvasCull::canvas_item_add_polyline(RID p_item, const Vector<Point
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Color color = Color(1, 1, 1, 1);
 
@@ -1040,6 +1176,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 	ERR_FAIL_COND(p_points.size() < 2);
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandPolygon *pline = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!pline);
@@ -1056,6 +1193,7 @@ void RendererCanvasCull::canvas_item_add_multiline(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -1066,6 +1204,7 @@ void RendererCanvasCull::canvas_item_add_rect(RID p_item, const Rect2 &p_rect, c
 void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos, float p_radius, const Color &p_color) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandPolygon *circle = canvas_item->alloc_command<Item::CommandPolygon>();
 	ERR_FAIL_COND(!circle);
@@ -1102,6 +1241,7 @@ void RendererCanvasCull::canvas_item_add_circle(RID p_item, const Point2 &p_pos,
 void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p_rect, RID p_texture, bool p_tile, const Color &p_modulate, bool p_transpose) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -1133,6 +1273,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect(RID p_item, const Rect2 &p
 void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, int p_outline_size, float p_px_range) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -1167,6 +1308,7 @@ void RendererCanvasCull::canvas_item_add_msdf_texture_rect_region(RID p_item, co
 void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const Rect2 &p_rect, RID p_texture, const Rect2 &p_src_rect, const Color &p_modulate, bool p_transpose, bool p_clip_uv) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandRect *rect = canvas_item->alloc_command<Item::CommandRect>();
 	ERR_FAIL_COND(!rect);
@@ -1208,6 +1350,7 @@ void RendererCanvasCull::canvas_item_add_texture_rect_region(RID p_item, const R
 void RendererCanvasCull::canvas_item_add_nine_patch(RID p_item, const Rect2 &p_rect, const Rect2 &p_source, RID p_texture, const Vector2 &p_topleft, const Vector2 &p_bottomright, RS::NinePatchAxisMode p_x_axis_mode, RS::NinePatchAxisMode p_y_axis_mode, bool p_draw_center, const Color &p_modulate) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandNinePatch *style = canvas_item->alloc_command<Item::CommandNinePatch>();
 	ERR_FAIL_COND(!style);
@@ -1232,6 +1375,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandPrimitive *prim = canvas_item->alloc_command<Item::CommandPrimitive>();
 	ERR_FAIL_COND(!prim);
@@ -1258,6 +1402,7 @@ void RendererCanvasCull::canvas_item_add_primitive(RID p_item, const Vector<Poin
 void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 #ifdef DEBUG_ENABLED
 	int pointcount = p_points.size();
 	ERR_FAIL_COND(pointcount < 3);
@@ -1279,6 +1424,7 @@ void RendererCanvasCull::canvas_item_add_polygon(RID p_item, const Vector<Point2
 void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector<int> &p_indices, const Vector<Point2> &p_points, const Vector<Color> &p_colors, const Vector<Point2> &p_uvs, const Vector<int> &p_bones, const Vector<float> &p_weights, RID p_texture, int p_count) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	int vertex_count = p_points.size();
 	ERR_FAIL_COND(vertex_count == 0);
@@ -1302,6 +1448,7 @@ void RendererCanvasCull::canvas_item_add_triangle_array(RID p_item, const Vector
 void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transform2D &p_transform) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandTransform *tr = canvas_item->alloc_command<Item::CommandTransform>();
 	ERR_FAIL_COND(!tr);
@@ -1311,6 +1458,7 @@ void RendererCanvasCull::canvas_item_add_set_transform(RID p_item, const Transfo
 void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, const Transform2D &p_transform, const Color &p_modulate, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 	ERR_FAIL_COND(!p_mesh.is_valid());
 
 	Item::CommandMesh *m = canvas_item->alloc_command<Item::CommandMesh>();
@@ -1330,6 +1478,7 @@ void RendererCanvasCull::canvas_item_add_mesh(RID p_item, const RID &p_mesh, con
 void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandParticles *part = canvas_item->alloc_command<Item::CommandParticles>();
 	ERR_FAIL_COND(!part);
@@ -1344,6 +1493,7 @@ void RendererCanvasCull::canvas_item_add_particles(RID p_item, RID p_particles,
 void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p_texture) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandMultiMesh *mm = canvas_item->alloc_command<Item::CommandMultiMesh>();
 	ERR_FAIL_COND(!mm);
@@ -1355,6 +1505,7 @@ void RendererCanvasCull::canvas_item_add_multimesh(RID p_item, RID p_mesh, RID p
 void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandClipIgnore *ci = canvas_item->alloc_command<Item::CommandClipIgnore>();
 	ERR_FAIL_COND(!ci);
@@ -1364,6 +1515,7 @@ void RendererCanvasCull::canvas_item_add_clip_ignore(RID p_item, bool p_ignore)
 void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_animation_length, double p_slice_begin, double p_slice_end, double p_offset) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	Item::CommandAnimationSlice *as = canvas_item->alloc_command<Item::CommandAnimationSlice>();
 	ERR_FAIL_COND(!as);
@@ -1376,6 +1528,7 @@ void RendererCanvasCull::canvas_item_add_animation_slice(RID p_item, double p_an
 void RendererCanvasCull::canvas_item_set_sort_children_by_y(RID p_item, bool p_enable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	canvas_item->sort_y = p_enable;
 
@@ -1401,6 +1554,7 @@ void RendererCanvasCull::canvas_item_set_z_as_relative_to_parent(RID p_item, boo
 void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 	if (canvas_item->skeleton == p_skeleton) {
 		return;
 	}
@@ -1430,6 +1584,7 @@ void RendererCanvasCull::canvas_item_attach_skeleton(RID p_item, RID p_skeleton)
 void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_enable, const Rect2 &p_rect) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 	if (p_enable && (canvas_item->copy_back_buffer == nullptr)) {
 		canvas_item->copy_back_buffer = memnew(RendererCanvasRender::Item::CopyBackBuffer);
 	}
@@ -1447,6 +1602,7 @@ void RendererCanvasCull::canvas_item_set_copy_to_backbuffer(RID p_item, bool p_e
 void RendererCanvasCull::canvas_item_clear(RID p_item) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	canvas_item->clear();
 }
@@ -1487,6 +1643,7 @@ void RendererCanvasCull::canvas_item_set_use_parent_material(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_enable, const Rect2 &p_area, const Callable &p_enter_callable, const Callable &p_exit_callable) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	if (p_enable) {
 		if (!canvas_item->visibility_notifier) {
@@ -1507,6 +1664,7 @@ void RendererCanvasCull::canvas_item_set_visibility_notifier(RID p_item, bool p_
 void RendererCanvasCull::canvas_item_set_canvas_group_mode(RID p_item, RS::CanvasGroupMode p_mode, float p_clear_margin, bool p_fit_empty, float p_fit_margin, bool p_blur_mipmaps) {
 	Item *canvas_item = canvas_item_owner.get_or_null(p_item);
 	ERR_FAIL_COND(!canvas_item);
+	_item_bvh_mark_dirty(canvas_item);
 
 	if (p_mode == RS::CANVAS_GROUP_MODE_DISABLED) {
 		if (canvas_item->canvas_group != nullptr) {
@@ -1967,11 +2125,24 @@ bool RendererCanvasCull::free(RID p_rid) {
 				if (item_owner->sort_y) {
 					_mark_ysort_dirty(item_owner, canvas_item_owner);
 				}
+
+				if (canvas_item->bvh_owner) {
+					_children_bvh_remove(canvas_item);
+				}
+				_item_bvh_mark_dirty(item_owner);
 			}
 		}
 
 		for (int i = 0; i < canvas_item->child_items.size(); i++) {
 			canvas_item->child_items[i]->parent = RID();
+			if (canvas_item->child_items[i]->bvh_owner) {
+				_children_bvh_remove(canvas_item->child_items[i]);
+			}
+		}
+
+		if (canvas_item->children_bvh) {
+			memdelete(canvas_item->children_bvh);
+			canvas_item->children_bvh = nullptr;
 		}
 
 		if (canvas_item->visibility_notifier != nullptr) {
@@ -2047,6 +2218,9 @@ RendererCanvasCull::RendererCanvasCull() {
 	z_last_list = (RendererCanvasRender::Item **)memalloc(z_range * sizeof(RendererCanvasRender::Item *));
 
 	disable_scale = false;
+
+	bvh_culling_default = GLOBAL_GET("rendering/2d/culling/use_bvh");
+	bvh_culling_min_children = MAX(1, int(GLOBAL_GET("rendering/2d/culling/bvh_minimum_children")));
 }
 
 RendererCanvasCull::~RendererCanvasCull() {
@@ -31,12 +31,15 @@
 #ifndef RENDERING_SERVER_CANVAS_CULL_H
 #define RENDERING_SERVER_CANVAS_CULL_H
 
+#include "core/math/bvh.h"
 #include "core/templates/paged_allocator.h"
 #include "renderer_compositor.h"
 #include "renderer_viewport.h"
 
 class RendererCanvasCull {
 public:
+	struct ChildrenBVH;
+
 	struct Item : public RendererCanvasRender::Item {
 		RID parent; // canvas it belongs to
 		List<Item *>::Element *E;
@@ -70,6 +73,15 @@ public:
 
 		VisibilityNotifierData *visibility_notifier = nullptr;
 
+		// Spatial index over the children, only created on canvases using BVH culling.
+		ChildrenBVH *children_bvh = nullptr;
+
+		// State of this item inside the parent's children BVH.
+		Item *bvh_owner = nullptr;
+		BVHHandle bvh_handle;
+		bool bvh_dirty = false;
+		bool bvh_unculled = false;
+
 		Item() {
 			children_order_dirty = true;
 			E = nullptr;
@@ -84,9 +96,34 @@ public:
 			ysort_xform = Transform2D();
 			ysort_pos = Vector2();
 			ysort_index = 0;
+			bvh_handle.set_invalid();
 		}
 	};
 
+	struct ChildrenBVH {
+		template <class T>
+		class UserPairTestFunction {
+		public:
+			static bool user_pair_check(const T *p_a, const T *p_b) {
+				return false;
+			}
+		};
+
+		template <class T>
+		class UserCullTestFunction {
+		public:
+			static bool user_cull_check(const T *p_a, const T *p_b) {
+				return true;
+			}
+		};
+
+		// Bounds are stored in the parent's local space, so moving the parent does not dirty them.
+		BVH_Manager<Item, 1, false, 32, UserPairTestFunction<Item>, UserCullTestFunction<Item>, Rect2, Vector2, false> bvh;
+		LocalVector<Item *> dirty_items;
+		LocalVector<Item *> unculled_items; // Children that can't be culled from their own bounds.
+		LocalVector<Item *> visible_items; // Result of the last query, sorted by draw index.
+	};
+
 	struct ItemIndexSort {
 		_FORCE_INLINE_ bool operator()(const Item *p_left, const Item *p_right) const {
 			return p_left->index < p_right->index;
@@ -140,6 +177,7 @@ public:
 		Color modulate;
 		RID parent;
 		float parent_scale;
+		bool use_bvh_culling = false;
 
 		int find_item(Item *p_item) {
 			for (int i = 0; i < child_items.size(); i++) {
@@ -170,6 +208,9 @@ public:
 	bool disable_scale;
 	bool sdf_used = false;
 	bool snapping_2d_transforms_to_pixel = false;
+	bool bvh_culling = false;
+	bool bvh_culling_default = false;
+	int bvh_culling_min_children = 128;
 
 	PagedAllocator<Item::VisibilityNotifierData> visibility_notifier_allocator;
 	SelfList<Item::VisibilityNotifierData>::List visibility_notifier_list;
@@ -180,6 +221,18 @@ private:
 	void _render_canvas_item_tree(RID p_to_render_target, Canvas::ChildItem *p_child_items, int p_child_item_count, Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, RendererCanvasRender::Light *p_lights, RendererCanvasRender::Light *p_directional_lights, RS::CanvasItemTextureFilter p_default_filter, RS::CanvasItemTextureRepeat p_default_repeat, bool p_snap_2d_vertices_to_pixel);
 	void _cull_canvas_item(Item *p_canvas_item, const Transform2D &p_transform, const Rect2 &p_clip_rect, const Color &p_modulate, int p_z, RendererCanvasRender::Item **z_list, RendererCanvasRender::Item **z_last_list, Item *p_canvas_clip, Item *p_material_owner, bool allow_y_sort);
 
+	static bool _is_item_bvh_cullable(const Item *p_item);
+	void _children_bvh_flush(Item *p_item);
+	int _children_bvh_cull(Item *p_item, const Transform2D &p_xform, const Rect2 &p_clip_rect, Item **&r_child_items);
+	void _children_bvh_remove(Item *p_item);
+
+	_FORCE_INLINE_ void _item_bvh_mark_dirty(Item *p_item) {
+		if (p_item->bvh_owner && !p_item->bvh_dirty) {
+			p_item->bvh_dirty = true;
+			p_item->bvh_owner->children_bvh->dirty_items.push_back(p_item);
+		}
+	}
+
 	RendererCanvasRender::Item **z_list;
 	RendererCanvasRender::Item **z_last_list;
 
@@ -195,6 +248,7 @@ public:
 	void canvas_set_modulate(RID p_canvas, const Color &p_color);
 	void canvas_set_parent(RID p_canvas, RID p_parent, float p_scale);
 	void canvas_set_disable_scale(bool p_disable);
+	void canvas_set_use_bvh_culling(RID p_canvas, bool p_enable);
 
 	RID canvas_item_allocate();
 	void canvas_item_initialize(RID p_rid);
@@ -1359,7 +1359,11 @@ void RenderForwardClustered::_render_scene(RenderDataRD *p_render_data, const Co
 	_update_render_base_uniform_set(); //may have changed due to the above (light buffer enlarged, as an example)
 
 	_fill_render_list(RENDER_LIST_OPAQUE, p_render_data, PASS_MODE_COLOR, using_sdfgi, using_sdfgi || using_voxelgi);
-	render_list[RENDER_LIST_OPAQUE].sort_by_key();
+	if (render_buffer) {
+		render_list[RENDER_LIST_OPAQUE].sort_by_key_cached(render_buffer->opaque_sort_cache, surface_cache_epoch);
+	} else {
+		render_list[RENDER_LIST_OPAQUE].sort_by_key();
+	}
 	render_list[RENDER_LIST_ALPHA].sort_by_reverse_depth_and_priority();
 	_fill_instance_data(RENDER_LIST_OPAQUE, p_render_data->render_info ? p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE] : (int *)nullptr);
 	_fill_instance_data(RENDER_LIST_ALPHA);
@@ -2611,6 +2615,7 @@ void RenderForwardClustered::_geometry_instance_mark_dirty(GeometryInstance *p_g
 	while (surf) {
 		GeometryInstanceSurfaceDataCache *next = surf->next;
 		geometry_instance_surface_alloc.free(surf);
+		surface_cache_epoch++;
 		surf = next;
 	}
 
@@ -3124,6 +3129,7 @@ void RenderForwardClustered::geometry_instance_free(GeometryInstance *p_geometry
 	while (surf) {
 		GeometryInstanceSurfaceDataCache *next = surf->next;
 		geometry_instance_surface_alloc.free(surf);
+		surface_cache_epoch++;
 		surf = next;
 	}
 	memdelete(ginstance->data);
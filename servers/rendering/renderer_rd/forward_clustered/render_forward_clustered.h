@@ -34,6 +34,7 @@
 #include "core/templates/paged_allocator.h"
 #include "servers/rendering/renderer_rd/forward_clustered/scene_shader_forward_clustered.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
+#include "servers/rendering/renderer_rd/render_list_sort_cache.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
 #include "servers/rendering/renderer_rd/renderer_storage_rd.h"
 #include "servers/rendering/renderer_rd/shaders/scene_forward_clustered.glsl.gen.h"
@@ -81,6 +82,8 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 
 	/* Framebuffer */
 
+	struct GeometryInstanceSurfaceDataCache;
+
 	struct RenderBufferDataForwardClustered : public RenderBufferData {
 		//for rendering, may be MSAAd
 
@@ -110,6 +113,9 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		uint32_t view_count;
 
 		RID render_sdfgi_uniform_set;
+
+		RenderListSortCache<GeometryInstanceSurfaceDataCache> opaque_sort_cache;
+
 		void ensure_specular();
 		void ensure_voxelgi();
 		void clear();
@@ -151,7 +157,6 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 		COLOR_PASS_FLAG_MULTIVIEW = 1 << 2
 	};
 
-	struct GeometryInstanceSurfaceDataCache;
 	struct RenderElementInfo;
 
 	struct RenderListParameters {
@@ -443,6 +448,8 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 			};
 		} sort;
 
+		uint64_t sort_cache_pass = 0; // scratch for RenderListSortCache
+
 		RS::PrimitiveType primitive = RS::PRIMITIVE_MAX;
 		uint32_t flags = 0;
 		uint32_t surface_index = 0;
@@ -532,6 +539,7 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 
 	PagedAllocator<GeometryInstanceForwardClustered> geometry_instance_alloc;
 	PagedAllocator<GeometryInstanceSurfaceDataCache> geometry_instance_surface_alloc;
+	uint64_t surface_cache_epoch = 0; // Bumped whenever surface caches are freed, invalidates render list sort caches.
 	PagedAllocator<GeometryInstanceLightmapSH> geometry_instance_lightmap_sh;
 
 	void _geometry_instance_add_surface_with_material(GeometryInstanceForwardClustered *ginstance, uint32_t p_surface, SceneShaderForwardClustered::MaterialData *p_material, uint32_t p_material_id, uint32_t p_shader_id, RID p_mesh);
@@ -565,6 +573,10 @@ class RenderForwardClustered : public RendererSceneRenderRD {
 			sorter.sort(elements.ptr(), elements.size());
 		}
 
+		void sort_by_key_cached(RenderListSortCache<GeometryInstanceSurfaceDataCache> &p_cache, uint64_t p_epoch) {
+			p_cache.sort(elements.ptr(), elements.size(), p_epoch);
+		}
+
 		void sort_by_key_range(uint32_t p_from, uint32_t p_size) {
 			SortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
 			sorter.sort(elements.ptr() + p_from, p_size);
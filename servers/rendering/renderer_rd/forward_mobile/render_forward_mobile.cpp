@@ -509,7 +509,11 @@ void RenderForwardMobile::_render_scene(RenderDataRD *p_render_data, const Color
 
 	// fill our render lists early so we can find out if we use various features
 	_fill_render_list(RENDER_LIST_OPAQUE, p_render_data, PASS_MODE_COLOR);
-	render_list[RENDER_LIST_OPAQUE].sort_by_key();
+	if (render_buffer) {
+		render_list[RENDER_LIST_OPAQUE].sort_by_key_cached(render_buffer->opaque_sort_cache, surface_cache_epoch);
+	} else {
+		render_list[RENDER_LIST_OPAQUE].sort_by_key();
+	}
 	render_list[RENDER_LIST_ALPHA].sort_by_reverse_depth_and_priority();
 	_fill_element_info(RENDER_LIST_OPAQUE);
 	_fill_element_info(RENDER_LIST_ALPHA);
@@ -2199,6 +2203,7 @@ void RenderForwardMobile::geometry_instance_free(GeometryInstance *p_geometry_in
 	while (surf) {
 		GeometryInstanceSurfaceDataCache *next = surf->next;
 		geometry_instance_surface_alloc.free(surf);
+		surface_cache_epoch++;
 		surf = next;
 	}
 	memdelete(ginstance->data);
@@ -2281,6 +2286,7 @@ void RenderForwardMobile::_geometry_instance_mark_dirty(GeometryInstance *p_geom
 	while (surf) {
 		GeometryInstanceSurfaceDataCache *next = surf->next;
 		geometry_instance_surface_alloc.free(surf);
+		surface_cache_epoch++;
 		surf = next;
 	}
 
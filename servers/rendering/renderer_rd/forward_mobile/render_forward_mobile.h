@@ -34,6 +34,7 @@
 #include "core/templates/paged_allocator.h"
 #include "servers/rendering/renderer_rd/forward_mobile/scene_shader_forward_mobile.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
+#include "servers/rendering/renderer_rd/render_list_sort_cache.h"
 #include "servers/rendering/renderer_rd/renderer_scene_render_rd.h"
 #include "servers/rendering/renderer_rd/renderer_storage_rd.h"
 
@@ -119,6 +120,8 @@ protected:
 		FB_CONFIG_MAX
 	};
 
+	struct GeometryInstanceSurfaceDataCache;
+
 	struct RenderBufferDataForwardMobile : public RenderBufferData {
 		RID color;
 		RID depth;
@@ -135,6 +138,8 @@ protected:
 		int width, height;
 		uint32_t view_count;
 
+		RenderListSortCache<GeometryInstanceSurfaceDataCache> opaque_sort_cache;
+
 		void clear();
 		virtual void configure(RID p_color_buffer, RID p_depth_buffer, RID p_target_buffer, int p_width, int p_height, RS::ViewportMSAA p_msaa, uint32_t p_view_count);
 
@@ -159,7 +164,6 @@ protected:
 	};
 
 	struct GeometryInstanceForwardMobile;
-	struct GeometryInstanceSurfaceDataCache;
 	struct RenderElementInfo;
 
 	struct RenderListParameters {
@@ -382,6 +386,10 @@ protected:
 			sorter.sort(elements.ptr(), elements.size());
 		}
 
+		void sort_by_key_cached(RenderListSortCache<GeometryInstanceSurfaceDataCache> &p_cache, uint64_t p_epoch) {
+			p_cache.sort(elements.ptr(), elements.size(), p_epoch);
+		}
+
 		void sort_by_key_range(uint32_t p_from, uint32_t p_size) {
 			SortArray<GeometryInstanceSurfaceDataCache *, SortByKey> sorter;
 			sorter.sort(elements.ptr() + p_from, p_size);
@@ -497,6 +505,8 @@ protected:
 			};
 		} sort;
 
+		uint64_t sort_cache_pass = 0; // scratch for RenderListSortCache
+
 		RS::PrimitiveType primitive = RS::PRIMITIVE_MAX;
 		uint32_t flags = 0;
 		uint32_t surface_index = 0;
@@ -618,6 +628,7 @@ public:
 
 	PagedAllocator<GeometryInstanceForwardMobile> geometry_instance_alloc;
 	PagedAllocator<GeometryInstanceSurfaceDataCache> geometry_instance_surface_alloc;
+	uint64_t surface_cache_epoch = 0; // Bumped whenever surface caches are freed, invalidates render list sort caches.
 	PagedAllocator<GeometryInstanceLightmapSH> geometry_instance_lightmap_sh;
 
 	void _geometry_instance_add_surface_with_material(GeometryInstanceForwardMobile *ginstance, uint32_t p_surface, SceneShaderForwardMobile::MaterialData *p_material, uint32_t p_material_id, uint32_t p_shader_id, RID p_mesh);
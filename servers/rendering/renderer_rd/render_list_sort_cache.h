@@ -0,0 +1,176 @@
+/*************************************************************************/
+/*  render_list_sort_cache.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef RENDER_LIST_SORT_CACHE_H
+#define RENDER_LIST_SORT_CACHE_H
+
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+
+// Keeps the sorted opaque render list of the previous frame around, so that
+// frames where most surfaces keep their sort keys (static geometry) only need
+// to sort the few elements that changed and merge them back in, instead of
+// sorting the whole list again.
+//
+// T must expose `sort.sort_key1`, `sort.sort_key2` and a `uint64_t sort_cache_pass`
+// scratch field. Elements must be unique within a list. Cached pointers are only
+// dereferenced while the epoch passed to sort() stays the same, so the owner must
+// bump it whenever elements may have been freed.
+template <class T>
+class RenderListSortCache {
+	struct Entry {
+		T *element = nullptr;
+		uint64_t sort_key1 = 0;
+		uint64_t sort_key2 = 0;
+	};
+
+	struct SortByKey {
+		_FORCE_INLINE_ bool operator()(const T *A, const T *B) const {
+			return (A->sort.sort_key2 == B->sort.sort_key2) ? (A->sort.sort_key1 < B->sort.sort_key1) : (A->sort.sort_key2 < B->sort.sort_key2);
+		}
+	};
+
+	LocalVector<Entry> entries;
+	LocalVector<T *> kept;
+	LocalVector<T *> changed;
+	uint64_t epoch = 0;
+	bool valid = false;
+
+	uint32_t reused_count = 0;
+	uint32_t sorted_count = 0;
+
+	static uint64_t _next_pass() {
+		// Two stamps per pass: "present in this list" and "already placed".
+		static uint64_t pass = 0;
+		pass += 2;
+		return pass;
+	}
+
+	void _store(T **p_elements, uint32_t p_count) {
+		entries.resize(p_count);
+		for (uint32_t i = 0; i < p_count; i++) {
+			entries[i].element = p_elements[i];
+			entries[i].sort_key1 = p_elements[i]->sort.sort_key1;
+			entries[i].sort_key2 = p_elements[i]->sort.sort_key2;
+		}
+	}
+
+	void _full_sort(T **p_elements, uint32_t p_count) {
+		SortArray<T *, SortByKey> sorter;
+		sorter.sort(p_elements, p_count);
+		reused_count = 0;
+		sorted_count = p_count;
+	}
+
+public:
+	void sort(T **p_elements, uint32_t p_count, uint64_t p_epoch) {
+		if (!valid || p_epoch != epoch || entries.size() == 0) {
+			_full_sort(p_elements, p_count);
+			_store(p_elements, p_count);
+			epoch = p_epoch;
+			valid = true;
+			return;
+		}
+
+		const uint64_t present = _next_pass();
+		const uint64_t placed = present + 1;
+
+		for (uint32_t i = 0; i < p_count; i++) {
+			p_elements[i]->sort_cache_pass = present;
+		}
+
+		// Cached entries still in the list with unchanged keys form an already sorted subsequence.
+		kept.clear();
+		for (uint32_t i = 0; i < entries.size(); i++) {
+			const Entry &e = entries[i];
+			T *element = e.element;
+			if (element->sort_cache_pass == present && element->sort.sort_key1 == e.sort_key1 && element->sort.sort_key2 == e.sort_key2) {
+				element->sort_cache_pass = placed;
+				kept.push_back(element);
+			}
+		}
+
+		changed.clear();
+		for (uint32_t i = 0; i < p_count; i++) {
+			if (p_elements[i]->sort_cache_pass == present) {
+				changed.push_back(p_elements[i]);
+			}
+		}
+
+		if (changed.size() > p_count / 2) {
+			// Too little coherence to be worth merging.
+			_full_sort(p_elements, p_count);
+			_store(p_elements, p_count);
+			return;
+		}
+
+		if (changed.size()) {
+			SortArray<T *, SortByKey> sorter;
+			sorter.sort(changed.ptr(), changed.size());
+		}
+
+		SortByKey compare;
+		uint32_t k = 0;
+		uint32_t c = 0;
+		uint32_t dst = 0;
+		while (k < kept.size() && c < changed.size()) {
+			if (compare(changed[c], kept[k])) {
+				p_elements[dst++] = changed[c++];
+			} else {
+				p_elements[dst++] = kept[k++];
+			}
+		}
+		while (k < kept.size()) {
+			p_elements[dst++] = kept[k++];
+		}
+		while (c < changed.size()) {
+			p_elements[dst++] = changed[c++];
+		}
+
+		reused_count = kept.size();
+		sorted_count = changed.size();
+
+		_store(p_elements, p_count);
+	}
+
+	void clear() {
+		entries.clear();
+		kept.clear();
+		changed.clear();
+		valid = false;
+		reused_count = 0;
+		sorted_count = 0;
+	}
+
+	uint32_t get_reused_count() const { return reused_count; }
+	uint32_t get_sorted_count() const { return sorted_count; }
+};
+
+#endif // RENDER_LIST_SORT_CACHE_H
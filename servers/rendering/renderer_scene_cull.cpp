@@ -31,12 +31,18 @@
 #include "renderer_scene_cull.h"
 
 #include "core/config/project_settings.h"
+#include "core/debugger/engine_debugger.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
 #include "rendering_server_default.h"
 #include "rendering_server_globals.h"
 
 #include <new>
 
+#if defined(__SSE2__) && !defined(REAL_T_IS_DOUBLE)
+#include <emmintrin.h>
+#endif
+
 /* CAMERA API */
 
 RID RendererSceneCull::camera_allocate() {
@@ -366,6 +372,7 @@ void RendererSceneCull::scenario_initialize(RID p_rid) {
 	scenario->reflection_atlas = scene_render->reflection_atlas_create();
 
 	scenario->instance_aabbs.set_page_pool(&instance_aabb_page_pool);
+	scenario->instance_aabb_blocks.set_page_pool(&instance_aabb_block_page_pool);
 	scenario->instance_data.set_page_pool(&instance_data_page_pool);
 	scenario->instance_visibility.set_page_pool(&instance_visibility_data_page_pool);
 
@@ -849,6 +856,18 @@ void RendererSceneCull::instance_geometry_set_transparency(RID p_instance, float
 	}
 }
 
+#ifdef DEBUG_ENABLED
+static bool _is_transform_finite(const Transform3D &p_transform) {
+	for (int i = 0; i < 4; i++) {
+		const Vector3 &v = i < 3 ? p_transform.basis.rows[i] : p_transform.origin;
+		if (Math::is_inf(v.x) || Math::is_nan(v.x) || Math::is_inf(v.y) || Math::is_nan(v.y) || Math::is_inf(v.z) || Math::is_nan(v.z)) {
+			return false;
+		}
+	}
+	return true;
+}
+#endif
+
 void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_COND(!instance);
@@ -858,22 +877,58 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	}
 
 #ifdef DEBUG_ENABLED
-
-	for (int i = 0; i < 4; i++) {
-		const Vector3 &v = i < 3 ? p_transform.basis.rows[i] : p_transform.origin;
-		ERR_FAIL_COND(Math::is_inf(v.x));
-		ERR_FAIL_COND(Math::is_nan(v.x));
-		ERR_FAIL_COND(Math::is_inf(v.y));
-		ERR_FAIL_COND(Math::is_nan(v.y));
-		ERR_FAIL_COND(Math::is_inf(v.z));
-		ERR_FAIL_COND(Math::is_nan(v.z));
-	}
-
+	ERR_FAIL_COND_MSG(!_is_transform_finite(p_transform), "Instance transform contains NaN or infinite values.");
 #endif
 	instance->transform = p_transform;
 	_instance_queue_update(instance, true);
 }
 
+void RendererSceneCull::instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms) {
+	ERR_FAIL_COND(p_instances.size() != p_transforms.size());
+
+	const RID *rids = p_instances.ptr();
+	const Transform3D *transforms = p_transforms.ptr();
+
+	transform_batch.clear();
+
+	for (int i = 0; i < p_instances.size(); i++) {
+		Instance *instance = instance_owner.get_or_null(rids[i]);
+		ERR_CONTINUE(!instance);
+
+		if (instance->transform == transforms[i]) {
+			continue;
+		}
+
+#ifdef DEBUG_ENABLED
+		ERR_CONTINUE_MSG(!_is_transform_finite(transforms[i]), "Instance transform contains NaN or infinite values.");
+#endif
+		instance->transform = transforms[i];
+
+		if (instance->update_item.in_list()) {
+			// Other changes are pending, let update_dirty_instances() process everything at once.
+			_instance_queue_update(instance, true);
+		} else {
+			transform_batch.push_back(instance);
+		}
+	}
+
+	// Bounds only depend on the instance itself, so they can be computed in parallel.
+	// Indexing and pairing touch the scenario and are done serially afterwards.
+	if (transform_batch.size() > thread_cull_threshold) {
+		RendererThreadPool::singleton->thread_work_pool.do_work(RendererThreadPool::singleton->thread_work_pool.get_thread_count(), this, &RendererSceneCull::_update_instance_bounds_threaded, &transform_batch);
+	} else {
+		for (uint32_t i = 0; i < transform_batch.size(); i++) {
+			_update_instance_bounds(transform_batch[i]);
+		}
+	}
+
+	for (uint32_t i = 0; i < transform_batch.size(); i++) {
+		_update_instance(transform_batch[i], true);
+	}
+
+	transform_batch.clear();
+}
+
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
 	Instance *instance = instance_owner.get_or_null(p_instance);
 	ERR_FAIL_COND(!instance);
@@ -1480,7 +1535,44 @@ void RendererSceneCull::instance_geometry_get_shader_parameter_list(RID p_instan
 	}
 }
 
-void RendererSceneCull::_update_instance(Instance *p_instance) {
+void RendererSceneCull::_update_instance_bounds(Instance *p_instance) {
+	if (p_instance->aabb.has_no_surface()) {
+		return;
+	}
+
+	p_instance->transformed_aabb = p_instance->transform.xform(p_instance->aabb);
+
+	//quantize to improve moving object performance
+	AABB bvh_aabb = p_instance->transformed_aabb;
+
+	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
+		//assume motion, see if bounds need to be quantized
+		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
+		float motion_longest_axis = motion_aabb.get_longest_axis_size();
+		float longest_axis = p_instance->transformed_aabb.get_longest_axis_size();
+
+		if (motion_longest_axis < longest_axis * 2) {
+			//moved but not a lot, use motion aabb quantizing
+			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
+			bvh_aabb.quantize(quantize_size);
+		}
+	}
+
+	p_instance->indexer_aabb = bvh_aabb;
+}
+
+void RendererSceneCull::_update_instance_bounds_threaded(uint32_t p_thread, LocalVector<Instance *> *p_instances) {
+	uint32_t total = p_instances->size();
+	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
+	uint32_t from = p_thread * total / total_threads;
+	uint32_t to = (p_thread + 1 == total_threads) ? total : ((p_thread + 1) * total / total_threads);
+
+	for (uint32_t i = from; i < to; i++) {
+		_update_instance_bounds((*p_instances)[i]);
+	}
+}
+
+void RendererSceneCull::_update_instance(Instance *p_instance, bool p_bounds_updated) {
 	p_instance->version++;
 
 	if (p_instance->base_type == RS::INSTANCE_LIGHT) {
@@ -1562,9 +1654,9 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 	}
 
-	AABB new_aabb;
-	new_aabb = p_instance->transform.xform(p_instance->aabb);
-	p_instance->transformed_aabb = new_aabb;
+	if (!p_bounds_updated) {
+		_update_instance_bounds(p_instance);
+	}
 
 	if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
 		InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
@@ -1597,21 +1689,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		return;
 	}
 
-	//quantize to improve moving object performance
-	AABB bvh_aabb = p_instance->transformed_aabb;
-
-	if (p_instance->indexer_id.is_valid() && bvh_aabb != p_instance->prev_transformed_aabb) {
-		//assume motion, see if bounds need to be quantized
-		AABB motion_aabb = bvh_aabb.merge(p_instance->prev_transformed_aabb);
-		float motion_longest_axis = motion_aabb.get_longest_axis_size();
-		float longest_axis = p_instance->transformed_aabb.get_longest_axis_size();
-
-		if (motion_longest_axis < longest_axis * 2) {
-			//moved but not a lot, use motion aabb quantizing
-			float quantize_size = Math::pow(2.0, Math::ceil(Math::log(motion_longest_axis) / Math::log(2.0))) * 0.5; //one fifth
-			bvh_aabb.quantize(quantize_size);
-		}
-	}
+	const AABB &bvh_aabb = p_instance->indexer_aabb;
 
 	if (!p_instance->indexer_id.is_valid()) {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1700,7 +1778,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		}
 
 		p_instance->scenario->instance_data.push_back(idata);
-		p_instance->scenario->instance_aabbs.push_back(InstanceBounds(p_instance->transformed_aabb));
+		p_instance->scenario->push_instance_bounds(InstanceBounds(p_instance->transformed_aabb));
 		_update_instance_visibility_dependencies(p_instance);
 	} else {
 		if ((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) {
@@ -1708,7 +1786,7 @@ void RendererSceneCull::_update_instance(Instance *p_instance) {
 		} else {
 			p_instance->scenario->indexers[Scenario::INDEXER_VOLUMES].update(p_instance->indexer_id, bvh_aabb);
 		}
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = InstanceBounds(p_instance->transformed_aabb);
+		p_instance->scenario->set_instance_bounds(p_instance->array_index, InstanceBounds(p_instance->transformed_aabb));
 	}
 
 	if (p_instance->visibility_index != -1) {
@@ -1791,7 +1869,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 		Instance *swapped_instance = p_instance->scenario->instance_data[swap_with_index].instance;
 		swapped_instance->array_index = p_instance->array_index; //swap
 		p_instance->scenario->instance_data[p_instance->array_index] = p_instance->scenario->instance_data[swap_with_index];
-		p_instance->scenario->instance_aabbs[p_instance->array_index] = p_instance->scenario->instance_aabbs[swap_with_index];
+		p_instance->scenario->set_instance_bounds(p_instance->array_index, p_instance->scenario->instance_aabbs[swap_with_index]);
 
 		if (swapped_instance->visibility_index != -1) {
 			swapped_instance->scenario->instance_visibility[swapped_instance->visibility_index].array_index = swapped_instance->array_index;
@@ -1807,7 +1885,7 @@ void RendererSceneCull::_unpair_instance(Instance *p_instance) {
 
 	// pop last
 	p_instance->scenario->instance_data.pop_back();
-	p_instance->scenario->instance_aabbs.pop_back();
+	p_instance->scenario->pop_instance_bounds();
 
 	//uninitialize
 	p_instance->array_index = -1;
@@ -2207,14 +2285,33 @@ void RendererSceneCull::_light_instance_setup_directional_shadow(int p_shadow_in
 	}
 }
 
+void RendererSceneCull::_light_instance_queue_shadow_cull(Instance *p_instance, const Vector<Plane> &p_planes, int p_pass) {
+	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
+
+	RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used];
+	shadow_data.light = light->instance;
+	shadow_data.pass = p_pass;
+
+	if (shadow_cull_job_count == shadow_cull_jobs.size()) {
+		shadow_cull_jobs.push_back(ShadowCullJob());
+	}
+
+	// Jobs are reused between frames, so their mesh instance lists keep their capacity.
+	ShadowCullJob &job = shadow_cull_jobs[shadow_cull_job_count++];
+	job.light = p_instance;
+	job.shadow_index = max_shadows_used++;
+	job.planes = p_planes;
+	job.animated_material_found = false;
+	job.mesh_instances.clear();
+	job.cull_usec = 0;
+}
+
 bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_screen_mesh_lod_threshold) {
 	InstanceLightData *light = static_cast<InstanceLightData *>(p_instance->base_data);
 
 	Transform3D light_transform = p_instance->transform;
 	light_transform.orthonormalize(); //scale does not count on lights
 
-	bool animated_material_found = false;
-
 	switch (RSG::light_storage->light_get_type(p_instance->base)) {
 		case RS::LIGHT_DIRECTIONAL: {
 		} break;
@@ -2226,9 +2323,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					return true;
 				}
 				for (int i = 0; i < 2; i++) {
-					//using this one ensures that raster deferred will have it
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Paraboloid, Half " + itos(i));
-
 					real_t radius = RSG::light_storage->light_get_param(p_instance->base, RS::LIGHT_PARAM_RANGE);
 
 					real_t z = i == 0 ? -1 : 1;
@@ -2241,48 +2335,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 					planes.write[4] = light_transform.xform(Plane(Vector3(0, -1, z).normalized(), radius));
 					planes.write[5] = light_transform.xform(Plane(Vector3(0, 0, -z), 0));
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
+					_light_instance_queue_shadow_cull(p_instance, planes, i);
 
 					scene_render->light_instance_set_shadow_transform(light->instance, CameraMatrix(), light_transform, radius, 0, i, 0);
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 			} else { //shadow cube
 
@@ -2295,9 +2350,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 				cm.set_perspective(90, 1, radius * 0.005f, radius);
 
 				for (int i = 0; i < 6; i++) {
-					RENDER_TIMESTAMP("Cull OmniLight3D Shadow Cube, Side " + itos(i));
-					//using this one ensures that raster deferred will have it
-
 					static const Vector3 view_normals[6] = {
 						Vector3(+1, 0, 0),
 						Vector3(-1, 0, 0),
@@ -2317,49 +2369,9 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 					Transform3D xform = light_transform * Transform3D().looking_at(view_normals[i], view_up[i]);
 
-					Vector<Plane> planes = cm.get_projection_planes(xform);
+					_light_instance_queue_shadow_cull(p_instance, cm.get_projection_planes(xform), i);
 
-					instance_shadow_cull_result.clear();
-
-					Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
-
-					struct CullConvex {
-						PagedArray<Instance *> *result;
-						_FORCE_INLINE_ bool operator()(void *p_data) {
-							Instance *p_instance = (Instance *)p_data;
-							result->push_back(p_instance);
-							return false;
-						}
-					};
-
-					CullConvex cull_convex;
-					cull_convex.result = &instance_shadow_cull_result;
-
-					p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
-
-					RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
-
-					for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-						Instance *instance = instance_shadow_cull_result[j];
-						if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-							continue;
-						} else {
-							if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-								animated_material_found = true;
-							}
-							if (instance->mesh_instance.is_valid()) {
-								RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-							}
-						}
-
-						shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
-					}
-
-					RSG::mesh_storage->update_mesh_instances();
 					scene_render->light_instance_set_shadow_transform(light->instance, cm, xform, radius, 0, i, 0);
-
-					shadow_data.light = light->instance;
-					shadow_data.pass = i;
 				}
 
 				//restore the regular DP matrix
@@ -2368,8 +2380,6 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 
 		} break;
 		case RS::LIGHT_SPOT: {
-			RENDER_TIMESTAMP("Cull SpotLight3D Shadow");
-
 			if (max_shadows_used + 1 > MAX_UPDATE_SHADOWS) {
 				return true;
 			}
@@ -2380,54 +2390,110 @@ bool RendererSceneCull::_light_instance_update_shadow(Instance *p_instance, cons
 			CameraMatrix cm;
 			cm.set_perspective(angle * 2.0, 1.0, 0.005f * radius, radius);
 
-			Vector<Plane> planes = cm.get_projection_planes(light_transform);
+			_light_instance_queue_shadow_cull(p_instance, cm.get_projection_planes(light_transform), 0);
 
-			instance_shadow_cull_result.clear();
+			scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
+		} break;
+	}
 
-			Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(&planes[0], planes.size());
+	// Animated materials are only known once the shadow has been culled, see _light_instance_cull_shadows().
+	return false;
+}
 
-			struct CullConvex {
-				PagedArray<Instance *> *result;
-				_FORCE_INLINE_ bool operator()(void *p_data) {
-					Instance *p_instance = (Instance *)p_data;
-					result->push_back(p_instance);
-					return false;
-				}
-			};
+void RendererSceneCull::_light_instance_cull_shadow_threaded(uint32_t p_job, Scenario *p_scenario) {
+	ShadowCullJob &job = shadow_cull_jobs[p_job];
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
 
-			CullConvex cull_convex;
-			cull_convex.result = &instance_shadow_cull_result;
+	Vector<Vector3> points = Geometry3D::compute_convex_mesh_points(job.planes.ptr(), job.planes.size());
 
-			p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(planes.ptr(), planes.size(), points.ptr(), points.size(), cull_convex);
+	struct CullConvex {
+		ShadowCullJob *job;
+		PagedArray<RendererSceneRender::GeometryInstance *> *result;
+		_FORCE_INLINE_ bool operator()(void *p_data) {
+			Instance *p_instance = (Instance *)p_data;
+			if (!p_instance->visible || !((1 << p_instance->base_type) & RS::INSTANCE_GEOMETRY_MASK)) {
+				return false;
+			}
 
-			RendererSceneRender::RenderShadowData &shadow_data = render_shadow_data[max_shadows_used++];
+			InstanceGeometryData *geom = static_cast<InstanceGeometryData *>(p_instance->base_data);
+			if (!geom->can_cast_shadows) {
+				return false;
+			}
 
-			for (int j = 0; j < (int)instance_shadow_cull_result.size(); j++) {
-				Instance *instance = instance_shadow_cull_result[j];
-				if (!instance->visible || !((1 << instance->base_type) & RS::INSTANCE_GEOMETRY_MASK) || !static_cast<InstanceGeometryData *>(instance->base_data)->can_cast_shadows) {
-					continue;
-				} else {
-					if (static_cast<InstanceGeometryData *>(instance->base_data)->material_is_animated) {
-						animated_material_found = true;
-					}
+			if (geom->material_is_animated) {
+				job->animated_material_found = true;
+			}
 
-					if (instance->mesh_instance.is_valid()) {
-						RSG::mesh_storage->mesh_instance_check_for_update(instance->mesh_instance);
-					}
-				}
-				shadow_data.instances.push_back(static_cast<InstanceGeometryData *>(instance->base_data)->geometry_instance);
+			// Mesh storage is not thread safe, the updates are requested once all jobs are done.
+			if (p_instance->mesh_instance.is_valid()) {
+				job->mesh_instances.push_back(p_instance->mesh_instance);
 			}
 
-			RSG::mesh_storage->update_mesh_instances();
+			result->push_back(geom->geometry_instance);
+			return false;
+		}
+	};
 
-			scene_render->light_instance_set_shadow_transform(light->instance, cm, light_transform, radius, 0, 0, 0);
-			shadow_data.light = light->instance;
-			shadow_data.pass = 0;
+	CullConvex cull_convex;
+	cull_convex.job = &job;
+	cull_convex.result = &render_shadow_data[job.shadow_index].instances;
 
-		} break;
+	p_scenario->indexers[Scenario::INDEXER_GEOMETRY].convex_query(job.planes.ptr(), job.planes.size(), points.ptr(), points.size(), cull_convex);
+
+	job.cull_usec = OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+void RendererSceneCull::_light_instance_cull_shadows(Scenario *p_scenario) {
+	if (shadow_cull_job_count == 0) {
+		return;
+	}
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	// Every job writes to its own RenderShadowData, so the results don't depend on how jobs are scheduled.
+	RendererThreadPool::singleton->thread_work_pool.do_work(shadow_cull_job_count, this, &RendererSceneCull::_light_instance_cull_shadow_threaded, p_scenario);
+
+	uint64_t cull_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	for (uint32_t i = 0; i < shadow_cull_job_count; i++) {
+		const ShadowCullJob &job = shadow_cull_jobs[i];
+
+		if (job.animated_material_found) {
+			static_cast<InstanceLightData *>(job.light->base_data)->shadow_dirty = true;
+		}
+
+		for (uint32_t j = 0; j < job.mesh_instances.size(); j++) {
+			RSG::mesh_storage->mesh_instance_check_for_update(job.mesh_instances[j]);
+		}
+	}
+
+	RSG::mesh_storage->update_mesh_instances();
+
+	// The servers profiler is not thread safe, so only report when rendering on the main thread.
+	if (!RSG::threaded && EngineDebugger::is_profiling("servers")) {
+		for (uint32_t i = 0; i < shadow_cull_job_count; i++) {
+			// Jobs from the same light are queued next to each other, report their sum.
+			Instance *light = shadow_cull_jobs[i].light;
+			uint64_t light_usec = shadow_cull_jobs[i].cull_usec;
+			while (i + 1 < shadow_cull_job_count && shadow_cull_jobs[i + 1].light == light) {
+				light_usec += shadow_cull_jobs[++i].cull_usec;
+			}
+
+			Array values;
+			values.push_back("shadow_culling");
+			values.push_back(vformat("%s %d", RSG::light_storage->light_get_type(light->base) == RS::LIGHT_OMNI ? "OmniLight3D" : "SpotLight3D", uint64_t(light->object_id)));
+			values.push_back(USEC_TO_SEC(light_usec));
+			EngineDebugger::profiler_add_frame_data("servers", values);
+		}
+
+		Array values;
+		values.push_back("shadow_culling");
+		values.push_back("total");
+		values.push_back(USEC_TO_SEC(cull_usec));
+		EngineDebugger::profiler_add_frame_data("servers", values);
 	}
 
-	return animated_material_found;
+	shadow_cull_job_count = 0;
 }
 
 void RendererSceneCull::render_camera(RID p_render_buffers, RID p_camera, RID p_scenario, RID p_viewport, Size2 p_viewport_size, float p_screen_mesh_lod_threshold, RID p_shadow_atlas, Ref<XRInterface> &p_xr_interface, RenderInfo *r_render_info) {
@@ -2612,6 +2678,46 @@ bool RendererSceneCull::_visibility_parent_check(const CullData &p_cull_data, co
 	return ((parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK) == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE) || (parent_flags & InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 }
 
+uint32_t RendererSceneCull::InstanceBoundsBlock::in_frustum_mask(const Frustum &p_frustum) const {
+	const real_t *components[6] = { min_x, min_y, min_z, max_x, max_y, max_z };
+
+#if defined(__SSE2__) && !defined(REAL_T_IS_DOUBLE)
+	static_assert(SIZE == 4, "SSE2 path tests exactly four bounds at once.");
+
+	__m128 outside = _mm_setzero_ps();
+	for (uint32_t i = 0; i < p_frustum.plane_count; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const PlaneSign &sign = p_frustum.plane_signs_ptr[i];
+
+		__m128 dist = _mm_mul_ps(_mm_loadu_ps(components[sign.signs[0]]), _mm_set1_ps(plane.normal.x));
+		dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(components[sign.signs[1]]), _mm_set1_ps(plane.normal.y)));
+		dist = _mm_add_ps(dist, _mm_mul_ps(_mm_loadu_ps(components[sign.signs[2]]), _mm_set1_ps(plane.normal.z)));
+		outside = _mm_or_ps(outside, _mm_cmpge_ps(_mm_sub_ps(dist, _mm_set1_ps(plane.d)), _mm_setzero_ps()));
+
+		if (_mm_movemask_ps(outside) == 0xF) {
+			return 0;
+		}
+	}
+
+	return ~uint32_t(_mm_movemask_ps(outside)) & 0xF;
+#else
+	uint32_t mask = (1 << SIZE) - 1;
+	for (uint32_t i = 0; i < p_frustum.plane_count && mask; i++) {
+		const Plane &plane = p_frustum.planes_ptr[i];
+		const PlaneSign &sign = p_frustum.plane_signs_ptr[i];
+
+		for (uint32_t j = 0; j < SIZE; j++) {
+			real_t dist = components[sign.signs[0]][j] * plane.normal.x + components[sign.signs[1]][j] * plane.normal.y + components[sign.signs[2]][j] * plane.normal.z - plane.d;
+			if (dist >= 0.0) {
+				mask &= ~(1 << j);
+			}
+		}
+	}
+
+	return mask;
+#endif
+}
+
 void RendererSceneCull::_scene_cull_threaded(uint32_t p_thread, CullData *cull_data) {
 	uint32_t cull_total = cull_data->scenario->instance_data.size();
 	uint32_t total_threads = RendererThreadPool::singleton->thread_work_pool.get_thread_count();
@@ -2633,23 +2739,41 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Frustum tests run once per block of instances, one bit per instance.
+	uint64_t frustum_block = UINT64_MAX;
+	uint32_t frustum_mask = 0;
+	uint32_t cascade_masks[RendererSceneRender::MAX_DIRECTIONAL_LIGHTS][RendererSceneRender::MAX_DIRECTIONAL_LIGHT_CASCADES];
+
 	for (uint64_t i = p_from; i < p_to; i++) {
 		bool mesh_visible = false;
 
+		const uint64_t block = i / InstanceBoundsBlock::SIZE;
+		if (block != frustum_block) {
+			const InstanceBoundsBlock &bounds_block = cull_data.scenario->instance_aabb_blocks[block];
+			frustum_mask = bounds_block.in_frustum_mask(cull_data.cull->frustum);
+			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
+				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
+					cascade_masks[j][k] = bounds_block.in_frustum_mask(cull_data.cull->shadows[j].cascades[k].frustum);
+				}
+			}
+			frustum_block = block;
+		}
+		const uint32_t lane_bit = 1 << (i % InstanceBoundsBlock::SIZE);
+
 		InstanceData &idata = cull_data.scenario->instance_data[i];
 		uint32_t visibility_flags = idata.flags & (InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE | InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN | InstanceData::FLAG_VISIBILITY_DEPENDENCY_FADE_CHILDREN);
 		int32_t visibility_check = -1;
 
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
-#define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_FRUSTUM(m_mask) (lane_bit & (m_mask))
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && IN_FRUSTUM(frustum_mask) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2828,7 +2952,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 
 			for (uint32_t j = 0; j < cull_data.cull->shadow_count; j++) {
 				for (uint32_t k = 0; k < cull_data.cull->shadows[j].cascade_count; k++) {
-					if (IN_FRUSTUM(cull_data.cull->shadows[j].cascades[k].frustum) && VIS_CHECK) {
+					if (IN_FRUSTUM(cascade_masks[j][k]) && VIS_CHECK) {
 						uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 
 						if (((1 << base_type) & RS::INSTANCE_GEOMETRY_MASK) && idata.flags & InstanceData::FLAG_CAST_SHADOWS) {
@@ -3162,6 +3286,9 @@ void RendererSceneCull::_render_scene(const RendererSceneRender::CameraData *p_c
 				light->shadow_dirty = redraw;
 			}
 		}
+
+		RENDER_TIMESTAMP("Cull Light3D Shadows");
+		_light_instance_cull_shadows(scenario);
 	}
 
 	//render SDFGI
@@ -3654,7 +3781,7 @@ void RendererSceneCull::_update_instance_shader_parameters_from_material(Map<Str
 	}
 }
 
-void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
+void RendererSceneCull::_update_dirty_instance_base(Instance *p_instance) {
 	if (p_instance->update_aabb) {
 		_update_instance_aabb(p_instance);
 	}
@@ -3861,6 +3988,10 @@ void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
 			scene_render->geometry_instance_set_surface_materials(geom->geometry_instance, p_instance->materials);
 		}
 	}
+}
+
+void RendererSceneCull::_update_dirty_instance(Instance *p_instance) {
+	_update_dirty_instance_base(p_instance);
 
 	_instance_update_list.remove(&p_instance->update_item);
 
@@ -3874,8 +4005,46 @@ void RendererSceneCull::update_dirty_instances() {
 	RSG::storage->update_dirty_resources();
 
 	while (_instance_update_list.first()) {
-		_update_dirty_instance(_instance_update_list.first()->self());
+		dirty_instance_batch.clear();
+		for (SelfList<Instance> *E = _instance_update_list.first(); E; E = E->next()) {
+			dirty_instance_batch.push_back(E->self());
+		}
+
+		if (dirty_instance_batch.size() <= thread_cull_threshold) {
+			while (_instance_update_list.first()) {
+				_update_dirty_instance(_instance_update_list.first()->self());
+			}
+			continue;
+		}
+
+		// Base AABBs and dependencies come from storage, which is not thread safe.
+		for (uint32_t i = 0; i < dirty_instance_batch.size(); i++) {
+			Instance *instance = dirty_instance_batch[i];
+			_update_dirty_instance_base(instance);
+			instance->update_aabb = false;
+			instance->update_dependencies = false;
+		}
+
+		// Bounds only depend on the instance itself, so they can be computed in parallel.
+		RendererThreadPool::singleton->thread_work_pool.do_work(RendererThreadPool::singleton->thread_work_pool.get_thread_count(), this, &RendererSceneCull::_update_instance_bounds_threaded, &dirty_instance_batch);
+
+		// Indexing and pairing touch the scenario, apply them serially in list order.
+		for (uint32_t i = 0; i < dirty_instance_batch.size(); i++) {
+			Instance *instance = dirty_instance_batch[i];
+			if (!instance->update_item.in_list()) {
+				continue;
+			}
+			if (instance->update_aabb || instance->update_dependencies) {
+				// Queued again by an instance processed earlier in this batch.
+				_update_dirty_instance(instance);
+				continue;
+			}
+			_instance_update_list.remove(&instance->update_item);
+			_update_instance(instance, true);
+		}
 	}
+
+	dirty_instance_batch.clear();
 }
 
 void RendererSceneCull::update() {
@@ -3913,6 +4082,7 @@ bool RendererSceneCull::free(RID p_rid) {
 			instance_set_scenario(scenario->instances.first()->self()->self, RID());
 		}
 		scenario->instance_aabbs.reset();
+		scenario->instance_aabb_blocks.reset();
 		scenario->instance_data.reset();
 		scenario->instance_visibility.reset();
 
@@ -3995,7 +4165,6 @@ RendererSceneCull::RendererSceneCull() {
 	singleton = this;
 
 	instance_cull_result.set_page_pool(&instance_cull_page_pool);
-	instance_shadow_cull_result.set_page_pool(&instance_cull_page_pool);
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.set_page_pool(&geometry_instance_cull_page_pool);
@@ -4014,12 +4183,12 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)RendererThreadPool::singleton->thread_work_pool.get_thread_count()); //make sure there is at least one thread per CPU
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Always available; backends registered by modules (such as raycast) take over the singleton when enabled.
+	raster_occlusion_culling = memnew(RasterOcclusionCull);
 }
 
 RendererSceneCull::~RendererSceneCull() {
 	instance_cull_result.reset();
-	instance_shadow_cull_result.reset();
 
 	for (uint32_t i = 0; i < MAX_UPDATE_SHADOWS; i++) {
 		render_shadow_data[i].instances.reset();
@@ -4034,7 +4203,7 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (raster_occlusion_culling) {
+		memdelete(raster_occlusion_culling);
 	}
 }
@@ -115,7 +115,7 @@ public:
 
 	/* VISIBILITY NOTIFIER API */
 
-	RendererSceneOcclusionCull *dummy_occlusion_culling = nullptr;
+	RendererSceneOcclusionCull *raster_occlusion_culling = nullptr;
 
 	/* SCENARIO API */
 
@@ -240,6 +240,40 @@ public:
 		}
 	};
 
+	struct InstanceBoundsBlock {
+		// Bounds of SIZE consecutive instances, stored as one array per component
+		// so frustum planes can be tested against all of them at once.
+		enum {
+			SIZE = 4
+		};
+
+		real_t min_x[SIZE];
+		real_t min_y[SIZE];
+		real_t min_z[SIZE];
+		real_t max_x[SIZE];
+		real_t max_y[SIZE];
+		real_t max_z[SIZE];
+
+		_ALWAYS_INLINE_ InstanceBoundsBlock() {
+			for (uint32_t i = 0; i < SIZE; i++) {
+				min_x[i] = min_y[i] = min_z[i] = 0;
+				max_x[i] = max_y[i] = max_z[i] = 0;
+			}
+		}
+
+		_ALWAYS_INLINE_ void set(uint32_t p_lane, const InstanceBounds &p_bounds) {
+			min_x[p_lane] = p_bounds.bounds[0];
+			min_y[p_lane] = p_bounds.bounds[1];
+			min_z[p_lane] = p_bounds.bounds[2];
+			max_x[p_lane] = p_bounds.bounds[3];
+			max_y[p_lane] = p_bounds.bounds[4];
+			max_z[p_lane] = p_bounds.bounds[5];
+		}
+
+		// Same test as InstanceBounds::in_frustum(), returns one bit per lane.
+		uint32_t in_frustum_mask(const Frustum &p_frustum) const;
+	};
+
 	struct InstanceVisibilityNotifierData;
 
 	struct InstanceData {
@@ -303,6 +337,7 @@ public:
 	};
 
 	PagedArrayPool<InstanceBounds> instance_aabb_page_pool;
+	PagedArrayPool<InstanceBoundsBlock> instance_aabb_block_page_pool;
 	PagedArrayPool<InstanceData> instance_data_page_pool;
 	PagedArrayPool<InstanceVisibilityData> instance_visibility_data_page_pool;
 
@@ -331,9 +366,31 @@ public:
 		LocalVector<RID> dynamic_lights;
 
 		PagedArray<InstanceBounds> instance_aabbs;
+		PagedArray<InstanceBoundsBlock> instance_aabb_blocks; // Same bounds as instance_aabbs, in SoA blocks for culling.
 		PagedArray<InstanceData> instance_data;
 		VisibilityArray instance_visibility;
 
+		_FORCE_INLINE_ void push_instance_bounds(const InstanceBounds &p_bounds) {
+			uint64_t index = instance_aabbs.size();
+			instance_aabbs.push_back(p_bounds);
+			if (index % InstanceBoundsBlock::SIZE == 0) {
+				instance_aabb_blocks.push_back(InstanceBoundsBlock());
+			}
+			instance_aabb_blocks[index / InstanceBoundsBlock::SIZE].set(index % InstanceBoundsBlock::SIZE, p_bounds);
+		}
+
+		_FORCE_INLINE_ void set_instance_bounds(uint64_t p_index, const InstanceBounds &p_bounds) {
+			instance_aabbs[p_index] = p_bounds;
+			instance_aabb_blocks[p_index / InstanceBoundsBlock::SIZE].set(p_index % InstanceBoundsBlock::SIZE, p_bounds);
+		}
+
+		_FORCE_INLINE_ void pop_instance_bounds() {
+			instance_aabbs.pop_back();
+			if (instance_aabbs.size() % InstanceBoundsBlock::SIZE == 0) {
+				instance_aabb_blocks.pop_back();
+			}
+		}
+
 		Scenario() {
 			indexers[INDEXER_GEOMETRY].set_index(INDEXER_GEOMETRY);
 			indexers[INDEXER_VOLUMES].set_index(INDEXER_VOLUMES);
@@ -418,6 +475,7 @@ public:
 		AABB aabb;
 		AABB transformed_aabb;
 		AABB prev_transformed_aabb;
+		AABB indexer_aabb; // transformed_aabb, quantized while moving.
 
 		struct InstanceShaderParameter {
 			int32_t index = -1;
@@ -786,7 +844,6 @@ public:
 	PagedArrayPool<RID> rid_cull_page_pool;
 
 	PagedArray<Instance *> instance_cull_result;
-	PagedArray<Instance *> instance_shadow_cull_result;
 
 	struct InstanceCullResult {
 		PagedArray<RendererSceneRender::GeometryInstance *> geometry_instances;
@@ -914,11 +971,27 @@ public:
 	RendererSceneRender::RenderShadowData render_shadow_data[MAX_UPDATE_SHADOWS];
 	uint32_t max_shadows_used = 0;
 
+	// One shadow frustum (omni half or cube side, or spot light) to cull, filling render_shadow_data[shadow_index].
+	struct ShadowCullJob {
+		Instance *light = nullptr;
+		uint32_t shadow_index = 0;
+		Vector<Plane> planes;
+		bool animated_material_found = false;
+		LocalVector<RID> mesh_instances;
+		uint64_t cull_usec = 0;
+	};
+
+	LocalVector<ShadowCullJob> shadow_cull_jobs;
+	uint32_t shadow_cull_job_count = 0;
+
 	RendererSceneRender::RenderSDFGIData render_sdfgi_data[SDFGI_MAX_CASCADES * SDFGI_MAX_REGIONS_PER_CASCADE];
 	RendererSceneRender::RenderSDFGIUpdateData sdfgi_update_data;
 
 	uint32_t thread_cull_threshold = 200;
 
+	LocalVector<Instance *> transform_batch;
+	LocalVector<Instance *> dirty_instance_batch;
+
 	RID_Owner<Instance, true> instance_owner;
 
 	uint32_t geometry_instance_pair_mask = 0; // used in traditional forward, unnecessary on clustered
@@ -930,6 +1003,7 @@ public:
 	virtual void instance_set_scenario(RID p_instance, RID p_scenario);
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask);
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform);
+	virtual void instances_set_transforms(const Vector<RID> &p_instances, const Vector<Transform3D> &p_transforms);
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id);
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight);
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material);
@@ -971,8 +1045,11 @@ public:
 	virtual Variant instance_geometry_get_shader_parameter(RID p_instance, const StringName &p_parameter) const;
 	virtual Variant instance_geometry_get_shader_parameter_default_value(RID p_instance, const StringName &p_parameter) const;
 
-	_FORCE_INLINE_ void _update_instance(Instance *p_instance);
+	_FORCE_INLINE_ void _update_instance_bounds(Instance *p_instance);
+	void _update_instance_bounds_threaded(uint32_t p_thread, LocalVector<Instance *> *p_instances);
+	_FORCE_INLINE_ void _update_instance(Instance *p_instance, bool p_bounds_updated = false);
 	_FORCE_INLINE_ void _update_instance_aabb(Instance *p_instance);
+	_FORCE_INLINE_ void _update_dirty_instance_base(Instance *p_instance);
 	_FORCE_INLINE_ void _update_dirty_instance(Instance *p_instance);
 	_FORCE_INLINE_ void _update_instance_lightmap_captures(Instance *p_instance);
 	void _unpair_instance(Instance *p_instance);
@@ -980,6 +1057,9 @@ public:
 	void _light_instance_setup_directional_shadow(int p_shadow_index, Instance *p_instance, const Transform3D p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect);
 
 	_FORCE_INLINE_ bool _light_instance_update_shadow(Instance *p_instance, const Transform3D p_cam_transform, const CameraMatrix &p_cam_projection, bool p_cam_orthogonal, bool p_cam_vaspect, RID p_shadow_atlas, Scenario *p_scenario, float p_scren_mesh_lod_threshold);
+	void _light_instance_queue_shadow_cull(Instance *p_instance, const Vector<Plane> &p_planes, int p_pass);
+	void _light_instance_cull_shadow_threaded(uint32_t p_job, Scenario *p_scenario);
+	void _light_instance_cull_shadows(Scenario *p_scenario);
 
 	RID _render_get_environment(RID p_camera, RID p_scenario);
 
@@ -55,6 +55,9 @@ public:
 
 	public:
 		bool is_empty() const;
+		_FORCE_INLINE_ Size2i get_size() const { return sizes.is_empty() ? Size2i() : sizes[0]; }
+		_FORCE_INLINE_ const float *get_depth() const { return mips.is_empty() ? nullptr : mips[0]; }
+
 		virtual void clear();
 		virtual void resize(const Size2i &p_size);
 
@@ -0,0 +1,245 @@
+/*************************************************************************/
+/*  test_http_client_pool.h                                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_HTTP_CLIENT_POOL_H
+#define TEST_HTTP_CLIENT_POOL_H
+
+#include "core/io/http_client_pool.h"
+#include "core/io/tcp_server.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestHTTPClientPool {
+
+// Minimal keep-alive HTTP server, answering "Response to <path>" to each request.
+class HTTPServerStandIn {
+	struct Peer {
+		Ref<StreamPeerTCP> tcp;
+		String received;
+		LocalVector<String> pending; // Paths of the requests not answered yet.
+	};
+
+	Ref<TCPServer> server;
+	LocalVector<Peer> peers;
+
+	void _respond(Peer &p_peer, const String &p_path) {
+		String body = "Response to " + p_path;
+		if (p_path.begins_with("/large")) {
+			while (body.length() < 64 * 1024) {
+				body += " and some more padding";
+			}
+		}
+		const CharString data = body.utf8();
+		String response = "HTTP/1.1 200 OK\r\n";
+		if (chunked) {
+			response += "Transfer-Encoding: chunked\r\n\r\n";
+			// Small chunks, so the client has to join them.
+			for (int ofs = 0; ofs < data.length(); ofs += 5) {
+				const int len = MIN(5, data.length() - ofs);
+				response += String::num_int64(len, 16) + "\r\n" + String::utf8(data.get_data() + ofs, len) + "\r\n";
+			}
+			response += "0\r\n\r\n";
+		} else {
+			response += "Content-Length: " + itos(data.length()) + "\r\n\r\n" + body;
+		}
+		const CharString out = response.utf8();
+		p_peer.tcp->put_data((const uint8_t *)out.get_data(), out.length());
+	}
+
+public:
+	bool chunked = false;
+	int hold_until = 1; // Requests to receive on a connection before answering them.
+	int accepted = 0;
+
+	int get_port() const { return server->get_local_port(); }
+
+	void poll() {
+		while (server->is_connection_available()) {
+			Peer peer;
+			peer.tcp = server->take_connection();
+			peers.push_back(peer);
+			accepted++;
+		}
+		for (uint32_t i = 0; i < peers.size(); i++) {
+			Peer &peer = peers[i];
+			peer.tcp->poll();
+			uint8_t buf[4096];
+			int read = 0;
+			while (peer.tcp->get_partial_data(buf, sizeof(buf), read) == OK && read > 0) {
+				peer.received += String::utf8((const char *)buf, read);
+			}
+			int end = peer.received.find("\r\n\r\n");
+			while (end != -1) {
+				const String head = peer.received.substr(0, end);
+				peer.received = peer.received.substr(end + 4);
+				peer.pending.push_back(head.get_slicec(' ', 1));
+				end = peer.received.find("\r\n\r\n");
+			}
+			if ((int)peer.pending.size() >= hold_until) {
+				for (uint32_t j = 0; j < peer.pending.size(); j++) {
+					_respond(peer, peer.pending[j]);
+				}
+				peer.pending.clear();
+			}
+		}
+	}
+
+	HTTPServerStandIn() {
+		server.instantiate();
+		server->listen(0, IPAddress("127.0.0.1"));
+	}
+};
+
+class ResponseRecorder : public Object {
+public:
+	struct Response {
+		int id = 0;
+		int result = 0;
+		int code = 0;
+		String body;
+	};
+	LocalVector<Response> responses;
+
+	void on_request_completed(int p_id, int p_result, int p_code, const PackedStringArray &p_headers, const PackedByteArray &p_body) {
+		Response response;
+		response.id = p_id;
+		response.result = p_result;
+		response.code = p_code;
+		response.body = String::utf8((const char *)p_body.ptr(), p_body.size());
+		responses.push_back(response);
+	}
+};
+
+static bool wait_responses(HTTPClientPool *p_pool, HTTPServerStandIn &p_server, ResponseRecorder &p_recorder, uint32_t p_count) {
+	for (int i = 0; i < 5000 && p_recorder.responses.size() < p_count; i++) {
+		p_server.poll();
+		p_pool->poll();
+		OS::get_singleton()->delay_usec(1000);
+	}
+	return p_recorder.responses.size() == p_count;
+}
+
+TEST_CASE("[HTTPClientPool] Keep-alive reuse") {
+	HTTPServerStandIn server;
+	ResponseRecorder recorder;
+	Ref<HTTPClientPool> pool;
+	pool.instantiate();
+	pool->connect("request_completed", callable_mp(&recorder, &ResponseRecorder::on_request_completed));
+	const String url = "http://127.0.0.1:" + itos(server.get_port());
+
+	const int first = pool->request(url + "/first");
+	REQUIRE(wait_responses(pool.ptr(), server, recorder, 1));
+	const int second = pool->request(url + "/second");
+	REQUIRE(wait_responses(pool.ptr(), server, recorder, 2));
+
+	CHECK(recorder.responses[0].id == first);
+	CHECK(recorder.responses[0].result == OK);
+	CHECK(recorder.responses[0].code == 200);
+	CHECK(recorder.responses[0].body == "Response to /first");
+	CHECK(recorder.responses[1].id == second);
+	CHECK(recorder.responses[1].body == "Response to /second");
+	CHECK_MESSAGE(server.accepted == 1, "The second request should reuse the first connection.");
+	CHECK(pool->get_connection_count() == 1);
+	CHECK(pool->get_pending_request_count() == 0);
+
+	ERR_PRINT_OFF;
+	CHECK(pool->request("ftp://127.0.0.1/") == -1);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[HTTPClientPool] Pipelining and chunked bodies") {
+	HTTPServerStandIn server;
+	server.chunked = true;
+	// Only answers once all the requests arrived, which requires pipelining on a single connection.
+	server.hold_until = 4;
+	ResponseRecorder recorder;
+	Ref<HTTPClientPool> pool;
+	pool.instantiate();
+	pool->set_max_connections_per_host(1);
+	pool->set_max_pipelined_requests(4);
+	pool->connect("request_completed", callable_mp(&recorder, &ResponseRecorder::on_request_completed));
+	const String url = "http://127.0.0.1:" + itos(server.get_port());
+
+	int ids[4];
+	for (int i = 0; i < 4; i++) {
+		ids[i] = pool->request(url + "/pipelined/" + itos(i));
+	}
+	REQUIRE(wait_responses(pool.ptr(), server, recorder, 4));
+	CHECK(server.accepted == 1);
+	for (int i = 0; i < 4; i++) {
+		CHECK_MESSAGE(recorder.responses[i].id == ids[i], "Pipelined responses should complete in order.");
+		CHECK(recorder.responses[i].result == OK);
+		CHECK(recorder.responses[i].body == "Response to /pipelined/" + itos(i));
+	}
+}
+
+TEST_CASE("[HTTPClientPool] Large bodies and size limit") {
+	HTTPServerStandIn server;
+	ResponseRecorder recorder;
+	Ref<HTTPClientPool> pool;
+	pool.instantiate();
+	pool->connect("request_completed", callable_mp(&recorder, &ResponseRecorder::on_request_completed));
+	const String url = "http://127.0.0.1:" + itos(server.get_port());
+
+	pool->request(url + "/large");
+	REQUIRE(wait_responses(pool.ptr(), server, recorder, 1));
+	CHECK(recorder.responses[0].result == OK);
+	CHECK(recorder.responses[0].body.length() >= 64 * 1024);
+	CHECK(recorder.responses[0].body.begins_with("Response to /large"));
+
+	pool->set_body_size_limit(1024);
+	pool->request(url + "/large");
+	REQUIRE(wait_responses(pool.ptr(), server, recorder, 2));
+	CHECK(recorder.responses[1].result == ERR_OUT_OF_MEMORY);
+	CHECK(recorder.responses[1].body.length() == 0);
+}
+
+TEST_CASE("[HTTPClientPool] Threaded requests") {
+	HTTPServerStandIn server;
+	ResponseRecorder recorder;
+	Ref<HTTPClientPool> pool;
+	pool.instantiate();
+	pool->set_use_threads(true);
+	pool->connect("request_completed", callable_mp(&recorder, &ResponseRecorder::on_request_completed));
+	const String url = "http://127.0.0.1:" + itos(server.get_port());
+
+	const int cancelled = pool->request(url + "/cancelled");
+	pool->cancel_request(cancelled);
+	const int id = pool->request(url + "/threaded");
+	REQUIRE(wait_responses(pool.ptr(), server, recorder, 1));
+	CHECK(recorder.responses[0].id == id);
+	CHECK(recorder.responses[0].body == "Response to /threaded");
+	pool->set_use_threads(false);
+}
+
+} // namespace TestHTTPClientPool
+
+#endif // TEST_HTTP_CLIENT_POOL_H
@@ -0,0 +1,108 @@
+/*************************************************************************/
+/*  test_net_socket_poller.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_NET_SOCKET_POLLER_H
+#define TEST_NET_SOCKET_POLLER_H
+
+#include "core/io/net_socket.h"
+#include "core/io/stream_peer_tcp.h"
+#include "core/io/tcp_server.h"
+
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestNetSocketPoller {
+
+static bool has_event(const LocalVector<NetSocketPoller::Event> &p_events, uint64_t p_id, uint32_t p_flag) {
+	for (uint32_t i = 0; i < p_events.size(); i++) {
+		if (p_events[i].id == p_id && (p_events[i].flags & p_flag)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+TEST_CASE("[NetSocketPoller] Loopback readiness") {
+	Ref<NetSocketPoller> poller = Ref<NetSocketPoller>(NetSocketPoller::create());
+	if (poller.is_null()) {
+		return; // Not supported on this platform.
+	}
+
+	Ref<TCPServer> server;
+	server.instantiate();
+	REQUIRE(server->listen(0, IPAddress("127.0.0.1")) == OK);
+	REQUIRE(poller->add_socket(server->get_socket(), 1, NetSocket::POLL_TYPE_IN) == OK);
+	CHECK(poller->add_socket(server->get_socket(), 1, NetSocket::POLL_TYPE_IN) == ERR_ALREADY_IN_USE);
+
+	LocalVector<NetSocketPoller::Event> events;
+	CHECK_MESSAGE(
+			poller->wait(events, 0) == ERR_BUSY,
+			"An idle listening socket should not be reported.");
+	CHECK(events.is_empty());
+
+	Ref<StreamPeerTCP> client;
+	client.instantiate();
+	REQUIRE(client->connect_to_host(IPAddress("127.0.0.1"), server->get_local_port()) == OK);
+	CHECK_MESSAGE(
+			poller->wait(events, 1000) == OK,
+			"A pending connection should make the listening socket readable.");
+	CHECK(has_event(events, 1, NetSocketPoller::EVENT_IN));
+
+	Ref<StreamPeerTCP> conn = server->take_connection();
+	REQUIRE(conn.is_valid());
+	REQUIRE(poller->add_socket(conn->get_socket(), 2, NetSocket::POLL_TYPE_IN) == OK);
+	CHECK(poller->get_socket_count() == 2);
+
+	client->wait(NetSocket::POLL_TYPE_OUT, 1000);
+	client->poll();
+	REQUIRE(client->get_status() == StreamPeerTCP::STATUS_CONNECTED);
+	const uint8_t data[4] = { 1, 2, 3, 4 };
+	REQUIRE(client->put_data(data, 4) == OK);
+	CHECK(poller->wait(events, 1000) == OK);
+	CHECK_MESSAGE(
+			has_event(events, 2, NetSocketPoller::EVENT_IN),
+			"The accepted connection should be reported readable with its own ID.");
+
+	uint8_t received[4] = {};
+	CHECK(conn->get_data(received, 4) == OK);
+	CHECK(received[3] == 4);
+	server->stop();
+	poller->remove_socket(1);
+	CHECK_MESSAGE(
+			poller->wait(events, 0) == ERR_BUSY,
+			"Drained sockets should not be reported anymore.");
+
+	poller->remove_socket(2);
+	CHECK(poller->get_socket_count() == 0);
+	CHECK_FALSE(poller->has_socket(2));
+}
+
+} // namespace TestNetSocketPoller
+
+#endif // TEST_NET_SOCKET_POLLER_H
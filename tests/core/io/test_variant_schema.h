@@ -0,0 +1,335 @@
+/*************************************************************************/
+/*  test_variant_schema.h                                                */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_VARIANT_SCHEMA_H
+#define TEST_VARIANT_SCHEMA_H
+
+#include "core/io/marshalls.h"
+#include "core/io/variant_schema.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVariantSchema {
+
+static const Variant::Type schema_types[] = {
+	Variant::NIL,
+	Variant::BOOL,
+	Variant::INT,
+	Variant::FLOAT,
+	Variant::STRING,
+	Variant::VECTOR2,
+	Variant::VECTOR2I,
+	Variant::RECT2,
+	Variant::VECTOR3,
+	Variant::VECTOR3I,
+	Variant::TRANSFORM2D,
+	Variant::PLANE,
+	Variant::QUATERNION,
+	Variant::AABB,
+	Variant::BASIS,
+	Variant::TRANSFORM3D,
+	Variant::COLOR,
+	Variant::STRING_NAME,
+	Variant::PACKED_BYTE_ARRAY,
+	Variant::PACKED_INT32_ARRAY,
+	Variant::PACKED_FLOAT32_ARRAY,
+};
+
+static real_t random_real(RandomPCG &p_rng) {
+	return p_rng.randf() * 2000 - 1000;
+}
+
+static Vector3 random_vector3(RandomPCG &p_rng) {
+	return Vector3(random_real(p_rng), random_real(p_rng), random_real(p_rng));
+}
+
+static int64_t random_int(RandomPCG &p_rng) {
+	// Cover every varint length.
+	const int64_t value = int64_t((uint64_t(p_rng.rand()) << 32) | p_rng.rand()) >> p_rng.rand(64);
+	return value;
+}
+
+static Variant random_value(Variant::Type p_type, RandomPCG &p_rng) {
+	switch (p_type) {
+		case Variant::NIL: {
+			// Any value, sent through encode_variant.
+			const Variant::Type types[] = { Variant::NIL, Variant::INT, Variant::STRING, Variant::VECTOR3 };
+			const Variant::Type type = types[p_rng.rand(4)];
+			return type == Variant::NIL ? Variant() : random_value(type, p_rng);
+		}
+		case Variant::BOOL:
+			return p_rng.rand(2) == 1;
+		case Variant::INT:
+			return random_int(p_rng);
+		case Variant::FLOAT:
+			return p_rng.randd() * 1e6 - 5e5;
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			String str;
+			const int len = p_rng.rand(24);
+			for (int i = 0; i < len; i++) {
+				// Include some non ASCII characters.
+				str += char32_t(p_rng.rand(4) ? 'a' + p_rng.rand(26) : 0x400 + p_rng.rand(0x100));
+			}
+			if (p_type == Variant::STRING_NAME) {
+				return StringName(str);
+			}
+			return str;
+		}
+		case Variant::VECTOR2:
+			return Vector2(random_real(p_rng), random_real(p_rng));
+		case Variant::VECTOR2I:
+			return Vector2i(int32_t(random_int(p_rng)), int32_t(random_int(p_rng)));
+		case Variant::RECT2:
+			return Rect2(random_real(p_rng), random_real(p_rng), random_real(p_rng), random_real(p_rng));
+		case Variant::VECTOR3:
+			return random_vector3(p_rng);
+		case Variant::VECTOR3I:
+			return Vector3i(int32_t(random_int(p_rng)), int32_t(random_int(p_rng)), int32_t(random_int(p_rng)));
+		case Variant::TRANSFORM2D:
+			return Transform2D(random_real(p_rng), Vector2(random_real(p_rng), random_real(p_rng)));
+		case Variant::PLANE:
+			return Plane(random_vector3(p_rng), random_real(p_rng));
+		case Variant::QUATERNION:
+			return Quaternion(random_real(p_rng), random_real(p_rng), random_real(p_rng), random_real(p_rng));
+		case Variant::AABB:
+			return AABB(random_vector3(p_rng), random_vector3(p_rng));
+		case Variant::BASIS:
+			return Basis(random_vector3(p_rng), random_vector3(p_rng), random_vector3(p_rng));
+		case Variant::TRANSFORM3D:
+			return Transform3D(Basis(random_vector3(p_rng), random_vector3(p_rng), random_vector3(p_rng)), random_vector3(p_rng));
+		case Variant::COLOR:
+			return Color(p_rng.randf(), p_rng.randf(), p_rng.randf(), p_rng.randf());
+		case Variant::PACKED_BYTE_ARRAY: {
+			PackedByteArray arr;
+			arr.resize(p_rng.rand(64));
+			for (int i = 0; i < arr.size(); i++) {
+				arr.write[i] = p_rng.rand(256);
+			}
+			return arr;
+		}
+		case Variant::PACKED_INT32_ARRAY: {
+			PackedInt32Array arr;
+			arr.resize(p_rng.rand(32));
+			for (int i = 0; i < arr.size(); i++) {
+				arr.write[i] = int32_t(random_int(p_rng));
+			}
+			return arr;
+		}
+		case Variant::PACKED_FLOAT32_ARRAY: {
+			PackedFloat32Array arr;
+			arr.resize(p_rng.rand(32));
+			for (int i = 0; i < arr.size(); i++) {
+				arr.write[i] = p_rng.randf();
+			}
+			return arr;
+		}
+		default:
+			return Variant();
+	}
+}
+
+TEST_CASE("[VariantSchema] Encoding and decoding") {
+	VariantSchema schema;
+	schema.add_field(Variant::INT);
+	schema.add_field(Variant::VECTOR3);
+	schema.add_field(Variant::STRING);
+	schema.add_field(Variant::BOOL);
+	CHECK(schema.get_field_count() == 4);
+
+	Variant values[4] = { -3, Vector3(1, 2, 3), "Hello", true };
+	uint8_t buf[64];
+	int len = 0;
+	REQUIRE(schema.encode(values, 4, buf, sizeof(buf), len) == OK);
+	CHECK(len == schema.get_encoded_size(values, 4));
+	CHECK_MESSAGE(
+			len == 1 + 3 * int(sizeof(real_t)) + 1 + 5 + 1,
+			"Fields should have no type header and small integers should take a single byte.");
+
+	Variant decoded[4];
+	int read = 0;
+	REQUIRE(schema.decode(buf, len, decoded, 4, &read) == OK);
+	CHECK(read == len);
+	for (int i = 0; i < 4; i++) {
+		CHECK(decoded[i] == values[i]);
+	}
+
+	Array args;
+	for (int i = 0; i < 4; i++) {
+		args.push_back(values[i]);
+	}
+	int marshalls_len = 0;
+	encode_variant(args, nullptr, marshalls_len);
+	CHECK_MESSAGE(len < marshalls_len / 2, "The schema encoding should be much smaller than encode_variant.");
+
+	// Decoding into Variants of a different type converts them.
+	decoded[0] = "Not an int";
+	REQUIRE(schema.decode(buf, len, decoded, 4) == OK);
+	CHECK(decoded[0].get_type() == Variant::INT);
+	CHECK(decoded[0] == values[0]);
+}
+
+TEST_CASE("[VariantSchema] Errors") {
+	VariantSchema schema;
+	ERR_PRINT_OFF;
+	CHECK(schema.add_field(Variant::OBJECT) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+	schema.add_field(Variant::INT);
+	schema.add_field(Variant::STRING);
+
+	uint8_t buf[8];
+	int len = 0;
+	Variant wrong_type[2] = { "Not an int", "Hello" };
+	ERR_PRINT_OFF;
+	CHECK(schema.encode(wrong_type, 2, buf, sizeof(buf), len) == ERR_INVALID_DATA);
+	CHECK(schema.encode(wrong_type, 1, buf, sizeof(buf), len) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+
+	Variant values[2] = { 1, "This string does not fit" };
+	CHECK_MESSAGE(
+			schema.encode(values, 2, buf, sizeof(buf), len) == ERR_OUT_OF_MEMORY,
+			"Encoding should fail instead of overflowing the buffer.");
+
+	Variant decoded[2];
+	values[1] = "Fits";
+	REQUIRE(schema.encode(values, 2, buf, sizeof(buf), len) == OK);
+	ERR_PRINT_OFF;
+	CHECK(schema.decode(buf, len - 1, decoded, 2) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+
+	VariantSchema other;
+	other.add_field(Variant::INT);
+	other.add_field(Variant::STRING_NAME);
+	CHECK(other.get_hash() != schema.get_hash());
+}
+
+TEST_CASE("[VariantSchema] Fuzzing") {
+	RandomPCG rng(1234);
+	const int type_count = sizeof(schema_types) / sizeof(schema_types[0]);
+	LocalVector<uint8_t> buf;
+	LocalVector<Variant> values;
+	LocalVector<Variant> decoded;
+
+	for (int iteration = 0; iteration < 500; iteration++) {
+		VariantSchema schema;
+		const int field_count = 1 + rng.rand(12);
+		values.resize(field_count);
+		decoded.resize(field_count);
+		for (int i = 0; i < field_count; i++) {
+			const Variant::Type type = schema_types[rng.rand(type_count)];
+			schema.add_field(type);
+			values[i] = random_value(type, rng);
+		}
+
+		const int size = schema.get_encoded_size(values.ptr(), field_count);
+		REQUIRE(size > 0);
+		buf.resize(size);
+		int len = 0;
+		REQUIRE(schema.encode(values.ptr(), field_count, buf.ptr(), size, len) == OK);
+		REQUIRE(len == size);
+
+		// Decode over the previous iteration's values.
+		int read = 0;
+		REQUIRE(schema.decode(buf.ptr(), len, decoded.ptr(), field_count, &read) == OK);
+		CHECK(read == len);
+		bool equal = true;
+		for (int i = 0; i < field_count; i++) {
+			equal = equal && decoded[i] == values[i];
+		}
+		CHECK_MESSAGE(equal, vformat("Values should survive a round trip (iteration %d).", iteration));
+
+		// Corrupted or truncated data must fail cleanly.
+		ERR_PRINT_OFF;
+		for (int i = 0; i < 4 && len > 0; i++) {
+			buf[rng.rand(len)] = rng.rand(256);
+			schema.decode(buf.ptr(), len, decoded.ptr(), field_count);
+		}
+		CHECK(schema.decode(buf.ptr(), rng.rand(len), decoded.ptr(), field_count) != ERR_BUG);
+		ERR_PRINT_ON;
+	}
+}
+
+// Run with `godot --test variant-schema-benchmark`.
+static void benchmark_variant_schema() {
+	const int count = 200000;
+	// A typical movement RPC.
+	const Variant::Type types[4] = { Variant::INT, Variant::VECTOR3, Variant::QUATERNION, Variant::BOOL };
+	VariantSchema schema;
+	Array args;
+	RandomPCG rng(5678);
+	for (int i = 0; i < 4; i++) {
+		schema.add_field(types[i]);
+		args.push_back(random_value(types[i], rng));
+	}
+	args[0] = 42;
+	Variant values[4] = { args[0], args[1], args[2], args[3] };
+
+	print_line(vformat("Variant schema benchmark: %d encodes and decodes of (int, Vector3, Quaternion, bool).", count));
+
+	uint8_t buf[256];
+	int len = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		encode_variant(args, nullptr, len);
+		encode_variant(args, buf, len);
+	}
+	const uint64_t marshalls_encode_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	const int marshalls_len = len;
+	Variant decoded_array;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		decode_variant(decoded_array, buf, marshalls_len);
+	}
+	const uint64_t marshalls_decode_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		schema.encode(values, 4, buf, sizeof(buf), len);
+	}
+	const uint64_t schema_encode_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	const int schema_len = len;
+	Variant decoded[4];
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		schema.decode(buf, schema_len, decoded, 4);
+	}
+	const uint64_t schema_decode_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	print_line(vformat("    marshalls: %d bytes, encode %.1f nsec, decode %.1f nsec", marshalls_len, double(marshalls_encode_usec) * 1000.0 / count, double(marshalls_decode_usec) * 1000.0 / count));
+	print_line(vformat("    schema:    %d bytes, encode %.1f nsec, decode %.1f nsec", schema_len, double(schema_encode_usec) * 1000.0 / count, double(schema_decode_usec) * 1000.0 / count));
+}
+
+REGISTER_TEST_COMMAND("variant-schema-benchmark", &benchmark_variant_schema);
+
+} // namespace TestVariantSchema
+
+#endif // TEST_VARIANT_SCHEMA_H
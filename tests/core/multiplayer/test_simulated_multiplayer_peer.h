@@ -0,0 +1,278 @@
+/*************************************************************************/
+/*  test_simulated_multiplayer_peer.h                                    */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_SIMULATED_MULTIPLAYER_PEER_H
+#define TEST_SIMULATED_MULTIPLAYER_PEER_H
+
+#include "core/io/marshalls.h"
+#include "core/multiplayer/simulated_multiplayer_peer.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSimulatedMultiplayerPeer {
+
+static Ref<SimulatedMultiplayerPeer> create_peer(double p_latency = 0) {
+	Ref<SimulatedMultiplayerPeer> peer;
+	peer.instantiate();
+	peer->set_latency(p_latency);
+	return peer;
+}
+
+static void send_index(Ref<SimulatedMultiplayerPeer> &p_peer, uint32_t p_index, int p_size = 4) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	data.fill(0);
+	encode_uint32(p_index, data.ptrw());
+	CHECK(p_peer->put_packet(data.ptr(), data.size()) == OK);
+}
+
+static LocalVector<uint32_t> receive_indices(Ref<SimulatedMultiplayerPeer> &p_peer) {
+	LocalVector<uint32_t> indices;
+	p_peer->poll();
+	while (p_peer->get_available_packet_count() > 0) {
+		const uint8_t *buffer = nullptr;
+		int size = 0;
+		p_peer->get_packet(&buffer, size);
+		indices.push_back(decode_uint32(buffer));
+	}
+	return indices;
+}
+
+// Connects a client to the server, on a network with manual time.
+static void connect_client(Ref<SimulatedMultiplayerPeer> &p_server, Ref<SimulatedMultiplayerPeer> &p_client) {
+	REQUIRE(p_client->create_client(p_server) == OK);
+	p_server->advance_time(MAX(p_server->get_latency(), p_client->get_latency()));
+	p_server->poll();
+	p_client->poll();
+	REQUIRE(p_client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTED);
+}
+
+TEST_CASE("[SimulatedMultiplayerPeer] Latency and connection") {
+	Ref<SimulatedMultiplayerPeer> server = create_peer(0.05);
+	Ref<SimulatedMultiplayerPeer> client = create_peer(0.05);
+	REQUIRE(server->create_server(true) == OK);
+	REQUIRE(client->create_client(server) == OK);
+	CHECK(server->get_unique_id() == 1);
+	CHECK(client->get_unique_id() == 2);
+	CHECK(server->is_server());
+	CHECK_FALSE(client->is_server());
+
+	client->poll();
+	CHECK(client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTING);
+	server->advance_time(0.05);
+	client->poll();
+	server->poll();
+	CHECK(client->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTED);
+
+	send_index(client, 42);
+	server->advance_time(0.049);
+	CHECK(receive_indices(server).size() == 0);
+	server->advance_time(0.001);
+	LocalVector<uint32_t> received = receive_indices(server);
+	REQUIRE(received.size() == 1);
+	CHECK(received[0] == 42);
+
+	server->close();
+	client->advance_time(0.05);
+	client->poll();
+	CHECK(client->get_connection_status() == MultiplayerPeer::CONNECTION_DISCONNECTED);
+}
+
+TEST_CASE("[SimulatedMultiplayerPeer] Packet loss") {
+	Ref<SimulatedMultiplayerPeer> server = create_peer();
+	Ref<SimulatedMultiplayerPeer> client = create_peer(0.02);
+	REQUIRE(server->create_server(true) == OK);
+	connect_client(server, client);
+	client->set_packet_loss(0.5);
+	client->set_seed(1234);
+
+	client->set_transfer_mode(Multiplayer::TRANSFER_MODE_UNRELIABLE);
+	for (int i = 0; i < 1000; i++) {
+		send_index(client, i);
+	}
+	server->advance_time(0.02);
+	const uint32_t unreliable = receive_indices(server).size();
+	const Dictionary stats = client->get_statistics();
+	CHECK(int(stats["packets_lost"]) + unreliable == 1000);
+	CHECK(unreliable > 400);
+	CHECK(unreliable < 600);
+
+	// Reliable packets all arrive, in order, the lost ones a few round trips later.
+	client->set_transfer_mode(Multiplayer::TRANSFER_MODE_RELIABLE);
+	for (int i = 0; i < 100; i++) {
+		send_index(client, i);
+	}
+	server->advance_time(0.02);
+	LocalVector<uint32_t> reliable = receive_indices(server);
+	CHECK(reliable.size() < 100);
+	server->advance_time(10);
+	LocalVector<uint32_t> late = receive_indices(server);
+	for (uint32_t i = 0; i < late.size(); i++) {
+		reliable.push_back(late[i]);
+	}
+	REQUIRE(reliable.size() == 100);
+	for (uint32_t i = 0; i < reliable.size(); i++) {
+		CHECK(reliable[i] == i);
+	}
+}
+
+TEST_CASE("[SimulatedMultiplayerPeer] Jitter and ordering") {
+	Ref<SimulatedMultiplayerPeer> server = create_peer();
+	Ref<SimulatedMultiplayerPeer> client = create_peer(0.01);
+	REQUIRE(server->create_server(true) == OK);
+	connect_client(server, client);
+	client->set_jitter(0.05);
+	client->set_transfer_mode(Multiplayer::TRANSFER_MODE_UNRELIABLE_ORDERED);
+
+	LocalVector<uint32_t> received;
+	for (int i = 0; i < 200; i++) {
+		send_index(client, i);
+		server->advance_time(0.005);
+		LocalVector<uint32_t> indices = receive_indices(server);
+		for (uint32_t j = 0; j < indices.size(); j++) {
+			received.push_back(indices[j]);
+		}
+	}
+	server->advance_time(1);
+	LocalVector<uint32_t> indices = receive_indices(server);
+	for (uint32_t j = 0; j < indices.size(); j++) {
+		received.push_back(indices[j]);
+	}
+	// Late packets are dropped, the others arrive in order.
+	CHECK(received.size() < 200);
+	bool in_order = true;
+	for (uint32_t i = 1; i < received.size(); i++) {
+		in_order = in_order && received[i] > received[i - 1];
+	}
+	CHECK(in_order);
+}
+
+TEST_CASE("[SimulatedMultiplayerPeer] Bandwidth limit") {
+	Ref<SimulatedMultiplayerPeer> server = create_peer();
+	Ref<SimulatedMultiplayerPeer> client = create_peer();
+	REQUIRE(server->create_server(true) == OK);
+	connect_client(server, client);
+
+	// One 100 bytes packet every 0.1 seconds.
+	client->set_bandwidth_limit(1000);
+	for (int i = 0; i < 10; i++) {
+		send_index(client, i, 100);
+	}
+	server->advance_time(0.5);
+	CHECK(receive_indices(server).size() == 5);
+	server->advance_time(0.5);
+	CHECK(receive_indices(server).size() == 5);
+	CHECK(int(client->get_statistics()["bytes_sent"]) == 1000);
+	CHECK(int(server->get_statistics()["bytes_received"]) == 1000);
+}
+
+TEST_CASE("[SimulatedMultiplayerPeer] Targets") {
+	Ref<SimulatedMultiplayerPeer> server = create_peer();
+	Ref<SimulatedMultiplayerPeer> client_a = create_peer();
+	Ref<SimulatedMultiplayerPeer> client_b = create_peer();
+	REQUIRE(server->create_server(true) == OK);
+	connect_client(server, client_a);
+	connect_client(server, client_b);
+	client_a->poll(); // Meets client B.
+
+	server->set_target_peer(-client_a->get_unique_id());
+	send_index(server, 1);
+	server->set_target_peer(MultiplayerPeer::TARGET_PEER_BROADCAST);
+	send_index(server, 2);
+	client_b->set_target_peer(client_a->get_unique_id());
+	send_index(client_b, 3);
+
+	LocalVector<uint32_t> received_a = receive_indices(client_a);
+	LocalVector<uint32_t> received_b = receive_indices(client_b);
+	REQUIRE(received_a.size() == 2);
+	CHECK(received_a[0] == 2);
+	CHECK(received_a[1] == 3);
+	REQUIRE(received_b.size() == 2);
+	CHECK(received_b[0] == 1);
+	CHECK(received_b[1] == 2);
+
+	ERR_PRINT_OFF;
+	server->set_target_peer(99);
+	CHECK(server->put_packet(nullptr, 0) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[SimulatedMultiplayerPeer] Record and replay") {
+	Ref<SimulatedMultiplayerPeer> server = create_peer(0.03);
+	Ref<SimulatedMultiplayerPeer> client = create_peer();
+	REQUIRE(server->create_server(true) == OK);
+	connect_client(server, client);
+
+	client->start_recording();
+	for (int i = 0; i < 3; i++) {
+		send_index(server, i);
+		server->advance_time(0.1);
+		CHECK(receive_indices(client).size() == 1);
+	}
+	client->stop_recording();
+	send_index(server, 99);
+	server->advance_time(0.1);
+	CHECK(receive_indices(client).size() == 1);
+	const Vector<uint8_t> recording = client->get_recording();
+
+	Ref<SimulatedMultiplayerPeer> replay = create_peer();
+	REQUIRE(replay->create_replay(recording, true) == OK);
+	CHECK(replay->get_unique_id() == client->get_unique_id());
+	replay->poll();
+	CHECK(replay->get_connection_status() == MultiplayerPeer::CONNECTION_CONNECTED);
+	CHECK(receive_indices(replay).size() == 0);
+	// The recorded packets arrive with the server latency.
+	replay->advance_time(0.03);
+	LocalVector<uint32_t> received = receive_indices(replay);
+	REQUIRE(received.size() == 1);
+	CHECK(received[0] == 0);
+	CHECK_FALSE(replay->is_replay_finished());
+	replay->advance_time(0.25);
+	received = receive_indices(replay);
+	REQUIRE(received.size() == 2);
+	CHECK(received[0] == 1);
+	CHECK(received[1] == 2);
+	CHECK(replay->is_replay_finished());
+
+	// Replays can answer, nobody receives it.
+	send_index(replay, 7);
+	CHECK(int(replay->get_statistics()["packets_sent"]) == 1);
+
+	Vector<uint8_t> truncated = recording;
+	truncated.resize(recording.size() - 1);
+	Ref<SimulatedMultiplayerPeer> invalid = create_peer();
+	ERR_PRINT_OFF;
+	CHECK(invalid->create_replay(truncated) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestSimulatedMultiplayerPeer
+
+#endif // TEST_SIMULATED_MULTIPLAYER_PEER_H
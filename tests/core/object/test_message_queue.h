@@ -0,0 +1,240 @@
+/*************************************************************************/
+/*  test_message_queue.h                                                 */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/config/project_settings.h"
+#include "core/object/callable_method_pointer.h"
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class MessageRecorder : public Object {
+public:
+	LocalVector<int> producers;
+	LocalVector<int> sequences;
+	int requeue_count = 0;
+
+	void record(int p_producer, int p_sequence) {
+		producers.push_back(p_producer);
+		sequences.push_back(p_sequence);
+	}
+
+	void record_large(int p_producer, int p_sequence, const PackedByteArray &p_payload) {
+		record(p_producer, p_sequence);
+	}
+
+	void requeue() {
+		if (requeue_count++ < 3) {
+			MessageQueue::get_singleton()->push_callable(callable_mp(this, &MessageRecorder::requeue));
+		}
+	}
+};
+
+// Only [SceneTree] tests get a MessageQueue from the test runner, test commands get none.
+class ScopedMessageQueue {
+	MessageQueue *queue = nullptr;
+
+public:
+	ScopedMessageQueue() {
+		if (!MessageQueue::get_singleton()) {
+			queue = memnew(MessageQueue);
+		}
+	}
+
+	~ScopedMessageQueue() {
+		if (queue) {
+			memdelete(queue);
+		}
+	}
+};
+
+struct ProducerData {
+	MessageRecorder *recorder = nullptr;
+	int producer = 0;
+	int count = 0;
+};
+
+static void producer_thread(void *p_userdata) {
+	ProducerData *data = static_cast<ProducerData *>(p_userdata);
+	for (int i = 0; i < data->count; i++) {
+		MessageQueue::get_singleton()->push_callable(callable_mp(data->recorder, &MessageRecorder::record), data->producer, i);
+	}
+}
+
+// Checks every producer's messages were all run, in the order they were pushed.
+static bool check_producer_order(const MessageRecorder &p_recorder, int p_producers, int p_count) {
+	LocalVector<int> next;
+	next.resize(p_producers);
+	for (int i = 0; i < p_producers; i++) {
+		next[i] = 0;
+	}
+	for (uint32_t i = 0; i < p_recorder.producers.size(); i++) {
+		const int producer = p_recorder.producers[i];
+		if (p_recorder.sequences[i] != next[producer]) {
+			return false;
+		}
+		next[producer]++;
+	}
+	for (int i = 0; i < p_producers; i++) {
+		if (next[i] != p_count) {
+			return false;
+		}
+	}
+	return true;
+}
+
+TEST_CASE("[MessageQueue] Calls from the main thread run in order") {
+	ScopedMessageQueue message_queue;
+	MessageRecorder recorder;
+	for (int i = 0; i < 100; i++) {
+		MessageQueue::get_singleton()->push_callable(callable_mp(&recorder, &MessageRecorder::record), 0, i);
+	}
+	CHECK(recorder.producers.size() == 0);
+
+	MessageQueue::get_singleton()->flush();
+	CHECK(check_producer_order(recorder, 1, 100));
+}
+
+TEST_CASE("[MessageQueue] Queue grows past a single page") {
+	ScopedMessageQueue message_queue;
+	MessageRecorder recorder;
+	PackedByteArray payload;
+	payload.resize(16);
+
+	// Enough messages to need several pages.
+	const int count = 10000;
+	for (int i = 0; i < count; i++) {
+		MessageQueue::get_singleton()->push_callable(callable_mp(&recorder, &MessageRecorder::record_large), 0, i, payload);
+	}
+
+	MessageQueue::get_singleton()->flush();
+	CHECK(check_producer_order(recorder, 1, count));
+	CHECK(MessageQueue::get_singleton()->get_max_buffer_usage() > 64 * 1024);
+}
+
+TEST_CASE("[MessageQueue] Calls pushed while flushing run in the same flush") {
+	ScopedMessageQueue message_queue;
+	MessageRecorder recorder;
+	MessageQueue::get_singleton()->push_callable(callable_mp(&recorder, &MessageRecorder::requeue));
+	MessageQueue::get_singleton()->flush();
+	CHECK(recorder.requeue_count == 4);
+}
+
+TEST_CASE("[MessageQueue] Calls from worker threads keep per-thread order") {
+	ScopedMessageQueue message_queue;
+	MessageRecorder recorder;
+	const int thread_count = 4;
+	const int count = 2000;
+
+	ProducerData data[thread_count + 1];
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		data[i].recorder = &recorder;
+		data[i].producer = i;
+		data[i].count = count;
+		threads[i].start(producer_thread, &data[i]);
+	}
+
+	// The main thread pushes at the same time.
+	data[thread_count].recorder = &recorder;
+	data[thread_count].producer = thread_count;
+	data[thread_count].count = count;
+	producer_thread(&data[thread_count]);
+
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	MessageQueue::get_singleton()->flush();
+	CHECK(recorder.producers.size() == uint32_t((thread_count + 1) * count));
+	CHECK_MESSAGE(check_producer_order(recorder, thread_count + 1, count), "Messages from each thread should run in the order they were pushed.");
+}
+
+// Run with `godot --test message-queue-benchmark`.
+static void benchmark_message_queue() {
+	const int count = 200000;
+	const int thread_counts[3] = { 1, 4, 8 };
+
+	// Every call of a run stays queued until the flush. The queue reads its cap when created, raise it so they all fit.
+	const String max_size_setting = "memory/limits/message_queue/max_size_kb";
+	const Variant max_size_kb = ProjectSettings::get_singleton()->get_setting(max_size_setting);
+	ProjectSettings::get_singleton()->set_setting(max_size_setting, 512 * 1024);
+	ScopedMessageQueue message_queue;
+	ProjectSettings::get_singleton()->set_setting(max_size_setting, max_size_kb);
+
+	MessageRecorder recorder;
+	recorder.producers.reserve(count * 8);
+	recorder.sequences.reserve(count * 8);
+
+	print_line(vformat("Message queue benchmark: %d deferred calls per thread.", count));
+
+	for (int t = 0; t < 3; t++) {
+		const int thread_count = thread_counts[t];
+		LocalVector<ProducerData> data;
+		data.resize(thread_count);
+		LocalVector<Thread *> threads;
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			data[i].recorder = &recorder;
+			data[i].producer = i;
+			data[i].count = count;
+			threads.push_back(memnew(Thread));
+			threads[i]->start(producer_thread, &data[i]);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i]->wait_to_finish();
+			memdelete(threads[i]);
+		}
+		const uint64_t push_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		const uint64_t flush_begin = OS::get_singleton()->get_ticks_usec();
+		MessageQueue::get_singleton()->flush();
+		const uint64_t flush_usec = OS::get_singleton()->get_ticks_usec() - flush_begin;
+
+		ERR_FAIL_COND(!check_producer_order(recorder, thread_count, count));
+		recorder.producers.clear();
+		recorder.sequences.clear();
+
+		print_line(vformat("    %d threads: push %.1f nsec per call, flush %.1f nsec per call, %d KiB flushed", thread_count, double(push_usec) * 1000.0 / (count * thread_count), double(flush_usec) * 1000.0 / (count * thread_count), MessageQueue::get_singleton()->get_max_buffer_usage() / 1024));
+	}
+}
+
+REGISTER_TEST_COMMAND("message-queue-benchmark", &benchmark_message_queue);
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
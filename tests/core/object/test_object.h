@@ -35,6 +35,9 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
 
 #include "tests/test_macros.h"
 
@@ -58,6 +61,35 @@ public:
 	int get_property() const { return property_value; }
 };
 
+class _TestSignalObject : public Object {
+	GDCLASS(_TestSignalObject, Object);
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("on_test_signal", "value"), &_TestSignalObject::on_test_signal);
+		ClassDB::bind_method(D_METHOD("on_test_signal_bound", "value", "bound"), &_TestSignalObject::on_test_signal_bound);
+		ClassDB::bind_method(D_METHOD("disconnect_from", "value", "emitter", "other"), &_TestSignalObject::disconnect_from);
+		ADD_SIGNAL(MethodInfo("test_signal", PropertyInfo(Variant::INT, "value")));
+	}
+
+public:
+	int call_count = 0;
+	int value_sum = 0;
+
+	void on_test_signal(int p_value) {
+		call_count++;
+		value_sum += p_value;
+	}
+	void on_test_signal_bound(int p_value, int p_bound) {
+		call_count++;
+		value_sum += p_value * p_bound;
+	}
+	void disconnect_from(int p_value, Object *p_emitter, Object *p_other) {
+		call_count++;
+		p_emitter->disconnect("test_signal", Callable(p_other, "on_test_signal"));
+	}
+};
+
 namespace TestObject {
 
 class _MockScriptInstance : public ScriptInstance {
@@ -275,6 +307,218 @@ TEST_CASE("[Object] Absent name getter") {
 			actual_value == Variant(),
 			"The returned value should equal nil variant.");
 }
+
+TEST_CASE("[Object] Signal emission") {
+	GDREGISTER_CLASS(_TestSignalObject);
+	_TestSignalObject emitter;
+	_TestSignalObject target;
+	_TestSignalObject bound_target;
+	_TestSignalObject oneshot_target;
+
+	CHECK_MESSAGE(emitter.emit_signal("test_signal", 1) == ERR_UNAVAILABLE, "Emitting a signal that was never connected should do nothing.");
+
+	emitter.connect("test_signal", Callable(&target, "on_test_signal"));
+	emitter.connect("test_signal", Callable(&bound_target, "on_test_signal_bound"), varray(10));
+	emitter.connect("test_signal", Callable(&oneshot_target, "on_test_signal"), Vector<Variant>(), Object::CONNECT_ONESHOT);
+
+	CHECK(emitter.emit_signal("test_signal", 2) == OK);
+	CHECK(emitter.emit_signal("test_signal", 3) == OK);
+
+	CHECK(target.call_count == 2);
+	CHECK(target.value_sum == 5);
+	CHECK_MESSAGE(bound_target.value_sum == 50, "Bound arguments should be appended to the emitted ones.");
+	CHECK_MESSAGE(oneshot_target.call_count == 1, "One-shot connections should be called once.");
+	CHECK(!emitter.is_connected("test_signal", Callable(&oneshot_target, "on_test_signal")));
+}
+
+TEST_CASE("[Object] Signal disconnected during emission") {
+	GDREGISTER_CLASS(_TestSignalObject);
+	_TestSignalObject emitter;
+	_TestSignalObject disconnecting_target;
+	_TestSignalObject target;
+
+	emitter.connect("test_signal", Callable(&disconnecting_target, "disconnect_from"), varray(&emitter, &target));
+	emitter.connect("test_signal", Callable(&target, "on_test_signal"));
+
+	emitter.emit_signal("test_signal", 1);
+	CHECK_MESSAGE(target.call_count == 1, "Connections removed during an emission should still be called by it.");
+	CHECK(!emitter.is_connected("test_signal", Callable(&target, "on_test_signal")));
+
+	emitter.emit_signal("test_signal", 1);
+	CHECK(disconnecting_target.call_count == 2);
+	CHECK(target.call_count == 1);
+}
+
+TEST_CASE("[Object] ObjectDB instance lookup") {
+	Object *object = memnew(Object);
+	const ObjectID id = object->get_instance_id();
+	CHECK(ObjectDB::get_instance(id) == object);
+	CHECK(ObjectDB::get_instance(ObjectID()) == nullptr);
+	// A null validator never matches, even in the slot of a live object.
+	CHECK(ObjectDB::get_instance(ObjectID(uint64_t(id) & OBJECTDB_SLOT_MAX_COUNT_MASK)) == nullptr);
+
+	memdelete(object);
+	CHECK_MESSAGE(ObjectDB::get_instance(id) == nullptr, "Freed objects should not be found.");
+
+	// Freed slots are reused by the same thread first, but with a new validator.
+	Object *reused = memnew(Object);
+	CHECK(ObjectDB::get_instance(reused->get_instance_id()) == reused);
+	CHECK(ObjectDB::get_instance(id) == nullptr);
+	memdelete(reused);
+}
+
+struct ObjectDBLookupThreadData {
+	Vector<ObjectID> ids;
+	SafeFlag stop;
+	SafeNumeric<uint64_t> lookups;
+	SafeNumeric<uint64_t> found;
+	SafeNumeric<uint64_t> allocations;
+	bool churn = false;
+};
+
+static void objectdb_lookup_thread(void *p_userdata) {
+	ObjectDBLookupThreadData *data = (ObjectDBLookupThreadData *)p_userdata;
+	uint64_t lookups = 0;
+	uint64_t found = 0;
+	uint64_t allocations = 0;
+	uint32_t index = 0;
+	while (!data->stop.is_set()) {
+		for (int i = 0; i < 1024; i++) {
+			Object *object = ObjectDB::get_instance(data->ids[index++ % data->ids.size()]);
+			found += object != nullptr ? 1 : 0;
+		}
+		lookups += 1024;
+		if (data->churn) {
+			for (int i = 0; i < 64; i++) {
+				memdelete(memnew(Object));
+			}
+			allocations += 64;
+		}
+	}
+	data->lookups.add(lookups);
+	data->found.add(found);
+	data->allocations.add(allocations);
+}
+
+TEST_CASE("[Object] ObjectDB concurrent lookup") {
+	const int object_count = 1024;
+	Vector<Object *> objects;
+	ObjectDBLookupThreadData data;
+	data.churn = true;
+	for (int i = 0; i < object_count; i++) {
+		objects.push_back(memnew(Object));
+		data.ids.push_back(objects[i]->get_instance_id());
+	}
+
+	Thread threads[4];
+	for (int i = 0; i < 4; i++) {
+		threads[i].start(objectdb_lookup_thread, &data);
+	}
+
+	// Free half of the objects while other threads look them up and allocate their own.
+	for (int i = 0; i < object_count; i += 2) {
+		memdelete(objects[i]);
+		objects.write[i] = nullptr;
+	}
+	OS::get_singleton()->delay_usec(10000);
+	data.stop.set();
+	for (int i = 0; i < 4; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	for (int i = 0; i < object_count; i++) {
+		if (objects[i]) {
+			CHECK(ObjectDB::get_instance(data.ids[i]) == objects[i]);
+			memdelete(objects[i]);
+		} else {
+			CHECK(ObjectDB::get_instance(data.ids[i]) == nullptr);
+		}
+	}
+	CHECK(data.lookups.get() > 0);
+}
+
+// Run with `godot --test objectdb-benchmark`.
+static void benchmark_objectdb() {
+	const int object_count = 100000;
+	const uint64_t duration_usec = 500000;
+
+	ObjectDBLookupThreadData base_data;
+	Vector<Object *> objects;
+	for (int i = 0; i < object_count; i++) {
+		objects.push_back(memnew(Object));
+		base_data.ids.push_back(objects[i]->get_instance_id());
+	}
+
+	const int max_threads = MIN(OS::get_singleton()->get_processor_count(), 32);
+	print_line(vformat("ObjectDB benchmark: %d objects, %d ms per case.", object_count, int(duration_usec / 1000)));
+
+	for (int churn = 0; churn < 2; churn++) {
+		for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+			ObjectDBLookupThreadData data;
+			data.ids = base_data.ids;
+			data.churn = churn;
+
+			Vector<Thread *> threads;
+			for (int i = 0; i < thread_count; i++) {
+				threads.push_back(memnew(Thread));
+				threads[i]->start(objectdb_lookup_thread, &data);
+			}
+			OS::get_singleton()->delay_usec(duration_usec);
+			data.stop.set();
+			for (int i = 0; i < thread_count; i++) {
+				threads[i]->wait_to_finish();
+				memdelete(threads[i]);
+			}
+
+			const double seconds = double(duration_usec) / 1000000.0;
+			print_line(vformat("    %s, %d threads: %.1f M lookups/s, %.1f M allocations/s", churn ? "lookup + alloc/free" : "lookup only", thread_count, double(data.lookups.get()) / seconds / 1000000.0, double(data.allocations.get()) / seconds / 1000000.0));
+		}
+	}
+
+	for (int i = 0; i < objects.size(); i++) {
+		memdelete(objects[i]);
+	}
+}
+
+REGISTER_TEST_COMMAND("objectdb-benchmark", &benchmark_objectdb);
+
+// Run with `godot --test signal-emit-benchmark`.
+static void benchmark_signal_emit() {
+	GDREGISTER_CLASS(_TestSignalObject);
+
+	const int emits = 1000000;
+	const int connection_counts[3] = { 0, 1, 8 };
+
+	print_line(vformat("Signal emit benchmark: %d emissions per case.", emits));
+
+	for (int c = 0; c < 3; c++) {
+		_TestSignalObject emitter;
+		Vector<_TestSignalObject *> targets;
+		for (int i = 0; i < connection_counts[c]; i++) {
+			_TestSignalObject *target = memnew(_TestSignalObject);
+			emitter.connect("test_signal", Callable(target, "on_test_signal"));
+			targets.push_back(target);
+		}
+
+		const Variant value = 1;
+		const Variant *args[1] = { &value };
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emits; i++) {
+			emitter.emit_signalp("test_signal", args, 1);
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("    %d connections: %.1f nsec per emission", connection_counts[c], double(usec) * 1000.0 / emits));
+
+		for (int i = 0; i < targets.size(); i++) {
+			memdelete(targets[i]);
+		}
+	}
+}
+
+REGISTER_TEST_COMMAND("signal-emit-benchmark", &benchmark_signal_emit);
+
 } // namespace TestObject
 
 #endif // TEST_OBJECT_H
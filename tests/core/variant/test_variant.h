@@ -911,6 +911,47 @@ TEST_CASE("[Variant] Nested dictionary comparison") {
 	CHECK_FALSE(v_d1 == v_d_other_val);
 }
 
+TEST_CASE("[Variant] Heap allocation counting for transforms, bases and AABBs") {
+	const int count = 10000;
+	const uint64_t allocations_before = Variant::get_allocation_count();
+
+	Vector<Variant> variants;
+	variants.resize(count * 4);
+	for (int i = 0; i < count; i++) {
+		variants.write[i * 4 + 0] = Transform2D(i, Vector2(i, -i));
+		variants.write[i * 4 + 1] = AABB(Vector3(i, 0, 0), Vector3(1, 2, 3));
+		variants.write[i * 4 + 2] = Basis(Vector3(i, 0, 0), Vector3(0, i, 0), Vector3(0, 0, i));
+		variants.write[i * 4 + 3] = Transform3D(Basis(), Vector3(i, i, i));
+	}
+
+#ifdef DEBUG_ENABLED
+	CHECK_MESSAGE(Variant::get_allocation_count() - allocations_before >= uint64_t(count * 4), "Allocations should be counted.");
+#else
+	CHECK(Variant::get_allocation_count() == allocations_before);
+#endif
+
+	// Copying, replacing and clearing some of them must leave the others intact.
+	for (int i = 0; i < count; i += 2) {
+		Variant copy = variants[i * 4 + 3];
+		variants.write[i * 4 + 0] = copy;
+		variants.write[i * 4 + 1] = Variant();
+	}
+
+	bool values_match = true;
+	for (int i = 0; i < count; i++) {
+		if (i % 2 == 0) {
+			values_match = values_match && Transform3D(variants[i * 4 + 0]) == Transform3D(Basis(), Vector3(i, i, i));
+			values_match = values_match && variants[i * 4 + 1].get_type() == Variant::NIL;
+		} else {
+			values_match = values_match && Transform2D(variants[i * 4 + 0]) == Transform2D(i, Vector2(i, -i));
+			values_match = values_match && AABB(variants[i * 4 + 1]) == AABB(Vector3(i, 0, 0), Vector3(1, 2, 3));
+		}
+		values_match = values_match && Basis(variants[i * 4 + 2]) == Basis(Vector3(i, 0, 0), Vector3(0, i, 0), Vector3(0, 0, i));
+		values_match = values_match && Transform3D(variants[i * 4 + 3]) == Transform3D(Basis(), Vector3(i, i, i));
+	}
+	CHECK(values_match);
+}
+
 } // namespace TestVariant
 
 #endif // TEST_VARIANT_H
@@ -31,6 +31,11 @@
 #ifndef TEST_ANIMATION_H
 #define TEST_ANIMATION_H
 
+#include "core/os/os.h"
+#include "scene/2d/node_2d.h"
+#include "scene/animation/animation_lod.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
 #include "scene/resources/animation.h"
 
 #include "tests/test_macros.h"
@@ -309,6 +314,223 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+// Builds a motion capture-like animation: a position and rotation track per bone, with a key every frame.
+static Ref<Animation> create_mocap_animation(int p_bones, double p_length, double p_fps) {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(p_length);
+	const int frames = int(p_length * p_fps) + 1;
+	for (int i = 0; i < p_bones; i++) {
+		const int pos_track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(pos_track, NodePath(vformat("Skeleton3D:bone_%d", i)));
+		const int rot_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(rot_track, NodePath(vformat("Skeleton3D:bone_%d", i)));
+		for (int j = 0; j < frames; j++) {
+			const double time = j / p_fps;
+			const double phase = time * (1.0 + i * 0.1);
+			animation->position_track_insert_key(pos_track, time, Vector3(Math::sin(phase), Math::cos(phase * 0.5), i * 0.1));
+			animation->rotation_track_insert_key(rot_track, time, Quaternion(Vector3(0, 1, 0), Math::sin(phase) * Math_PI));
+		}
+	}
+	return animation;
+}
+
+TEST_CASE("[Animation] Compressed track sampling with cursor") {
+	Ref<Animation> animation = create_mocap_animation(2, 10.0, 30.0);
+	animation->compress(1024);
+
+	REQUIRE(animation->track_is_compressed(0));
+	REQUIRE(animation->track_is_compressed(1));
+
+	Animation::CompressedCursor pos_cursor;
+	Animation::CompressedCursor rot_cursor;
+
+	// Forward playback, then seeking backwards and past the end, must match sampling without a cursor.
+	const double times[] = { 0.0, 0.01, 0.5, 0.51, 1.0, 2.5, 9.99, 10.0, 0.25, 5.0, 4.9, 12.0, 0.0 };
+	for (const double time : times) {
+		Vector3 pos;
+		Vector3 pos_with_cursor;
+		CHECK(animation->position_track_interpolate(0, time, &pos) == OK);
+		CHECK(animation->position_track_interpolate(0, time, &pos_with_cursor, &pos_cursor) == OK);
+		CHECK(pos.is_equal_approx(pos_with_cursor));
+
+		Quaternion rot;
+		Quaternion rot_with_cursor;
+		CHECK(animation->rotation_track_interpolate(1, time, &rot) == OK);
+		CHECK(animation->rotation_track_interpolate(1, time, &rot_with_cursor, &rot_cursor) == OK);
+		CHECK(rot.is_equal_approx(rot_with_cursor));
+	}
+
+	// A cursor left over from another track must still give the right result.
+	Vector3 pos;
+	Vector3 pos_with_cursor;
+	CHECK(animation->position_track_interpolate(2, 7.3, &pos) == OK);
+	CHECK(animation->position_track_interpolate(2, 7.3, &pos_with_cursor, &pos_cursor) == OK);
+	CHECK(pos.is_equal_approx(pos_with_cursor));
+}
+
+TEST_CASE("[Animation] LOD throttling accumulates skipped delta") {
+	AnimationLOD lod;
+	double delta = 0.0;
+
+	SUBCASE("Disabled throttling evaluates every frame") {
+		for (int i = 0; i < 4; i++) {
+			CHECK(lod.process(nullptr, 0.25, delta));
+			CHECK(delta == doctest::Approx(0.25));
+		}
+	}
+
+	SUBCASE("Lowest importance skips max_frame_skip frames") {
+		lod.max_frame_skip = 3;
+		lod.importance = 0.0;
+		for (int i = 0; i < 2; i++) {
+			CHECK_FALSE(lod.process(nullptr, 0.25, delta));
+			CHECK_FALSE(lod.process(nullptr, 0.25, delta));
+			CHECK_FALSE(lod.process(nullptr, 0.25, delta));
+			CHECK(lod.process(nullptr, 0.25, delta));
+			CHECK_MESSAGE(delta == doctest::Approx(1.0), "The evaluated frame should catch up the delta of the skipped frames.");
+		}
+	}
+
+	SUBCASE("Importance scales the interval") {
+		lod.max_frame_skip = 4;
+		lod.importance = 0.5;
+		CHECK_FALSE(lod.process(nullptr, 0.1, delta));
+		CHECK_FALSE(lod.process(nullptr, 0.2, delta));
+		CHECK(lod.process(nullptr, 0.3, delta));
+		CHECK(delta == doctest::Approx(0.6));
+
+		lod.importance = 1.0;
+		CHECK(lod.process(nullptr, 0.1, delta));
+		CHECK(delta == doctest::Approx(0.1));
+	}
+
+	SUBCASE("Reset drops the accumulated delta") {
+		lod.max_frame_skip = 2;
+		lod.importance = 0.0;
+		CHECK_FALSE(lod.process(nullptr, 0.5, delta));
+		lod.reset();
+		CHECK_FALSE(lod.process(nullptr, 0.25, delta));
+		CHECK_FALSE(lod.process(nullptr, 0.25, delta));
+		CHECK(lod.process(nullptr, 0.25, delta));
+		CHECK(delta == doctest::Approx(0.75));
+	}
+}
+
+TEST_CASE("[SceneTree][AnimationPlayer] LOD throttling catches up on the evaluated frames") {
+	Node *parent = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	Node2D *target = memnew(Node2D);
+	target->set_name("Target");
+	parent->add_child(target);
+
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(10.0);
+	const int track_index = animation->add_track(Animation::TYPE_VALUE);
+	animation->track_set_path(track_index, NodePath("Target:position"));
+	animation->track_insert_key(track_index, 0.0, Vector2(0, 0));
+	animation->track_insert_key(track_index, 10.0, Vector2(10, 0));
+
+	Ref<AnimationLibrary> library;
+	library.instantiate();
+	library->add_animation("move", animation);
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	parent->add_child(player);
+	player->add_animation_library("", library);
+	player->set_lod_max_frame_skip(3);
+	player->set_lod_importance(0.0);
+	player->play("move");
+
+	for (int i = 0; i < 3; i++) {
+		SceneTree::get_singleton()->process(0.25);
+		CHECK_MESSAGE(target->get_position().is_equal_approx(Vector2(0, 0)), "Throttled frames should not evaluate the animation.");
+	}
+	SceneTree::get_singleton()->process(0.25);
+	CHECK(player->get_current_animation_position() == doctest::Approx(1.0));
+	CHECK(target->get_position().is_equal_approx(Vector2(1, 0)));
+
+	for (int i = 0; i < 4; i++) {
+		SceneTree::get_singleton()->process(0.25);
+	}
+	CHECK(target->get_position().is_equal_approx(Vector2(2, 0)));
+
+	// Without throttling the animation advances every frame again.
+	player->set_lod_max_frame_skip(0);
+	SceneTree::get_singleton()->process(0.25);
+	CHECK(target->get_position().is_equal_approx(Vector2(2.25, 0)));
+
+	memdelete(parent);
+}
+
+static uint64_t get_animation_data_size(const Ref<Animation> &p_animation) {
+	uint64_t size = 0;
+	if (p_animation->track_is_compressed(0)) {
+		Dictionary compression = p_animation->get("_compression");
+		Array pages = compression["pages"];
+		for (int i = 0; i < pages.size(); i++) {
+			Dictionary page = pages[i];
+			size += PackedByteArray(page["data"]).size();
+		}
+	} else {
+		for (int i = 0; i < p_animation->get_track_count(); i++) {
+			size += PackedFloat32Array(p_animation->get(vformat("tracks/%d/keys", i))).size() * sizeof(float);
+		}
+	}
+	return size;
+}
+
+static uint64_t benchmark_animation_sampling(const Ref<Animation> &p_animation, double p_fps, bool p_use_cursors) {
+	LocalVector<Animation::CompressedCursor> cursors;
+	cursors.resize(p_animation->get_track_count());
+
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	const int frames = int(p_animation->get_length() * p_fps);
+	for (int i = 0; i < frames; i++) {
+		const double time = i / p_fps;
+		for (int j = 0; j < p_animation->get_track_count(); j++) {
+			Animation::CompressedCursor *cursor = p_use_cursors ? &cursors[j] : nullptr;
+			if (p_animation->track_get_type(j) == Animation::TYPE_POSITION_3D) {
+				Vector3 pos;
+				p_animation->position_track_interpolate(j, time, &pos, cursor);
+			} else {
+				Quaternion rot;
+				p_animation->rotation_track_interpolate(j, time, &rot, cursor);
+			}
+		}
+	}
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+// Compares memory usage and sampling throughput of uncompressed and compressed animations.
+// Run with `godot --test animation-compression-benchmark`.
+static void benchmark_animation_compression() {
+	const int bones = 80;
+	const double length = 120.0;
+	const double fps = 60.0;
+
+	print_line(vformat("Animation compression benchmark: %d bones, %.1f seconds at %d FPS.", bones, length, int(fps)));
+
+	Ref<Animation> uncompressed = create_mocap_animation(bones, length, fps);
+	Ref<Animation> compressed = create_mocap_animation(bones, length, fps);
+	compressed->compress();
+
+	const uint64_t uncompressed_size = get_animation_data_size(uncompressed);
+	const uint64_t compressed_size = get_animation_data_size(compressed);
+	print_line(vformat("Memory: uncompressed %d KiB, compressed %d KiB (%.1f%%).", uncompressed_size / 1024, compressed_size / 1024, 100.0 * compressed_size / MAX(uncompressed_size, 1u)));
+
+	const uint64_t samples = uint64_t(length * fps) * uncompressed->get_track_count();
+	const uint64_t uncompressed_usec = benchmark_animation_sampling(uncompressed, fps, false);
+	const uint64_t compressed_usec = benchmark_animation_sampling(compressed, fps, false);
+	const uint64_t cursor_usec = benchmark_animation_sampling(compressed, fps, true);
+	print_line(vformat("Sampling %d track keys:", samples));
+	print_line(vformat("    uncompressed: %d msec (%.1f samples/usec)", uncompressed_usec / 1000, double(samples) / MAX(uncompressed_usec, 1u)));
+	print_line(vformat("    compressed: %d msec (%.1f samples/usec)", compressed_usec / 1000, double(samples) / MAX(compressed_usec, 1u)));
+	print_line(vformat("    compressed with cursors: %d msec (%.1f samples/usec)", cursor_usec / 1000, double(samples) / MAX(cursor_usec, 1u)));
+}
+
+REGISTER_TEST_COMMAND("animation-compression-benchmark", &benchmark_animation_compression);
+
 } // namespace TestAnimation
 
 #endif // TEST_ANIMATION_H
@@ -0,0 +1,162 @@
+/*************************************************************************/
+/*  tests/scene/test_process_thread_group.h                              */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PROCESS_THREAD_GROUP_H
+#define TEST_PROCESS_THREAD_GROUP_H
+
+#include "scene/2d/node_2d.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestThreadGroupNode3D : public Node3D {
+	GDCLASS(_TestThreadGroupNode3D, Node3D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS) {
+			processed_global_transform = get_global_transform();
+			accessible = is_accessible_from_caller_thread();
+			process_count++;
+		}
+	}
+
+public:
+	Transform3D processed_global_transform;
+	bool accessible = false;
+	int process_count = 0;
+};
+
+class _TestThreadGroupNode2D : public Node2D {
+	GDCLASS(_TestThreadGroupNode2D, Node2D);
+
+protected:
+	void _notification(int p_what) {
+		if (p_what == NOTIFICATION_PROCESS) {
+			processed_global_transform = get_global_transform();
+			accessible = is_accessible_from_caller_thread();
+			process_count++;
+		}
+	}
+
+public:
+	Transform2D processed_global_transform;
+	bool accessible = false;
+	int process_count = 0;
+};
+
+namespace TestProcessThreadGroup {
+
+TEST_CASE("[SceneTree][Node] Sub-thread group under a transformed Node3D parent") {
+	Node3D *parent = memnew(Node3D);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	const int group_count = 4;
+	_TestThreadGroupNode3D *groups[group_count];
+	_TestThreadGroupNode3D *children[group_count];
+	for (int i = 0; i < group_count; i++) {
+		groups[i] = memnew(_TestThreadGroupNode3D);
+		groups[i]->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		groups[i]->set_position(Vector3(i, 0, 0));
+		groups[i]->set_process(true);
+		parent->add_child(groups[i]);
+
+		children[i] = memnew(_TestThreadGroupNode3D);
+		children[i]->set_position(Vector3(0, 0, 1));
+		children[i]->set_process(true);
+		groups[i]->add_child(children[i]);
+	}
+
+	for (int frame = 0; frame < 2; frame++) {
+		// Dirty the parent shared by the groups right before processing, it must be updated before they read it.
+		parent->set_position(Vector3(10, 20 + frame, 30));
+		parent->set_rotation(Vector3(0, Math_PI * 0.5 * frame, 0));
+
+		SceneTree::get_singleton()->process(0.016);
+
+		const Transform3D parent_xform = parent->get_global_transform();
+		for (int i = 0; i < group_count; i++) {
+			const Transform3D group_xform = parent_xform * Transform3D(Basis(), Vector3(i, 0, 0));
+			CHECK(groups[i]->process_count == frame + 1);
+			CHECK(groups[i]->accessible);
+			CHECK(groups[i]->processed_global_transform.is_equal_approx(group_xform));
+			CHECK(groups[i]->get_global_transform().is_equal_approx(group_xform));
+
+			const Transform3D child_xform = group_xform * Transform3D(Basis(), Vector3(0, 0, 1));
+			CHECK(children[i]->process_count == frame + 1);
+			CHECK(children[i]->accessible);
+			CHECK(children[i]->processed_global_transform.is_equal_approx(child_xform));
+		}
+	}
+
+	memdelete(parent);
+}
+
+TEST_CASE("[SceneTree][Node] Sub-thread group under a transformed Node2D parent") {
+	Node2D *parent = memnew(Node2D);
+	SceneTree::get_singleton()->get_root()->add_child(parent);
+
+	const int group_count = 4;
+	_TestThreadGroupNode2D *groups[group_count];
+	for (int i = 0; i < group_count; i++) {
+		groups[i] = memnew(_TestThreadGroupNode2D);
+		groups[i]->set_process_thread_group(Node::PROCESS_THREAD_GROUP_SUB_THREAD);
+		groups[i]->set_position(Vector2(0, i));
+		groups[i]->set_process(true);
+		parent->add_child(groups[i]);
+	}
+
+	for (int frame = 0; frame < 2; frame++) {
+		parent->set_position(Vector2(100, 200 + frame));
+		parent->set_rotation(Math_PI * 0.5 * frame);
+		parent->set_scale(Vector2(2, 2));
+
+		SceneTree::get_singleton()->process(0.016);
+
+		const Transform2D parent_xform = parent->get_global_transform();
+		for (int i = 0; i < group_count; i++) {
+			const Transform2D group_xform = parent_xform * Transform2D(0, Vector2(0, i));
+			CHECK(groups[i]->process_count == frame + 1);
+			CHECK(groups[i]->accessible);
+			CHECK(groups[i]->processed_global_transform.is_equal_approx(group_xform));
+			CHECK(groups[i]->get_global_transform().is_equal_approx(group_xform));
+		}
+	}
+
+	memdelete(parent);
+}
+
+} // namespace TestProcessThreadGroup
+
+#endif // TEST_PROCESS_THREAD_GROUP_H
@@ -0,0 +1,732 @@
+/*************************************************************************/
+/*  test_scene_replication.h                                             */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_SCENE_REPLICATION_H
+#define TEST_SCENE_REPLICATION_H
+
+#include "core/config/project_settings.h"
+#include "core/io/marshalls.h"
+#include "core/multiplayer/multiplayer_api.h"
+#include "core/multiplayer/simulated_multiplayer_peer.h"
+#include "core/templates/local_vector.h"
+#include "scene/3d/node_3d.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
+#include "scene/multiplayer/multiplayer_synchronizer.h"
+#include "scene/resources/scene_replication_config.h"
+#include "servers/navigation_server_2d.h"
+#include "servers/navigation_server_3d.h"
+#include "servers/physics_server_2d.h"
+#include "servers/physics_server_3d.h"
+#include "servers/rendering/rendering_server_default.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSceneReplication {
+
+// Delivers packets directly to the linked peers' queues, optionally dropping unreliable ones.
+class LoopbackMultiplayerPeer : public MultiplayerPeer {
+	struct Packet {
+		int from = 0;
+		Vector<uint8_t> data;
+	};
+
+	int unique_id = 0;
+	int target_peer = 0;
+	HashMap<int, LoopbackMultiplayerPeer *> links;
+	List<Packet> incoming;
+	Vector<uint8_t> current_packet;
+	uint32_t unreliable_count = 0;
+
+public:
+	uint64_t bytes_sent = 0;
+	int drop_unreliable_every = 0; // Drop one in every N unreliable packets, 0 disables.
+
+	void link(LoopbackMultiplayerPeer *p_peer) {
+		links[p_peer->unique_id] = p_peer;
+		p_peer->links[unique_id] = this;
+	}
+
+	virtual int get_available_packet_count() const override { return incoming.size(); }
+	virtual Error get_packet(const uint8_t **r_buffer, int &r_buffer_size) override {
+		ERR_FAIL_COND_V(incoming.is_empty(), ERR_UNAVAILABLE);
+		current_packet = incoming.front()->get().data;
+		incoming.pop_front();
+		*r_buffer = current_packet.ptr();
+		r_buffer_size = current_packet.size();
+		return OK;
+	}
+	virtual Error put_packet(const uint8_t *p_buffer, int p_buffer_size) override {
+		bool drop = false;
+		if (get_transfer_mode() == Multiplayer::TRANSFER_MODE_UNRELIABLE && drop_unreliable_every > 0) {
+			drop = ++unreliable_count % drop_unreliable_every == 0;
+		}
+		const int *k = nullptr;
+		while ((k = links.next(k))) {
+			if (target_peer != 0 && target_peer != *k && !(target_peer < 0 && -target_peer != *k)) {
+				continue;
+			}
+			bytes_sent += p_buffer_size;
+			if (drop) {
+				continue;
+			}
+			Packet packet;
+			packet.from = unique_id;
+			packet.data.resize(p_buffer_size);
+			memcpy(packet.data.ptrw(), p_buffer, p_buffer_size);
+			links[*k]->incoming.push_back(packet);
+		}
+		return OK;
+	}
+	virtual int get_max_packet_size() const override { return 1 << 24; }
+
+	virtual void set_target_peer(int p_peer_id) override { target_peer = p_peer_id; }
+	virtual int get_packet_peer() const override { return incoming.is_empty() ? 0 : incoming.front()->get().from; }
+	virtual bool is_server() const override { return unique_id == 1; }
+	virtual void poll() override {}
+	virtual int get_unique_id() const override { return unique_id; }
+	virtual ConnectionStatus get_connection_status() const override { return CONNECTION_CONNECTED; }
+
+	LoopbackMultiplayerPeer(int p_unique_id) {
+		unique_id = p_unique_id;
+	}
+};
+
+// A server and its clients in the same scene tree, each with its own MultiplayerAPI and a copy
+// of the same path-synchronized nodes, under "/root/Peer<id>". The peers are either loopback
+// peers, connected right away, or simulated peers with manual time, connected by the first poll.
+class ReplicationLoopback {
+	struct Side {
+		Ref<MultiplayerAPI> api;
+		Ref<MultiplayerPeer> peer;
+		Node *root = nullptr;
+		Vector<Node3D *> nodes;
+	};
+
+	LocalVector<Side> sides;
+
+public:
+	Vector<Node3D *> &get_nodes(int p_side) { return sides[p_side].nodes; }
+	MultiplayerSynchronizer *get_sync(int p_side, int p_node) { return Object::cast_to<MultiplayerSynchronizer>(sides[p_side].nodes[p_node]->get_node(NodePath("Sync"))); }
+	MultiplayerAPI *get_api(int p_side) { return sides[p_side].api.ptr(); }
+	Node *get_root(int p_side) { return sides[p_side].root; }
+	LoopbackMultiplayerPeer *get_peer(int p_side) { return Object::cast_to<LoopbackMultiplayerPeer>(sides[p_side].peer.ptr()); }
+	SimulatedMultiplayerPeer *get_simulated_peer(int p_side) { return Object::cast_to<SimulatedMultiplayerPeer>(sides[p_side].peer.ptr()); }
+
+	void poll() {
+		for (uint32_t i = 0; i < sides.size(); i++) {
+			sides[i].api->poll();
+		}
+	}
+
+	ReplicationLoopback(int p_clients, int p_node_count, real_t p_quantization, bool p_simulated = false) {
+		SceneTree *tree = SceneTree::get_singleton();
+		Ref<SceneReplicationConfig> config;
+		config.instantiate();
+		config->add_property(NodePath(":position"));
+		config->add_property(NodePath(":quaternion"));
+		config->add_property(NodePath(":scale"));
+
+		sides.resize(p_clients + 1);
+		for (uint32_t i = 0; i < sides.size(); i++) {
+			Side &side = sides[i];
+			side.root = memnew(Node);
+			side.root->set_name(vformat("Peer%d", i + 1));
+			tree->get_root()->add_child(side.root);
+
+			side.api.instantiate();
+			tree->set_multiplayer(side.api, side.root->get_path());
+			if (p_simulated) {
+				Ref<SimulatedMultiplayerPeer> peer;
+				peer.instantiate();
+				if (i == 0) {
+					peer->create_server(true);
+				} else {
+					peer->create_client(Ref<SimulatedMultiplayerPeer>(get_simulated_peer(0)));
+				}
+				side.peer = peer;
+			} else {
+				side.peer = Ref<LoopbackMultiplayerPeer>(memnew(LoopbackMultiplayerPeer(i + 1)));
+			}
+			side.api->set_multiplayer_peer(side.peer);
+
+			for (int j = 0; j < p_node_count; j++) {
+				Node3D *node = memnew(Node3D);
+				node->set_name(vformat("Node%d", j));
+				MultiplayerSynchronizer *sync = memnew(MultiplayerSynchronizer);
+				sync->set_name("Sync");
+				sync->set_replication_config(config);
+				sync->set_sync_quantization(p_quantization);
+				sync->set_root_path(NodePath(".."));
+				node->add_child(sync);
+				side.root->add_child(node);
+				side.nodes.push_back(node);
+			}
+		}
+
+		if (p_simulated) {
+			return;
+		}
+		for (uint32_t i = 1; i < sides.size(); i++) {
+			get_peer(0)->link(get_peer(i));
+			sides[0].peer->emit_signal(SNAME("peer_connected"), i + 1);
+			sides[i].peer->emit_signal(SNAME("peer_connected"), 1);
+			sides[i].peer->emit_signal(SNAME("connection_succeeded"));
+		}
+	}
+
+	~ReplicationLoopback() {
+		SceneTree *tree = SceneTree::get_singleton();
+		for (uint32_t i = 0; i < sides.size(); i++) {
+			const NodePath path = sides[i].root->get_path();
+			memdelete(sides[i].root);
+			sides[i].api->set_multiplayer_peer(Ref<MultiplayerPeer>());
+			tree->set_multiplayer(Ref<MultiplayerAPI>(), path);
+		}
+	}
+};
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Delta synchronization") {
+	ReplicationLoopback loopback(1, 4, 0);
+	Vector<Node3D *> &server_nodes = loopback.get_nodes(0);
+	Vector<Node3D *> &client_nodes = loopback.get_nodes(1);
+
+	server_nodes[0]->set_position(Vector3(1, 2, 3));
+	server_nodes[1]->set_scale(Vector3(2, 2, 2));
+	for (int i = 0; i < 4; i++) {
+		loopback.poll();
+	}
+	CHECK(client_nodes[0]->get_position() == Vector3(1, 2, 3));
+	CHECK(client_nodes[1]->get_scale() == Vector3(2, 2, 2));
+
+	SUBCASE("Nothing is sent once the peer acknowledged the current state") {
+		LoopbackMultiplayerPeer *server_peer = loopback.get_peer(0);
+		const uint64_t bytes = server_peer->bytes_sent;
+		loopback.poll();
+		CHECK(server_peer->bytes_sent == bytes);
+	}
+
+	SUBCASE("Only changed properties are sent") {
+		LoopbackMultiplayerPeer *server_peer = loopback.get_peer(0);
+		const uint64_t bytes = server_peer->bytes_sent;
+		server_nodes[2]->set_position(Vector3(-4, 5, 6));
+		loopback.poll();
+		loopback.poll();
+		CHECK(client_nodes[2]->get_position() == Vector3(-4, 5, 6));
+		CHECK(client_nodes[1]->get_scale() == Vector3(2, 2, 2));
+
+		// Sync header, node ID, flags, baseline, size, dirty mask and the encoded Vector3.
+		int vector_size = 0;
+		MultiplayerAPI::encode_and_compress_variant(Vector3(), nullptr, vector_size, false);
+		CHECK(server_peer->bytes_sent - bytes == uint64_t(3 + 4 + 1 + 2 + 2 + 1 + vector_size));
+	}
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Delta synchronization across several packets") {
+	// The full states of all the nodes need several packets per tick.
+	const int node_count = 200;
+	ReplicationLoopback loopback(1, node_count, 0);
+	LoopbackMultiplayerPeer *server_peer = loopback.get_peer(0);
+	Vector<Node3D *> &server_nodes = loopback.get_nodes(0);
+	Vector<Node3D *> &client_nodes = loopback.get_nodes(1);
+
+	for (int i = 0; i < node_count; i++) {
+		server_nodes[i]->set_position(Vector3(i, 0, 0));
+	}
+	uint64_t bytes = server_peer->bytes_sent;
+	loopback.poll();
+	CHECK_MESSAGE(server_peer->bytes_sent - bytes > uint64_t(1350 * 2), "The first states should need several packets.");
+	for (int i = 0; i < 4; i++) {
+		loopback.poll();
+	}
+	for (int i = 0; i < node_count; i++) {
+		CHECK(client_nodes[i]->get_position() == Vector3(i, 0, 0));
+	}
+
+	// Every packet was acknowledged, so no state is sent again.
+	bytes = server_peer->bytes_sent;
+	loopback.poll();
+	CHECK(server_peer->bytes_sent == bytes);
+
+	// Every node has a baseline, so only the changed property is sent for each of them.
+	for (int i = 0; i < node_count; i++) {
+		server_nodes[i]->set_position(Vector3(i, 1, 0));
+	}
+	bytes = server_peer->bytes_sent;
+	loopback.poll();
+	loopback.poll();
+	for (int i = 0; i < node_count; i++) {
+		CHECK(client_nodes[i]->get_position() == Vector3(i, 1, 0));
+	}
+	int vector_size = 0;
+	MultiplayerAPI::encode_and_compress_variant(Vector3(), nullptr, vector_size, false);
+	// Node ID, flags, baseline, size, dirty mask and the encoded Vector3, after a 3 bytes header per packet.
+	const int delta_size = 4 + 1 + 2 + 2 + 1 + vector_size;
+	const int per_packet = (1350 - 3) / delta_size;
+	const int packets = (node_count + per_packet - 1) / per_packet;
+	CHECK(server_peer->bytes_sent - bytes == uint64_t(node_count * delta_size + packets * 3));
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Synchronization with packet loss") {
+	ReplicationLoopback loopback(1, 8, 0);
+	loopback.get_peer(0)->drop_unreliable_every = 2;
+	loopback.get_peer(1)->drop_unreliable_every = 3;
+	Vector<Node3D *> &server_nodes = loopback.get_nodes(0);
+	Vector<Node3D *> &client_nodes = loopback.get_nodes(1);
+
+	for (int tick = 0; tick < 20; tick++) {
+		for (int i = 0; i < server_nodes.size(); i++) {
+			if ((tick + i) % 3 == 0) {
+				server_nodes[i]->set_position(Vector3(tick, i, tick * i));
+			}
+		}
+		loopback.poll();
+	}
+	// Stop changing, and let the remaining states get through.
+	for (int tick = 0; tick < 20; tick++) {
+		loopback.poll();
+	}
+	for (int i = 0; i < server_nodes.size(); i++) {
+		CHECK(client_nodes[i]->get_position() == server_nodes[i]->get_position());
+	}
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Quantized synchronization") {
+	ReplicationLoopback loopback(1, 1, 0.01);
+	Node3D *server_node = loopback.get_nodes(0)[0];
+	Node3D *client_node = loopback.get_nodes(1)[0];
+
+	server_node->set_position(Vector3(1.2345, -100.001, 0.004));
+	server_node->set_quaternion(Quaternion(Vector3(1, 2, 3).normalized(), 0.75));
+	loopback.poll();
+	loopback.poll();
+
+	CHECK(client_node->get_position().is_equal_approx(Vector3(1.23, -100, 0)));
+	// Either sign represents the same rotation.
+	CHECK(Math::abs(client_node->get_quaternion().dot(server_node->get_quaternion())) > 0.9999);
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Relevancy radius") {
+	ReplicationLoopback loopback(1, 2, 0);
+	Vector<Node3D *> &server_nodes = loopback.get_nodes(0);
+	Vector<Node3D *> &client_nodes = loopback.get_nodes(1);
+	for (int i = 0; i < 2; i++) {
+		loopback.get_sync(0, i)->set_relevancy_radius(10);
+	}
+	loopback.get_api(0)->set_peer_interest_origin(2, Vector3());
+
+	server_nodes[0]->set_position(Vector3(1, 0, 0));
+	server_nodes[1]->set_position(Vector3(100, 0, 0));
+	for (int i = 0; i < 8; i++) {
+		loopback.poll();
+	}
+	CHECK(client_nodes[0]->get_position() == Vector3(1, 0, 0));
+	CHECK(client_nodes[1]->get_position() == Vector3());
+
+	SUBCASE("Moving the interest origin changes the relevant nodes") {
+		loopback.get_api(0)->set_peer_interest_origin(2, Vector3(95, 0, 0));
+		server_nodes[0]->set_position(Vector3(2, 0, 0));
+		for (int i = 0; i < 8; i++) {
+			loopback.poll();
+		}
+		CHECK(client_nodes[0]->get_position() == Vector3(1, 0, 0));
+		CHECK(client_nodes[1]->get_position() == Vector3(100, 0, 0));
+	}
+
+	SUBCASE("Peers without an interest origin receive every node") {
+		loopback.get_api(0)->clear_peer_interest_origin(2);
+		for (int i = 0; i < 8; i++) {
+			loopback.poll();
+		}
+		CHECK(client_nodes[1]->get_position() == Vector3(100, 0, 0));
+	}
+}
+
+class VisibilityFilter : public Object {
+public:
+	bool visible = false;
+	bool is_visible(int p_peer) { return visible; }
+};
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Visibility filters") {
+	ReplicationLoopback loopback(1, 2, 0);
+	Vector<Node3D *> &server_nodes = loopback.get_nodes(0);
+	Vector<Node3D *> &client_nodes = loopback.get_nodes(1);
+	VisibilityFilter filter;
+	MultiplayerSynchronizer *sync = loopback.get_sync(0, 0);
+	sync->add_visibility_filter(callable_mp(&filter, &VisibilityFilter::is_visible));
+	CHECK_FALSE(sync->is_visible_to(2));
+
+	server_nodes[0]->set_position(Vector3(1, 2, 3));
+	server_nodes[1]->set_position(Vector3(4, 5, 6));
+	for (int i = 0; i < 4; i++) {
+		loopback.poll();
+	}
+	CHECK(client_nodes[0]->get_position() == Vector3());
+	CHECK(client_nodes[1]->get_position() == Vector3(4, 5, 6));
+
+	filter.visible = true;
+	for (int i = 0; i < 4; i++) {
+		loopback.poll();
+	}
+	CHECK(client_nodes[0]->get_position() == Vector3(1, 2, 3));
+	sync->remove_visibility_filter(callable_mp(&filter, &VisibilityFilter::is_visible));
+}
+
+TEST_CASE("[SceneTree][SceneReplicationInterface] Bandwidth limit") {
+	const int node_count = 64;
+	ReplicationLoopback loopback(1, node_count, 0);
+	Vector<Node3D *> &server_nodes = loopback.get_nodes(0);
+	Vector<Node3D *> &client_nodes = loopback.get_nodes(1);
+	// Allows bursts of 2000 bytes, less than the full state of all nodes.
+	loopback.get_api(0)->set_replication_bandwidth_limit(20000);
+	loopback.get_sync(0, node_count - 1)->set_sync_priority(10);
+	for (int i = 0; i < node_count; i++) {
+		server_nodes[i]->set_position(Vector3(i + 1, 0, 0));
+	}
+
+	loopback.poll();
+	int synced = 0;
+	for (int i = 0; i < node_count; i++) {
+		synced += client_nodes[i]->get_position() == server_nodes[i]->get_position() ? 1 : 0;
+	}
+	CHECK(synced > 0);
+	CHECK(synced < node_count);
+	// The highest priority state is sent first.
+	CHECK(client_nodes[node_count - 1]->get_position() == server_nodes[node_count - 1]->get_position());
+
+	// The delayed states get through as the budget refills.
+	for (int i = 0; i < 20; i++) {
+		OS::get_singleton()->delay_usec(50000);
+		loopback.poll();
+	}
+	for (int i = 0; i < node_count; i++) {
+		CHECK(client_nodes[i]->get_position() == server_nodes[i]->get_position());
+	}
+}
+
+TEST_CASE("[SceneTree][SceneRPCInterface] Cached node resolution") {
+	ReplicationLoopback loopback(1, 0, 0);
+	Node3D *server_node = memnew(Node3D);
+	server_node->set_name("Target");
+	server_node->rpc_config("set_visible", Multiplayer::RPC_MODE_AUTHORITY);
+	loopback.get_root(0)->add_child(server_node);
+	Node3D *client_node = memnew(Node3D);
+	client_node->set_name("Target");
+	client_node->rpc_config("set_visible", Multiplayer::RPC_MODE_AUTHORITY);
+	loopback.get_root(1)->add_child(client_node);
+
+	// Sent with the full path, until the client confirms it cached the ID.
+	server_node->rpc("set_visible", false);
+	loopback.poll();
+	CHECK_FALSE(client_node->is_visible());
+
+	server_node->rpc("set_visible", true);
+	loopback.poll();
+	CHECK(client_node->is_visible());
+
+	// Now resolved from the cached ID.
+	server_node->rpc("set_visible", false);
+	loopback.poll();
+	CHECK_FALSE(client_node->is_visible());
+
+	SUBCASE("A node replaced at the cached path receives the calls") {
+		memdelete(client_node);
+		client_node = memnew(Node3D);
+		client_node->set_name("Target");
+		client_node->rpc_config("set_visible", Multiplayer::RPC_MODE_AUTHORITY);
+		loopback.get_root(1)->add_child(client_node);
+
+		server_node->rpc("set_visible", false);
+		loopback.poll();
+		CHECK_FALSE(client_node->is_visible());
+	}
+}
+
+// Test commands run before the test servers are set up.
+static void init_benchmark_servers() {
+	GLOBAL_DEF("memory/limits/multithreaded_server/rid_pool_prealloc", 60);
+	memnew(MessageQueue);
+
+	Error err = OK;
+	for (int i = 0; i < DisplayServer::get_create_function_count(); i++) {
+		if (String("headless") == DisplayServer::get_create_function_name(i)) {
+			DisplayServer::create(i, "", DisplayServer::WindowMode::WINDOW_MODE_MINIMIZED, DisplayServer::VSyncMode::VSYNC_ENABLED, 0, Vector2i(0, 0), err);
+			break;
+		}
+	}
+	CRASH_COND_MSG(!DisplayServer::get_singleton(), "The headless display server is required to run this benchmark.");
+
+	memnew(RenderingServerDefault());
+	RenderingServerDefault::get_singleton()->init();
+	RenderingServerDefault::get_singleton()->set_render_loop_enabled(false);
+	PhysicsServer3DManager::new_default_server()->init();
+	PhysicsServer2DManager::new_default_server()->init();
+	NavigationServer3DManager::new_default_server();
+	memnew(NavigationServer2D);
+	memnew(SceneTree);
+	SceneTree::get_singleton()->initialize();
+}
+
+static void finish_benchmark_servers() {
+	SceneTree::get_singleton()->finalize();
+	MessageQueue::get_singleton()->flush();
+	memdelete(SceneTree::get_singleton());
+	memdelete(NavigationServer2D::get_singleton_mut());
+	memdelete(NavigationServer3D::get_singleton_mut());
+	PhysicsServer3D::get_singleton()->finish();
+	memdelete(PhysicsServer3D::get_singleton());
+	PhysicsServer2D::get_singleton()->finish();
+	memdelete(PhysicsServer2D::get_singleton());
+	RenderingServer::get_singleton()->sync();
+	RenderingServer::get_singleton()->finish();
+	memdelete(RenderingServer::get_singleton());
+	memdelete(DisplayServer::get_singleton());
+	memdelete(MessageQueue::get_singleton());
+}
+
+// Measures the server egress per tick while a fraction of the replicated nodes move.
+// Run with `godot --test scene-replication-benchmark`.
+static void benchmark_scene_replication() {
+	init_benchmark_servers();
+
+	const int clients = 8;
+	const int node_count = 2000;
+	const int ticks = 60;
+	const float moving_ratios[3] = { 0.0, 0.1, 1.0 };
+	const real_t quantizations[2] = { 0, 0.001 };
+
+	print_line(vformat("Scene replication benchmark: %d nodes synchronized to %d clients, %d ticks per case.", node_count, clients, ticks));
+
+	for (int q = 0; q < 2; q++) {
+		for (int m = 0; m < 3; m++) {
+			ReplicationLoopback loopback(clients, node_count, quantizations[q]);
+			Vector<Node3D *> &nodes = loopback.get_nodes(0);
+			const int moving = int(node_count * moving_ratios[m]);
+
+			// Warm up, so that path caches are confirmed and baselines acknowledged.
+			for (int i = 0; i < 4; i++) {
+				loopback.poll();
+			}
+
+			// What sending the full state of every node each tick would cost.
+			uint64_t full_bytes = 0;
+			for (int i = 0; i < node_count; i++) {
+				const Vector<Variant> state = varray(nodes[i]->get_position(), nodes[i]->get_quaternion(), nodes[i]->get_scale());
+				int size = 0;
+				for (int j = 0; j < state.size(); j++) {
+					int value_size = 0;
+					MultiplayerAPI::encode_and_compress_variant(state[j], nullptr, value_size, false);
+					size += value_size;
+				}
+				full_bytes += 4 + 4 + size;
+			}
+			full_bytes *= clients;
+
+			LoopbackMultiplayerPeer *server_peer = loopback.get_peer(0);
+			const uint64_t begin_bytes = server_peer->bytes_sent;
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int tick = 0; tick < ticks; tick++) {
+				for (int i = 0; i < moving; i++) {
+					Node3D *node = nodes[(i + tick * moving) % node_count];
+					node->set_position(node->get_position() + Vector3(0.01, 0, 0.02));
+					node->rotate_y(0.01);
+				}
+				loopback.poll();
+			}
+			const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+			const uint64_t bytes = (server_peer->bytes_sent - begin_bytes) / ticks;
+
+			print_line(vformat("    %d%% moving, quantization %.3f: %d bytes per tick (full state: %d), %.2f msec per tick", int(moving_ratios[m] * 100), quantizations[q], bytes, full_bytes, double(usec) / ticks / 1000.0));
+		}
+	}
+
+	finish_benchmark_servers();
+}
+
+REGISTER_TEST_COMMAND("scene-replication-benchmark", &benchmark_scene_replication);
+
+// Measures how many RPCs per second the server can broadcast, and the clients process.
+// Run with `godot --test multiplayer-rpc-benchmark`.
+static void benchmark_multiplayer_rpc() {
+	init_benchmark_servers();
+
+	const int clients = 8;
+	const int node_count = 1000;
+	const int rounds = 100;
+
+	print_line(vformat("Multiplayer RPC benchmark: %d nodes, one broadcast RPC per node to %d clients, %d rounds.", node_count, clients, rounds));
+	{
+		ReplicationLoopback loopback(clients, 0, 0);
+		Vector<Node *> server_nodes;
+		for (int side = 0; side <= clients; side++) {
+			for (int i = 0; i < node_count; i++) {
+				Node3D *node = memnew(Node3D);
+				node->set_name(vformat("Target%d", i));
+				node->rpc_config("set_visible", Multiplayer::RPC_MODE_AUTHORITY, false, Multiplayer::TRANSFER_MODE_UNRELIABLE);
+				loopback.get_root(side)->add_child(node);
+				if (side == 0) {
+					server_nodes.push_back(node);
+				}
+			}
+		}
+
+		// Warm up, so that every path is cached by the clients.
+		for (int i = 0; i < node_count; i++) {
+			server_nodes[i]->rpc("set_visible", true);
+		}
+		loopback.poll();
+		loopback.poll();
+
+		uint64_t send_usec = 0;
+		uint64_t process_usec = 0;
+		for (int round = 0; round < rounds; round++) {
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < node_count; i++) {
+				server_nodes[i]->rpc("set_visible", bool(round % 2));
+			}
+			send_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			begin = OS::get_singleton()->get_ticks_usec();
+			loopback.poll();
+			process_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		}
+		const double sent = double(node_count) * rounds;
+		print_line(vformat("    send: %.0f RPCs/s, receive: %.0f RPCs/s (all clients)", sent * 1000000.0 / MAX(send_usec, uint64_t(1)), sent * clients * 1000000.0 / MAX(process_usec, uint64_t(1))));
+	}
+
+	finish_benchmark_servers();
+}
+
+REGISTER_TEST_COMMAND("multiplayer-rpc-benchmark", &benchmark_multiplayer_rpc);
+
+// Measures the traffic and the processing cost per tick of replication and RPCs, at 60 ticks per
+// second on simulated networks. Then replays what a client received, to measure its processing alone.
+// Run with `godot --test multiplayer-simulation-benchmark`.
+static void benchmark_multiplayer_simulation() {
+	init_benchmark_servers();
+
+	const int clients = 8;
+	const int node_count = 500;
+	const int ticks = 300;
+	const int moving = node_count / 10;
+	const double tick_time = 1.0 / 60.0;
+
+	struct NetworkConditions {
+		const char *name;
+		double latency;
+		double jitter;
+		double packet_loss;
+		int bandwidth_limit;
+	};
+	const NetworkConditions conditions[3] = {
+		{ "LAN", 0.001, 0, 0, 0 },
+		{ "Broadband", 0.03, 0.005, 0.01, 0 },
+		{ "Mobile", 0.1, 0.03, 0.05, 256 * 1024 },
+	};
+
+	print_line(vformat("Multiplayer simulation benchmark: %d nodes synchronized to %d clients, %d moving, an RPC per moving node, %d ticks.", node_count, clients, moving, ticks));
+
+	for (int c = 0; c < 3; c++) {
+		const NetworkConditions &network = conditions[c];
+		Vector<uint8_t> recording;
+		{
+			ReplicationLoopback loopback(clients, node_count, 0, true);
+			for (int side = 0; side <= clients; side++) {
+				SimulatedMultiplayerPeer *peer = loopback.get_simulated_peer(side);
+				peer->set_latency(network.latency);
+				peer->set_jitter(network.jitter);
+				peer->set_packet_loss(network.packet_loss);
+				peer->set_bandwidth_limit(network.bandwidth_limit);
+				peer->set_seed(side);
+				for (int i = 0; i < node_count; i++) {
+					loopback.get_nodes(side)[i]->rpc_config("set_visible", Multiplayer::RPC_MODE_AUTHORITY, false, Multiplayer::TRANSFER_MODE_UNRELIABLE_ORDERED);
+				}
+			}
+			SimulatedMultiplayerPeer *server_peer = loopback.get_simulated_peer(0);
+			// Everything from the connection on, so that the replay knows the cached paths.
+			loopback.get_simulated_peer(1)->start_recording();
+			Vector<Node3D *> &nodes = loopback.get_nodes(0);
+
+			uint64_t server_usec = 0;
+			uint64_t client_usec = 0;
+			for (int tick = 0; tick < ticks; tick++) {
+				for (int i = 0; i < moving; i++) {
+					Node3D *node = nodes[(i + tick * moving) % node_count];
+					node->set_position(node->get_position() + Vector3(0.01, 0, 0.02));
+					node->rpc("set_visible", bool(tick % 2));
+				}
+				server_peer->advance_time(tick_time);
+				uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				loopback.get_api(0)->poll();
+				server_usec += OS::get_singleton()->get_ticks_usec() - begin;
+				begin = OS::get_singleton()->get_ticks_usec();
+				for (int side = 1; side <= clients; side++) {
+					loopback.get_api(side)->poll();
+				}
+				client_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			}
+			recording = loopback.get_simulated_peer(1)->get_recording();
+
+			const Dictionary stats = server_peer->get_statistics();
+			print_line(vformat("    %s: server sent %d bytes per tick, lost %d packets, %.3f msec per tick. Clients: %.3f msec per tick each.",
+					network.name, uint64_t(stats["bytes_sent"]) / ticks, stats["packets_lost"], double(server_usec) / ticks / 1000.0, double(client_usec) / ticks / clients / 1000.0));
+		}
+
+		{
+			ReplicationLoopback loopback(1, node_count, 0, true);
+			for (int i = 0; i < node_count; i++) {
+				loopback.get_nodes(1)[i]->rpc_config("set_visible", Multiplayer::RPC_MODE_AUTHORITY, false, Multiplayer::TRANSFER_MODE_UNRELIABLE_ORDERED);
+			}
+			Ref<SimulatedMultiplayerPeer> replay;
+			replay.instantiate();
+			ERR_FAIL_COND(replay->create_replay(recording, true) != OK);
+			loopback.get_api(1)->set_multiplayer_peer(replay);
+
+			int replay_ticks = 0;
+			uint64_t usec = 0;
+			while (!replay->is_replay_finished() && replay_ticks < ticks * 2) {
+				replay->advance_time(tick_time);
+				const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				loopback.get_api(1)->poll();
+				usec += OS::get_singleton()->get_ticks_usec() - begin;
+				replay_ticks++;
+			}
+			print_line(vformat("        Replay of a client: %d bytes, %.3f msec per tick.", recording.size(), double(usec) / MAX(replay_ticks, 1) / 1000.0));
+		}
+	}
+
+	finish_benchmark_servers();
+}
+
+REGISTER_TEST_COMMAND("multiplayer-simulation-benchmark", &benchmark_multiplayer_simulation);
+
+} // namespace TestSceneReplication
+
+#endif // TEST_SCENE_REPLICATION_H
@@ -0,0 +1,240 @@
+/*************************************************************************/
+/*  test_physics_space_history.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_PHYSICS_SPACE_HISTORY_H
+#define TEST_PHYSICS_SPACE_HISTORY_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/physics_server_3d.h"
+#include "tests/test_macros.h"
+
+namespace TestPhysicsSpaceHistory {
+
+static RID create_body(RID p_space, RID p_shape, PhysicsServer3D::BodyMode p_mode, const Vector3 &p_position) {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID body = ps->body_create();
+	ps->body_set_mode(body, p_mode);
+	ps->body_add_shape(body, p_shape);
+	ps->body_set_space(body, p_space);
+	ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), p_position));
+	return body;
+}
+
+// Casts a vertical ray through the given x position, returns whether it hit p_body, or anything if p_body is invalid.
+static bool ray_hits(RID p_space, real_t p_x, int p_rewind_ticks, RID p_body) {
+	PhysicsDirectSpaceState3D::RayParameters parameters;
+	parameters.from = Vector3(p_x, -10, 0);
+	parameters.to = Vector3(p_x, 10, 0);
+	parameters.rewind_ticks = p_rewind_ticks;
+	PhysicsDirectSpaceState3D::RayResult result;
+	return PhysicsServer3D::get_singleton()->space_get_direct_state(p_space)->intersect_ray(parameters, result) && (!p_body.is_valid() || result.rid == p_body);
+}
+
+TEST_CASE("[SceneTree][PhysicsServer3D] Queries in past steps") {
+	PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	ps->space_set_param(space, PhysicsServer3D::SPACE_PARAM_HISTORY_TICKS, 3);
+	CHECK(ps->space_get_param(space, PhysicsServer3D::SPACE_PARAM_HISTORY_TICKS) == 3);
+
+	RID sphere = ps->sphere_shape_create();
+	ps->shape_set_data(sphere, 0.25);
+	RID body = create_body(space, sphere, PhysicsServer3D::BODY_MODE_KINEMATIC, Vector3());
+	RID wall = create_body(space, sphere, PhysicsServer3D::BODY_MODE_STATIC, Vector3(100, 0, 0));
+
+	// Kinematic bodies move during the step, so the body is at x = 5 and was at x = 5 - n, n steps ago.
+	for (int i = 1; i <= 5; i++) {
+		ps->body_set_state(body, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(i, 0, 0)));
+		ps->step(1.0 / 60.0);
+	}
+
+	SUBCASE("Rays") {
+		CHECK(ray_hits(space, 5, 0, body));
+		CHECK_FALSE(ray_hits(space, 4, 0, body));
+		CHECK(ray_hits(space, 4, 1, body));
+		CHECK_FALSE(ray_hits(space, 5, 1, body));
+		CHECK(ray_hits(space, 3, 2, body));
+		CHECK(ray_hits(space, 2, 3, body));
+		// Further back than recorded uses the oldest step.
+		CHECK(ray_hits(space, 2, 10, body));
+		// Static bodies are not recorded, and found in every step.
+		CHECK(ray_hits(space, 100, 0, wall));
+		CHECK(ray_hits(space, 100, 2, wall));
+	}
+
+	SUBCASE("Shapes") {
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = sphere;
+		parameters.transform = Transform3D(Basis(), Vector3(3.3, 0, 0));
+		PhysicsDirectSpaceState3D::ShapeResult results[4];
+		PhysicsDirectSpaceState3D *state = ps->space_get_direct_state(space);
+
+		CHECK(state->intersect_shape(parameters, results, 4) == 0);
+		parameters.rewind_ticks = 2;
+		CHECK(state->intersect_shape(parameters, results, 4) == 1);
+		CHECK(results[0].rid == body);
+		parameters.rewind_ticks = 1;
+		CHECK(state->intersect_shape(parameters, results, 4) == 0);
+
+		PhysicsDirectSpaceState3D::ShapeRestInfo info;
+		parameters.rewind_ticks = 2;
+		CHECK(state->rest_info(parameters, &info));
+		CHECK(info.rid == body);
+	}
+
+	SUBCASE("Removed bodies") {
+		CHECK(ps->get_process_info(PhysicsServer3D::INFO_HISTORY_MEMORY) > 0);
+		ps->free(body);
+		body = RID();
+		CHECK_FALSE(ray_hits(space, 4, 1, RID()));
+		CHECK_FALSE(ray_hits(space, 2, 3, RID()));
+	}
+
+	SUBCASE("Bodies made static") {
+		ps->body_set_mode(body, PhysicsServer3D::BODY_MODE_STATIC);
+		// Static bodies are found in their current state only, not in the snapshots recorded before.
+		CHECK_FALSE(ray_hits(space, 4, 1, RID()));
+		CHECK(ray_hits(space, 5, 1, body));
+
+		RID large_sphere = ps->sphere_shape_create();
+		ps->shape_set_data(large_sphere, 1.0);
+		PhysicsDirectSpaceState3D::ShapeParameters parameters;
+		parameters.shape_rid = large_sphere;
+		parameters.transform = Transform3D(Basis(), Vector3(4.5, 0, 0));
+		parameters.rewind_ticks = 1;
+		PhysicsDirectSpaceState3D::ShapeResult results[4];
+		CHECK_MESSAGE(ps->space_get_direct_state(space)->intersect_shape(parameters, results, 4) == 1, "The body should not also be found where it was before.");
+		CHECK(results[0].rid == body);
+		ps->free(large_sphere);
+	}
+
+	SUBCASE("Disabled history") {
+		ps->space_set_param(space, PhysicsServer3D::SPACE_PARAM_HISTORY_TICKS, 0);
+		ps->step(1.0 / 60.0);
+		CHECK(ps->get_process_info(PhysicsServer3D::INFO_HISTORY_MEMORY) == 0);
+		ERR_PRINT_OFF;
+		CHECK_FALSE(ray_hits(space, 4, 1, body));
+		ERR_PRINT_ON;
+		CHECK(ray_hits(space, 5, 0, body));
+	}
+
+	if (body.is_valid()) {
+		ps->free(body);
+	}
+	ps->free(wall);
+	ps->free(sphere);
+	ps->free(space);
+}
+
+// Measures what recording the history costs per step, its memory, and queries in the past against queries in the present.
+// Run with `godot --test physics-space-history-benchmark`.
+static void benchmark_physics_space_history() {
+	PhysicsServer3D *ps = PhysicsServer3DManager::new_default_server();
+	ps->init();
+
+	const int moving_count = 1000;
+	const int static_count = 1000;
+	const int history_ticks = 64;
+	const int steps = 120;
+	const int rays = 10000;
+
+	RID space = ps->space_create();
+	ps->space_set_active(space, true);
+	RID capsule = ps->capsule_shape_create();
+	Dictionary capsule_data;
+	capsule_data["radius"] = 0.4;
+	capsule_data["height"] = 1.8;
+	ps->shape_set_data(capsule, capsule_data);
+	RID box = ps->box_shape_create();
+	ps->shape_set_data(box, Vector3(2, 2, 2));
+
+	RandomPCG rng(2022);
+	LocalVector<RID> bodies;
+	LocalVector<Vector3> positions;
+	for (int i = 0; i < static_count; i++) {
+		bodies.push_back(create_body(space, box, PhysicsServer3D::BODY_MODE_STATIC, Vector3(rng.random(-200.0, 200.0), 0, rng.random(-200.0, 200.0))));
+	}
+	for (int i = 0; i < moving_count; i++) {
+		const Vector3 position(rng.random(-200.0, 200.0), 0, rng.random(-200.0, 200.0));
+		bodies.push_back(create_body(space, capsule, PhysicsServer3D::BODY_MODE_KINEMATIC, position));
+		positions.push_back(position);
+	}
+
+	print_line(vformat("Physics space history benchmark: %d moving bodies, %d static bodies, %d steps.", moving_count, static_count, steps));
+
+	for (int pass = 0; pass < 2; pass++) {
+		ps->space_set_param(space, PhysicsServer3D::SPACE_PARAM_HISTORY_TICKS, pass == 0 ? 0 : history_ticks);
+		uint64_t usec = 0;
+		for (int step = 0; step < steps; step++) {
+			for (int i = 0; i < moving_count; i++) {
+				positions[i] += Vector3(0.05, 0, 0.05);
+				ps->body_set_state(bodies[static_count + i], PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), positions[i]));
+			}
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			ps->step(1.0 / 60.0);
+			usec += OS::get_singleton()->get_ticks_usec() - begin;
+		}
+		print_line(vformat("    History of %d steps: %.3f msec per step, %d KiB recorded.", pass == 0 ? 0 : history_ticks, double(usec) / steps / 1000.0, ps->get_process_info(PhysicsServer3D::INFO_HISTORY_MEMORY) / 1024));
+	}
+
+	PhysicsDirectSpaceState3D *state = ps->space_get_direct_state(space);
+	const int rewinds[3] = { 0, 1, history_ticks / 2 };
+	for (int r = 0; r < 3; r++) {
+		PhysicsDirectSpaceState3D::RayParameters parameters;
+		parameters.rewind_ticks = rewinds[r];
+		PhysicsDirectSpaceState3D::RayResult result;
+		int hits = 0;
+		rng.seed(2022);
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < rays; i++) {
+			parameters.from = Vector3(rng.random(-200.0, 200.0), 1, rng.random(-200.0, 200.0));
+			parameters.to = parameters.from + Vector3(rng.random(-50.0, 50.0), 0, rng.random(-50.0, 50.0));
+			hits += state->intersect_ray(parameters, result);
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+		print_line(vformat("    %d rays %d steps back: %.3f usec per ray, %d hits.", rays, rewinds[r], double(usec) / rays, hits));
+	}
+
+	for (uint32_t i = 0; i < bodies.size(); i++) {
+		ps->free(bodies[i]);
+	}
+	ps->free(capsule);
+	ps->free(box);
+	ps->free(space);
+	ps->finish();
+	memdelete(ps);
+}
+
+REGISTER_TEST_COMMAND("physics-space-history-benchmark", &benchmark_physics_space_history);
+
+} // namespace TestPhysicsSpaceHistory
+
+#endif // TEST_PHYSICS_SPACE_HISTORY_H
@@ -0,0 +1,202 @@
+/*************************************************************************/
+/*  test_raster_occlusion_cull.h                                         */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "core/templates/thread_work_pool.h"
+#include "servers/rendering/raster_occlusion_cull.h"
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Creates an occluder mesh for the given box, using the same vertex order as AABB::get_endpoint().
+static RID create_box_occluder(RendererSceneOcclusionCull *p_cull, const AABB &p_box) {
+	static const int32_t box_indices[36] = {
+		0, 1, 3, 0, 3, 2, // -X
+		4, 6, 7, 4, 7, 5, // +X
+		0, 4, 5, 0, 5, 1, // -Y
+		2, 3, 7, 2, 7, 6, // +Y
+		0, 2, 6, 0, 6, 4, // -Z
+		1, 5, 7, 1, 7, 3, // +Z
+	};
+
+	PackedVector3Array vertices;
+	for (int i = 0; i < 8; i++) {
+		vertices.push_back(p_box.get_endpoint(i));
+	}
+
+	PackedInt32Array indices;
+	for (int i = 0; i < 36; i++) {
+		indices.push_back(box_indices[i]);
+	}
+
+	RID occluder = p_cull->occluder_allocate();
+	p_cull->occluder_initialize(occluder);
+	p_cull->occluder_set_mesh(occluder, vertices, indices);
+	return occluder;
+}
+
+static bool is_box_occluded(RendererSceneOcclusionCull *p_cull, RID p_buffer, const AABB &p_box, const Transform3D &p_cam_transform, const CameraMatrix &p_cam_projection) {
+	const RendererSceneOcclusionCull::HZBuffer *buffer = p_cull->buffer_get_ptr(p_buffer);
+	const real_t bounds[6] = {
+		p_box.position.x, p_box.position.y, p_box.position.z,
+		p_box.position.x + p_box.size.x, p_box.position.y + p_box.size.y, p_box.position.z + p_box.size.z
+	};
+	return buffer->is_occluded(bounds, p_cam_transform.origin, p_cam_transform.affine_inverse(), p_cam_projection, p_cam_projection.get_z_near());
+}
+
+static float get_center_depth(RendererSceneOcclusionCull *p_cull, RID p_buffer) {
+	const RendererSceneOcclusionCull::HZBuffer *buffer = p_cull->buffer_get_ptr(p_buffer);
+	const Size2i size = buffer->get_size();
+	return buffer->get_depth()[(size.y / 2) * size.x + size.x / 2];
+}
+
+TEST_CASE("[RasterOcclusionCull] Occluders hide boxes behind them") {
+	ThreadWorkPool thread_pool;
+	thread_pool.init(4);
+
+	RasterOcclusionCull *cull = memnew(RasterOcclusionCull);
+	const RID scenario = RID::from_uint64(1);
+	const RID buffer = RID::from_uint64(2);
+	const RID instance = RID::from_uint64(3);
+
+	cull->add_scenario(scenario);
+	cull->add_buffer(buffer);
+	cull->buffer_set_scenario(buffer, scenario);
+	cull->buffer_set_size(buffer, Size2i(64, 64));
+
+	// A 10x10 wall facing the camera, 10 units away.
+	RID wall = create_box_occluder(cull, AABB(Vector3(-5, -5, -11), Vector3(10, 10, 1)));
+	cull->scenario_set_instance(scenario, instance, wall, Transform3D(), true);
+
+	const Transform3D cam_transform;
+	CameraMatrix cam_projection;
+	cam_projection.set_perspective(90, 1, 0.1, 100);
+
+	const AABB behind(Vector3(-1, -1, -21), Vector3(2, 2, 2));
+	const AABB peeking(Vector3(8, -1, -21), Vector3(4, 2, 2));
+	const AABB in_front(Vector3(-1, -1, -6), Vector3(2, 2, 2));
+
+	cull->buffer_update(buffer, cam_transform, cam_projection, false, thread_pool);
+
+	CHECK_MESSAGE(get_center_depth(cull, buffer) == doctest::Approx(10.0),
+			"The depth buffer should contain the view depth of the wall.");
+	CHECK_MESSAGE(is_box_occluded(cull, buffer, behind, cam_transform, cam_projection),
+			"A box fully behind the wall should be occluded.");
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, peeking, cam_transform, cam_projection),
+			"A box partially visible around the wall should not be occluded.");
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, in_front, cam_transform, cam_projection),
+			"A box in front of the wall should not be occluded.");
+
+	// Moving the instance must update its transformed vertices.
+	cull->scenario_set_instance(scenario, instance, wall, Transform3D(Basis(), Vector3(20, 0, 0)), true);
+	cull->buffer_update(buffer, cam_transform, cam_projection, false, thread_pool);
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, behind, cam_transform, cam_projection),
+			"A box should not be occluded once the wall has moved away.");
+
+	cull->scenario_set_instance(scenario, instance, wall, Transform3D(), false);
+	cull->buffer_update(buffer, cam_transform, cam_projection, false, thread_pool);
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, behind, cam_transform, cam_projection),
+			"Disabled occluders should not occlude anything.");
+
+	cull->scenario_set_instance(scenario, instance, wall, Transform3D(), true);
+	cull->buffer_update(buffer, cam_transform, cam_projection, false, thread_pool);
+	CHECK(is_box_occluded(cull, buffer, behind, cam_transform, cam_projection));
+
+	cull->scenario_remove_instance(scenario, instance);
+	cull->buffer_update(buffer, cam_transform, cam_projection, false, thread_pool);
+	CHECK_MESSAGE(!is_box_occluded(cull, buffer, behind, cam_transform, cam_projection),
+			"Removed occluders should not occlude anything.");
+
+	cull->free_occluder(wall);
+	cull->remove_buffer(buffer);
+	cull->remove_scenario(scenario);
+	memdelete(cull);
+	thread_pool.finish();
+}
+
+TEST_CASE("[RasterOcclusionCull] Clipping and orthogonal projection") {
+	ThreadWorkPool thread_pool;
+	thread_pool.init(4);
+
+	RasterOcclusionCull *cull = memnew(RasterOcclusionCull);
+	const RID scenario = RID::from_uint64(1);
+	const RID buffer = RID::from_uint64(2);
+
+	cull->add_scenario(scenario);
+	cull->add_buffer(buffer);
+	cull->buffer_set_scenario(buffer, scenario);
+	cull->buffer_set_size(buffer, Size2i(96, 64));
+
+	const Transform3D cam_transform;
+	CameraMatrix cam_projection;
+	cam_projection.set_perspective(70, 1.5, 0.1, 200);
+
+	SUBCASE("Occluders crossing the near plane") {
+		// A long wall to the right of the camera that extends behind it.
+		RID wall = create_box_occluder(cull, AABB(Vector3(2, -50, -100), Vector3(1, 100, 150)));
+		cull->scenario_set_instance(scenario, RID::from_uint64(3), wall, Transform3D(), true);
+		cull->buffer_update(buffer, cam_transform, cam_projection, false, thread_pool);
+
+		CHECK_MESSAGE(is_box_occluded(cull, buffer, AABB(Vector3(10, -1, -12), Vector3(1, 2, 1)), cam_transform, cam_projection),
+				"A box behind a wall that is clipped by the near plane should be occluded.");
+		CHECK_MESSAGE(!is_box_occluded(cull, buffer, AABB(Vector3(0.5, -1, -6), Vector3(0.5, 2, 1)), cam_transform, cam_projection),
+				"A box on the near side of the wall should not be occluded.");
+
+		cull->scenario_remove_instance(scenario, RID::from_uint64(3));
+		cull->free_occluder(wall);
+	}
+
+	SUBCASE("Orthogonal projection") {
+		cam_projection.set_orthogonal(20, 1.5, 0.1, 200);
+
+		RID wall = create_box_occluder(cull, AABB(Vector3(-5, -5, -11), Vector3(10, 10, 1)));
+		cull->scenario_set_instance(scenario, RID::from_uint64(3), wall, Transform3D(), true);
+		cull->buffer_update(buffer, cam_transform, cam_projection, true, thread_pool);
+
+		CHECK_MESSAGE(get_center_depth(cull, buffer) == doctest::Approx(10.0),
+				"The depth buffer should contain the view depth of the wall.");
+		CHECK(is_box_occluded(cull, buffer, AABB(Vector3(-1, -1, -30), Vector3(2, 2, 2)), cam_transform, cam_projection));
+		CHECK(!is_box_occluded(cull, buffer, AABB(Vector3(6, -1, -30), Vector3(2, 2, 2)), cam_transform, cam_projection));
+
+		cull->scenario_remove_instance(scenario, RID::from_uint64(3));
+		cull->free_occluder(wall);
+	}
+
+	cull->remove_buffer(buffer);
+	cull->remove_scenario(scenario);
+	memdelete(cull);
+	thread_pool.finish();
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,226 @@
+/*************************************************************************/
+/*  test_render_list_sort_cache.h                                        */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RENDER_LIST_SORT_CACHE_H
+#define TEST_RENDER_LIST_SORT_CACHE_H
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_rd/render_list_sort_cache.h"
+#include "tests/test_macros.h"
+
+namespace TestRenderListSortCache {
+
+// Mirrors the fields the forward renderers' surface caches expose to the sort cache.
+struct TestElement {
+	struct {
+		uint64_t sort_key1 = 0;
+		uint64_t sort_key2 = 0;
+	} sort;
+	uint64_t sort_cache_pass = 0;
+};
+
+struct TestSortByKey {
+	_FORCE_INLINE_ bool operator()(const TestElement *A, const TestElement *B) const {
+		return (A->sort.sort_key2 == B->sort.sort_key2) ? (A->sort.sort_key1 < B->sort.sort_key1) : (A->sort.sort_key2 < B->sort.sort_key2);
+	}
+};
+
+static bool is_sorted(const LocalVector<TestElement *> &p_list) {
+	TestSortByKey compare;
+	for (uint32_t i = 1; i < p_list.size(); i++) {
+		if (compare(p_list[i], p_list[i - 1])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool contains_all(const LocalVector<TestElement *> &p_list, const LocalVector<TestElement *> &p_expected) {
+	if (p_list.size() != p_expected.size()) {
+		return false;
+	}
+	for (uint32_t i = 0; i < p_expected.size(); i++) {
+		if (p_list.find(p_expected[i]) == -1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static void fill_elements(LocalVector<TestElement> &r_elements, RandomPCG &p_rng) {
+	for (uint32_t i = 0; i < r_elements.size(); i++) {
+		r_elements[i].sort.sort_key1 = p_rng.rand() % 64;
+		r_elements[i].sort.sort_key2 = p_rng.rand() % 16;
+	}
+}
+
+TEST_CASE("[RenderListSortCache] Sorted output matches a full sort") {
+	RandomPCG rng(1234);
+	LocalVector<TestElement> elements;
+	elements.resize(200);
+	fill_elements(elements, rng);
+
+	LocalVector<TestElement *> fill_order;
+	for (uint32_t i = 0; i < elements.size(); i++) {
+		fill_order.push_back(&elements[i]);
+	}
+
+	RenderListSortCache<TestElement> cache;
+	LocalVector<TestElement *> list = fill_order;
+	cache.sort(list.ptr(), list.size(), 0);
+	CHECK(is_sorted(list));
+	CHECK(contains_all(list, fill_order));
+	CHECK(cache.get_sorted_count() == 200);
+	CHECK(cache.get_reused_count() == 0);
+
+	SUBCASE("Unchanged list is reused entirely") {
+		list = fill_order;
+		cache.sort(list.ptr(), list.size(), 0);
+		CHECK(is_sorted(list));
+		CHECK(contains_all(list, fill_order));
+		CHECK(cache.get_sorted_count() == 0);
+		CHECK(cache.get_reused_count() == 200);
+	}
+
+	SUBCASE("Changed keys are merged back in") {
+		for (uint32_t i = 0; i < 10; i++) {
+			elements[i * 7].sort.sort_key1 = rng.rand() % 64;
+			elements[i * 7].sort.sort_key2 = rng.rand() % 16;
+		}
+		list = fill_order;
+		cache.sort(list.ptr(), list.size(), 0);
+		CHECK(is_sorted(list));
+		CHECK(contains_all(list, fill_order));
+		CHECK(cache.get_reused_count() + cache.get_sorted_count() == 200);
+		CHECK(cache.get_sorted_count() <= 10);
+	}
+
+	SUBCASE("Removed and added elements are handled") {
+		LocalVector<TestElement> extra;
+		extra.resize(5);
+		fill_elements(extra, rng);
+
+		LocalVector<TestElement *> expected;
+		for (uint32_t i = 0; i < fill_order.size(); i++) {
+			if (i % 20 != 0) {
+				expected.push_back(fill_order[i]);
+			}
+		}
+		for (uint32_t i = 0; i < extra.size(); i++) {
+			expected.push_back(&extra[i]);
+		}
+
+		list = expected;
+		cache.sort(list.ptr(), list.size(), 0);
+		CHECK(is_sorted(list));
+		CHECK(contains_all(list, expected));
+		CHECK(cache.get_sorted_count() == 5);
+		CHECK(cache.get_reused_count() == 190);
+	}
+
+	SUBCASE("Epoch change forces a full sort") {
+		list = fill_order;
+		cache.sort(list.ptr(), list.size(), 1);
+		CHECK(is_sorted(list));
+		CHECK(cache.get_sorted_count() == 200);
+		CHECK(cache.get_reused_count() == 0);
+	}
+
+	SUBCASE("Mostly changed list falls back to a full sort") {
+		fill_elements(elements, rng);
+		list = fill_order;
+		cache.sort(list.ptr(), list.size(), 0);
+		CHECK(is_sorted(list));
+		CHECK(contains_all(list, fill_order));
+		CHECK(cache.get_reused_count() + cache.get_sorted_count() == 200);
+	}
+}
+
+// Measures the CPU cost of sorting the opaque render list without any GPU, using synthetic
+// surfaces where a small fraction changes sort keys every frame (e.g. LOD or depth layer changes).
+// Run with `godot --test render-list-sort-benchmark`.
+static void benchmark_render_list_sort() {
+	const uint32_t element_count = 50000;
+	const uint32_t dynamic_count = element_count / 50;
+	const int frames = 200;
+
+	print_line(vformat("Render list sort benchmark: %d surfaces, %d changing per frame, %d frames.", element_count, dynamic_count, frames));
+
+	LocalVector<TestElement> elements;
+	elements.resize(element_count);
+
+	for (int pass = 0; pass < 2; pass++) {
+		const bool use_cache = pass == 1;
+
+		RandomPCG rng(4321);
+		for (uint32_t i = 0; i < element_count; i++) {
+			elements[i].sort.sort_key1 = rng.rand();
+			elements[i].sort.sort_key2 = rng.rand() % 256;
+			elements[i].sort_cache_pass = 0;
+		}
+
+		RenderListSortCache<TestElement> cache;
+		LocalVector<TestElement *> list;
+		list.resize(element_count);
+		uint64_t reused = 0;
+		uint64_t fill_usec = 0;
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < frames; i++) {
+			const uint64_t fill_begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t j = 0; j < dynamic_count; j++) {
+				elements[rng.rand() % element_count].sort.sort_key1 = rng.rand();
+			}
+			for (uint32_t j = 0; j < element_count; j++) {
+				list[j] = &elements[j];
+			}
+			fill_usec += OS::get_singleton()->get_ticks_usec() - fill_begin;
+
+			if (use_cache) {
+				cache.sort(list.ptr(), list.size(), 0);
+				reused += cache.get_reused_count();
+			} else {
+				SortArray<TestElement *, TestSortByKey> sorter;
+				sorter.sort(list.ptr(), list.size());
+			}
+		}
+		const uint64_t sort_usec = OS::get_singleton()->get_ticks_usec() - begin - fill_usec;
+
+		ERR_FAIL_COND(!is_sorted(list));
+		print_line(vformat("    %s: list build %.3f msec, sort %.3f msec per frame, %.1f%% of surfaces reused", use_cache ? "cached sort" : "full sort", double(fill_usec) / frames / 1000.0, double(sort_usec) / frames / 1000.0, use_cache ? 100.0 * double(reused) / (double(element_count) * frames) : 0.0));
+	}
+}
+
+REGISTER_TEST_COMMAND("render-list-sort-benchmark", &benchmark_render_list_sort);
+
+} // namespace TestRenderListSortCache
+
+#endif // TEST_RENDER_LIST_SORT_CACHE_H
@@ -0,0 +1,222 @@
+/*************************************************************************/
+/*  test_renderer_canvas_cull.h                                          */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_CULL_H
+#define TEST_RENDERER_CANVAS_CULL_H
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+#include "servers/display_server.h"
+#include "servers/rendering/renderer_canvas_cull.h"
+#include "servers/rendering/rendering_server_default.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasCull {
+
+// Creates a parent item with a grid of small children spaced `p_spacing` pixels apart.
+static RID create_item_grid(RID p_canvas, int p_width, int p_height, real_t p_spacing, Vector<RID> &r_children) {
+	RenderingServer *rs = RenderingServer::get_singleton();
+
+	RID parent = rs->canvas_item_create();
+	rs->canvas_item_set_parent(parent, p_canvas);
+
+	for (int y = 0; y < p_height; y++) {
+		for (int x = 0; x < p_width; x++) {
+			RID child = rs->canvas_item_create();
+			rs->canvas_item_set_parent(child, parent);
+			rs->canvas_item_set_draw_index(child, r_children.size());
+			rs->canvas_item_set_transform(child, Transform2D(0, Vector2(x, y) * p_spacing));
+			rs->canvas_item_add_rect(child, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+			rs->canvas_item_set_visibility_notifier(child, true, Rect2(0, 0, 10, 10), Callable(), Callable());
+			r_children.push_back(child);
+		}
+	}
+
+	return parent;
+}
+
+// Renders the canvas and returns how many of the given items were attached for drawing.
+static int render_and_count_visible(RID p_canvas, const Rect2 &p_clip_rect, const Vector<RID> &p_items, Vector<bool> *r_visible = nullptr) {
+	RendererCanvasCull *canvas_cull = RSG::canvas;
+	while (canvas_cull->visibility_notifier_list.first()) {
+		canvas_cull->visibility_notifier_list.remove(canvas_cull->visibility_notifier_list.first());
+	}
+
+	RendererCanvasCull::Canvas *canvas = canvas_cull->canvas_owner.get_or_null(p_canvas);
+	canvas_cull->render_canvas(RID(), canvas, Transform2D(), nullptr, nullptr, p_clip_rect, RS::CANVAS_ITEM_TEXTURE_FILTER_LINEAR, RS::CANVAS_ITEM_TEXTURE_REPEAT_DISABLED, false, false);
+
+	int visible = 0;
+	if (r_visible) {
+		r_visible->resize(p_items.size());
+	}
+	for (int i = 0; i < p_items.size(); i++) {
+		RendererCanvasCull::Item *item = canvas_cull->canvas_item_owner.get_or_null(p_items[i]);
+		bool in_list = item->visibility_notifier->visible_element.in_list();
+		if (in_list) {
+			visible++;
+		}
+		if (r_visible) {
+			r_visible->write[i] = in_list;
+		}
+	}
+	return visible;
+}
+
+TEST_CASE("[SceneTree][RendererCanvasCull] BVH culling matches the recursive walk") {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+
+	// 20x20 children 100 pixels apart, the parent offset so only a 5x5 block lands in the clip rect.
+	Vector<RID> children;
+	RID parent = create_item_grid(canvas, 20, 20, 100, children);
+	rs->canvas_item_set_transform(parent, Transform2D(0, Vector2(-500, -500)));
+
+	// A child that can't be culled through the BVH, since it has children of its own.
+	RID group = rs->canvas_item_create();
+	rs->canvas_item_set_parent(group, parent);
+	rs->canvas_item_set_draw_index(group, children.size());
+	RID grandchild = rs->canvas_item_create();
+	rs->canvas_item_set_parent(grandchild, group);
+	rs->canvas_item_add_rect(grandchild, Rect2(0, 0, 10, 10), Color(1, 1, 1));
+	rs->canvas_item_set_visibility_notifier(grandchild, true, Rect2(0, 0, 10, 10), Callable(), Callable());
+	rs->canvas_item_set_transform(group, Transform2D(0, Vector2(600, 600)));
+
+	Vector<RID> items = children;
+	items.push_back(grandchild);
+
+	const Rect2 clip_rect(0, 0, 450, 450);
+
+	Vector<bool> walk_visible;
+	rs->canvas_set_use_bvh_culling(canvas, false);
+	CHECK(render_and_count_visible(canvas, clip_rect, items, &walk_visible) == 26);
+
+	Vector<bool> bvh_visible;
+	rs->canvas_set_use_bvh_culling(canvas, true);
+	CHECK(render_and_count_visible(canvas, clip_rect, items, &bvh_visible) == 26);
+	CHECK_MESSAGE(walk_visible == bvh_visible, "The same items should be visible with and without BVH culling.");
+
+	SUBCASE("Moved items are updated in the BVH") {
+		rs->canvas_item_set_transform(children[0], Transform2D(0, Vector2(700, 700)));
+		CHECK(render_and_count_visible(canvas, clip_rect, items, &bvh_visible) == 27);
+		CHECK(bvh_visible[0]);
+
+		rs->canvas_item_set_transform(parent, Transform2D(0, Vector2(2000, 2000)));
+		CHECK_MESSAGE(render_and_count_visible(canvas, clip_rect, items) == 0, "Moving the parent should move the query, not the children bounds.");
+	}
+
+	SUBCASE("Reparented and freed items leave the BVH") {
+		rs->canvas_item_set_parent(children[21 * 5], RID());
+		CHECK(render_and_count_visible(canvas, clip_rect, items) == 25);
+
+		rs->free(children[21 * 5 + 1]);
+		items.erase(children[21 * 5 + 1]);
+		CHECK(render_and_count_visible(canvas, clip_rect, items) == 24);
+
+		rs->canvas_item_set_parent(children[21 * 5], parent);
+		CHECK(render_and_count_visible(canvas, clip_rect, items) == 25);
+	}
+
+	rs->free(canvas);
+	for (int i = 0; i < items.size(); i++) {
+		rs->free(items[i]);
+	}
+	rs->free(group);
+	rs->free(parent);
+}
+
+// Measures the per-frame cull cost of a large canvas while panning over it, with and without BVH culling.
+// Run with `godot --test canvas-cull-benchmark`.
+static void benchmark_canvas_cull() {
+	GLOBAL_DEF("memory/limits/multithreaded_server/rid_pool_prealloc", 60);
+
+	Error err = OK;
+	for (int i = 0; i < DisplayServer::get_create_function_count(); i++) {
+		if (String("headless") == DisplayServer::get_create_function_name(i)) {
+			DisplayServer::create(i, "", DisplayServer::WindowMode::WINDOW_MODE_MINIMIZED, DisplayServer::VSyncMode::VSYNC_ENABLED, 0, Vector2i(0, 0), err);
+			break;
+		}
+	}
+	ERR_FAIL_COND_MSG(!DisplayServer::get_singleton(), "The headless display server is required to run this benchmark.");
+
+	memnew(RenderingServerDefault());
+	RenderingServerDefault::get_singleton()->init();
+	RenderingServerDefault::get_singleton()->set_render_loop_enabled(false);
+
+	const int side = 320;
+	const int frames = 300;
+	const Rect2 clip_rect(0, 0, 1920, 1080);
+
+	RenderingServer *rs = RenderingServer::get_singleton();
+	RID canvas = rs->canvas_create();
+	Vector<RID> children;
+	RID parent = create_item_grid(canvas, side, side, 64, children);
+
+	print_line(vformat("Canvas cull benchmark: %d items, %d frames at %dx%d.", children.size(), frames, int(clip_rect.size.x), int(clip_rect.size.y)));
+
+	for (int pass = 0; pass < 2; pass++) {
+		const bool use_bvh = pass == 1;
+		rs->canvas_set_use_bvh_culling(canvas, use_bvh);
+
+		uint64_t total_usec = 0;
+		for (int i = 0; i < frames; i++) {
+			// Pan diagonally across the grid, and animate one in every hundred items.
+			rs->canvas_item_set_transform(parent, Transform2D(0, -Vector2(i, i) * 32.0));
+			for (int j = i % 100; j < children.size(); j += 100) {
+				const int x = j % side;
+				const int y = j / side;
+				rs->canvas_item_set_transform(children[j], Transform2D(0, Vector2(x, y) * 64 + Vector2(i % 16, 0)));
+			}
+
+			const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			render_and_count_visible(canvas, clip_rect, Vector<RID>());
+			total_usec += OS::get_singleton()->get_ticks_usec() - begin;
+		}
+
+		print_line(vformat("    %s: %.3f msec per frame", use_bvh ? "BVH culling" : "recursive walk", double(total_usec) / frames / 1000.0));
+	}
+
+	for (int i = 0; i < children.size(); i++) {
+		rs->free(children[i]);
+	}
+	rs->free(parent);
+	rs->free(canvas);
+
+	rs->sync();
+	rs->finish();
+	memdelete(rs);
+	memdelete(DisplayServer::get_singleton());
+}
+
+REGISTER_TEST_COMMAND("canvas-cull-benchmark", &benchmark_canvas_cull);
+
+} // namespace TestRendererCanvasCull
+
+#endif // TEST_RENDERER_CANVAS_CULL_H
@@ -0,0 +1,138 @@
+/*************************************************************************/
+/*  test_renderer_scene_cull.h                                           */
+/*************************************************************************/
+/*                       This file is part of:                           */
+/*                           GODOT ENGINE                                */
+/*                      https://godotengine.org                          */
+/*************************************************************************/
+/* Copyright (c) 2007-2022 Juan Linietsky, Ariel Manzur.                 */
+/* Copyright (c) 2014-2022 Godot Engine contributors (cf. AUTHORS.md).   */
+/*                                                                       */
+/* Permission is hereby granted, free of charge, to any person obtaining */
+/* a copy of this software and associated documentation files (the       */
+/* "Software"), to deal in the Software without restriction, including   */
+/* without limitation the rights to use, copy, modify, merge, publish,   */
+/* distribute, sublicense, and/or sell copies of the Software, and to    */
+/* permit persons to whom the Software is furnished to do so, subject to */
+/* the following conditions:                                             */
+/*                                                                       */
+/* The above copyright notice and this permission notice shall be        */
+/* included in all copies or substantial portions of the Software.       */
+/*                                                                       */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,       */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF    */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.*/
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY  */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,  */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE     */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                */
+/*************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "core/math/camera_matrix.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+typedef RendererSceneCull::InstanceBounds InstanceBounds;
+typedef RendererSceneCull::InstanceBoundsBlock InstanceBoundsBlock;
+
+// Scatters small boxes around the origin, some inside and some outside of the test camera frustum.
+static void create_bounds(uint32_t p_count, LocalVector<InstanceBounds> &r_bounds, LocalVector<InstanceBoundsBlock> &r_blocks) {
+	RandomPCG rng(2022);
+	r_bounds.resize(p_count);
+	r_blocks.resize((p_count + InstanceBoundsBlock::SIZE - 1) / InstanceBoundsBlock::SIZE);
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Vector3 position(rng.random(-500.0, 500.0), rng.random(-50.0, 50.0), rng.random(-500.0, 500.0));
+		const Vector3 size(rng.random(0.1, 10.0), rng.random(0.1, 10.0), rng.random(0.1, 10.0));
+		r_bounds[i] = InstanceBounds(AABB(position, size));
+		r_blocks[i / InstanceBoundsBlock::SIZE].set(i % InstanceBoundsBlock::SIZE, r_bounds[i]);
+	}
+}
+
+static RendererSceneCull::Frustum create_frustum(real_t p_yaw) {
+	CameraMatrix projection;
+	projection.set_perspective(70, 16.0 / 9.0, 0.05, 300);
+	const Transform3D transform(Basis(Vector3(0, 1, 0), p_yaw), Vector3(0, 2, 0));
+	return RendererSceneCull::Frustum(projection.get_projection_planes(transform));
+}
+
+TEST_CASE("[RendererSceneCull] Block frustum test matches the per-instance test") {
+	LocalVector<InstanceBounds> bounds;
+	LocalVector<InstanceBoundsBlock> blocks;
+	create_bounds(4002, bounds, blocks);
+
+	for (int f = 0; f < 8; f++) {
+		const RendererSceneCull::Frustum frustum = create_frustum(f * Math_TAU / 8);
+
+		uint32_t mismatches = 0;
+		uint32_t visible = 0;
+		for (uint32_t i = 0; i < bounds.size(); i++) {
+			const uint32_t mask = blocks[i / InstanceBoundsBlock::SIZE].in_frustum_mask(frustum);
+			const bool block_result = (mask >> (i % InstanceBoundsBlock::SIZE)) & 1;
+			const bool expected = bounds[i].in_frustum(frustum);
+			if (block_result != expected) {
+				mismatches++;
+			}
+			if (expected) {
+				visible++;
+			}
+		}
+
+		CHECK_MESSAGE(mismatches == 0, "Block frustum test should agree with InstanceBounds::in_frustum().");
+		CHECK_MESSAGE(visible > 0, "Some instances should be in the frustum.");
+		CHECK_MESSAGE(visible < bounds.size(), "Some instances should be outside of the frustum.");
+	}
+}
+
+// Compares the frustum test over per-instance bounds with the SoA blocks used by _scene_cull().
+// Run with `godot --test scene-cull-benchmark`.
+static void benchmark_scene_cull() {
+	const uint32_t counts[2] = { 100000, 1000000 };
+	const int frames = 30;
+
+	for (int c = 0; c < 2; c++) {
+		LocalVector<InstanceBounds> bounds;
+		LocalVector<InstanceBoundsBlock> blocks;
+		create_bounds(counts[c], bounds, blocks);
+
+		uint64_t visible_aos = 0;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int f = 0; f < frames; f++) {
+			const RendererSceneCull::Frustum frustum = create_frustum(f * 0.1);
+			for (uint32_t i = 0; i < bounds.size(); i++) {
+				visible_aos += bounds[i].in_frustum(frustum);
+			}
+		}
+		const uint64_t aos_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		uint64_t visible_soa = 0;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int f = 0; f < frames; f++) {
+			const RendererSceneCull::Frustum frustum = create_frustum(f * 0.1);
+			for (uint32_t i = 0; i < blocks.size(); i++) {
+				const uint32_t mask = blocks[i].in_frustum_mask(frustum);
+				for (uint32_t j = 0; j < InstanceBoundsBlock::SIZE && i * InstanceBoundsBlock::SIZE + j < counts[c]; j++) {
+					visible_soa += (mask >> j) & 1;
+				}
+			}
+		}
+		const uint64_t soa_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("Scene cull benchmark: %d instances, %d frames, %.1f%% visible.", counts[c], frames, 100.0 * double(visible_aos) / (double(counts[c]) * frames)));
+		print_line(vformat("    per-instance bounds: %.3f msec per frame", double(aos_usec) / frames / 1000.0));
+		print_line(vformat("    SoA blocks of %d: %.3f msec per frame", InstanceBoundsBlock::SIZE, double(soa_usec) / frames / 1000.0));
+		ERR_FAIL_COND_MSG(visible_aos != visible_soa, "Per-instance and block frustum tests disagree.");
+	}
+}
+
+REGISTER_TEST_COMMAND("scene-cull-benchmark", &benchmark_scene_cull);
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -32,11 +32,14 @@
 
 #include "tests/core/io/test_config_file.h"
 #include "tests/core/io/test_file_access.h"
+#include "tests/core/io/test_http_client_pool.h"
 #include "tests/core/io/test_image.h"
 #include "tests/core/io/test_json.h"
 #include "tests/core/io/test_marshalls.h"
+#include "tests/core/io/test_net_socket_poller.h"
 #include "tests/core/io/test_pck_packer.h"
 #include "tests/core/io/test_resource.h"
+#include "tests/core/io/test_variant_schema.h"
 #include "tests/core/io/test_xml_parser.h"
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
@@ -52,7 +55,9 @@
 #include "tests/core/math/test_vector2i.h"
 #include "tests/core/math/test_vector3.h"
 #include "tests/core/math/test_vector3i.h"
+#include "tests/core/multiplayer/test_simulated_multiplayer_peer.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/string/test_node_path.h"
@@ -76,8 +81,15 @@
 #include "tests/scene/test_curve.h"
 #include "tests/scene/test_gradient.h"
 #include "tests/scene/test_path_3d.h"
+#include "tests/scene/test_process_thread_group.h"
+#include "tests/scene/test_scene_replication.h"
 #include "tests/scene/test_text_edit.h"
 #include "tests/scene/test_theme.h"
+#include "tests/servers/test_physics_space_history.h"
+#include "tests/servers/test_raster_occlusion_cull.h"
+#include "tests/servers/test_render_list_sort_cache.h"
+#include "tests/servers/test_renderer_canvas_cull.h"
+#include "tests/servers/test_renderer_scene_cull.h"
 #include "tests/servers/test_text_server.h"
 #include "tests/test_validate_testing.h"
 